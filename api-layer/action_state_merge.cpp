@@ -0,0 +1,300 @@
+// Copyright (c) 2021 LunarG, Inc.
+// Copyright (c) 2017-2021 PlutoVR Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Brad Grantham <brad@lunarg.com>
+
+#include "action_state_merge.h"
+#include "action_state_merge_kernel.h"
+
+#include <algorithm>
+#include <cstdint>
+
+#if !defined(OVERLAYS_API_LAYER_SCALAR_ACTION_MERGE)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define ACTION_MERGE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define ACTION_MERGE_NEON
+#include <arm_neon.h>
+#endif
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+void ActionStateLaneArrays::Resize(size_t count)
+{
+    isActive.resize(count);
+    changedSinceLastSync.resize(count);
+    lastChangeTimes.resize(count);
+    booleanStates.resize(count);
+    floatStates.resize(count);
+    yStates.resize(count);
+}
+
+void ActionStateLaneArrays::Clear()
+{
+    std::fill(isActive.begin(), isActive.end(), XR_FALSE);
+    std::fill(changedSinceLastSync.begin(), changedSinceLastSync.end(), XR_FALSE);
+    std::fill(lastChangeTimes.begin(), lastChangeTimes.end(), 0);
+    std::fill(booleanStates.begin(), booleanStates.end(), XR_FALSE);
+    std::fill(floatStates.begin(), floatStates.end(), 0.0f);
+    std::fill(yStates.begin(), yStates.end(), 0.0f);
+}
+
+ActionStateLanes ActionStateLaneArrays::Lanes()
+{
+    return { isActive.data(), changedSinceLastSync.data(), lastChangeTimes.data(), booleanStates.data(), floatStates.data(), yStates.data() };
+}
+
+namespace {
+
+template <typename T>
+T* OffsetLanes(T* p, size_t offset)
+{
+    return p ? (p + offset) : nullptr;
+}
+
+ActionStateLanes OffsetLanes(const ActionStateLanes& lanes, size_t offset)
+{
+    return {
+        OffsetLanes(lanes.isActive, offset),
+        OffsetLanes(lanes.changedSinceLastSync, offset),
+        OffsetLanes(lanes.lastChangeTimes, offset),
+        OffsetLanes(lanes.booleanStates, offset),
+        OffsetLanes(lanes.floatStates, offset),
+        OffsetLanes(lanes.yStates, offset),
+    };
+}
+
+#if defined(ACTION_MERGE_SSE2)
+
+struct SSE2Ops
+{
+    static constexpr size_t LaneWidth = 4;
+    typedef __m128i VecI;
+    typedef __m128 VecF;
+
+    static VecI LoadI(const XrBool32* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    static void StoreI(XrBool32* p, VecI v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+    static VecF LoadF(const float* p) { return _mm_loadu_ps(p); }
+    static void StoreF(float* p, VecF v) { _mm_storeu_ps(p, v); }
+    static VecI IsZero(VecI v) { return _mm_cmpeq_epi32(v, _mm_setzero_si128()); }
+    static VecI OrI(VecI a, VecI b) { return _mm_or_si128(a, b); }
+    static VecI SelectI(VecI mask, VecI a, VecI b) { return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b)); }
+    static VecF SelectF(VecI mask, VecF a, VecF b) { return _mm_castsi128_ps(SelectI(mask, _mm_castps_si128(a), _mm_castps_si128(b))); }
+    static VecI GreaterF(VecF a, VecF b) { return _mm_castps_si128(_mm_cmpgt_ps(a, b)); }
+    static VecF MulF(VecF a, VecF b) { return _mm_mul_ps(a, b); }
+    static VecF AddF(VecF a, VecF b) { return _mm_add_ps(a, b); }
+
+    static void SelectTimes(VecI mask, XrTime* accumulated, const XrTime* states)
+    {
+        VecI masks[2] = { _mm_unpacklo_epi32(mask, mask), _mm_unpackhi_epi32(mask, mask) };
+        for(int half = 0; half < 2; half++) {
+            __m128i* a = reinterpret_cast<__m128i*>(accumulated + half * 2);
+            const __m128i* s = reinterpret_cast<const __m128i*>(states + half * 2);
+            _mm_storeu_si128(a, SelectI(masks[half], _mm_loadu_si128(s), _mm_loadu_si128(a)));
+        }
+    }
+};
+
+#elif defined(ACTION_MERGE_NEON)
+
+struct NEONOps
+{
+    static constexpr size_t LaneWidth = 4;
+    typedef uint32x4_t VecI;
+    typedef float32x4_t VecF;
+
+    static VecI LoadI(const XrBool32* p) { return vld1q_u32(reinterpret_cast<const uint32_t*>(p)); }
+    static void StoreI(XrBool32* p, VecI v) { vst1q_u32(reinterpret_cast<uint32_t*>(p), v); }
+    static VecF LoadF(const float* p) { return vld1q_f32(p); }
+    static void StoreF(float* p, VecF v) { vst1q_f32(p, v); }
+    static VecI IsZero(VecI v) { return vceqq_u32(v, vdupq_n_u32(0)); }
+    static VecI OrI(VecI a, VecI b) { return vorrq_u32(a, b); }
+    static VecI SelectI(VecI mask, VecI a, VecI b) { return vbslq_u32(mask, a, b); }
+    static VecF SelectF(VecI mask, VecF a, VecF b) { return vbslq_f32(mask, a, b); }
+    static VecI GreaterF(VecF a, VecF b) { return vcgtq_f32(a, b); }
+    static VecF MulF(VecF a, VecF b) { return vmulq_f32(a, b); }
+    static VecF AddF(VecF a, VecF b) { return vaddq_f32(a, b); }
+
+    static void SelectTimes(VecI mask, XrTime* accumulated, const XrTime* states)
+    {
+        uint64x2_t masks[2] = {
+            vreinterpretq_u64_s64(vmovl_s32(vreinterpret_s32_u32(vget_low_u32(mask)))),
+            vreinterpretq_u64_s64(vmovl_s32(vreinterpret_s32_u32(vget_high_u32(mask)))),
+        };
+        for(int half = 0; half < 2; half++) {
+            uint64_t* a = reinterpret_cast<uint64_t*>(accumulated + half * 2);
+            const uint64_t* s = reinterpret_cast<const uint64_t*>(states + half * 2);
+            vst1q_u64(a, vbslq_u64(masks[half], vld1q_u64(s), vld1q_u64(a)));
+        }
+    }
+};
+
+#endif
+
+// Whether the CPU and OS can run AVX2 code
+bool CpuHasAVX2()
+{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    int info[4];
+    __cpuid(info, 0);
+    if(info[0] < 7) {
+        return false;
+    }
+    __cpuid(info, 1);
+    bool osSavesYmm = ((info[2] & (1 << 27)) != 0) && ((info[2] & (1 << 28)) != 0) && ((_xgetbv(0) & 0x6) == 0x6);
+    if(!osSavesYmm) {
+        return false;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+
+ActionMergeKernel BestActionMergeKernel()
+{
+    for(ActionMergeKernel kernel: { ActionMergeKernel::AVX2, ActionMergeKernel::SSE2, ActionMergeKernel::NEON }) {
+        if(ActionMergeKernelAvailable(kernel)) {
+            return kernel;
+        }
+    }
+    return ActionMergeKernel::Scalar;
+}
+
+}  // namespace
+
+bool ActionMergeKernelAvailable(ActionMergeKernel kernel)
+{
+    switch(kernel) {
+        case ActionMergeKernel::Scalar:
+            return true;
+        case ActionMergeKernel::SSE2:
+#if defined(ACTION_MERGE_SSE2)
+            return true;
+#else
+            return false;
+#endif
+        case ActionMergeKernel::AVX2: {
+            static const bool available = ActionMergeAVX2Built && CpuHasAVX2();
+            return available;
+        }
+        case ActionMergeKernel::NEON:
+#if defined(ACTION_MERGE_NEON)
+            return true;
+#else
+            return false;
+#endif
+    }
+    return false;
+}
+
+void MergeActionStateLanesScalar(XrActionType actionType, size_t count, const ActionStateLanes& accumulated, const ActionStateLanes& states)
+{
+    for(size_t i = 0; i < count; i++) {
+
+        if(actionType == XR_ACTION_TYPE_POSE_INPUT) {
+            accumulated.isActive[i] |= states.isActive[i];
+            continue;
+        }
+
+        // An inactive lane takes the merged state as is
+        if(!accumulated.isActive[i]) {
+            accumulated.isActive[i] = states.isActive[i];
+            accumulated.changedSinceLastSync[i] = states.changedSinceLastSync[i];
+            accumulated.lastChangeTimes[i] = states.lastChangeTimes[i];
+            switch(actionType) {
+                case XR_ACTION_TYPE_BOOLEAN_INPUT:
+                    accumulated.booleanStates[i] = states.booleanStates[i];
+                    break;
+                case XR_ACTION_TYPE_FLOAT_INPUT:
+                    accumulated.floatStates[i] = states.floatStates[i];
+                    break;
+                case XR_ACTION_TYPE_VECTOR2F_INPUT:
+                    accumulated.floatStates[i] = states.floatStates[i];
+                    accumulated.yStates[i] = states.yStates[i];
+                    break;
+                default:
+                    break;
+            }
+            continue;
+        }
+
+        switch(actionType) {
+            case XR_ACTION_TYPE_BOOLEAN_INPUT: {
+                accumulated.booleanStates[i] |= states.booleanStates[i];
+                break;
+            }
+            case XR_ACTION_TYPE_FLOAT_INPUT: {
+                accumulated.floatStates[i] = std::max(accumulated.floatStates[i], states.floatStates[i]);
+                break;
+            }
+            case XR_ACTION_TYPE_VECTOR2F_INPUT: {
+                float x = states.floatStates[i], y = states.yStates[i];
+                float ax = accumulated.floatStates[i], ay = accumulated.yStates[i];
+                float mergesq = x * x + y * y;
+                float accumsq = ax * ax + ay * ay;
+                if(mergesq > accumsq) {
+                    accumulated.floatStates[i] = x;
+                    accumulated.yStates[i] = y;
+                }
+                break;
+            }
+            default:
+                break;
+        }
+    }
+}
+
+void MergeActionStateLanesWithKernel(ActionMergeKernel kernel, XrActionType actionType, size_t count, const ActionStateLanes& accumulated, const ActionStateLanes& states)
+{
+    size_t merged = 0;
+
+    switch(kernel) {
+        case ActionMergeKernel::Scalar:
+            break;
+        case ActionMergeKernel::SSE2:
+#if defined(ACTION_MERGE_SSE2)
+            merged = MergeActionStateLanesVector<SSE2Ops>(actionType, count, accumulated, states);
+#endif
+            break;
+        case ActionMergeKernel::AVX2:
+            merged = MergeActionStateLanesAVX2(actionType, count, accumulated, states);
+            break;
+        case ActionMergeKernel::NEON:
+#if defined(ACTION_MERGE_NEON)
+            merged = MergeActionStateLanesVector<NEONOps>(actionType, count, accumulated, states);
+#endif
+            break;
+    }
+
+    if(merged < count) {
+        MergeActionStateLanesScalar(actionType, count - merged, OffsetLanes(accumulated, merged), OffsetLanes(states, merged));
+    }
+}
+
+void MergeActionStateLanes(XrActionType actionType, size_t count, const ActionStateLanes& accumulated, const ActionStateLanes& states)
+{
+    static const ActionMergeKernel kernel = BestActionMergeKernel();
+    MergeActionStateLanesWithKernel(kernel, actionType, count, accumulated, states);
+}
@@ -0,0 +1,84 @@
+// Copyright (c) 2021 LunarG, Inc.
+// Copyright (c) 2017-2021 PlutoVR Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Brad Grantham <brad@lunarg.com>
+#ifndef _ACTION_STATE_MERGE_H_
+#define _ACTION_STATE_MERGE_H_
+
+#include <openxr/openxr.h>
+#include <cstddef>
+#include <vector>
+
+// Action states of one action type, as parallel arrays with one lane per
+// state.  Boolean lanes use booleanStates, float lanes floatStates, and
+// vector2f lanes floatStates for x and yStates for y; pose lanes only have
+// isActive.
+struct ActionStateLanes
+{
+    XrBool32* isActive;
+    XrBool32* changedSinceLastSync;
+    XrTime* lastChangeTimes;
+    XrBool32* booleanStates;
+    float* floatStates;
+    float* yStates;
+};
+
+// Storage for ActionStateLanes
+struct ActionStateLaneArrays
+{
+    std::vector<XrBool32> isActive;
+    std::vector<XrBool32> changedSinceLastSync;
+    std::vector<XrTime> lastChangeTimes;
+    std::vector<XrBool32> booleanStates;
+    std::vector<float> floatStates;
+    std::vector<float> yStates;
+
+    void Resize(size_t count);
+    void Clear();       // every lane inactive and zero
+    ActionStateLanes Lanes();
+};
+
+// Instruction sets the merge below can use
+enum class ActionMergeKernel
+{
+    Scalar,
+    SSE2,
+    AVX2,
+    NEON,
+};
+
+// Whether kernel was built and this CPU runs it.  SSE2 and NEON are built
+// where the compiler targets them; AVX2 is built for any x86 in a file of
+// its own and is only available if the CPU has it.  Only Scalar is built
+// if OVERLAYS_API_LAYER_SCALAR_ACTION_MERGE is defined.
+bool ActionMergeKernelAvailable(ActionMergeKernel kernel);
+
+// Merge lane i of states into lane i of accumulated for count lanes, as
+// xrGetActionState* merges the bindings of an action: an inactive lane
+// takes the state as is; otherwise booleans are ORed, the larger float
+// and the longer vector2f are kept, and pose lanes are active if either is.
+// Uses the widest available kernel, picked the first time it's called.
+void MergeActionStateLanes(XrActionType actionType, size_t count, const ActionStateLanes& accumulated, const ActionStateLanes& states);
+
+// The same with kernel, which must be available; lanes past its last
+// whole vector are merged one at a time
+void MergeActionStateLanesWithKernel(ActionMergeKernel kernel, XrActionType actionType, size_t count, const ActionStateLanes& accumulated, const ActionStateLanes& states);
+
+// The same, one lane at a time
+void MergeActionStateLanesScalar(XrActionType actionType, size_t count, const ActionStateLanes& accumulated, const ActionStateLanes& states);
+
+#endif /* _ACTION_STATE_MERGE_H_ */
@@ -0,0 +1,80 @@
+// Copyright (c) 2021 LunarG, Inc.
+// Copyright (c) 2017-2021 PlutoVR Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Brad Grantham <brad@lunarg.com>
+
+// The AVX2 action state merge.  This file alone is built with AVX2 enabled
+// and MergeActionStateLanes only calls it on CPUs which have AVX2, so it
+// must not define anything the rest of the layer could link to instead of
+// its own copy.
+
+#include "action_state_merge_kernel.h"
+
+#if defined(__AVX2__) && !defined(OVERLAYS_API_LAYER_SCALAR_ACTION_MERGE)
+
+#include <immintrin.h>
+
+namespace {
+
+struct AVX2Ops
+{
+    static constexpr size_t LaneWidth = 8;
+    typedef __m256i VecI;
+    typedef __m256 VecF;
+
+    static VecI LoadI(const XrBool32* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    static void StoreI(XrBool32* p, VecI v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+    static VecF LoadF(const float* p) { return _mm256_loadu_ps(p); }
+    static void StoreF(float* p, VecF v) { _mm256_storeu_ps(p, v); }
+    static VecI IsZero(VecI v) { return _mm256_cmpeq_epi32(v, _mm256_setzero_si256()); }
+    static VecI OrI(VecI a, VecI b) { return _mm256_or_si256(a, b); }
+    static VecI SelectI(VecI mask, VecI a, VecI b) { return _mm256_blendv_epi8(b, a, mask); }
+    static VecF SelectF(VecI mask, VecF a, VecF b) { return _mm256_blendv_ps(b, a, _mm256_castsi256_ps(mask)); }
+    static VecI GreaterF(VecF a, VecF b) { return _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_GT_OQ)); }
+    static VecF MulF(VecF a, VecF b) { return _mm256_mul_ps(a, b); }
+    static VecF AddF(VecF a, VecF b) { return _mm256_add_ps(a, b); }
+
+    static void SelectTimes(VecI mask, XrTime* accumulated, const XrTime* states)
+    {
+        VecI masks[2] = { _mm256_cvtepi32_epi64(_mm256_castsi256_si128(mask)), _mm256_cvtepi32_epi64(_mm256_extracti128_si256(mask, 1)) };
+        for(int half = 0; half < 2; half++) {
+            __m256i* a = reinterpret_cast<__m256i*>(accumulated + half * 4);
+            const __m256i* s = reinterpret_cast<const __m256i*>(states + half * 4);
+            _mm256_storeu_si256(a, _mm256_blendv_epi8(_mm256_loadu_si256(a), _mm256_loadu_si256(s), masks[half]));
+        }
+    }
+};
+
+}  // namespace
+
+const bool ActionMergeAVX2Built = true;
+
+size_t MergeActionStateLanesAVX2(XrActionType actionType, size_t count, const ActionStateLanes& accumulated, const ActionStateLanes& states)
+{
+    return MergeActionStateLanesVector<AVX2Ops>(actionType, count, accumulated, states);
+}
+
+#else
+
+const bool ActionMergeAVX2Built = false;
+
+size_t MergeActionStateLanesAVX2(XrActionType, size_t, const ActionStateLanes&, const ActionStateLanes&)
+{
+    return 0;
+}
+
+#endif
@@ -0,0 +1,103 @@
+// Copyright (c) 2021 LunarG, Inc.
+// Copyright (c) 2017-2021 PlutoVR Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Brad Grantham <brad@lunarg.com>
+#ifndef _ACTION_STATE_MERGE_KERNEL_H_
+#define _ACTION_STATE_MERGE_KERNEL_H_
+
+// Shared by the action_state_merge*.cpp files only.  The vector merge is
+// written once here over an Ops type each instruction set defines in the
+// file built for it; Ops are in anonymous namespaces, so each file's
+// instantiation stays in that file and code built for AVX2 is never
+// picked by the linker for a CPU without it.
+
+#include "action_state_merge.h"
+
+#include <cstddef>
+
+// Merge whole vectors of lanes and return how many lanes were merged.  Ops has:
+//   LaneWidth, VecI (LaneWidth XrBool32s) and VecF (LaneWidth floats)
+//   LoadI, StoreI, LoadF, StoreF: unaligned loads and stores
+//   IsZero: all ones in lanes which are 0
+//   OrI, MulF, AddF
+//   SelectI, SelectF: lanes of a where mask is all ones, of b elsewhere
+//   GreaterF: all ones in lanes where a > b; false for NaNs
+//   SelectTimes: lastChangeTimes of states where mask is all ones
+template <class Ops>
+size_t MergeActionStateLanesVector(XrActionType actionType, size_t count, const ActionStateLanes& accumulated, const ActionStateLanes& states)
+{
+    typedef typename Ops::VecI VecI;
+    typedef typename Ops::VecF VecF;
+    const size_t LaneWidth = Ops::LaneWidth;
+
+    size_t i = 0;
+
+    if(actionType == XR_ACTION_TYPE_POSE_INPUT) {
+        for(; i + LaneWidth <= count; i += LaneWidth) {
+            Ops::StoreI(accumulated.isActive + i, Ops::OrI(Ops::LoadI(accumulated.isActive + i), Ops::LoadI(states.isActive + i)));
+        }
+        return i;
+    }
+
+    for(; i + LaneWidth <= count; i += LaneWidth) {
+        VecI accumulatedActive = Ops::LoadI(accumulated.isActive + i);
+        VecI takeState = Ops::IsZero(accumulatedActive);
+
+        switch(actionType) {
+            case XR_ACTION_TYPE_BOOLEAN_INPUT: {
+                VecI a = Ops::LoadI(accumulated.booleanStates + i);
+                VecI s = Ops::LoadI(states.booleanStates + i);
+                Ops::StoreI(accumulated.booleanStates + i, Ops::SelectI(takeState, s, Ops::OrI(a, s)));
+                break;
+            }
+            case XR_ACTION_TYPE_FLOAT_INPUT: {
+                VecF a = Ops::LoadF(accumulated.floatStates + i);
+                VecF s = Ops::LoadF(states.floatStates + i);
+                VecF larger = Ops::SelectF(Ops::GreaterF(s, a), s, a);
+                Ops::StoreF(accumulated.floatStates + i, Ops::SelectF(takeState, s, larger));
+                break;
+            }
+            case XR_ACTION_TYPE_VECTOR2F_INPUT: {
+                VecF ax = Ops::LoadF(accumulated.floatStates + i);
+                VecF ay = Ops::LoadF(accumulated.yStates + i);
+                VecF sx = Ops::LoadF(states.floatStates + i);
+                VecF sy = Ops::LoadF(states.yStates + i);
+                VecF accumsq = Ops::AddF(Ops::MulF(ax, ax), Ops::MulF(ay, ay));
+                VecF mergesq = Ops::AddF(Ops::MulF(sx, sx), Ops::MulF(sy, sy));
+                VecI takeVector = Ops::OrI(takeState, Ops::GreaterF(mergesq, accumsq));
+                Ops::StoreF(accumulated.floatStates + i, Ops::SelectF(takeVector, sx, ax));
+                Ops::StoreF(accumulated.yStates + i, Ops::SelectF(takeVector, sy, ay));
+                break;
+            }
+            default:
+                return 0;
+        }
+
+        Ops::StoreI(accumulated.isActive + i, Ops::SelectI(takeState, Ops::LoadI(states.isActive + i), accumulatedActive));
+        Ops::StoreI(accumulated.changedSinceLastSync + i, Ops::SelectI(takeState, Ops::LoadI(states.changedSinceLastSync + i), Ops::LoadI(accumulated.changedSinceLastSync + i)));
+        Ops::SelectTimes(takeState, accumulated.lastChangeTimes + i, states.lastChangeTimes + i);
+    }
+
+    return i;
+}
+
+// From action_state_merge_avx2.cpp, which is built with AVX2 enabled on x86
+// and as these stubs elsewhere
+extern const bool ActionMergeAVX2Built;
+size_t MergeActionStateLanesAVX2(XrActionType actionType, size_t count, const ActionStateLanes& accumulated, const ActionStateLanes& states);
+
+#endif /* _ACTION_STATE_MERGE_KERNEL_H_ */
@@ -551,8 +551,8 @@ add_to_handle_struct["XrInstance"] = {
     std::set<OverlaysLayerXrActionSetHandleInfo::Ptr> childActionSets;
     std::set<OverlaysLayerXrSessionHandleInfo::Ptr> childSessions;
     std::set<OverlaysLayerXrDebugUtilsMessengerEXTHandleInfo::Ptr> childDebugUtilsMessengerEXTs;
-    std::unordered_map<WellKnownStringIndex, XrPath> OverlaysLayerWellKnownStringToPath;
-    std::unordered_map<XrPath, WellKnownStringIndex> OverlaysLayerPathToWellKnownString;
+    std::vector<XrPath> OverlaysLayerWellKnownStringToPath;   // indexed by WellKnownStringIndex
+    WellKnownStringsByPath OverlaysLayerPathToWellKnownString;
     std::unordered_map<XrPath, XrPath> OverlaysLayerBindingToSubaction;
     std::set<XrPath> OverlaysLayerAllSubactionPaths;
 
@@ -565,21 +565,40 @@ add_to_handle_struct["XrInstance"] = {
 add_to_handle_struct["XrSession"] = {
     "members" : """
     ID3D11Device*   d3d11Device;
+    GraphicsBackend::Ptr graphicsBackend;
     XrSession localHandle;
     const XrSessionCreateInfo *createInfo = nullptr;
     std::set<OverlaysLayerXrSwapchainHandleInfo::Ptr> childSwapchains;
     std::set<OverlaysLayerXrSpaceHandleInfo::Ptr> childSpaces;
     XrActionSet placeholderActionSet;
     std::unordered_map<XrAction, std::string> placeholderActionNames;
-    std::unordered_map<XrPath, std::pair<XrAction, XrActionType>> placeholderActions;
-    std::map<std::pair<XrPath /* interaction profile */, XrPath /* full binding */>, std::pair<XrAction, XrActionType>> placeholderActionsByProfileAndFullBinding;
+    PlaceholderStateCache placeholderStates;
+    SpaceLocationCache spaceLocations;
+    XrAction placeholderActionTable[PlaceholderProfileCount][PlaceholderComponentCount] = {};   // by PlaceholderCells index, XR_NULL_HANDLE if not created
     std::unordered_map<XrPath, std::vector<XrActionSuggestedBinding>> bindingsByProfile;
-    std::unordered_map<XrAction, XrPath> bindingsByAction;
-    std::vector<XrActiveActionSet> lastSyncedActiveActionSets;
+    std::bitset<PlaceholderProfileCount * PlaceholderComponentCount> requestedPlaceholders;     // cells Overlays asked for before placeholder Actions were created
+    bool placeholderActionsCreated = false;     // placeholder Actions are created when Main attaches, the last point Actions can be added
+    std::unordered_map<uint64_t, SyncActionsPlan::Ptr> syncActionsPlans;     // by HashActiveActionSets()
+    SyncActionsPlan::Ptr lastSyncActionsPlan;
+    ActionStateStore actionStates;
+    std::recursive_mutex syncActionsMutex;  // held from a downchain SyncActions through the Gets and locates which rely on it
+    uint64_t locateSyncGeneration = 0;      // GetMainFrameGeneration() when locateSyncedActionSets was last cleared
+    std::set<std::pair<XrActionSet, XrPath>> locateSyncedActionSets;    // synced by the Main app or its locates this frame
     bool actionSetsWereAttached = false;
     std::set<XrPath> interactionProfiles;
     std::unordered_map<XrPath,XrPath> currentInteractionProfileBySubactionPath;
     bool interactionProfileChangePending = false;
+    std::vector<std::shared_ptr<const XrCompositionLayerBaseHeader>> lastSubmittedLayers;
+    XrEnvironmentBlendMode lastSubmittedBlendMode = XR_ENVIRONMENT_BLEND_MODE_MAX_ENUM;
+    bool swapchainReleasedSinceEndFrame = true;    // Overlay: Main may have copies and runtime releases pending
+""",
+    "methods" : """
+    // Only one SyncActions of this session's ActionSets, the Main app's or
+    // the placeholders for Overlays, may be relied on at a time
+    std::unique_lock<std::recursive_mutex> GetSyncActionsLock()
+    {
+        return std::unique_lock<std::recursive_mutex>(syncActionsMutex);
+    }
 """,
 }
 
@@ -646,6 +665,7 @@ after_downchain_main["xrWaitFrame"] = """
         mainSession->sessionState.savedFrameState = savedFrameState;
 
         mainSession->sessionState.DoCommand(OpenXRCommand::WAIT_FRAME);
+        mainSession->waitFrameCount++;
 
         std::unique_lock<std::recursive_mutex> lock(gConnectionsToOverlayByProcessIdMutex);
         if(!gConnectionsToOverlayByProcessId.empty()) {
@@ -711,7 +731,6 @@ add_to_handle_struct["XrAction"] = {
     std::set<XrPath> subactionPaths;
     std::set<XrPath> suggestedBindings;
     std::unordered_map<XrPath /* interaction Profile */, std::set<XrPath>> suggestedBindingsByProfile;
-    std::unordered_map<XrPath, ActionStateUnion> stateBySubactionPath;
 """,
 }
 
@@ -1336,6 +1355,95 @@ CreateSwapchainRPC = {
     "function" : "OverlaysLayerCreateSwapchainMainAsOverlay"
 }
 
+GetSwapchainSharedImagesRPC = {
+    "command_name" : "GetSwapchainSharedImages",
+    "args" : (
+        {
+            "name" : "swapchain",
+            "type" : "POD",
+            "pod_type" : "XrSwapchain",
+        },
+        {
+            "name" : "imageCapacityInput",
+            "type" : "POD",
+            "pod_type" : "uint32_t",
+        },
+        {
+            "name" : "imageCountOutput",
+            "type" : "pointer_to_pod",
+            "pod_type" : "uint32_t",
+            "is_const" : False
+        },
+        {
+            "name" : "images",
+            "type" : "fixed_array",
+            "base_type" : "HANDLE",
+            "input_size" : "imageCapacityInput",
+            "output_size" : "imageCountOutput",
+            "is_const" : False
+        },
+        {
+            "name" : "fences",
+            "type" : "fixed_array",
+            "base_type" : "HANDLE",
+            "input_size" : "imageCapacityInput",
+            "output_size" : "imageCountOutput",
+            "is_const" : False
+        },
+    ),
+    "function" : "OverlaysLayerGetSwapchainSharedImagesMainAsOverlay"
+}
+
+SetSwapchainSharedImagesRPC = {
+    "command_name" : "SetSwapchainSharedImages",
+    "args" : (
+        {
+            "name" : "swapchain",
+            "type" : "POD",
+            "pod_type" : "XrSwapchain",
+        },
+        {
+            "name" : "imageCount",
+            "type" : "POD",
+            "pod_type" : "uint32_t",
+        },
+        {
+            "name" : "images",
+            "type" : "fixed_array",
+            "base_type" : "HANDLE",
+            "input_size" : "imageCount",
+            "is_const" : True
+        },
+        {
+            "name" : "fences",
+            "type" : "fixed_array",
+            "base_type" : "HANDLE",
+            "input_size" : "imageCount",
+            "is_const" : True
+        },
+    ),
+    "function" : "OverlaysLayerSetSwapchainSharedImagesMainAsOverlay"
+}
+
+DiscardSharedImagesRPC = {
+    "command_name" : "DiscardSharedImages",
+    "args" : (
+        {
+            "name" : "imageCount",
+            "type" : "POD",
+            "pod_type" : "uint32_t",
+        },
+        {
+            "name" : "images",
+            "type" : "fixed_array",
+            "base_type" : "HANDLE",
+            "input_size" : "imageCount",
+            "is_const" : True
+        },
+    ),
+    "function" : "OverlaysLayerDiscardSharedImagesMainAsOverlay"
+}
+
 CreateReferenceSpaceRPC = {
     "command_name" : "CreateReferenceSpace",
     "args" : (
@@ -1475,6 +1583,18 @@ EndFrameRPC = {
     "function" : "OverlaysLayerEndFrameMainAsOverlay"
 }
 
+EndFrameUnchangedRPC = {
+    "command_name" : "EndFrameUnchanged",
+    "args" : (
+        {
+            "name" : "session",
+            "type" : "POD",
+            "pod_type" : "XrSession",
+        },
+    ),
+    "function" : "OverlaysLayerEndFrameUnchangedMainAsOverlay"
+}
+
 AcquireSwapchainImageRPC = {
     "command_name" : "AcquireSwapchainImage",
     "args" : (
@@ -1541,6 +1661,23 @@ ReleaseSwapchainImageRPC = {
             "type" : "POD",
             "pod_type" : "HANDLE",
         },
+        {
+            "name" : "hasDamageRects",
+            "type" : "POD",
+            "pod_type" : "XrBool32",
+        },
+        {
+            "name" : "damageRectCount",
+            "type" : "POD",
+            "pod_type" : "uint32_t",
+        },
+        {
+            "name" : "damageRects",
+            "type" : "fixed_array",
+            "base_type" : "XrRect2Di",
+            "input_size" : "damageRectCount",
+            "is_const" : True
+        },
     ),
     "function" : "OverlaysLayerReleaseSwapchainImageMainAsOverlay"
 }
@@ -1671,6 +1808,51 @@ LocateSpaceRPC = {
     "function" : "OverlaysLayerLocateSpaceMainAsOverlay"
 }
 
+LocateSpacesRPC = {
+    "command_name" : "LocateSpaces",
+    "args" : (
+        {
+            "name" : "time",
+            "type" : "POD",
+            "pod_type" : "XrTime",
+        },
+        {
+            "name" : "spaceCount",
+            "type" : "POD",
+            "pod_type" : "uint32_t",
+        },
+        {
+            "name" : "spaces",
+            "type" : "fixed_array",
+            "base_type" : "XrSpace",
+            "input_size" : "spaceCount",
+            "is_const" : True
+        },
+        {
+            "name" : "baseSpaces",
+            "type" : "fixed_array",
+            "base_type" : "XrSpace",
+            "input_size" : "spaceCount",
+            "is_const" : True
+        },
+        {
+            "name" : "locations",
+            "type" : "fixed_xrstruct_array",
+            "struct_type" : "XrSpaceLocation",
+            "input_size" : "spaceCount",
+            "is_const" : False
+        },
+        {
+            "name" : "results",
+            "type" : "fixed_array",
+            "base_type" : "XrResult",
+            "input_size" : "spaceCount",
+            "is_const" : False
+        },
+    ),
+    "function" : "OverlaysLayerLocateSpacesMainAsOverlay"
+}
+
 DestroySpaceRPC = {
     "command_name" : "DestroySpace",
     "args" : (
@@ -1691,6 +1873,12 @@ DestroySwapchainRPC = {
             "type" : "POD",
             "pod_type" : "XrSwapchain",
         },
+        {
+            "name" : "imagesPooled",
+            "type" : "pointer_to_pod",
+            "pod_type" : "XrBool32",
+            "is_const" : False,
+        },
     ),
     "function" : "OverlaysLayerDestroySwapchainMainAsOverlay"
 }
@@ -1723,10 +1911,36 @@ SyncActionsAndGetStateRPC = {
             "is_const" : True
         },
         {
-            "name" : "states",
+            "name" : "acknowledgedGeneration",
+            "type" : "POD",
+            "pod_type" : "uint64_t",
+        },
+        {
+            "name" : "stateGeneration",
+            "type" : "pointer_to_pod",
+            "pod_type" : "uint64_t",
+            "is_const" : False
+        },
+        {
+            "name" : "changedCount",
+            "type" : "pointer_to_pod",
+            "pod_type" : "uint32_t",
+            "is_const" : False
+        },
+        {
+            "name" : "changedIndices",
+            "type" : "fixed_array",
+            "base_type" : "uint32_t",
+            "input_size" : "countProfileAndBindings",
+            "output_size" : "changedCount",
+            "is_const" : False
+        },
+        {
+            "name" : "changedStates",
             "type" : "fixed_array",
             "base_type" : "ActionStateUnion",
             "input_size" : "countProfileAndBindings",
+            "output_size" : "changedCount",
             "is_const" : False
         },
         {
@@ -1896,17 +2110,52 @@ StopHapticFeedbackRPC = {
     "function" : "OverlaysLayerStopHapticFeedbackMainAsOverlay"
 }
 
+RequestPlaceholderActionsRPC = {
+    "command_name" : "RequestPlaceholderActions",
+    "args" : (
+        {
+            "name" : "session",
+            "type" : "POD",
+            "pod_type" : "XrSession",
+        },
+        {
+            "name" : "countProfileAndBindings",
+            "type" : "POD",
+            "pod_type" : "uint32_t",
+        },
+        {
+            "name" : "profileStrings",
+            "type" : "fixed_array",
+            "base_type" : "WellKnownStringIndex",
+            "input_size" : "countProfileAndBindings",
+            "is_const" : True
+        },
+        {
+            "name" : "bindingStrings",
+            "type" : "fixed_array",
+            "base_type" : "WellKnownStringIndex",
+            "input_size" : "countProfileAndBindings",
+            "is_const" : True
+        },
+    ),
+    "function" : "OverlaysLayerRequestPlaceholderActionsMainAsOverlay"
+}
+
 rpcs = (
     CreateSessionRPC,
     DestroySessionRPC,
     EnumerateSwapchainFormatsRPC,
     CreateSwapchainRPC,
+    GetSwapchainSharedImagesRPC,
+    SetSwapchainSharedImagesRPC,
+    DiscardSharedImagesRPC,
     DestroySwapchainRPC,
     EnumerateReferenceSpacesRPC,
     GetReferenceSpaceBoundsRectRPC,
     CreateReferenceSpaceRPC,
     LocateViewsRPC,
     LocateSpaceRPC,
+    LocateSpacesRPC,
     DestroySpaceRPC,
     PollEventRPC,
     BeginSessionRPC,
@@ -1915,6 +2164,7 @@ rpcs = (
     WaitFrameRPC,
     BeginFrameRPC,
     EndFrameRPC,
+    EndFrameUnchangedRPC,
     AcquireSwapchainImageRPC,
     WaitSwapchainImageRPC,
     ReleaseSwapchainImageRPC,
@@ -1923,6 +2173,7 @@ rpcs = (
     GetInputSourceLocalizedNameRPC,
     ApplyHapticFeedbackRPC,
     StopHapticFeedbackRPC,
+    RequestPlaceholderActionsRPC,
 )
 
 
@@ -244,31 +244,134 @@ def to_upper_snake(str) :
 
 num = 1
 well_known_enums = ""
-well_known_mappings = ""
 for str in well_known_strings:
     well_known_enums += "    " + to_upper_snake(str) + " = %d,\n" % num
-    well_known_mappings += "    {" + to_upper_snake(str) + ', "' + str + '"},\n'
     num += 1
 
-placeholder_ids = ""
+# Perfect hash from well-known string to WellKnownStringIndex, hash and
+# displace style: the unseeded hash picks a bucket and the bucket's seed
+# rehashes its strings to slots no other string uses.  Seeds are searched
+# biggest bucket first; both hashes must match HashWellKnownString() below.
 
+hash_bucket_count = 64
+hash_slot_count = 256
+
+def hash_well_known_string(str, seed):
+    h = (2166136261 ^ seed) & 0xFFFFFFFF
+    for c in str.encode("utf-8"):
+        h = ((h ^ c) * 16777619) & 0xFFFFFFFF
+    h ^= h >> 15
+    h = (h * 0x2C1B3C6D) & 0xFFFFFFFF
+    h ^= h >> 12
+    return h
+
+buckets = [[] for i in range(hash_bucket_count)]
+for str in sorted(well_known_strings):
+    buckets[hash_well_known_string(str, 0) % hash_bucket_count].append(str)
+
+hash_seeds = [0] * hash_bucket_count
+hash_slots = [None] * hash_slot_count
+for b in sorted(range(hash_bucket_count), key = lambda b: -len(buckets[b])):
+    if len(buckets[b]) == 0:
+        break
+    seed = 1
+    while True:
+        slots = [hash_well_known_string(str, seed) % hash_slot_count for str in buckets[b]]
+        if len(set(slots)) == len(slots) and all(hash_slots[slot] is None for slot in slots):
+            break
+        seed += 1
+    hash_seeds[b] = seed
+    for (str, slot) in zip(buckets[b], slots):
+        hash_slots[slot] = str
+
+well_known_hash_seeds = ""
+for i in range(0, hash_bucket_count, 8):
+    well_known_hash_seeds += "    " + " ".join(["%d," % seed for seed in hash_seeds[i:i + 8]]) + "\n"
+
+well_known_hash_slots = ""
+for str in hash_slots:
+    if str is None:
+        well_known_hash_slots += "    {nullptr, NULL_PATH},\n"
+    else:
+        well_known_hash_slots += '    {"' + str + '", ' + to_upper_snake(str) + "},\n"
+
+# One placeholder action per interaction profile and input component,
+# with a subaction path for each top-level path having that component in
+# the profile.  Cells are indexed by position in the sorted profile and
+# component lists; top-level paths are bits in a cell's subactionMask.
+
+def component_action_type(component):
+    if component.endswith("value") or component.endswith("x") or component.endswith("y") or component.endswith("force") or component.endswith("touch"):
+        return "XR_ACTION_TYPE_FLOAT_INPUT"
+    elif component.endswith("click"):
+        return "XR_ACTION_TYPE_BOOLEAN_INPUT"
+    elif component.endswith("pose"):
+        return "XR_ACTION_TYPE_POSE_INPUT"
+    elif component.endswith("haptic") or component.endswith("haptic_left") or component.endswith("haptic_right") or component.endswith("haptic_left_trigger") or component.endswith("haptic_right_trigger"):
+        return "XR_ACTION_TYPE_VIBRATION_OUTPUT"
+    print("oh, crap: %s" % component)
+    sys.exit(1)
+
+placeholder_cells = {}      # (profile, component) : [type, set of top_level]
 for (profile, top_levels) in placeholder_profiles.items():
     for (top_level, components) in top_levels.items():
         for component in components:
-            if component.endswith("value") or component.endswith("x") or component.endswith("y") or component.endswith("force") or component.endswith("touch"):
-                type = "XR_ACTION_TYPE_FLOAT_INPUT"
-            elif component.endswith("click"):
-                type = "XR_ACTION_TYPE_BOOLEAN_INPUT"
-            elif component.endswith("pose"):
-                type = "XR_ACTION_TYPE_POSE_INPUT"
-            elif component.endswith("haptic") or component.endswith("haptic_left") or component.endswith("haptic_right") or component.endswith("haptic_left_trigger") or component.endswith("haptic_right_trigger"):
-                type = "XR_ACTION_TYPE_VIBRATION_OUTPUT"
-            else:
-                print("oh, crap: %s" % component)
-                sys.exit(1);
-            placeholder_ids += '    {"' + profile + top_level + component + '", ' + type + ', ' + to_upper_snake(profile) + ", " + to_upper_snake(top_level) + ", " + to_upper_snake(component) + ", " + to_upper_snake(top_level + component) + "},\n"
+            typed_components = [(component, component_action_type(component))]
             if component.endswith("x"):
-                placeholder_ids += '    {"' + profile + top_level + component[:-2] + '", XR_ACTION_TYPE_VECTOR2F_INPUT, ' + to_upper_snake(profile) + ", " + to_upper_snake(top_level) + ", " + to_upper_snake(component[:-2]) + ", " + to_upper_snake(top_level + component[:-2]) + "},\n"
+                typed_components.append((component[:-2], "XR_ACTION_TYPE_VECTOR2F_INPUT"))
+            for (c, type) in typed_components:
+                cell = placeholder_cells.setdefault((profile, c), [type, set()])
+                if cell[0] != type:
+                    print("placeholder %s%s is both %s and %s" % (profile, c, cell[0], type))
+                    sys.exit(1)
+                cell[1].add(top_level)
+
+placeholder_profile_list = sorted(placeholder_profiles.keys())
+placeholder_component_list = sorted(set([c for (p, c) in placeholder_cells.keys()]))
+placeholder_top_level_list = sorted(set([t for (type, top_levels) in placeholder_cells.values() for t in top_levels]))
+
+# Validate offline what Main relies on at runtime: indices fit the tables'
+# types, and every full binding splits into exactly one top-level path and
+# component
+if len(placeholder_top_level_list) > 32:
+    print("%d top-level paths don't fit in subactionMask" % len(placeholder_top_level_list))
+    sys.exit(1)
+if max(len(placeholder_profile_list), len(placeholder_component_list)) >= 255:
+    print("too many placeholder profiles or components for uint8_t indices")
+    sys.exit(1)
+
+placeholder_bindings = {}   # full binding : (top_level, component)
+for ((profile, component), (type, top_levels)) in placeholder_cells.items():
+    for top_level in top_levels:
+        full_binding = top_level + component
+        if full_binding not in well_known_strings:
+            print("placeholder binding %s isn't a well-known string" % full_binding)
+            sys.exit(1)
+        if placeholder_bindings.setdefault(full_binding, (top_level, component)) != (top_level, component):
+            print("placeholder binding %s splits more than one way" % full_binding)
+            sys.exit(1)
+
+placeholder_top_levels = "".join(["    " + to_upper_snake(t) + ",\n" for t in placeholder_top_level_list])
+placeholder_profile_strings = "".join(["    " + to_upper_snake(p) + ",\n" for p in placeholder_profile_list])
+placeholder_component_strings = "".join(["    " + to_upper_snake(c) + ",\n" for c in placeholder_component_list])
+
+placeholder_cell_rows = ""
+for profile in placeholder_profile_list:
+    placeholder_cell_rows += "    { // " + profile + "\n"
+    for component in placeholder_component_list:
+        if (profile, component) in placeholder_cells:
+            (type, top_levels) = placeholder_cells[(profile, component)]
+            mask = sum([1 << placeholder_top_level_list.index(t) for t in top_levels])
+            placeholder_cell_rows += "        {%s, 0x%X},\n" % (type, mask)
+        else:
+            placeholder_cell_rows += "        {XR_ACTION_TYPE_MAX_ENUM, 0},\n"
+    placeholder_cell_rows += "    },\n"
+
+placeholder_binding_entries = ""
+for full_binding in sorted(placeholder_bindings.keys()):
+    (top_level, component) = placeholder_bindings[full_binding]
+    placeholder_binding_entries += "    {%s, %d, %d},\n" % (to_upper_snake(full_binding), placeholder_top_level_list.index(top_level), placeholder_component_list.index(component))
+
 
 
 well_known = f"""
@@ -277,28 +380,150 @@ enum WellKnownStringIndex {{
 {well_known_enums}
 }}; // Existing entries will need to not change for subsequent versions for backward compatibility after the first public release
 
-std::unordered_map<WellKnownStringIndex, const char *> OverlaysLayerWellKnownStrings = {{
-{well_known_mappings}
+constexpr uint32_t WellKnownStringCount = {len(well_known_strings) + 1};  // including NULL_PATH
+
+constexpr uint32_t HashWellKnownString(const char *str, uint32_t seed)
+{{
+    uint32_t h = 2166136261u ^ seed;
+    for(; *str; str++) {{
+        h = (h ^ (unsigned char)*str) * 16777619u;
+    }}
+    h ^= h >> 15;
+    h *= 0x2C1B3C6Du;
+    h ^= h >> 12;
+    return h;
+}}
+
+constexpr bool WellKnownStringsEqual(const char *a, const char *b)
+{{
+    for(; *a && (*a == *b); a++, b++);
+    return *a == *b;
+}}
+
+struct WellKnownStringHashSlot
+{{
+    const char *string;                 // nullptr if no string hashes here
+    WellKnownStringIndex index;
 }};
 
+constexpr uint32_t WellKnownStringHashBucketCount = {hash_bucket_count};
+constexpr uint32_t WellKnownStringHashSlotCount = {hash_slot_count};
+
+inline constexpr uint32_t WellKnownStringHashSeeds[WellKnownStringHashBucketCount] = {{
+{well_known_hash_seeds}}};
+
+inline constexpr WellKnownStringHashSlot WellKnownStringHashSlots[WellKnownStringHashSlotCount] = {{
+{well_known_hash_slots}}};
+
+// WellKnownStringIndex for str, or NULL_PATH if str isn't a well-known string
+constexpr WellKnownStringIndex FindWellKnownString(const char *str)
+{{
+    uint32_t seed = WellKnownStringHashSeeds[HashWellKnownString(str, 0) % WellKnownStringHashBucketCount];
+    const WellKnownStringHashSlot& slot = WellKnownStringHashSlots[HashWellKnownString(str, seed) % WellKnownStringHashSlotCount];
+    return (slot.string && WellKnownStringsEqual(slot.string, str)) ? slot.index : NULL_PATH;
+}}
+
+constexpr std::array<const char *, WellKnownStringCount> MakeWellKnownStringTable()
+{{
+    std::array<const char *, WellKnownStringCount> strings {{}};
+    for(const auto& slot: WellKnownStringHashSlots) {{
+        if(slot.string) {{
+            strings[slot.index] = slot.string;
+        }}
+    }}
+    return strings;
+}}
+
+// String for each WellKnownStringIndex; nullptr for NULL_PATH
+inline constexpr std::array<const char *, WellKnownStringCount> OverlaysLayerWellKnownStrings = MakeWellKnownStringTable();
+
+static_assert(FindWellKnownString("/interaction_profiles/khr/simple_controller") == INTERACTION_PROFILES_KHR_SIMPLE_CONTROLLER, "well-known string hash doesn't find its strings");
+static_assert(FindWellKnownString("/interaction_profiles/khr/not_a_controller") == NULL_PATH, "well-known string hash finds strings it doesn't have");
+
 """
 
 placeholders = f"""
+// Placeholder actions Main creates for Overlays, one for each cell of
+// PlaceholderCells, i.e. interaction profile and input component, with a
+// subaction path for every top-level path in the cell's subactionMask
+
+constexpr uint32_t PlaceholderTopLevelCount = {len(placeholder_top_level_list)};
+inline constexpr WellKnownStringIndex PlaceholderTopLevels[PlaceholderTopLevelCount] = {{
+{placeholder_top_levels}}};
+
+constexpr uint32_t PlaceholderProfileCount = {len(placeholder_profile_list)};
+inline constexpr WellKnownStringIndex PlaceholderProfiles[PlaceholderProfileCount] = {{
+{placeholder_profile_strings}}};
+
+constexpr uint32_t PlaceholderComponentCount = {len(placeholder_component_list)};
+inline constexpr WellKnownStringIndex PlaceholderComponents[PlaceholderComponentCount] = {{
+{placeholder_component_strings}}};
 
-struct PlaceholderActionId
+struct PlaceholderCell
+{{
+    XrActionType type;          // XR_ACTION_TYPE_MAX_ENUM if the profile doesn't have the component
+    uint32_t subactionMask;     // bit i is PlaceholderTopLevels[i]
+}};
+
+inline constexpr PlaceholderCell PlaceholderCells[PlaceholderProfileCount][PlaceholderComponentCount] = {{
+{placeholder_cell_rows}}};
+
+struct PlaceholderBinding
 {{
-    std::string name;
-    XrActionType type;
-    WellKnownStringIndex interactionProfileString;
-    WellKnownStringIndex subActionString;
-    WellKnownStringIndex componentString;
     WellKnownStringIndex fullBindingString;
+    uint8_t topLevel;           // index into PlaceholderTopLevels
+    uint8_t component;          // index into PlaceholderComponents
 }};
 
-std::vector<PlaceholderActionId> PlaceholderActionIds =
+constexpr uint32_t PlaceholderBindingCount = {len(placeholder_bindings)};
+inline constexpr PlaceholderBinding PlaceholderBindings[PlaceholderBindingCount] = {{
+{placeholder_binding_entries}}};
+
+constexpr uint8_t PlaceholderNoIndex = 0xFF;
+
+// Where a well-known string falls in the tables above, if anywhere
+struct PlaceholderIndices
 {{
-{placeholder_ids}
+    uint8_t profile = PlaceholderNoIndex;       // if the string is an interaction profile
+    uint8_t topLevel = PlaceholderNoIndex;      // these two if it's a full binding
+    uint8_t component = PlaceholderNoIndex;
 }};
+
+constexpr std::array<PlaceholderIndices, WellKnownStringCount> MakePlaceholderIndicesByString()
+{{
+    std::array<PlaceholderIndices, WellKnownStringCount> indices {{}};
+    for(uint32_t i = 0; i < PlaceholderProfileCount; i++) {{
+        indices[PlaceholderProfiles[i]].profile = (uint8_t)i;
+    }}
+    for(const auto& binding: PlaceholderBindings) {{
+        indices[binding.fullBindingString].topLevel = binding.topLevel;
+        indices[binding.fullBindingString].component = binding.component;
+    }}
+    return indices;
+}}
+
+inline constexpr std::array<PlaceholderIndices, WellKnownStringCount> PlaceholderIndicesByString = MakePlaceholderIndicesByString();
+
+// Cell and top-level path of the placeholder for a profile and full
+// binding; false if no placeholder has that binding
+constexpr bool FindPlaceholderCell(WellKnownStringIndex profileString, WellKnownStringIndex bindingString, uint32_t *profile, uint32_t *component, uint32_t *topLevel)
+{{
+    if(((uint32_t)profileString >= WellKnownStringCount) || ((uint32_t)bindingString >= WellKnownStringCount)) {{
+        return false;
+    }}
+    const PlaceholderIndices& p = PlaceholderIndicesByString[profileString];
+    const PlaceholderIndices& b = PlaceholderIndicesByString[bindingString];
+    if((p.profile == PlaceholderNoIndex) || (b.component == PlaceholderNoIndex)) {{
+        return false;
+    }}
+    if((PlaceholderCells[p.profile][b.component].subactionMask & (1u << b.topLevel)) == 0) {{
+        return false;
+    }}
+    *profile = p.profile;
+    *component = b.component;
+    *topLevel = b.topLevel;
+    return true;
+}}
 """
 
 print(well_known,)
@@ -0,0 +1,236 @@
+// Copyright (c) 2020-2021 LunarG, Inc.
+// Copyright (c) 2017-2021 PlutoVR Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Brad Grantham <brad@lunarg.com>
+// Author: John Zulauf <jzulauf@lunarg.com>
+#ifndef _GRAPHICS_BACKEND_H_
+#define _GRAPHICS_BACKEND_H_
+
+#include <openxr/openxr.h>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#if defined(_WIN32)
+#include <windows.h>
+typedef HANDLE SharedObjectHandle;      // valid in the process it was duplicated into
+typedef DWORD GraphicsProcessId;
+#define NO_SHARED_OBJECT_HANDLE NULL
+#else
+#include <sys/types.h>
+typedef intptr_t SharedObjectHandle;    // file descriptor number in the process which created the image
+typedef pid_t GraphicsProcessId;
+#define NO_SHARED_OBJECT_HANDLE -1
+#ifndef INFINITE
+#define INFINITE 0xFFFFFFFF             // WaitImage timeout, as on Windows
+#endif
+#endif
+
+// An image as the other process opens it.  The fence travels separately
+// from the image, so neither handle has to fit in part of the other.
+struct SharedImageHandle
+{
+    SharedObjectHandle image;   // texture, memory or shared memory mapping
+    SharedObjectHandle fence;   // NO_SHARED_OBJECT_HANDLE if the backend keeps the fence with the image
+};
+
+// The other process, opened once by whoever holds the connection to it and
+// kept open for as long as the connection lasts, so sharing a swapchain's
+// images doesn't reopen it
+struct GraphicsPeer
+{
+    GraphicsProcessId processId;
+#if defined(_WIN32)
+    HANDLE processHandle;               // with at least PROCESS_DUP_HANDLE access
+#else
+    int handleSocket;                   // connected Unix socket descriptors are passed over, or -1
+#endif
+};
+
+// Make the handles the other process's CreateSharedImages gave valid in
+// this process, before opening them.  On Windows it already duplicated
+// them into this one.  Elsewhere the descriptors of all of a swapchain's
+// images come in one message on peer.handleSocket, which has to match
+// handles, the other process's numbers for them, and they replace handles.
+bool ReceivePeerHandles(const GraphicsPeer& peer, std::vector<SharedImageHandle>& handles, uint32_t timeoutMs);
+
+#if !defined(_WIN32)
+// Descriptors go over a Unix socket as SCM_RIGHTS, because taking them out
+// of the other process with pidfd_getfd needs ptrace access to it, which
+// Yama's default ptrace_scope only allows for descendants.  Main listens
+// on an abstract socket named for the connection like the RPC channels,
+// and the Overlay connects to it.
+#define PeerHandlesSocketNameTemplate "LUNARG_XR_EXTX_overlay_rpc_handles_%u"
+const uint32_t MaxPeerHandlesPerMessage = 64;
+int ListenForPeerHandles(uint32_t channelId);
+int AcceptPeerHandles(int listenSocket, uint32_t timeoutMs);
+int ConnectForPeerHandles(uint32_t channelId);
+
+// Send descriptors valid in this process to peer in one message, see ReceivePeerHandles
+bool SendPeerHandles(const GraphicsPeer& peer, const std::vector<SharedImageHandle>& handles);
+#endif
+
+#if defined(_WIN32)
+// Close handles DuplicateHandle made in peer, when sharing images fails partway
+inline void CloseHandlesInPeer(const GraphicsPeer& peer, const std::vector<SharedImageHandle>& handles)
+{
+    for(const auto& handle: handles) {
+        if(handle.image) {
+            DuplicateHandle(peer.processHandle, handle.image, NULL, NULL, 0, FALSE, DUPLICATE_CLOSE_SOURCE);
+        }
+        if(handle.fence) {
+            DuplicateHandle(peer.processHandle, handle.fence, NULL, NULL, 0, FALSE, DUPLICATE_CLOSE_SOURCE);
+        }
+    }
+}
+#endif
+
+// Everything the Overlay and Main sides of the API layer need in order to
+// share swapchain images lives behind GraphicsBackend.  One side creates
+// images and hands them to the other, which opens them.  Each image carries
+// a fence whose value only increases; each side signals a new value when it
+// is done with the image and waits for the other side's value before using
+// it, so one image can be in use by one side while the other side works on
+// another image.  Usually the
+// Overlay creates the images and Main copies their content into the
+// runtime's swapchain images; if Main's images can be shared themselves,
+// Main creates them and the Overlay renders into them directly.
+
+struct SharedImageDesc
+{
+    uint32_t width;
+    uint32_t height;
+    int64_t format;         // graphics API format, e.g. DXGI_FORMAT or VkFormat
+    uint32_t arraySize;
+    uint32_t mipCount;
+    uint32_t sampleCount;
+};
+
+inline bool operator==(const SharedImageDesc& a, const SharedImageDesc& b)
+{
+    return (a.width == b.width) && (a.height == b.height) && (a.format == b.format) &&
+        (a.arraySize == b.arraySize) && (a.mipCount == b.mipCount) && (a.sampleCount == b.sampleCount);
+}
+
+// Backend-specific image, e.g. an ID3D11Texture2D or a mapping of shared memory
+struct GraphicsImage
+{
+    virtual ~GraphicsImage() {}
+    typedef std::shared_ptr<GraphicsImage> Ptr;
+};
+
+// Backends report failures through this so they don't depend on the rest of the layer
+typedef std::function<void (const char* xrfunc, const char* message)> GraphicsBackendErrorFunc;
+
+struct GraphicsBackend
+{
+    virtual ~GraphicsBackend() {}
+
+    // Create count images the other process can open, sharing them all at
+    // once.  The handles are valid in peer after its ReceivePeerHandles.
+    virtual bool CreateSharedImages(const SharedImageDesc& desc, uint32_t count, const GraphicsPeer& peer, std::vector<GraphicsImage::Ptr>& images, std::vector<SharedImageHandle>& handles) = 0;
+
+    // Open an image created in peer with desc, from a handle ReceivePeerHandles
+    // made valid here.  The image owns the handle afterwards.
+    virtual GraphicsImage::Ptr OpenSharedImage(SharedImageHandle handle, const SharedImageDesc& desc, const GraphicsPeer& peer) = 0;
+
+    // An image only this process uses, standing in for runtime images the backend can't get from the runtime
+    virtual GraphicsImage::Ptr CreateLocalImage(const SharedImageDesc& desc) = 0;
+
+    // Make work submitted after this wait until image's fence reaches value.
+    // The GPU waits where the API allows it; otherwise the CPU blocks up to timeoutMs.
+    virtual bool WaitImage(GraphicsImage* image, uint64_t value, uint32_t timeoutMs) = 0;
+
+    // Set image's fence to value once work already submitted is complete.
+    // The other process may not see it until Flush.
+    virtual bool SignalImage(GraphicsImage* image, uint64_t value) = 0;
+
+    // Hand work recorded so far, including signals, to the GPU.  Only
+    // called inside the application's own xrAcquireSwapchainImage,
+    // xrReleaseSwapchainImage and xrEndFrame, during which it may not use
+    // the queue it gave OpenXR.
+    virtual void Flush() = 0;
+
+    // Main side: as Flush, but from the thread serving the Overlay's RPCs,
+    // while the application may be submitting to its queue.  A backend that
+    // would have to submit to that queue holds the work for the next Flush
+    // and returns false.
+    virtual bool FlushFromRPCThread() = 0;
+
+    // Main side: whether the images Main submits to the runtime can be
+    // created with CreateSharedImages, letting the Overlay render into
+    // them without a copy.  Only asked of backends whose swapchain images
+    // are Main's own stand-ins (GetSwapchainImageType() is XR_TYPE_UNKNOWN);
+    // OpenXR has no way to ask the runtime for shareable images, so the
+    // D3D11 and Vulkan backends always copy.
+    virtual bool CanShareSwapchainImages() const = 0;
+
+    // Main side: copy all of src into dst
+    virtual bool CopyImage(GraphicsImage* dst, GraphicsImage* src) = 0;
+
+    // Main side: copy only the given rectangles of every array layer of src into dst
+    virtual bool CopyImageRegions(GraphicsImage* dst, GraphicsImage* src, const XrRect2Di* rects, uint32_t rectCount) = 0;
+
+    // Runtime and application swapchain image structures for this backend;
+    // XR_TYPE_UNKNOWN if there is no OpenXR structure for this backend's images
+    virtual XrStructureType GetSwapchainImageType() const = 0;
+    virtual size_t GetSwapchainImageStructSize() const = 0;
+    virtual GraphicsImage::Ptr WrapSwapchainImage(const XrSwapchainImageBaseHeader* image) = 0;
+    virtual void FillSwapchainImage(GraphicsImage* image, XrSwapchainImageBaseHeader* out) = 0;
+
+    typedef std::shared_ptr<GraphicsBackend> Ptr;
+};
+
+// Clip rect to a width by height image; false if nothing is left
+inline bool ClipRectToImage(const XrRect2Di& rect, uint32_t width, uint32_t height, uint32_t* left, uint32_t* top, uint32_t* right, uint32_t* bottom)
+{
+    int64_t l = std::max<int64_t>(rect.offset.x, 0);
+    int64_t t = std::max<int64_t>(rect.offset.y, 0);
+    int64_t r = std::min<int64_t>(int64_t(rect.offset.x) + rect.extent.width, width);
+    int64_t b = std::min<int64_t>(int64_t(rect.offset.y) + rect.extent.height, height);
+    if((l >= r) || (t >= b)) {
+        return false;
+    }
+    *left = uint32_t(l);
+    *top = uint32_t(t);
+    *right = uint32_t(r);
+    *bottom = uint32_t(b);
+    return true;
+}
+
+#if defined(XR_USE_GRAPHICS_API_D3D11)
+struct ID3D11Device;
+GraphicsBackend::Ptr CreateD3D11GraphicsBackend(ID3D11Device* d3d11Device, GraphicsBackendErrorFunc errorFunc);
+#endif
+
+#if defined(XR_USE_GRAPHICS_API_VULKAN)
+struct XrGraphicsBindingVulkanKHR;
+GraphicsBackend::Ptr CreateVulkanGraphicsBackend(const XrGraphicsBindingVulkanKHR* binding, GraphicsBackendErrorFunc errorFunc);
+#endif
+
+// Images are RGBA8 texels in shared memory (memfd on Linux, a pagefile mapping on Windows).
+// Nothing samples them, so this backend is for headless sessions of the
+// layer on Windows and for exercising the sharing and fence protocol
+// without a GPU, as api-layer/tests does on every platform.
+GraphicsBackend::Ptr CreateCpuGraphicsBackend(GraphicsBackendErrorFunc errorFunc);
+
+// Texel memory of an image created or opened by the CPU backend
+void* GetCpuGraphicsImageMemory(GraphicsImage* image);
+
+#endif /* _GRAPHICS_BACKEND_H_ */
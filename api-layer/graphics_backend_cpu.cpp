@@ -0,0 +1,409 @@
+// Copyright (c) 2020-2021 LunarG, Inc.
+// Copyright (c) 2017-2021 PlutoVR Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Brad Grantham <brad@lunarg.com>
+// Author: John Zulauf <jzulauf@lunarg.com>
+
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif  // !NOMINMAX
+
+#include "graphics_backend.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <new>
+#include <thread>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Shared memory layout of an image: a header followed by RGBA8 texels of
+// every array layer.  Mips and samples are not stored; nothing reads them.
+struct CpuSharedImageHeader
+{
+    std::atomic<uint64_t> fenceValue;   // simulated fence, see SignalImage
+    uint32_t width;
+    uint32_t height;
+    uint32_t arraySize;
+    uint32_t pad[11];
+};
+static_assert(sizeof(CpuSharedImageHeader) == 64, "CPU shared image header should stay one cache line");
+
+static const uint32_t CpuBytesPerTexel = 4;
+
+static size_t CpuImageMappingSize(uint32_t width, uint32_t height, uint32_t arraySize)
+{
+    return sizeof(CpuSharedImageHeader) + size_t(width) * height * arraySize * CpuBytesPerTexel;
+}
+
+struct CpuGraphicsImage : public GraphicsImage
+{
+    CpuSharedImageHeader*   header;
+    size_t                  size;
+    bool                    isShared;   // mapped from shared memory rather than allocated locally
+#if defined(_WIN32)
+    HANDLE                  mapping;
+#else
+    int                     fd;
+#endif
+
+    CpuGraphicsImage() :
+        header(nullptr),
+        size(0),
+        isShared(false),
+#if defined(_WIN32)
+        mapping(NULL)
+#else
+        fd(-1)
+#endif
+    {
+    }
+
+    ~CpuGraphicsImage()
+    {
+        if(!isShared) {
+            if(header) {
+                header->~CpuSharedImageHeader();
+                free(header);
+            }
+            return;
+        }
+#if defined(_WIN32)
+        if(header) {
+            UnmapViewOfFile(header);
+        }
+        if(mapping) {
+            CloseHandle(mapping);
+        }
+#else
+        if(header) {
+            munmap(header, size);
+        }
+        if(fd >= 0) {
+            close(fd);
+        }
+#endif
+    }
+
+    void* Texels()
+    {
+        return reinterpret_cast<uint8_t*>(header) + sizeof(CpuSharedImageHeader);
+    }
+
+    size_t TexelBytes() const
+    {
+        return size - sizeof(CpuSharedImageHeader);
+    }
+};
+
+struct CpuGraphicsBackend : public GraphicsBackend
+{
+    GraphicsBackendErrorFunc    errorFunc;
+
+    CpuGraphicsBackend(GraphicsBackendErrorFunc errorFunc_) :
+        errorFunc(errorFunc_)
+    {
+    }
+
+    void LogError(const char *xrfunc, const char* what, const char *file, int line)
+    {
+        char message[1024];
+#if defined(_WIN32)
+        snprintf(message, sizeof(message), "%s at %s:%d failed with %d", what, file, line, GetLastError());
+#else
+        snprintf(message, sizeof(message), "%s at %s:%d failed with %d (%s)", what, file, line, errno, strerror(errno));
+#endif
+        errorFunc(xrfunc, message);
+    }
+
+    // Create and map the memory of one image; *handle is valid in this process
+    std::shared_ptr<CpuGraphicsImage> CreateMapping(const SharedImageDesc& desc, SharedObjectHandle *handle)
+    {
+        auto image = std::make_shared<CpuGraphicsImage>();
+        image->size = CpuImageMappingSize(desc.width, desc.height, desc.arraySize);
+        image->isShared = true;
+
+#if defined(_WIN32)
+        image->mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, (DWORD)(uint64_t(image->size) >> 32), (DWORD)(image->size & 0xFFFFFFFF), nullptr);
+        if(image->mapping == NULL) {
+            LogError("xrCreateSwapchain", "CreateFileMappingA", __FILE__, __LINE__);
+            return nullptr;
+        }
+        void* memory = MapViewOfFile(image->mapping, FILE_MAP_ALL_ACCESS, 0, 0, image->size);
+        if(!memory) {
+            LogError("xrCreateSwapchain", "MapViewOfFile", __FILE__, __LINE__);
+            return nullptr;
+        }
+        *handle = image->mapping;
+#else
+        image->fd = memfd_create("xr_extx_overlay image", MFD_CLOEXEC);
+        if(image->fd < 0) {
+            LogError("xrCreateSwapchain", "memfd_create", __FILE__, __LINE__);
+            return nullptr;
+        }
+        if(ftruncate(image->fd, image->size) != 0) {
+            LogError("xrCreateSwapchain", "ftruncate", __FILE__, __LINE__);
+            return nullptr;
+        }
+        void* memory = mmap(nullptr, image->size, PROT_READ | PROT_WRITE, MAP_SHARED, image->fd, 0);
+        if(memory == MAP_FAILED) {
+            LogError("xrCreateSwapchain", "mmap", __FILE__, __LINE__);
+            return nullptr;
+        }
+        *handle = image->fd;
+#endif
+
+        // New mappings are zeroed, so only the fields need constructing
+        image->header = new(memory) CpuSharedImageHeader;
+        image->header->fenceValue = 0;
+        image->header->width = desc.width;
+        image->header->height = desc.height;
+        image->header->arraySize = desc.arraySize;
+        return image;
+    }
+
+    bool CreateSharedImages(const SharedImageDesc& desc, uint32_t count, const GraphicsPeer& peer, std::vector<GraphicsImage::Ptr>& images, std::vector<SharedImageHandle>& handles) override
+    {
+#if defined(_WIN32)
+        HANDLE thisProcessHandle = GetCurrentProcess();
+#endif
+
+        images.clear();
+        handles.clear();
+
+        for(uint32_t i = 0; i < count; i++) {
+            SharedObjectHandle localHandle;
+            auto image = CreateMapping(desc, &localHandle);
+            if(!image) {
+#if defined(_WIN32)
+                CloseHandlesInPeer(peer, handles);
+#endif
+                return false;
+            }
+            images.push_back(image);
+
+            // The fence lives in the mapping.  On Linux the memfds are sent
+            // below; the other process knows them by their numbers here.
+            SharedImageHandle handle { localHandle, NO_SHARED_OBJECT_HANDLE };
+#if defined(_WIN32)
+            // Duplicate the handle so the other process can use it
+            if(!DuplicateHandle(thisProcessHandle, localHandle, peer.processHandle, &handle.image, 0, TRUE, DUPLICATE_SAME_ACCESS)) {
+                LogError("xrCreateSwapchain", "DuplicateHandle", __FILE__, __LINE__);
+                CloseHandlesInPeer(peer, handles);
+                return false;
+            }
+#endif
+            handles.push_back(handle);
+        }
+
+#if !defined(_WIN32)
+        if(!SendPeerHandles(peer, handles)) {
+            LogError("xrCreateSwapchain", "SendPeerHandles", __FILE__, __LINE__);
+            images.clear();
+            handles.clear();
+            return false;
+        }
+#endif
+
+        return true;
+    }
+
+    GraphicsImage::Ptr OpenSharedImage(SharedImageHandle handle, const SharedImageDesc& desc, const GraphicsPeer& peer) override
+    {
+        auto image = std::make_shared<CpuGraphicsImage>();
+        image->isShared = true;
+
+        // The other process sized the mapping; don't trust it to match desc
+        image->size = CpuImageMappingSize(desc.width, desc.height, desc.arraySize);
+
+#if defined(_WIN32)
+        (void)peer;
+        image->mapping = handle.image;
+        // Fails if the mapping is smaller than desc says
+        void* memory = MapViewOfFile(image->mapping, FILE_MAP_ALL_ACCESS, 0, 0, image->size);
+        if(!memory) {
+            LogError(nullptr, "MapViewOfFile", __FILE__, __LINE__);
+            return nullptr;
+        }
+        image->header = reinterpret_cast<CpuSharedImageHeader*>(memory);
+#else
+        (void)peer;
+        image->fd = (int)handle.image;
+        struct stat status;
+        if(fstat(image->fd, &status) != 0) {
+            LogError(nullptr, "fstat", __FILE__, __LINE__);
+            return nullptr;
+        }
+        if((size_t)status.st_size != image->size) {
+            errorFunc("xrCreateSwapchain", "shared CPU image memory doesn't match its description");
+            return nullptr;
+        }
+        void* memory = mmap(nullptr, image->size, PROT_READ | PROT_WRITE, MAP_SHARED, image->fd, 0);
+        if(memory == MAP_FAILED) {
+            LogError(nullptr, "mmap", __FILE__, __LINE__);
+            return nullptr;
+        }
+        image->header = reinterpret_cast<CpuSharedImageHeader*>(memory);
+#endif
+
+        const CpuSharedImageHeader* mapped = image->header;
+        if((mapped->width != desc.width) || (mapped->height != desc.height) || (mapped->arraySize != desc.arraySize)) {
+            errorFunc("xrCreateSwapchain", "shared CPU image header doesn't match its description");
+            return nullptr;
+        }
+        return image;
+    }
+
+    GraphicsImage::Ptr CreateLocalImage(const SharedImageDesc& desc) override
+    {
+        auto image = std::make_shared<CpuGraphicsImage>();
+        image->size = CpuImageMappingSize(desc.width, desc.height, desc.arraySize);
+        void* memory = calloc(1, image->size);
+        if(!memory) {
+            errorFunc("xrCreateSwapchain", "couldn't allocate local CPU image");
+            return nullptr;
+        }
+        image->header = new(memory) CpuSharedImageHeader;
+        image->header->fenceValue = 0;
+        image->header->width = desc.width;
+        image->header->height = desc.height;
+        image->header->arraySize = desc.arraySize;
+        return image;
+    }
+
+    bool WaitImage(GraphicsImage* image, uint64_t value, uint32_t timeoutMs) override
+    {
+        auto header = static_cast<CpuGraphicsImage*>(image)->header;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+
+        while(header->fenceValue.load(std::memory_order_acquire) < value) {
+            if((timeoutMs != INFINITE) && (std::chrono::steady_clock::now() >= deadline)) {
+                errorFunc(nullptr, "WaitImage on CPU image timed out");
+                return false;
+            }
+            std::this_thread::yield();
+        }
+        return true;
+    }
+
+    bool SignalImage(GraphicsImage* image, uint64_t value) override
+    {
+        // Copies are done by the time they return, so the fence can advance right away
+        auto header = static_cast<CpuGraphicsImage*>(image)->header;
+        header->fenceValue.store(value, std::memory_order_release);
+        return true;
+    }
+
+    void Flush() override
+    {
+        // Nothing is queued
+    }
+
+    bool FlushFromRPCThread() override
+    {
+        return true;
+    }
+
+    bool CanShareSwapchainImages() const override
+    {
+        // Main's images are our own stand-ins, so they can live in shared memory too
+        return true;
+    }
+
+    bool CopyImage(GraphicsImage* dst, GraphicsImage* src) override
+    {
+        auto dstImage = static_cast<CpuGraphicsImage*>(dst);
+        auto srcImage = static_cast<CpuGraphicsImage*>(src);
+        if(dstImage->TexelBytes() != srcImage->TexelBytes()) {
+            errorFunc(nullptr, "CopyImage between CPU images of different sizes");
+            return false;
+        }
+        memcpy(dstImage->Texels(), srcImage->Texels(), dstImage->TexelBytes());
+        return true;
+    }
+
+    bool CopyImageRegions(GraphicsImage* dst, GraphicsImage* src, const XrRect2Di* rects, uint32_t rectCount) override
+    {
+        auto dstImage = static_cast<CpuGraphicsImage*>(dst);
+        auto srcImage = static_cast<CpuGraphicsImage*>(src);
+        if(dstImage->TexelBytes() != srcImage->TexelBytes()) {
+            errorFunc(nullptr, "CopyImageRegions between CPU images of different sizes");
+            return false;
+        }
+
+        uint32_t width = srcImage->header->width;
+        uint32_t height = srcImage->header->height;
+        size_t rowPitch = size_t(width) * CpuBytesPerTexel;
+        size_t layerPitch = rowPitch * height;
+        uint8_t* dstTexels = reinterpret_cast<uint8_t*>(dstImage->Texels());
+        const uint8_t* srcTexels = reinterpret_cast<const uint8_t*>(srcImage->Texels());
+
+        for(uint32_t layer = 0; layer < srcImage->header->arraySize; layer++) {
+            for(uint32_t i = 0; i < rectCount; i++) {
+                uint32_t left, top, right, bottom;
+                if(!ClipRectToImage(rects[i], width, height, &left, &top, &right, &bottom)) {
+                    continue;
+                }
+                size_t rowBytes = size_t(right - left) * CpuBytesPerTexel;
+                for(uint32_t y = top; y < bottom; y++) {
+                    size_t offset = layerPitch * layer + rowPitch * y + size_t(left) * CpuBytesPerTexel;
+                    memcpy(dstTexels + offset, srcTexels + offset, rowBytes);
+                }
+            }
+        }
+        return true;
+    }
+
+    XrStructureType GetSwapchainImageType() const override
+    {
+        return XR_TYPE_UNKNOWN;
+    }
+
+    size_t GetSwapchainImageStructSize() const override
+    {
+        return 0;
+    }
+
+    GraphicsImage::Ptr WrapSwapchainImage(const XrSwapchainImageBaseHeader*) override
+    {
+        // Not asked; GetSwapchainImageType() is XR_TYPE_UNKNOWN
+        return nullptr;
+    }
+
+    void FillSwapchainImage(GraphicsImage*, XrSwapchainImageBaseHeader*) override
+    {
+    }
+};
+
+GraphicsBackend::Ptr CreateCpuGraphicsBackend(GraphicsBackendErrorFunc errorFunc)
+{
+    return std::make_shared<CpuGraphicsBackend>(errorFunc);
+}
+
+void* GetCpuGraphicsImageMemory(GraphicsImage* image)
+{
+    return static_cast<CpuGraphicsImage*>(image)->Texels();
+}
@@ -0,0 +1,570 @@
+// Copyright (c) 2020-2021 LunarG, Inc.
+// Copyright (c) 2017-2021 PlutoVR Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Brad Grantham <brad@lunarg.com>
+// Author: John Zulauf <jzulauf@lunarg.com>
+
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif  // !NOMINMAX
+
+#include "graphics_backend.h"
+
+#include <map>
+#include <string>
+
+#include <dxgi1_2.h>
+#include <d3d11_1.h>
+#include <d3d11_4.h>
+
+#include <openxr/openxr_platform.h>
+
+static std::map<DXGI_FORMAT, DXGI_FORMAT> TypedFormatToTypelessFormat = {
+    { DXGI_FORMAT_R32G32B32A32_FLOAT, DXGI_FORMAT_R32G32B32A32_TYPELESS },
+    { DXGI_FORMAT_R32G32B32A32_UINT, DXGI_FORMAT_R32G32B32A32_TYPELESS },
+    { DXGI_FORMAT_R32G32B32A32_SINT, DXGI_FORMAT_R32G32B32A32_TYPELESS },
+    { DXGI_FORMAT_R32G32B32_FLOAT, DXGI_FORMAT_R32G32B32_TYPELESS },
+    { DXGI_FORMAT_R32G32B32_UINT, DXGI_FORMAT_R32G32B32_TYPELESS },
+    { DXGI_FORMAT_R32G32B32_SINT, DXGI_FORMAT_R32G32B32_TYPELESS },
+    { DXGI_FORMAT_R16G16B16A16_FLOAT, DXGI_FORMAT_R16G16B16A16_TYPELESS },
+    { DXGI_FORMAT_R16G16B16A16_UNORM, DXGI_FORMAT_R16G16B16A16_TYPELESS },
+    { DXGI_FORMAT_R16G16B16A16_UINT, DXGI_FORMAT_R16G16B16A16_TYPELESS },
+    { DXGI_FORMAT_R16G16B16A16_SNORM, DXGI_FORMAT_R16G16B16A16_TYPELESS },
+    { DXGI_FORMAT_R16G16B16A16_SINT, DXGI_FORMAT_R16G16B16A16_TYPELESS },
+    { DXGI_FORMAT_R32G32_FLOAT, DXGI_FORMAT_R32G32_TYPELESS },
+    { DXGI_FORMAT_R32G32_UINT, DXGI_FORMAT_R32G32_TYPELESS },
+    { DXGI_FORMAT_R32G32_SINT, DXGI_FORMAT_R32G32_TYPELESS },
+    { DXGI_FORMAT_D32_FLOAT_S8X24_UINT, DXGI_FORMAT_R32G8X24_TYPELESS },
+    { DXGI_FORMAT_R32_FLOAT_X8X24_TYPELESS, DXGI_FORMAT_R32G8X24_TYPELESS },
+    { DXGI_FORMAT_X32_TYPELESS_G8X24_UINT, DXGI_FORMAT_R32G8X24_TYPELESS },
+    { DXGI_FORMAT_R10G10B10A2_UNORM, DXGI_FORMAT_R10G10B10A2_TYPELESS },
+    { DXGI_FORMAT_R10G10B10A2_UINT, DXGI_FORMAT_R10G10B10A2_TYPELESS },
+    { DXGI_FORMAT_R8G8B8A8_UNORM, DXGI_FORMAT_R8G8B8A8_TYPELESS },
+    { DXGI_FORMAT_R8G8B8A8_UNORM_SRGB, DXGI_FORMAT_R8G8B8A8_TYPELESS },
+    { DXGI_FORMAT_R8G8B8A8_UINT, DXGI_FORMAT_R8G8B8A8_TYPELESS },
+    { DXGI_FORMAT_R8G8B8A8_SNORM, DXGI_FORMAT_R8G8B8A8_TYPELESS },
+    { DXGI_FORMAT_R8G8B8A8_SINT, DXGI_FORMAT_R8G8B8A8_TYPELESS },
+    { DXGI_FORMAT_R16G16_FLOAT, DXGI_FORMAT_R16G16_TYPELESS },
+    { DXGI_FORMAT_R16G16_UNORM, DXGI_FORMAT_R16G16_TYPELESS },
+    { DXGI_FORMAT_R16G16_UINT, DXGI_FORMAT_R16G16_TYPELESS },
+    { DXGI_FORMAT_R16G16_SNORM, DXGI_FORMAT_R16G16_TYPELESS },
+    { DXGI_FORMAT_R16G16_SINT, DXGI_FORMAT_R16G16_TYPELESS },
+    { DXGI_FORMAT_D32_FLOAT, DXGI_FORMAT_R32_TYPELESS },
+    { DXGI_FORMAT_R32_FLOAT, DXGI_FORMAT_R32_TYPELESS },
+    { DXGI_FORMAT_R32_UINT, DXGI_FORMAT_R32_TYPELESS },
+    { DXGI_FORMAT_R32_SINT, DXGI_FORMAT_R32_TYPELESS },
+    { DXGI_FORMAT_D24_UNORM_S8_UINT, DXGI_FORMAT_R24G8_TYPELESS },
+    { DXGI_FORMAT_R24_UNORM_X8_TYPELESS, DXGI_FORMAT_R24G8_TYPELESS },
+    { DXGI_FORMAT_X24_TYPELESS_G8_UINT, DXGI_FORMAT_R24G8_TYPELESS },
+    { DXGI_FORMAT_R8G8_UNORM, DXGI_FORMAT_R8G8_TYPELESS },
+    { DXGI_FORMAT_R8G8_UINT, DXGI_FORMAT_R8G8_TYPELESS },
+    { DXGI_FORMAT_R8G8_SNORM, DXGI_FORMAT_R8G8_TYPELESS },
+    { DXGI_FORMAT_R8G8_SINT, DXGI_FORMAT_R8G8_TYPELESS },
+    { DXGI_FORMAT_R16_FLOAT, DXGI_FORMAT_R16_TYPELESS, },
+    { DXGI_FORMAT_D16_UNORM, DXGI_FORMAT_R16_TYPELESS, },
+    { DXGI_FORMAT_R16_UNORM, DXGI_FORMAT_R16_TYPELESS, },
+    { DXGI_FORMAT_R16_UINT, DXGI_FORMAT_R16_TYPELESS, },
+    { DXGI_FORMAT_R16_SNORM, DXGI_FORMAT_R16_TYPELESS, },
+    { DXGI_FORMAT_R16_SINT, DXGI_FORMAT_R16_TYPELESS, },
+    { DXGI_FORMAT_R8_UNORM, DXGI_FORMAT_R8_TYPELESS },
+    { DXGI_FORMAT_R8_UINT, DXGI_FORMAT_R8_TYPELESS },
+    { DXGI_FORMAT_R8_SNORM, DXGI_FORMAT_R8_TYPELESS },
+    { DXGI_FORMAT_R8_SINT, DXGI_FORMAT_R8_TYPELESS },
+    { DXGI_FORMAT_A8_UNORM, DXGI_FORMAT_R8_TYPELESS },
+    { DXGI_FORMAT_BC1_UNORM, DXGI_FORMAT_BC1_TYPELESS },
+    { DXGI_FORMAT_BC1_UNORM_SRGB, DXGI_FORMAT_BC1_TYPELESS },
+    { DXGI_FORMAT_BC2_UNORM, DXGI_FORMAT_BC2_TYPELESS },
+    { DXGI_FORMAT_BC2_UNORM_SRGB, DXGI_FORMAT_BC2_TYPELESS },
+    { DXGI_FORMAT_BC3_UNORM, DXGI_FORMAT_BC3_TYPELESS },
+    { DXGI_FORMAT_BC3_UNORM_SRGB, DXGI_FORMAT_BC3_TYPELESS },
+    { DXGI_FORMAT_BC4_UNORM, DXGI_FORMAT_BC4_TYPELESS },
+    { DXGI_FORMAT_BC4_SNORM, DXGI_FORMAT_BC4_TYPELESS },
+    { DXGI_FORMAT_BC5_UNORM, DXGI_FORMAT_BC5_TYPELESS },
+    { DXGI_FORMAT_BC5_SNORM, DXGI_FORMAT_BC5_TYPELESS },
+    // DXGI_FORMAT_B5G6R5_UNORM,
+    // DXGI_FORMAT_B5G5R5A1_UNORM,
+    // DXGI_FORMAT_B8G8R8A8_UNORM,
+    // DXGI_FORMAT_B8G8R8X8_UNORM,
+    // DXGI_FORMAT_R10G10B10_XR_BIAS_A2_UNORM,
+    { DXGI_FORMAT_B8G8R8A8_UNORM_SRGB, DXGI_FORMAT_B8G8R8A8_TYPELESS },
+    { DXGI_FORMAT_B8G8R8X8_UNORM_SRGB, DXGI_FORMAT_B8G8R8X8_TYPELESS },
+    { DXGI_FORMAT_BC6H_UF16, DXGI_FORMAT_BC6H_TYPELESS },
+    { DXGI_FORMAT_BC6H_SF16, DXGI_FORMAT_BC6H_TYPELESS },
+    { DXGI_FORMAT_BC7_UNORM, DXGI_FORMAT_BC7_TYPELESS },
+    { DXGI_FORMAT_BC7_UNORM_SRGB, DXGI_FORMAT_BC7_TYPELESS },
+    // DXGI_FORMAT_AYUV,
+    // DXGI_FORMAT_Y410,
+    // DXGI_FORMAT_Y416,
+    // DXGI_FORMAT_NV12,
+    // DXGI_FORMAT_P010,
+    // DXGI_FORMAT_P016,
+    // DXGI_FORMAT_420_OPAQUE,
+    // DXGI_FORMAT_YUY2,
+    // DXGI_FORMAT_Y210,
+    // DXGI_FORMAT_Y216,
+    // DXGI_FORMAT_NV11,
+    // DXGI_FORMAT_AI44,
+    // DXGI_FORMAT_IA44,
+    // DXGI_FORMAT_P8,
+    // DXGI_FORMAT_A8P8,
+    // DXGI_FORMAT_B4G4R4A4_UNORM,
+    // DXGI_FORMAT_P208,
+    // DXGI_FORMAT_V208,
+    // DXGI_FORMAT_V408,
+    // DXGI_FORMAT_SAMPLER_FEEDBACK_MIN_MIP_OPAQUE,
+    // DXGI_FORMAT_SAMPLER_FEEDBACK_MIP_REGION_USED_OPAQUE,
+    // DXGI_FORMAT_FORCE_UINT
+};
+
+// Image on either side of the share; Main's side owns the NT handles it was opened from
+struct D3D11GraphicsImage : public GraphicsImage
+{
+    ID3D11Texture2D*    texture;
+    HANDLE              sharedHandle;
+    ID3D11Fence*        fence;          // null if not shared or shared with keyedMutex
+    HANDLE              fenceHandle;
+    IDXGIKeyedMutex*    keyedMutex;     // null unless shared by a device without fences
+
+    // Takes over references to texture and fence
+    D3D11GraphicsImage(ID3D11Texture2D* texture_, HANDLE sharedHandle_, ID3D11Fence* fence_ = nullptr, HANDLE fenceHandle_ = NULL) :
+        texture(texture_),
+        sharedHandle(sharedHandle_),
+        fence(fence_),
+        fenceHandle(fenceHandle_),
+        keyedMutex(nullptr)
+    {
+    }
+
+    ~D3D11GraphicsImage()
+    {
+        if(keyedMutex) {
+            keyedMutex->Release();
+        }
+        if(fence) {
+            fence->Release();
+        }
+        texture->Release();
+        if(sharedHandle) {
+            CloseHandle(sharedHandle);
+        }
+        if(fenceHandle) {
+            CloseHandle(fenceHandle);
+        }
+    }
+};
+
+struct D3D11GraphicsBackend : public GraphicsBackend
+{
+    ID3D11Device*               d3d11Device;
+    ID3D11Device1*              d3d11Device1;   // null if the device doesn't support OpenSharedResource1
+    ID3D11Device5*              d3d11Device5;   // null if the device doesn't support fences
+    ID3D11DeviceContext*        d3dContext;
+    ID3D11DeviceContext4*       d3dContext4;    // null if the device doesn't support fences
+    GraphicsBackendErrorFunc    errorFunc;
+
+    D3D11GraphicsBackend(ID3D11Device* d3d11Device_, GraphicsBackendErrorFunc errorFunc_) :
+        d3d11Device(d3d11Device_),
+        d3d11Device1(nullptr),
+        d3d11Device5(nullptr),
+        d3dContext(nullptr),
+        d3dContext4(nullptr),
+        errorFunc(errorFunc_)
+    {
+        d3d11Device->AddRef();
+        d3d11Device->GetImmediateContext(&d3dContext);
+
+        HRESULT result = d3d11Device->QueryInterface(__uuidof (ID3D11Device1), (void **)&d3d11Device1);
+        if(result != S_OK) {
+            LogError(result, "xrCreateSession", "QueryInterface", __FILE__, __LINE__);
+            d3d11Device1 = nullptr;
+        }
+
+        // Fences need Windows 10 Creators Update
+        result = d3d11Device->QueryInterface(__uuidof (ID3D11Device5), (void **)&d3d11Device5);
+        if(result != S_OK) {
+            LogError(result, "xrCreateSession", "QueryInterface", __FILE__, __LINE__);
+            d3d11Device5 = nullptr;
+        }
+        result = d3dContext->QueryInterface(__uuidof (ID3D11DeviceContext4), (void **)&d3dContext4);
+        if(result != S_OK) {
+            LogError(result, "xrCreateSession", "QueryInterface", __FILE__, __LINE__);
+            d3dContext4 = nullptr;
+        }
+    }
+
+    ~D3D11GraphicsBackend()
+    {
+        if(d3dContext4) {
+            d3dContext4->Release();
+        }
+        if(d3d11Device5) {
+            d3d11Device5->Release();
+        }
+        if(d3d11Device1) {
+            d3d11Device1->Release();
+        }
+        d3dContext->Release();
+        d3d11Device->Release();
+    }
+
+    void LogError(DWORD result, const char *xrfunc, const char* what, const char *file, int line)
+    {
+        LPVOID messageBuf;
+        FormatMessageA(FORMAT_MESSAGE_ALLOCATE_BUFFER | FORMAT_MESSAGE_FROM_SYSTEM | FORMAT_MESSAGE_IGNORE_INSERTS, nullptr, result, MAKELANGID(LANG_NEUTRAL, SUBLANG_DEFAULT), (LPSTR) &messageBuf, 0, nullptr);
+        char message[1024];
+        snprintf(message, sizeof(message), "%s at %s:%d failed with %d (%s)", what, file, line, result, (const char*)messageBuf);
+        errorFunc(xrfunc, message);
+        LocalFree(messageBuf);
+    }
+
+    // Images are synchronized with a shared ID3D11Fence where the device
+    // has one (Windows 10 Creators Update), otherwise with the texture's
+    // keyed mutex.  The keyed mutex stands in for the fence by using fence
+    // values as keys, which works because each side waits for exactly the
+    // value the other side last signaled and signals before the other waits again.
+    bool HasFences() const
+    {
+        return d3d11Device5 && d3dContext4;
+    }
+
+    bool CreateSharedImages(const SharedImageDesc& imageDesc, uint32_t count, const GraphicsPeer& peer, std::vector<GraphicsImage::Ptr>& images, std::vector<SharedImageHandle>& handles) override
+    {
+        bool useFences = HasFences();
+
+        D3D11_TEXTURE2D_DESC desc;
+        desc.Width = imageDesc.width;
+        desc.Height = imageDesc.height;
+        desc.MipLevels = imageDesc.mipCount;
+        desc.ArraySize = imageDesc.arraySize;
+        desc.SampleDesc.Count = imageDesc.sampleCount;
+        desc.SampleDesc.Quality = 0;
+        desc.Usage = D3D11_USAGE_DEFAULT;
+        desc.BindFlags = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_RENDER_TARGET;
+        desc.CPUAccessFlags = 0;
+        desc.MiscFlags = D3D11_RESOURCE_MISC_SHARED_NTHANDLE | (useFences ? D3D11_RESOURCE_MISC_SHARED : D3D11_RESOURCE_MISC_SHARED_KEYEDMUTEX);
+
+        DXGI_FORMAT format = static_cast<DXGI_FORMAT>(imageDesc.format);
+        if(TypedFormatToTypelessFormat.count(format) > 0) {
+            desc.Format = TypedFormatToTypelessFormat.at(format);
+        } else {
+            desc.Format = format;
+        }
+
+        HANDLE thisProcessHandle = GetCurrentProcess();
+        HANDLE hostProcessHandle = peer.processHandle;
+
+        images.clear();
+        handles.clear();
+
+        // Handles already in the other process have to be closed there if a later image fails
+        auto fail = [&]() {
+            CloseHandlesInPeer(peer, handles);
+            handles.clear();
+            return false;
+        };
+
+        for(uint32_t i = 0; i < count; i++) {
+            HRESULT result;
+            ID3D11Texture2D* texture;
+            if((result = d3d11Device->CreateTexture2D(&desc, NULL, &texture)) != S_OK) {
+                LogError(result, "xrCreateSwapchain", "CreateTexture2D", __FILE__, __LINE__);
+                return fail();
+            }
+            ID3D11Fence* fence = nullptr;
+            if(useFences) {
+                if((result = d3d11Device5->CreateFence(0, D3D11_FENCE_FLAG_SHARED, __uuidof(ID3D11Fence), (void**)&fence)) != S_OK) {
+                    LogError(result, "xrCreateSwapchain", "CreateFence", __FILE__, __LINE__);
+                    texture->Release();
+                    return fail();
+                }
+            }
+            auto image = std::make_shared<D3D11GraphicsImage>(texture, (HANDLE)NULL, fence);
+            images.push_back(image);
+
+            if(!useFences) {
+                if((result = texture->QueryInterface(__uuidof(IDXGIKeyedMutex), (LPVOID*) &image->keyedMutex)) != S_OK) {
+                    LogError(result, "xrCreateSwapchain", "QueryInterface", __FILE__, __LINE__);
+                    image->keyedMutex = nullptr;
+                    return fail();
+                }
+            }
+
+            IDXGIResource1* sharedResource = NULL;
+            if((result = texture->QueryInterface(__uuidof(IDXGIResource1), (LPVOID*) &sharedResource)) != S_OK) {
+                LogError(result, "xrCreateSwapchain", "QueryInterface", __FILE__, __LINE__);
+                return fail();
+            }
+
+            HANDLE handle;
+
+            // Get the Shared Handle for the texture. This is still local to this process but is an actual HANDLE
+            result = sharedResource->CreateSharedHandle(NULL,
+                DXGI_SHARED_RESOURCE_READ, // GENERIC_ALL | DXGI_SHARED_RESOURCE_READ | DXGI_SHARED_RESOURCE_WRITE,
+                NULL, &handle);
+            sharedResource->Release();
+            if(result != S_OK) {
+                LogError(result, "xrCreateSwapchain", "CreateSharedHandle", __FILE__, __LINE__);
+                return fail();
+            }
+
+            // Duplicate the handles so "Host" RPC service process can use them
+            SharedImageHandle hostHandles { NULL, NULL };
+            BOOL duplicated = DuplicateHandle(thisProcessHandle, handle, hostProcessHandle, &hostHandles.image, 0, TRUE, DUPLICATE_SAME_ACCESS);
+            CloseHandle(handle);
+            if(!duplicated) {
+                LogError(GetLastError(), "xrCreateSwapchain", "DuplicateHandle", __FILE__, __LINE__);
+                return fail();
+            }
+            handles.push_back(hostHandles);
+
+            if(fence) {
+                HANDLE fenceHandle;
+                result = fence->CreateSharedHandle(NULL, GENERIC_ALL, NULL, &fenceHandle);
+                if(result != S_OK) {
+                    LogError(result, "xrCreateSwapchain", "CreateSharedHandle", __FILE__, __LINE__);
+                    return fail();
+                }
+                duplicated = DuplicateHandle(thisProcessHandle, fenceHandle, hostProcessHandle, &handles.back().fence, 0, TRUE, DUPLICATE_SAME_ACCESS);
+                CloseHandle(fenceHandle);
+                if(!duplicated) {
+                    LogError(GetLastError(), "xrCreateSwapchain", "DuplicateHandle", __FILE__, __LINE__);
+                    handles.back().fence = NULL;
+                    return fail();
+                }
+            }
+        }
+
+        return true;
+    }
+
+    GraphicsImage::Ptr OpenSharedImage(SharedImageHandle handle, const SharedImageDesc& desc, const GraphicsPeer& peer) override
+    {
+        auto closeHandles = [&handle]() {
+            CloseHandle(handle.image);
+            if(handle.fence) {
+                CloseHandle(handle.fence);
+            }
+        };
+
+        if(!d3d11Device1) {
+            errorFunc(nullptr, "D3D11 device has no ID3D11Device1 interface, can't open shared swapchain images");
+            closeHandles();
+            return nullptr;
+        }
+        if(handle.fence && !HasFences()) {
+            errorFunc(nullptr, "D3D11 device has no ID3D11Device5 or ID3D11DeviceContext4 interface, can't open a swapchain image shared with a fence");
+            closeHandles();
+            return nullptr;
+        }
+
+        ID3D11Texture2D *sharedTexture;
+        HRESULT result = d3d11Device1->OpenSharedResource1(handle.image, __uuidof(ID3D11Texture2D), (LPVOID*) &sharedTexture);
+        if(result != S_OK) {
+            LogError(result, nullptr, "OpenSharedResource1", __FILE__, __LINE__);
+            closeHandles();
+            return nullptr;
+        }
+
+        if(!handle.fence) {
+            // The other process has no fences; synchronize with the texture's keyed mutex
+            auto image = std::make_shared<D3D11GraphicsImage>(sharedTexture, handle.image);
+            result = sharedTexture->QueryInterface(__uuidof(IDXGIKeyedMutex), (LPVOID*) &image->keyedMutex);
+            if(result != S_OK) {
+                LogError(result, nullptr, "QueryInterface", __FILE__, __LINE__);
+                image->keyedMutex = nullptr;
+                return nullptr;
+            }
+            return image;
+        }
+
+        ID3D11Fence* fence;
+        result = d3d11Device5->OpenSharedFence(handle.fence, __uuidof(ID3D11Fence), (void**)&fence);
+        if(result != S_OK) {
+            LogError(result, nullptr, "OpenSharedFence", __FILE__, __LINE__);
+            sharedTexture->Release();
+            closeHandles();
+            return nullptr;
+        }
+
+        return std::make_shared<D3D11GraphicsImage>(sharedTexture, handle.image, fence, handle.fence);
+    }
+
+    GraphicsImage::Ptr CreateLocalImage(const SharedImageDesc& imageDesc) override
+    {
+        D3D11_TEXTURE2D_DESC desc {};
+        desc.Width = imageDesc.width;
+        desc.Height = imageDesc.height;
+        desc.MipLevels = imageDesc.mipCount;
+        desc.ArraySize = imageDesc.arraySize;
+        desc.SampleDesc.Count = imageDesc.sampleCount;
+        desc.Usage = D3D11_USAGE_DEFAULT;
+        desc.BindFlags = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_RENDER_TARGET;
+        desc.Format = static_cast<DXGI_FORMAT>(imageDesc.format);
+
+        HRESULT result;
+        ID3D11Texture2D* texture;
+        if((result = d3d11Device->CreateTexture2D(&desc, NULL, &texture)) != S_OK) {
+            LogError(result, "xrCreateSwapchain", "CreateTexture2D", __FILE__, __LINE__);
+            return nullptr;
+        }
+        return std::make_shared<D3D11GraphicsImage>(texture, (HANDLE)NULL);
+    }
+
+    bool WaitImage(GraphicsImage* image, uint64_t value, uint32_t timeoutMs) override
+    {
+        D3D11GraphicsImage* d3dImage = static_cast<D3D11GraphicsImage*>(image);
+        HRESULT result;
+        if(d3dImage->keyedMutex) {
+            // The CPU waits, up to timeoutMs; WAIT_TIMEOUT is a success code, so check for S_OK
+            result = d3dImage->keyedMutex->AcquireSync(value, timeoutMs);
+            if(result != S_OK) {
+                LogError(result, nullptr, "AcquireSync", __FILE__, __LINE__);
+                return false;
+            }
+            return true;
+        }
+
+        // With a bound, the CPU waits for the other side's work to finish so
+        // that a stalled process is noticed instead of stalling our GPU queue
+        if((timeoutMs != INFINITE) && (d3dImage->fence->GetCompletedValue() < value)) {
+            HANDLE event = CreateEvent(NULL, FALSE, FALSE, NULL);
+            if(event == NULL) {
+                LogError(GetLastError(), nullptr, "CreateEvent", __FILE__, __LINE__);
+                return false;
+            }
+            result = d3dImage->fence->SetEventOnCompletion(value, event);
+            DWORD waitResult = (result == S_OK) ? WaitForSingleObject(event, timeoutMs) : WAIT_FAILED;
+            CloseHandle(event);
+            if(result != S_OK) {
+                LogError(result, nullptr, "SetEventOnCompletion", __FILE__, __LINE__);
+                return false;
+            }
+            if(waitResult != WAIT_OBJECT_0) {
+                errorFunc(nullptr, "timed out waiting for shared image fence");
+                return false;
+            }
+            return true;
+        }
+
+        // Otherwise the GPU waits and the CPU goes on recording
+        result = d3dContext4->Wait(d3dImage->fence, value);
+        if(result != S_OK) {
+            LogError(result, nullptr, "Wait", __FILE__, __LINE__);
+            return false;
+        }
+        return true;
+    }
+
+    bool SignalImage(GraphicsImage* image, uint64_t value) override
+    {
+        D3D11GraphicsImage* d3dImage = static_cast<D3D11GraphicsImage*>(image);
+        HRESULT result;
+        if(d3dImage->keyedMutex) {
+            // Releasing flushes work already recorded, so the other side sees it right away
+            result = d3dImage->keyedMutex->ReleaseSync(value);
+            if(result != S_OK) {
+                LogError(result, nullptr, "ReleaseSync", __FILE__, __LINE__);
+                return false;
+            }
+            return true;
+        }
+
+        result = d3dContext4->Signal(d3dImage->fence, value);
+        if(result != S_OK) {
+            LogError(result, nullptr, "Signal", __FILE__, __LINE__);
+            return false;
+        }
+        return true;
+    }
+
+    void Flush() override
+    {
+        d3dContext->Flush();
+    }
+
+    bool FlushFromRPCThread() override
+    {
+        // The copies and signals were recorded on the immediate context from this thread too
+        d3dContext->Flush();
+        return true;
+    }
+
+    bool CanShareSwapchainImages() const override
+    {
+        // Not asked; the runtime creates the textures, without the shared flags
+        return false;
+    }
+
+    bool CopyImage(GraphicsImage* dst, GraphicsImage* src) override
+    {
+        d3dContext->CopyResource(static_cast<D3D11GraphicsImage*>(dst)->texture, static_cast<D3D11GraphicsImage*>(src)->texture);
+        return true;
+    }
+
+    bool CopyImageRegions(GraphicsImage* dst, GraphicsImage* src, const XrRect2Di* rects, uint32_t rectCount) override
+    {
+        ID3D11Texture2D* dstTexture = static_cast<D3D11GraphicsImage*>(dst)->texture;
+        ID3D11Texture2D* srcTexture = static_cast<D3D11GraphicsImage*>(src)->texture;
+
+        D3D11_TEXTURE2D_DESC desc;
+        srcTexture->GetDesc(&desc);
+
+        // CopySubresourceRegion can't take a box for multisampled or
+        // depth textures, and smaller mips would be left stale
+        if((desc.MipLevels > 1) || (desc.SampleDesc.Count > 1) || (desc.BindFlags & D3D11_BIND_DEPTH_STENCIL)) {
+            return CopyImage(dst, src);
+        }
+
+        for(UINT layer = 0; layer < desc.ArraySize; layer++) {
+            UINT subresource = D3D11CalcSubresource(0, layer, desc.MipLevels);
+            for(uint32_t i = 0; i < rectCount; i++) {
+                D3D11_BOX box { 0, 0, 0, 0, 0, 1 };
+                if(ClipRectToImage(rects[i], desc.Width, desc.Height, &box.left, &box.top, &box.right, &box.bottom)) {
+                    d3dContext->CopySubresourceRegion(dstTexture, subresource, box.left, box.top, 0, srcTexture, subresource, &box);
+                }
+            }
+        }
+        return true;
+    }
+
+    XrStructureType GetSwapchainImageType() const override
+    {
+        return XR_TYPE_SWAPCHAIN_IMAGE_D3D11_KHR;
+    }
+
+    size_t GetSwapchainImageStructSize() const override
+    {
+        return sizeof(XrSwapchainImageD3D11KHR);
+    }
+
+    GraphicsImage::Ptr WrapSwapchainImage(const XrSwapchainImageBaseHeader* image) override
+    {
+        ID3D11Texture2D* texture = reinterpret_cast<const XrSwapchainImageD3D11KHR*>(image)->texture;
+        texture->AddRef();
+        return std::make_shared<D3D11GraphicsImage>(texture, (HANDLE)NULL);
+    }
+
+    void FillSwapchainImage(GraphicsImage* image, XrSwapchainImageBaseHeader* out) override
+    {
+        reinterpret_cast<XrSwapchainImageD3D11KHR*>(out)->texture = static_cast<D3D11GraphicsImage*>(image)->texture;
+    }
+};
+
+GraphicsBackend::Ptr CreateD3D11GraphicsBackend(ID3D11Device* d3d11Device, GraphicsBackendErrorFunc errorFunc)
+{
+    return std::make_shared<D3D11GraphicsBackend>(d3d11Device, errorFunc);
+}
@@ -0,0 +1,807 @@
+// Copyright (c) 2020-2021 LunarG, Inc.
+// Copyright (c) 2017-2021 PlutoVR Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Brad Grantham <brad@lunarg.com>
+// Author: John Zulauf <jzulauf@lunarg.com>
+
+// Vulkan backend: images are exported and imported as opaque handles, NT
+// handles on Windows (VK_KHR_external_memory_win32) and file descriptors
+// elsewhere (VK_KHR_external_memory_fd), and handed between the processes
+// with a timeline semaphore shared the same way (VK_KHR_external_semaphore_win32
+// or VK_KHR_external_semaphore_fd, and VK_KHR_timeline_semaphore).  The
+// application must enable those device extensions.  This works on any
+// conformant Linux driver, including lavapipe, so the Overlay and Main
+// swapchain path can run without a GPU.
+//
+// Submissions go to the queue the application gave OpenXR, which the
+// application only leaves alone during its OpenXR frame and swapchain calls.
+// Work recorded on Main's RPC thread is held until Main's next xrEndFrame.
+
+#include "graphics_backend.h"
+
+#include <cinttypes>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+
+#if !defined(_WIN32)
+#include <unistd.h>
+#endif
+
+#include <vulkan/vulkan.h>
+#if defined(_WIN32)
+#include <vulkan/vulkan_win32.h>
+#endif
+#include <openxr/openxr_platform.h>
+
+#if defined(_WIN32)
+
+const VkExternalMemoryHandleTypeFlagBits ExternalMemoryHandleType = VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_WIN32_BIT;
+const VkExternalSemaphoreHandleTypeFlagBits ExternalSemaphoreHandleType = VK_EXTERNAL_SEMAPHORE_HANDLE_TYPE_OPAQUE_WIN32_BIT;
+
+static void CloseSharedObject(SharedObjectHandle handle)
+{
+    CloseHandle(handle);
+}
+
+#else
+
+const VkExternalMemoryHandleTypeFlagBits ExternalMemoryHandleType = VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_FD_BIT;
+const VkExternalSemaphoreHandleTypeFlagBits ExternalSemaphoreHandleType = VK_EXTERNAL_SEMAPHORE_HANDLE_TYPE_OPAQUE_FD_BIT;
+
+static void CloseSharedObject(SharedObjectHandle handle)
+{
+    close((int)handle);
+}
+
+#endif
+
+// A handle ReceivePeerHandles made valid here that won't be imported after all
+static void DropPeerHandle(SharedObjectHandle handle)
+{
+    if(handle != NO_SHARED_OBJECT_HANDLE) {
+        CloseSharedObject(handle);
+    }
+}
+
+// semaphore is the image's fence, a timeline semaphore starting at 0.
+// Held by pending submissions, so it outlives the commands that use it.
+struct VulkanGraphicsImage : public GraphicsImage, public std::enable_shared_from_this<VulkanGraphicsImage>
+{
+    VkDevice device;
+    VkImage image;
+    VkDeviceMemory memory;      // VK_NULL_HANDLE if the runtime owns image
+    VkSemaphore semaphore;      // VK_NULL_HANDLE unless shared
+#if !defined(_WIN32)
+    int memoryFd;               // exported fds, kept open as the numbers the peer knows them by
+    int semaphoreFd;
+#endif
+    SharedImageDesc desc;
+
+    VulkanGraphicsImage(VkDevice device_, VkImage image_, const SharedImageDesc& desc_) :
+        device(device_),
+        image(image_),
+        memory(VK_NULL_HANDLE),
+        semaphore(VK_NULL_HANDLE),
+#if !defined(_WIN32)
+        memoryFd(-1),
+        semaphoreFd(-1),
+#endif
+        desc(desc_)
+    {}
+
+    ~VulkanGraphicsImage()
+    {
+        if(memory != VK_NULL_HANDLE) {
+            // We created or imported image, so it's ours to destroy
+            vkDestroyImage(device, image, nullptr);
+            vkFreeMemory(device, memory, nullptr);
+        }
+        if(semaphore != VK_NULL_HANDLE) {
+            vkDestroySemaphore(device, semaphore, nullptr);
+        }
+#if !defined(_WIN32)
+        if(memoryFd >= 0) {
+            close(memoryFd);
+        }
+        if(semaphoreFd >= 0) {
+            close(semaphoreFd);
+        }
+#endif
+    }
+};
+
+struct VulkanGraphicsBackend : public GraphicsBackend
+{
+    VkPhysicalDevice physicalDevice;
+    VkDevice device;
+    VkQueue queue;
+    VkCommandPool commandPool;
+    GraphicsBackendErrorFunc errorFunc;
+
+    // Copies are recorded into whichever of these has finished executing.
+    // images are the ones its commands use, kept alive until then.
+    struct CopyCommands {
+        VkCommandBuffer commandBuffer;
+        VkFence fence;
+        bool held;              // recorded but not submitted until the next Flush
+        std::vector<std::shared_ptr<VulkanGraphicsImage>> images;
+    };
+    std::deque<CopyCommands> copyCommands;     // not moved by push_back, so heldSubmits can point into it
+    enum { MAX_COPY_COMMANDS = 8 };
+
+    // Command buffers and semaphore signals to submit at the next Flush, in order
+    struct HeldSubmit {
+        CopyCommands* commands;                             // nullptr if only signaling
+        std::shared_ptr<VulkanGraphicsImage> signalImage;   // nullptr if only commands
+        uint64_t signalValue;
+    };
+    std::vector<HeldSubmit> heldSubmits;
+
+    // Main records on its RPC thread and submits on the application's thread
+    std::mutex mutex;
+
+#if defined(_WIN32)
+    PFN_vkGetMemoryWin32HandleKHR GetMemoryWin32Handle;
+    PFN_vkGetSemaphoreWin32HandleKHR GetSemaphoreWin32Handle;
+    PFN_vkImportSemaphoreWin32HandleKHR ImportSemaphoreWin32Handle;
+#else
+    PFN_vkGetMemoryFdKHR GetMemoryFd;
+    PFN_vkGetSemaphoreFdKHR GetSemaphoreFd;
+    PFN_vkImportSemaphoreFdKHR ImportSemaphoreFd;
+#endif
+    PFN_vkWaitSemaphoresKHR WaitSemaphores;
+
+    VulkanGraphicsBackend(VkPhysicalDevice physicalDevice_, VkDevice device_, GraphicsBackendErrorFunc errorFunc_) :
+        physicalDevice(physicalDevice_),
+        device(device_),
+        queue(VK_NULL_HANDLE),
+        commandPool(VK_NULL_HANDLE),
+        errorFunc(errorFunc_),
+#if defined(_WIN32)
+        GetMemoryWin32Handle(nullptr),
+        GetSemaphoreWin32Handle(nullptr),
+        ImportSemaphoreWin32Handle(nullptr),
+#else
+        GetMemoryFd(nullptr),
+        GetSemaphoreFd(nullptr),
+        ImportSemaphoreFd(nullptr),
+#endif
+        WaitSemaphores(nullptr)
+    {}
+
+    ~VulkanGraphicsBackend()
+    {
+        // Held work is never submitted
+        for(auto& commands: copyCommands) {
+            if(!commands.held) {
+                vkWaitForFences(device, 1, &commands.fence, VK_TRUE, UINT64_MAX);
+            }
+            vkDestroyFence(device, commands.fence, nullptr);
+        }
+        if(commandPool != VK_NULL_HANDLE) {
+            vkDestroyCommandPool(device, commandPool, nullptr);
+        }
+    }
+
+    void LogError(VkResult result, const char *xrfunc, const char* what, const char *file, int line)
+    {
+        char message[1024];
+        snprintf(message, sizeof(message), "%s at %s:%d failed with %d", what, file, line, result);
+        errorFunc(xrfunc, message);
+    }
+
+    bool Init(uint32_t queueFamilyIndex, uint32_t queueIndex)
+    {
+#if defined(_WIN32)
+        GetMemoryWin32Handle = (PFN_vkGetMemoryWin32HandleKHR)vkGetDeviceProcAddr(device, "vkGetMemoryWin32HandleKHR");
+        GetSemaphoreWin32Handle = (PFN_vkGetSemaphoreWin32HandleKHR)vkGetDeviceProcAddr(device, "vkGetSemaphoreWin32HandleKHR");
+        ImportSemaphoreWin32Handle = (PFN_vkImportSemaphoreWin32HandleKHR)vkGetDeviceProcAddr(device, "vkImportSemaphoreWin32HandleKHR");
+        bool haveExternal = GetMemoryWin32Handle && GetSemaphoreWin32Handle && ImportSemaphoreWin32Handle;
+        const char* required = "Vulkan device must enable VK_KHR_external_memory_win32, VK_KHR_external_semaphore_win32 and VK_KHR_timeline_semaphore for overlays";
+#else
+        GetMemoryFd = (PFN_vkGetMemoryFdKHR)vkGetDeviceProcAddr(device, "vkGetMemoryFdKHR");
+        GetSemaphoreFd = (PFN_vkGetSemaphoreFdKHR)vkGetDeviceProcAddr(device, "vkGetSemaphoreFdKHR");
+        ImportSemaphoreFd = (PFN_vkImportSemaphoreFdKHR)vkGetDeviceProcAddr(device, "vkImportSemaphoreFdKHR");
+        bool haveExternal = GetMemoryFd && GetSemaphoreFd && ImportSemaphoreFd;
+        const char* required = "Vulkan device must enable VK_KHR_external_memory_fd, VK_KHR_external_semaphore_fd and VK_KHR_timeline_semaphore for overlays";
+#endif
+        WaitSemaphores = (PFN_vkWaitSemaphoresKHR)vkGetDeviceProcAddr(device, "vkWaitSemaphores");
+        if(!WaitSemaphores) {
+            WaitSemaphores = (PFN_vkWaitSemaphoresKHR)vkGetDeviceProcAddr(device, "vkWaitSemaphoresKHR");
+        }
+        if(!haveExternal || !WaitSemaphores) {
+            errorFunc("xrCreateSession", required);
+            return false;
+        }
+
+        // The application's queue, only submitted to from Flush
+        vkGetDeviceQueue(device, queueFamilyIndex, queueIndex, &queue);
+
+        VkCommandPoolCreateInfo poolInfo { VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO };
+        poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+        poolInfo.queueFamilyIndex = queueFamilyIndex;
+        VkResult result = vkCreateCommandPool(device, &poolInfo, nullptr, &commandPool);
+        if(result != VK_SUCCESS) {
+            LogError(result, "xrCreateSession", "vkCreateCommandPool", __FILE__, __LINE__);
+            return false;
+        }
+        return true;
+    }
+
+    // Get a command buffer whose previous submission has completed, in the
+    // recording state.  Called with mutex held.
+    CopyCommands* BeginCommands()
+    {
+        CopyCommands* commands = nullptr;
+        CopyCommands* submitted = nullptr;
+        for(auto& c: copyCommands) {
+            if(!c.held) {
+                if(vkGetFenceStatus(device, c.fence) == VK_SUCCESS) {
+                    commands = &c;
+                    break;
+                }
+                submitted = submitted ? submitted : &c;
+            }
+        }
+
+        // Held ones can't be waited for until Flush, so only stop adding
+        // command buffers when there are enough executing to wait for
+        if(!commands && ((copyCommands.size() < MAX_COPY_COMMANDS) || !submitted)) {
+            CopyCommands c;
+            c.held = false;
+            VkCommandBufferAllocateInfo allocInfo { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
+            allocInfo.commandPool = commandPool;
+            allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            allocInfo.commandBufferCount = 1;
+            VkResult result = vkAllocateCommandBuffers(device, &allocInfo, &c.commandBuffer);
+            if(result != VK_SUCCESS) {
+                LogError(result, nullptr, "vkAllocateCommandBuffers", __FILE__, __LINE__);
+                return nullptr;
+            }
+            VkFenceCreateInfo fenceInfo { VK_STRUCTURE_TYPE_FENCE_CREATE_INFO };
+            fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+            result = vkCreateFence(device, &fenceInfo, nullptr, &c.fence);
+            if(result != VK_SUCCESS) {
+                vkFreeCommandBuffers(device, commandPool, 1, &c.commandBuffer);
+                LogError(result, nullptr, "vkCreateFence", __FILE__, __LINE__);
+                return nullptr;
+            }
+            copyCommands.push_back(c);
+            commands = &copyCommands.back();
+        }
+
+        if(!commands) {
+            // All executing; wait for the first submitted
+            commands = submitted;
+        }
+
+        vkWaitForFences(device, 1, &commands->fence, VK_TRUE, UINT64_MAX);
+        vkResetFences(device, 1, &commands->fence);
+        vkResetCommandBuffer(commands->commandBuffer, 0);
+        commands->images.clear();
+
+        VkCommandBufferBeginInfo beginInfo { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        vkBeginCommandBuffer(commands->commandBuffer, &beginInfo);
+
+        return commands;
+    }
+
+    // Finish recording and hold commands for the next Flush.  Called with mutex held.
+    void EndCommands(CopyCommands* commands)
+    {
+        vkEndCommandBuffer(commands->commandBuffer);
+        commands->held = true;
+        heldSubmits.push_back({commands, nullptr, 0});
+    }
+
+    static void AddBarrier(std::vector<VkImageMemoryBarrier>& barriers, VulkanGraphicsImage* image, VkImageLayout oldLayout, VkImageLayout newLayout, VkAccessFlags srcAccess, VkAccessFlags dstAccess)
+    {
+        VkImageMemoryBarrier barrier { VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER };
+        barrier.srcAccessMask = srcAccess;
+        barrier.dstAccessMask = dstAccess;
+        barrier.oldLayout = oldLayout;
+        barrier.newLayout = newLayout;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = image->image;
+        barrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, VK_REMAINING_MIP_LEVELS, 0, VK_REMAINING_ARRAY_LAYERS };
+        barriers.push_back(barrier);
+    }
+
+    static void CmdBarriers(VkCommandBuffer commandBuffer, const std::vector<VkImageMemoryBarrier>& barriers)
+    {
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0,
+            0, nullptr, 0, nullptr, (uint32_t)barriers.size(), barriers.data());
+    }
+
+    uint32_t FindMemoryType(uint32_t typeBits, VkMemoryPropertyFlags properties)
+    {
+        VkPhysicalDeviceMemoryProperties memoryProperties;
+        vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memoryProperties);
+        for(uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++) {
+            if((typeBits & (1u << i)) && ((memoryProperties.memoryTypes[i].propertyFlags & properties) == properties)) {
+                return i;
+            }
+        }
+        // XXX no device-local type; take anything the image allows
+        for(uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++) {
+            if(typeBits & (1u << i)) {
+                return i;
+            }
+        }
+        return 0xFFFFFFFF;
+    }
+
+    // Create image and its memory, exportable or imported from importHandle.
+    // Afterwards importHandle is Vulkan's or closed, even on failure.
+    std::shared_ptr<VulkanGraphicsImage> CreateImage(const SharedImageDesc& desc, bool external, SharedObjectHandle importHandle)
+    {
+        bool importing = (importHandle != NO_SHARED_OBJECT_HANDLE);
+
+        VkExternalMemoryImageCreateInfo externalInfo { VK_STRUCTURE_TYPE_EXTERNAL_MEMORY_IMAGE_CREATE_INFO };
+        externalInfo.handleTypes = ExternalMemoryHandleType;
+
+        // XXX depth formats will need DEPTH_STENCIL_ATTACHMENT usage and aspect
+        VkImageCreateInfo imageInfo { VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO };
+        imageInfo.pNext = external ? &externalInfo : nullptr;
+        imageInfo.imageType = VK_IMAGE_TYPE_2D;
+        imageInfo.format = (VkFormat)desc.format;
+        imageInfo.extent = { desc.width, desc.height, 1 };
+        imageInfo.mipLevels = desc.mipCount;
+        imageInfo.arrayLayers = desc.arraySize;
+        imageInfo.samples = (VkSampleCountFlagBits)desc.sampleCount;
+        imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+        imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+        VkImage image;
+        VkResult result = vkCreateImage(device, &imageInfo, nullptr, &image);
+        if(result != VK_SUCCESS) {
+            if(importing) {
+                CloseSharedObject(importHandle);
+            }
+            LogError(result, "xrCreateSwapchain", "vkCreateImage", __FILE__, __LINE__);
+            return nullptr;
+        }
+
+        VkMemoryRequirements requirements;
+        vkGetImageMemoryRequirements(device, image, &requirements);
+
+        VkMemoryDedicatedAllocateInfo dedicatedInfo { VK_STRUCTURE_TYPE_MEMORY_DEDICATED_ALLOCATE_INFO };
+        dedicatedInfo.image = image;
+        VkExportMemoryAllocateInfo exportInfo { VK_STRUCTURE_TYPE_EXPORT_MEMORY_ALLOCATE_INFO };
+        exportInfo.handleTypes = ExternalMemoryHandleType;
+#if defined(_WIN32)
+        VkImportMemoryWin32HandleInfoKHR importInfo { VK_STRUCTURE_TYPE_IMPORT_MEMORY_WIN32_HANDLE_INFO_KHR };
+        importInfo.handleType = ExternalMemoryHandleType;
+        importInfo.handle = importHandle;
+#else
+        VkImportMemoryFdInfoKHR importInfo { VK_STRUCTURE_TYPE_IMPORT_MEMORY_FD_INFO_KHR };
+        importInfo.handleType = ExternalMemoryHandleType;
+        importInfo.fd = (int)importHandle;
+#endif
+
+        VkMemoryAllocateInfo allocInfo { VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
+        if(external) {
+            // Exporter and importer must agree on dedicated allocation
+            allocInfo.pNext = &dedicatedInfo;
+            dedicatedInfo.pNext = importing ? (const void*)&importInfo : (const void*)&exportInfo;
+        }
+        allocInfo.allocationSize = requirements.size;
+        allocInfo.memoryTypeIndex = FindMemoryType(requirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+        VkDeviceMemory memory;
+        result = vkAllocateMemory(device, &allocInfo, nullptr, &memory);
+
+        // Importing an NT handle doesn't take it over; importing an fd does, but only on success
+#if defined(_WIN32)
+        if(importing) {
+#else
+        if(importing && (result != VK_SUCCESS)) {
+#endif
+            CloseSharedObject(importHandle);
+        }
+
+        if(result != VK_SUCCESS) {
+            vkDestroyImage(device, image, nullptr);
+            LogError(result, "xrCreateSwapchain", "vkAllocateMemory", __FILE__, __LINE__);
+            return nullptr;
+        }
+
+        auto vulkanImage = std::make_shared<VulkanGraphicsImage>(device, image, desc);
+        vulkanImage->memory = memory;
+
+        result = vkBindImageMemory(device, image, memory, 0);
+        if(result != VK_SUCCESS) {
+            LogError(result, "xrCreateSwapchain", "vkBindImageMemory", __FILE__, __LINE__);
+            return nullptr;
+        }
+
+        return vulkanImage;
+    }
+
+    // Create the image's timeline semaphore, exportable or imported from
+    // importHandle.  Afterwards importHandle is Vulkan's or closed.
+    bool CreateSemaphore(VulkanGraphicsImage* image, SharedObjectHandle importHandle)
+    {
+        bool importing = (importHandle != NO_SHARED_OBJECT_HANDLE);
+
+        VkExportSemaphoreCreateInfo exportInfo { VK_STRUCTURE_TYPE_EXPORT_SEMAPHORE_CREATE_INFO };
+        exportInfo.handleTypes = ExternalSemaphoreHandleType;
+        VkSemaphoreTypeCreateInfo typeInfo { VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO };
+        typeInfo.pNext = importing ? nullptr : &exportInfo;
+        typeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+        typeInfo.initialValue = 0;
+        VkSemaphoreCreateInfo semaphoreInfo { VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO };
+        semaphoreInfo.pNext = &typeInfo;
+
+        VkResult result = vkCreateSemaphore(device, &semaphoreInfo, nullptr, &image->semaphore);
+        if(result != VK_SUCCESS) {
+            if(importing) {
+                CloseSharedObject(importHandle);
+            }
+            LogError(result, "xrCreateSwapchain", "vkCreateSemaphore", __FILE__, __LINE__);
+            return false;
+        }
+
+        if(!importing) {
+            return true;
+        }
+
+#if defined(_WIN32)
+        VkImportSemaphoreWin32HandleInfoKHR importInfo { VK_STRUCTURE_TYPE_IMPORT_SEMAPHORE_WIN32_HANDLE_INFO_KHR };
+        importInfo.semaphore = image->semaphore;
+        importInfo.handleType = ExternalSemaphoreHandleType;
+        importInfo.handle = importHandle;
+        result = ImportSemaphoreWin32Handle(device, &importInfo);
+        CloseSharedObject(importHandle);
+        if(result != VK_SUCCESS) {
+            LogError(result, "xrCreateSwapchain", "vkImportSemaphoreWin32HandleKHR", __FILE__, __LINE__);
+            return false;
+        }
+#else
+        VkImportSemaphoreFdInfoKHR importInfo { VK_STRUCTURE_TYPE_IMPORT_SEMAPHORE_FD_INFO_KHR };
+        importInfo.semaphore = image->semaphore;
+        importInfo.handleType = ExternalSemaphoreHandleType;
+        importInfo.fd = (int)importHandle;
+        result = ImportSemaphoreFd(device, &importInfo);
+        if(result != VK_SUCCESS) {
+            CloseSharedObject(importHandle);
+            LogError(result, "xrCreateSwapchain", "vkImportSemaphoreFdKHR", __FILE__, __LINE__);
+            return false;
+        }
+#endif
+        return true;
+    }
+
+    // Export image's memory and semaphore as handles valid in peer
+    bool ShareWithPeer(VulkanGraphicsImage* image, const GraphicsPeer& peer, SharedImageHandle* handle)
+    {
+#if defined(_WIN32)
+        HANDLE thisProcessHandle = GetCurrentProcess();
+
+        HANDLE memoryHandle;
+        VkMemoryGetWin32HandleInfoKHR getMemoryInfo { VK_STRUCTURE_TYPE_MEMORY_GET_WIN32_HANDLE_INFO_KHR };
+        getMemoryInfo.memory = image->memory;
+        getMemoryInfo.handleType = ExternalMemoryHandleType;
+        VkResult result = GetMemoryWin32Handle(device, &getMemoryInfo, &memoryHandle);
+        if(result != VK_SUCCESS) {
+            LogError(result, "xrCreateSwapchain", "vkGetMemoryWin32HandleKHR", __FILE__, __LINE__);
+            return false;
+        }
+        BOOL duplicated = DuplicateHandle(thisProcessHandle, memoryHandle, peer.processHandle, &handle->image, 0, TRUE, DUPLICATE_SAME_ACCESS);
+        CloseHandle(memoryHandle);
+        if(!duplicated) {
+            LogError(VK_ERROR_UNKNOWN, "xrCreateSwapchain", "DuplicateHandle", __FILE__, __LINE__);
+            return false;
+        }
+
+        HANDLE semaphoreHandle;
+        VkSemaphoreGetWin32HandleInfoKHR getSemaphoreInfo { VK_STRUCTURE_TYPE_SEMAPHORE_GET_WIN32_HANDLE_INFO_KHR };
+        getSemaphoreInfo.semaphore = image->semaphore;
+        getSemaphoreInfo.handleType = ExternalSemaphoreHandleType;
+        result = GetSemaphoreWin32Handle(device, &getSemaphoreInfo, &semaphoreHandle);
+        if(result != VK_SUCCESS) {
+            LogError(result, "xrCreateSwapchain", "vkGetSemaphoreWin32HandleKHR", __FILE__, __LINE__);
+            CloseHandlesInPeer(peer, {*handle});
+            return false;
+        }
+        duplicated = DuplicateHandle(thisProcessHandle, semaphoreHandle, peer.processHandle, &handle->fence, 0, TRUE, DUPLICATE_SAME_ACCESS);
+        CloseHandle(semaphoreHandle);
+        if(!duplicated) {
+            LogError(VK_ERROR_UNKNOWN, "xrCreateSwapchain", "DuplicateHandle", __FILE__, __LINE__);
+            handle->fence = NULL;
+            CloseHandlesInPeer(peer, {*handle});
+            return false;
+        }
+#else
+        // CreateSharedImages sends the fds to the peer; they stay open here as
+        // the numbers the layer names them by
+        VkMemoryGetFdInfoKHR getMemoryInfo { VK_STRUCTURE_TYPE_MEMORY_GET_FD_INFO_KHR };
+        getMemoryInfo.memory = image->memory;
+        getMemoryInfo.handleType = ExternalMemoryHandleType;
+        VkResult result = GetMemoryFd(device, &getMemoryInfo, &image->memoryFd);
+        if(result != VK_SUCCESS) {
+            LogError(result, "xrCreateSwapchain", "vkGetMemoryFdKHR", __FILE__, __LINE__);
+            return false;
+        }
+
+        VkSemaphoreGetFdInfoKHR getSemaphoreInfo { VK_STRUCTURE_TYPE_SEMAPHORE_GET_FD_INFO_KHR };
+        getSemaphoreInfo.semaphore = image->semaphore;
+        getSemaphoreInfo.handleType = ExternalSemaphoreHandleType;
+        result = GetSemaphoreFd(device, &getSemaphoreInfo, &image->semaphoreFd);
+        if(result != VK_SUCCESS) {
+            LogError(result, "xrCreateSwapchain", "vkGetSemaphoreFdKHR", __FILE__, __LINE__);
+            return false;
+        }
+
+        handle->image = image->memoryFd;
+        handle->fence = image->semaphoreFd;
+#endif
+        return true;
+    }
+
+    bool CreateSharedImages(const SharedImageDesc& desc, uint32_t count, const GraphicsPeer& peer, std::vector<GraphicsImage::Ptr>& images, std::vector<SharedImageHandle>& handles) override
+    {
+        images.clear();
+        handles.clear();
+
+        std::unique_lock<std::mutex> lock(mutex);
+        CopyCommands* commands = BeginCommands();
+        if(!commands) {
+            return false;
+        }
+        std::vector<VkImageMemoryBarrier> barriers;
+
+        bool created = true;
+        for(uint32_t i = 0; created && (i < count); i++) {
+            auto image = CreateImage(desc, true, NO_SHARED_OBJECT_HANDLE);
+            SharedImageHandle handle { NO_SHARED_OBJECT_HANDLE, NO_SHARED_OBJECT_HANDLE };
+            created = image && CreateSemaphore(image.get(), NO_SHARED_OBJECT_HANDLE) && ShareWithPeer(image.get(), peer, &handle);
+            if(created) {
+                images.push_back(image);
+                handles.push_back(handle);
+
+                // Hand the images over in the layout an application renders to
+                AddBarrier(barriers, image.get(), VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, 0, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT);
+                commands->images.push_back(image);
+            }
+        }
+
+#if !defined(_WIN32)
+        // All of them in one message
+        if(created && !SendPeerHandles(peer, handles)) {
+            LogError(VK_ERROR_UNKNOWN, "xrCreateSwapchain", "SendPeerHandles", __FILE__, __LINE__);
+            created = false;
+        }
+#endif
+
+        if(!created) {
+#if defined(_WIN32)
+            CloseHandlesInPeer(peer, handles);
+#endif
+            images.clear();
+            handles.clear();
+        }
+
+        // Ended even on failure, so the command buffer goes back into rotation
+        CmdBarriers(commands->commandBuffer, barriers);
+        EndCommands(commands);
+        return created;
+    }
+
+    GraphicsImage::Ptr OpenSharedImage(SharedImageHandle handle, const SharedImageDesc& desc, const GraphicsPeer&) override
+    {
+        if((handle.image == NO_SHARED_OBJECT_HANDLE) || (handle.fence == NO_SHARED_OBJECT_HANDLE)) {
+            errorFunc("xrCreateSwapchain", "shared image is missing its memory or semaphore handle");
+            DropPeerHandle(handle.image);
+            DropPeerHandle(handle.fence);
+            return nullptr;
+        }
+        auto image = CreateImage(desc, true, handle.image);
+        if(!image) {
+            DropPeerHandle(handle.fence);
+            return nullptr;
+        }
+
+        if(!CreateSemaphore(image.get(), handle.fence)) {
+            return nullptr;
+        }
+
+        return image;
+    }
+
+    GraphicsImage::Ptr CreateLocalImage(const SharedImageDesc& desc) override
+    {
+        return CreateImage(desc, false, NO_SHARED_OBJECT_HANDLE);
+    }
+
+    bool WaitImage(GraphicsImage* image, uint64_t value, uint32_t timeoutMs) override
+    {
+        // A semaphore wait in a submission doesn't hold back later
+        // submissions, and the application's rendering is submitted later,
+        // so wait on the CPU
+        VulkanGraphicsImage* vulkanImage = static_cast<VulkanGraphicsImage*>(image);
+
+        VkSemaphoreWaitInfo waitInfo { VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO };
+        waitInfo.semaphoreCount = 1;
+        waitInfo.pSemaphores = &vulkanImage->semaphore;
+        waitInfo.pValues = &value;
+        uint64_t timeoutNs = (timeoutMs == INFINITE) ? UINT64_MAX : (uint64_t)timeoutMs * 1000000;
+        VkResult result = WaitSemaphores(device, &waitInfo, timeoutNs);
+        if(result != VK_SUCCESS) {
+            LogError(result, nullptr, "vkWaitSemaphores", __FILE__, __LINE__);
+            return false;
+        }
+        return true;
+    }
+
+    bool SignalImage(GraphicsImage* image, uint64_t value) override
+    {
+        // Signaled on the queue at Flush, so it's ordered after rendering or copies already submitted
+        std::unique_lock<std::mutex> lock(mutex);
+        heldSubmits.push_back({nullptr, static_cast<VulkanGraphicsImage*>(image)->shared_from_this(), value});
+        return true;
+    }
+
+    void Flush() override
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        for(auto& submit: heldSubmits) {
+            VkTimelineSemaphoreSubmitInfo timelineInfo { VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO };
+            VkSubmitInfo submitInfo { VK_STRUCTURE_TYPE_SUBMIT_INFO };
+            VkFence fence = VK_NULL_HANDLE;
+            if(submit.commands) {
+                submitInfo.commandBufferCount = 1;
+                submitInfo.pCommandBuffers = &submit.commands->commandBuffer;
+                fence = submit.commands->fence;
+            }
+            if(submit.signalImage) {
+                timelineInfo.signalSemaphoreValueCount = 1;
+                timelineInfo.pSignalSemaphoreValues = &submit.signalValue;
+                submitInfo.pNext = &timelineInfo;
+                submitInfo.signalSemaphoreCount = 1;
+                submitInfo.pSignalSemaphores = &submit.signalImage->semaphore;
+            }
+            VkResult result = vkQueueSubmit(queue, 1, &submitInfo, fence);
+            if(result != VK_SUCCESS) {
+                LogError(result, nullptr, "vkQueueSubmit", __FILE__, __LINE__);
+                if(submit.commands) {
+                    // Never submitted, so nothing will signal the fence; replace it with a signaled one
+                    vkDestroyFence(device, submit.commands->fence, nullptr);
+                    VkFenceCreateInfo fenceInfo { VK_STRUCTURE_TYPE_FENCE_CREATE_INFO };
+                    fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+                    vkCreateFence(device, &fenceInfo, nullptr, &submit.commands->fence);
+                }
+            }
+            if(submit.commands) {
+                submit.commands->held = false;
+            }
+        }
+        heldSubmits.clear();
+    }
+
+    bool FlushFromRPCThread() override
+    {
+        // The application may be submitting to the queue; Main's next xrEndFrame submits these
+        return false;
+    }
+
+    bool CanShareSwapchainImages() const override
+    {
+        // Not asked; the runtime allocates the images, without exportable memory
+        return false;
+    }
+
+    bool CopyImageRegions(GraphicsImage* dst, GraphicsImage* src, const XrRect2Di* rects, uint32_t rectCount) override
+    {
+        VulkanGraphicsImage* dstImage = static_cast<VulkanGraphicsImage*>(dst);
+        VulkanGraphicsImage* srcImage = static_cast<VulkanGraphicsImage*>(src);
+        const SharedImageDesc& desc = srcImage->desc;
+
+        std::vector<VkImageCopy> regions;
+        if(!rects || (desc.mipCount > 1)) {
+            // Whole image, every mip
+            for(uint32_t mip = 0; mip < desc.mipCount; mip++) {
+                VkImageCopy region {};
+                region.srcSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, mip, 0, desc.arraySize };
+                region.dstSubresource = region.srcSubresource;
+                region.extent = { std::max(desc.width >> mip, 1u), std::max(desc.height >> mip, 1u), 1 };
+                regions.push_back(region);
+            }
+        } else {
+            for(uint32_t i = 0; i < rectCount; i++) {
+                uint32_t left, top, right, bottom;
+                if(ClipRectToImage(rects[i], desc.width, desc.height, &left, &top, &right, &bottom)) {
+                    VkImageCopy region {};
+                    region.srcSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, desc.arraySize };
+                    region.dstSubresource = region.srcSubresource;
+                    region.srcOffset = { (int32_t)left, (int32_t)top, 0 };
+                    region.dstOffset = region.srcOffset;
+                    region.extent = { right - left, bottom - top, 1 };
+                    regions.push_back(region);
+                }
+            }
+            if(regions.empty()) {
+                return true;
+            }
+        }
+
+        std::unique_lock<std::mutex> lock(mutex);
+        CopyCommands* commands = BeginCommands();
+        if(!commands) {
+            return false;
+        }
+        commands->images.push_back(dstImage->shared_from_this());
+        commands->images.push_back(srcImage->shared_from_this());
+
+        // Both images are in COLOR_ATTACHMENT_OPTIMAL between uses
+        std::vector<VkImageMemoryBarrier> barriers;
+        AddBarrier(barriers, srcImage, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT);
+        AddBarrier(barriers, dstImage, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 0, VK_ACCESS_TRANSFER_WRITE_BIT);
+        CmdBarriers(commands->commandBuffer, barriers);
+
+        vkCmdCopyImage(commands->commandBuffer, srcImage->image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, dstImage->image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, (uint32_t)regions.size(), regions.data());
+
+        barriers.clear();
+        AddBarrier(barriers, srcImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, 0, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT);
+        AddBarrier(barriers, dstImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_SHADER_READ_BIT);
+        CmdBarriers(commands->commandBuffer, barriers);
+
+        EndCommands(commands);
+        return true;
+    }
+
+    bool CopyImage(GraphicsImage* dst, GraphicsImage* src) override
+    {
+        return CopyImageRegions(dst, src, nullptr, 0);
+    }
+
+    XrStructureType GetSwapchainImageType() const override
+    {
+        return XR_TYPE_SWAPCHAIN_IMAGE_VULKAN_KHR;
+    }
+
+    size_t GetSwapchainImageStructSize() const override
+    {
+        return sizeof(XrSwapchainImageVulkanKHR);
+    }
+
+    GraphicsImage::Ptr WrapSwapchainImage(const XrSwapchainImageBaseHeader* image) override
+    {
+        // The runtime's image; copies only use the shared image's description
+        SharedImageDesc desc {};
+        return std::make_shared<VulkanGraphicsImage>(device, reinterpret_cast<const XrSwapchainImageVulkanKHR*>(image)->image, desc);
+    }
+
+    void FillSwapchainImage(GraphicsImage* image, XrSwapchainImageBaseHeader* out) override
+    {
+        reinterpret_cast<XrSwapchainImageVulkanKHR*>(out)->image = static_cast<VulkanGraphicsImage*>(image)->image;
+    }
+};
+
+GraphicsBackend::Ptr CreateVulkanGraphicsBackend(const XrGraphicsBindingVulkanKHR* binding, GraphicsBackendErrorFunc errorFunc)
+{
+    auto backend = std::make_shared<VulkanGraphicsBackend>(binding->physicalDevice, binding->device, errorFunc);
+    if(!backend->Init(binding->queueFamilyIndex, binding->queueIndex)) {
+        return nullptr;
+    }
+    return backend;
+}
@@ -0,0 +1,213 @@
+// Copyright (c) 2021 LunarG, Inc.
+// Copyright (c) 2017-2021 PlutoVR Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Brad Grantham <brad@lunarg.com>
+
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif  // !NOMINMAX
+
+#include "graphics_backend.h"
+
+#if !defined(_WIN32)
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// One message carries the other process's numbers for every handle, so the
+// receiver can check them against the ones it got by RPC, followed by the
+// descriptors themselves as SCM_RIGHTS, images and fences in that order,
+// leaving out NO_SHARED_OBJECT_HANDLE.
+struct PeerHandlesMessage
+{
+    uint32_t count;
+    int32_t numbers[MaxPeerHandlesPerMessage][2];      // image, fence
+};
+
+static socklen_t PeerHandlesAddress(uint32_t channelId, sockaddr_un* address)
+{
+    // Abstract, so nothing is left in the filesystem and any process can connect by name
+    memset(address, 0, sizeof(*address));
+    address->sun_family = AF_UNIX;
+    int length = snprintf(address->sun_path + 1, sizeof(address->sun_path) - 1, PeerHandlesSocketNameTemplate, channelId);
+    return (socklen_t)(offsetof(sockaddr_un, sun_path) + 1 + length);
+}
+
+int ListenForPeerHandles(uint32_t channelId)
+{
+    int listenSocket = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    if(listenSocket < 0) {
+        return -1;
+    }
+    sockaddr_un address;
+    socklen_t addressLength = PeerHandlesAddress(channelId, &address);
+    if((bind(listenSocket, reinterpret_cast<sockaddr*>(&address), addressLength) != 0) || (listen(listenSocket, 1) != 0)) {
+        close(listenSocket);
+        return -1;
+    }
+    return listenSocket;
+}
+
+int AcceptPeerHandles(int listenSocket, uint32_t timeoutMs)
+{
+    pollfd waitFor { listenSocket, POLLIN, 0 };
+    if(poll(&waitFor, 1, (timeoutMs == INFINITE) ? -1 : (int)timeoutMs) != 1) {
+        return -1;
+    }
+    return accept4(listenSocket, nullptr, nullptr, SOCK_CLOEXEC);
+}
+
+int ConnectForPeerHandles(uint32_t channelId)
+{
+    int handleSocket = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    if(handleSocket < 0) {
+        return -1;
+    }
+    sockaddr_un address;
+    socklen_t addressLength = PeerHandlesAddress(channelId, &address);
+    if(connect(handleSocket, reinterpret_cast<sockaddr*>(&address), addressLength) != 0) {
+        close(handleSocket);
+        return -1;
+    }
+    return handleSocket;
+}
+
+bool SendPeerHandles(const GraphicsPeer& peer, const std::vector<SharedImageHandle>& handles)
+{
+    if((peer.handleSocket < 0) || (handles.size() > MaxPeerHandlesPerMessage)) {
+        return false;
+    }
+
+    PeerHandlesMessage message {};
+    message.count = (uint32_t)handles.size();
+    std::vector<int> descriptors;
+    for(size_t i = 0; i < handles.size(); i++) {
+        message.numbers[i][0] = (int32_t)handles[i].image;
+        message.numbers[i][1] = (int32_t)handles[i].fence;
+        for(SharedObjectHandle handle: { handles[i].image, handles[i].fence }) {
+            if(handle != NO_SHARED_OBJECT_HANDLE) {
+                descriptors.push_back((int)handle);
+            }
+        }
+    }
+
+    iovec data { &message, sizeof(message) };
+    std::vector<char> control(CMSG_SPACE(sizeof(int) * descriptors.size()));
+    msghdr header {};
+    header.msg_iov = &data;
+    header.msg_iovlen = 1;
+    if(!descriptors.empty()) {
+        header.msg_control = control.data();
+        header.msg_controllen = control.size();
+        cmsghdr* rights = CMSG_FIRSTHDR(&header);
+        rights->cmsg_level = SOL_SOCKET;
+        rights->cmsg_type = SCM_RIGHTS;
+        rights->cmsg_len = CMSG_LEN(sizeof(int) * descriptors.size());
+        memcpy(CMSG_DATA(rights), descriptors.data(), sizeof(int) * descriptors.size());
+    }
+
+    ssize_t sent;
+    do {
+        sent = sendmsg(peer.handleSocket, &header, MSG_NOSIGNAL);
+    } while((sent < 0) && (errno == EINTR));
+    return sent == (ssize_t)sizeof(message);
+}
+
+bool ReceivePeerHandles(const GraphicsPeer& peer, std::vector<SharedImageHandle>& handles, uint32_t timeoutMs)
+{
+    if((peer.handleSocket < 0) || (handles.size() > MaxPeerHandlesPerMessage)) {
+        return false;
+    }
+
+    pollfd waitFor { peer.handleSocket, POLLIN, 0 };
+    if(poll(&waitFor, 1, (timeoutMs == INFINITE) ? -1 : (int)timeoutMs) != 1) {
+        return false;
+    }
+
+    PeerHandlesMessage message {};
+    iovec data { &message, sizeof(message) };
+    std::vector<char> control(CMSG_SPACE(sizeof(int) * MaxPeerHandlesPerMessage * 2));
+    msghdr header {};
+    header.msg_iov = &data;
+    header.msg_iovlen = 1;
+    header.msg_control = control.data();
+    header.msg_controllen = control.size();
+
+    ssize_t received;
+    do {
+        received = recvmsg(peer.handleSocket, &header, MSG_CMSG_CLOEXEC);
+    } while((received < 0) && (errno == EINTR));
+    if(received < 0) {
+        return false;
+    }
+
+    std::vector<int> descriptors;
+    for(cmsghdr* rights = CMSG_FIRSTHDR(&header); rights; rights = CMSG_NXTHDR(&header, rights)) {
+        if((rights->cmsg_level == SOL_SOCKET) && (rights->cmsg_type == SCM_RIGHTS)) {
+            size_t count = (rights->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+            const int* fds = reinterpret_cast<const int*>(CMSG_DATA(rights));
+            descriptors.insert(descriptors.end(), fds, fds + count);
+        }
+    }
+
+    // Everything has to be for the handles we were told about, in order
+    bool matches = (received == (ssize_t)sizeof(message)) && !(header.msg_flags & (MSG_TRUNC | MSG_CTRUNC)) &&
+        (message.count == handles.size());
+    std::vector<SharedImageHandle> taken(handles.size());
+    size_t next = 0;
+    for(size_t i = 0; matches && (i < handles.size()); i++) {
+        SharedObjectHandle* takenHandles[2] = { &taken[i].image, &taken[i].fence };
+        SharedObjectHandle peerHandles[2] = { handles[i].image, handles[i].fence };
+        for(int j = 0; matches && (j < 2); j++) {
+            matches = (message.numbers[i][j] == (int32_t)peerHandles[j]);
+            if(peerHandles[j] == NO_SHARED_OBJECT_HANDLE) {
+                *takenHandles[j] = NO_SHARED_OBJECT_HANDLE;
+            } else if(next < descriptors.size()) {
+                *takenHandles[j] = descriptors[next++];
+            } else {
+                matches = false;
+            }
+        }
+    }
+    matches = matches && (next == descriptors.size());
+
+    if(!matches) {
+        for(int descriptor: descriptors) {
+            close(descriptor);
+        }
+        return false;
+    }
+
+    handles = taken;
+    return true;
+}
+
+#else
+
+bool ReceivePeerHandles(const GraphicsPeer&, std::vector<SharedImageHandle>&, uint32_t)
+{
+    // The other process duplicated them into this one
+    return true;
+}
+
+#endif
@@ -0,0 +1,75 @@
+// Copyright (c) 2021 LunarG, Inc.
+// Copyright (c) 2017-2021 PlutoVR Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Brad Grantham <brad@lunarg.com>
+#ifndef _OVERLAY_VISIBILITY_H_
+#define _OVERLAY_VISIBILITY_H_
+
+#include <cstdint>
+
+// Whether an Overlay whose layers can't be seen should still be told to
+// render.  An Overlay told not to render submits nothing, and nothing can't
+// be culled, so deciding from one frame alone would flip shouldRender every
+// other frame.  Instead the Overlay is only culled after its layers were
+// invisible for framesToCull of Main's frames in a row; while culled it is
+// still told to render every framesBetweenProbes of its own frames, and the
+// first visible layer it then submits uncovers it again.
+struct OverlayCullHysteresis
+{
+    uint32_t framesToCull = 3;
+    uint32_t framesBetweenProbes = 30;
+
+    bool culled = false;
+    uint32_t invisibleFrames = 0;       // Main frames in a row in which the Overlay's layers were all invisible
+    uint32_t framesSinceProbe = 0;      // Overlay frames since it was last told to render while culled
+
+    // Main's xrEndFrame, with the Overlay's layers for that frame
+    void UpdateFromLayers(bool submittedLayers, bool anyLayerVisible)
+    {
+        if(!submittedLayers) {
+            // Nothing to judge; the Overlay was told not to render or chose not to
+            return;
+        }
+        if(anyLayerVisible) {
+            culled = false;
+            invisibleFrames = 0;
+            return;
+        }
+        if(invisibleFrames < framesToCull) {
+            invisibleFrames++;
+        }
+        if(!culled && (invisibleFrames >= framesToCull)) {
+            culled = true;
+            framesSinceProbe = 0;
+        }
+    }
+
+    // The Overlay's xrWaitFrame: whether the Overlay should render this frame
+    bool ShouldRender()
+    {
+        if(!culled) {
+            return true;
+        }
+        if(++framesSinceProbe >= framesBetweenProbes) {
+            framesSinceProbe = 0;
+            return true;
+        }
+        return false;
+    }
+};
+
+#endif /* _OVERLAY_VISIBILITY_H_ */
@@ -37,6 +37,8 @@
 
 #include <algorithm>
 #include <cctype>
+#include <chrono>
+#include <cmath>
 #include <cstring>
 #include <fstream>
 #include <iostream>
@@ -51,9 +53,11 @@
 #include <vector>
 #include <unordered_set>
 
+#if defined(XR_USE_GRAPHICS_API_D3D11)
 #include <dxgi1_2.h>
 #include <d3d11_1.h>
 #include <d3d11_4.h>
+#endif
 //#include <d3d12.h>
 
 
@@ -87,433 +91,6 @@ void LogToFile(const char *str)
     }
 }
 
-std::unordered_map<WellKnownStringIndex, const char *> OverlaysLayerWellKnownStrings = {
-    {USER_HAND_LEFT_INPUT_GRIP_POSE, "/user/hand/left/input/grip/pose"},
-    {USER_HAND_LEFT_INPUT_Y_TOUCH, "/user/hand/left/input/y/touch"},
-    {INTERACTION_PROFILES_OCULUS_GO_CONTROLLER, "/interaction_profiles/oculus/go_controller"},
-    {INTERACTION_PROFILES_HTC_VIVE_CONTROLLER, "/interaction_profiles/htc/vive_controller"},
-    {USER_HAND_RIGHT_INPUT_TRACKPAD_CLICK, "/user/hand/right/input/trackpad/click"},
-    {INPUT_SELECT_CLICK, "/input/select/click"},
-    {USER_GAMEPAD_INPUT_THUMBSTICK_LEFT_Y, "/user/gamepad/input/thumbstick_left/y"},
-    {USER_HAND_LEFT_INPUT_Y_CLICK, "/user/hand/left/input/y/click"},
-    {INPUT_B_TOUCH, "/input/b/touch"},
-    {USER_HAND_RIGHT_INPUT_MENU_CLICK, "/user/hand/right/input/menu/click"},
-    {INTERACTION_PROFILES_HTC_VIVE_PRO, "/interaction_profiles/htc/vive_pro"},
-    {INTERACTION_PROFILES_MICROSOFT_MOTION_CONTROLLER, "/interaction_profiles/microsoft/motion_controller"},
-    {USER_HAND_LEFT_INPUT_A_CLICK, "/user/hand/left/input/a/click"},
-    {INPUT_X_TOUCH, "/input/x/touch"},
-    {USER_HAND_LEFT_INPUT_THUMBSTICK, "/user/hand/left/input/thumbstick"},
-    {INPUT_TRACKPAD_FORCE, "/input/trackpad/force"},
-    {INPUT_THUMBSTICK_RIGHT, "/input/thumbstick_right"},
-    {INPUT_THUMBSTICK_CLICK, "/input/thumbstick/click"},
-    {USER_GAMEPAD_INPUT_DPAD_RIGHT_CLICK, "/user/gamepad/input/dpad_right/click"},
-    {INPUT_THUMBSTICK_LEFT, "/input/thumbstick_left"},
-    {USER_GAMEPAD, "/user/gamepad"},
-    {USER_HAND_LEFT_INPUT_TRACKPAD, "/user/hand/left/input/trackpad"},
-    {USER_HAND_RIGHT_INPUT_TRIGGER_CLICK, "/user/hand/right/input/trigger/click"},
-    {INPUT_DPAD_RIGHT_CLICK, "/input/dpad_right/click"},
-    {USER_HAND_RIGHT_INPUT_A_CLICK, "/user/hand/right/input/a/click"},
-    {INTERACTION_PROFILES_VALVE_INDEX_CONTROLLER, "/interaction_profiles/valve/index_controller"},
-    {INPUT_TRACKPAD, "/input/trackpad"},
-    {USER_GAMEPAD_INPUT_THUMBSTICK_RIGHT_CLICK, "/user/gamepad/input/thumbstick_right/click"},
-    {USER_HAND_RIGHT_INPUT_SYSTEM_TOUCH, "/user/hand/right/input/system/touch"},
-    {INPUT_SHOULDER_RIGHT_CLICK, "/input/shoulder_right/click"},
-    {USER_HAND_RIGHT_INPUT_AIM_POSE, "/user/hand/right/input/aim/pose"},
-    {USER_HAND_RIGHT_INPUT_B_CLICK, "/user/hand/right/input/b/click"},
-    {INPUT_TRACKPAD_TOUCH, "/input/trackpad/touch"},
-    {INPUT_DPAD_DOWN_CLICK, "/input/dpad_down/click"},
-    {INPUT_Y_CLICK, "/input/y/click"},
-    {OUTPUT_HAPTIC_RIGHT_TRIGGER, "/output/haptic_right_trigger"},
-    {INPUT_THUMBSTICK_RIGHT_CLICK, "/input/thumbstick_right/click"},
-    {INPUT_Y_TOUCH, "/input/y/touch"},
-    {USER_HAND_RIGHT_INPUT_SELECT_CLICK, "/user/hand/right/input/select/click"},
-    {USER_HEAD, "/user/head"},
-    {INPUT_SYSTEM_CLICK, "/input/system/click"},
-    {USER_HAND_RIGHT_INPUT_GRIP_POSE, "/user/hand/right/input/grip/pose"},
-    {USER_HAND_LEFT_INPUT_SYSTEM_TOUCH, "/user/hand/left/input/system/touch"},
-    {USER_HAND_LEFT_INPUT_B_TOUCH, "/user/hand/left/input/b/touch"},
-    {USER_GAMEPAD_INPUT_THUMBSTICK_RIGHT_Y, "/user/gamepad/input/thumbstick_right/y"},
-    {OUTPUT_HAPTIC_LEFT_TRIGGER, "/output/haptic_left_trigger"},
-    {OUTPUT_HAPTIC_LEFT, "/output/haptic_left"},
-    {INTERACTION_PROFILES_GOOGLE_DAYDREAM_CONTROLLER, "/interaction_profiles/google/daydream_controller"},
-    {USER_HAND_LEFT_INPUT_THUMBSTICK_Y, "/user/hand/left/input/thumbstick/y"},
-    {USER_HAND_RIGHT_INPUT_SYSTEM_CLICK, "/user/hand/right/input/system/click"},
-    {USER_HAND_LEFT_INPUT_TRACKPAD_X, "/user/hand/left/input/trackpad/x"},
-    {USER_HAND_RIGHT_INPUT_TRIGGER_VALUE, "/user/hand/right/input/trigger/value"},
-    {OUTPUT_HAPTIC_RIGHT, "/output/haptic_right"},
-    {INPUT_THUMBSTICK_TOUCH, "/input/thumbstick/touch"},
-    {USER_HAND_LEFT_INPUT_SQUEEZE_CLICK, "/user/hand/left/input/squeeze/click"},
-    {USER_GAMEPAD_INPUT_THUMBSTICK_RIGHT_X, "/user/gamepad/input/thumbstick_right/x"},
-    {USER_HAND_LEFT_INPUT_TRACKPAD_FORCE, "/user/hand/left/input/trackpad/force"},
-    {USER_HAND_RIGHT_INPUT_TRACKPAD_X, "/user/hand/right/input/trackpad/x"},
-    {INPUT_THUMBSTICK_Y, "/input/thumbstick/y"},
-    {USER_HEAD_INPUT_VOLUME_UP_CLICK, "/user/head/input/volume_up/click"},
-    {USER_GAMEPAD_OUTPUT_HAPTIC_RIGHT, "/user/gamepad/output/haptic_right"},
-    {USER_HAND_LEFT_INPUT_TRIGGER_VALUE, "/user/hand/left/input/trigger/value"},
-    {INTERACTION_PROFILES_MICROSOFT_XBOX_CONTROLLER, "/interaction_profiles/microsoft/xbox_controller"},
-    {USER_HAND_RIGHT_INPUT_TRACKPAD_Y, "/user/hand/right/input/trackpad/y"},
-    {USER_GAMEPAD_INPUT_Y_CLICK, "/user/gamepad/input/y/click"},
-    {USER_GAMEPAD_OUTPUT_HAPTIC_LEFT, "/user/gamepad/output/haptic_left"},
-    {USER_HAND_LEFT_INPUT_TRIGGER_TOUCH, "/user/hand/left/input/trigger/touch"},
-    {USER_HEAD_INPUT_MUTE_MIC_CLICK, "/user/head/input/mute_mic/click"},
-    {USER_GAMEPAD_INPUT_A_CLICK, "/user/gamepad/input/a/click"},
-    {USER_HAND_RIGHT_INPUT_THUMBSTICK, "/user/hand/right/input/thumbstick"},
-    {INPUT_BACK_CLICK, "/input/back/click"},
-    {INPUT_TRIGGER_TOUCH, "/input/trigger/touch"},
-    {INPUT_TRACKPAD_CLICK, "/input/trackpad/click"},
-    {USER_HAND_LEFT_INPUT_SELECT_CLICK, "/user/hand/left/input/select/click"},
-    {INPUT_THUMBSTICK_LEFT_Y, "/input/thumbstick_left/y"},
-    {INPUT_THUMBSTICK, "/input/thumbstick"},
-    {INPUT_DPAD_LEFT_CLICK, "/input/dpad_left/click"},
-    {USER_GAMEPAD_OUTPUT_HAPTIC_LEFT_TRIGGER, "/user/gamepad/output/haptic_left_trigger"},
-    {USER_HAND_RIGHT_INPUT_THUMBSTICK_CLICK, "/user/hand/right/input/thumbstick/click"},
-    {USER_GAMEPAD_INPUT_B_CLICK, "/user/gamepad/input/b/click"},
-    {INPUT_VIEW_CLICK, "/input/view/click"},
-    {INPUT_B_CLICK, "/input/b/click"},
-    {USER_GAMEPAD_INPUT_VIEW_CLICK, "/user/gamepad/input/view/click"},
-    {USER_GAMEPAD_INPUT_DPAD_DOWN_CLICK, "/user/gamepad/input/dpad_down/click"},
-    {USER_HAND_RIGHT_INPUT_B_TOUCH, "/user/hand/right/input/b/touch"},
-    {USER_HAND_RIGHT_INPUT_TRIGGER_TOUCH, "/user/hand/right/input/trigger/touch"},
-    {INPUT_DPAD_UP_CLICK, "/input/dpad_up/click"},
-    {USER_HAND_RIGHT_INPUT_SQUEEZE_CLICK, "/user/hand/right/input/squeeze/click"},
-    {USER_GAMEPAD_INPUT_TRIGGER_LEFT_VALUE, "/user/gamepad/input/trigger_left/value"},
-    {INTERACTION_PROFILES_HP_MIXED_REALITY_CONTROLLER, "/interaction_profiles/hp/mixed_reality_controller"},
-    {INPUT_TRACKPAD_Y, "/input/trackpad/y"},
-    {INPUT_SQUEEZE_FORCE, "/input/squeeze/force"},
-    {USER_HAND_RIGHT_INPUT_TRACKPAD_TOUCH, "/user/hand/right/input/trackpad/touch"},
-    {USER_HAND_LEFT_INPUT_THUMBREST_TOUCH, "/user/hand/left/input/thumbrest/touch"},
-    {USER_HAND_LEFT_INPUT_X_TOUCH, "/user/hand/left/input/x/touch"},
-    {INPUT_MENU_CLICK, "/input/menu/click"},
-    {USER_HAND_RIGHT_INPUT_A_TOUCH, "/user/hand/right/input/a/touch"},
-    {USER_HAND_RIGHT_INPUT_TRACKPAD_FORCE, "/user/hand/right/input/trackpad/force"},
-    {USER_HAND_LEFT_INPUT_SYSTEM_CLICK, "/user/hand/left/input/system/click"},
-    {USER_HAND_LEFT_INPUT_MENU_CLICK, "/user/hand/left/input/menu/click"},
-    {USER_GAMEPAD_INPUT_X_CLICK, "/user/gamepad/input/x/click"},
-    {USER_HAND_RIGHT_INPUT_SQUEEZE_FORCE, "/user/hand/right/input/squeeze/force"},
-    {USER_HAND_LEFT_INPUT_SQUEEZE_FORCE, "/user/hand/left/input/squeeze/force"},
-    {INPUT_SYSTEM_TOUCH, "/input/system/touch"},
-    {USER_HAND_RIGHT_INPUT_SQUEEZE_VALUE, "/user/hand/right/input/squeeze/value"},
-    {USER_HAND_LEFT_INPUT_THUMBSTICK_CLICK, "/user/hand/left/input/thumbstick/click"},
-    {INPUT_TRIGGER_RIGHT_VALUE, "/input/trigger_right/value"},
-    {USER_HAND_LEFT_INPUT_BACK_CLICK, "/user/hand/left/input/back/click"},
-    {USER_GAMEPAD_INPUT_THUMBSTICK_LEFT_CLICK, "/user/gamepad/input/thumbstick_left/click"},
-    {USER_HAND_RIGHT, "/user/hand/right"},
-    {USER_HAND_LEFT_INPUT_TRACKPAD_CLICK, "/user/hand/left/input/trackpad/click"},
-    {USER_HAND_LEFT, "/user/hand/left"},
-    {INPUT_A_CLICK, "/input/a/click"},
-    {INPUT_THUMBSTICK_LEFT_CLICK, "/input/thumbstick_left/click"},
-    {USER_GAMEPAD_INPUT_DPAD_UP_CLICK, "/user/gamepad/input/dpad_up/click"},
-    {INPUT_GRIP_POSE, "/input/grip/pose"},
-    {USER_HAND_RIGHT_INPUT_THUMBSTICK_Y, "/user/hand/right/input/thumbstick/y"},
-    {INPUT_SQUEEZE_VALUE, "/input/squeeze/value"},
-    {USER_HAND_LEFT_INPUT_X_CLICK, "/user/hand/left/input/x/click"},
-    {USER_HAND_LEFT_INPUT_TRACKPAD_TOUCH, "/user/hand/left/input/trackpad/touch"},
-    {USER_HAND_LEFT_INPUT_THUMBSTICK_X, "/user/hand/left/input/thumbstick/x"},
-    {INPUT_MUTE_MIC_CLICK, "/input/mute_mic/click"},
-    {USER_HEAD_INPUT_SYSTEM_CLICK, "/user/head/input/system/click"},
-    {USER_GAMEPAD_INPUT_THUMBSTICK_RIGHT, "/user/gamepad/input/thumbstick_right"},
-    {USER_GAMEPAD_OUTPUT_HAPTIC_RIGHT_TRIGGER, "/user/gamepad/output/haptic_right_trigger"},
-    {USER_HAND_LEFT_INPUT_TRIGGER_CLICK, "/user/hand/left/input/trigger/click"},
-    {INPUT_THUMBSTICK_LEFT_X, "/input/thumbstick_left/x"},
-    {INPUT_TRACKPAD_X, "/input/trackpad/x"},
-    {USER_HAND_LEFT_INPUT_TRACKPAD_Y, "/user/hand/left/input/trackpad/y"},
-    {USER_GAMEPAD_INPUT_TRIGGER_RIGHT_VALUE, "/user/gamepad/input/trigger_right/value"},
-    {USER_HAND_RIGHT_INPUT_TRACKPAD, "/user/hand/right/input/trackpad"},
-    {OUTPUT_HAPTIC, "/output/haptic"},
-    {INPUT_THUMBSTICK_X, "/input/thumbstick/x"},
-    {USER_HAND_LEFT_OUTPUT_HAPTIC, "/user/hand/left/output/haptic"},
-    {USER_GAMEPAD_INPUT_MENU_CLICK, "/user/gamepad/input/menu/click"},
-    {USER_HAND_RIGHT_INPUT_THUMBSTICK_TOUCH, "/user/hand/right/input/thumbstick/touch"},
-    {INPUT_SQUEEZE_CLICK, "/input/squeeze/click"},
-    {INPUT_X_CLICK, "/input/x/click"},
-    {INPUT_TRIGGER_VALUE, "/input/trigger/value"},
-    {USER_GAMEPAD_INPUT_THUMBSTICK_LEFT_X, "/user/gamepad/input/thumbstick_left/x"},
-    {USER_HAND_LEFT_INPUT_THUMBSTICK_TOUCH, "/user/hand/left/input/thumbstick/touch"},
-    {USER_HAND_RIGHT_INPUT_THUMBREST_TOUCH, "/user/hand/right/input/thumbrest/touch"},
-    {USER_HAND_RIGHT_OUTPUT_HAPTIC, "/user/hand/right/output/haptic"},
-    {INPUT_THUMBSTICK_RIGHT_X, "/input/thumbstick_right/x"},
-    {USER_HAND_LEFT_INPUT_A_TOUCH, "/user/hand/left/input/a/touch"},
-    {INPUT_THUMBREST_TOUCH, "/input/thumbrest/touch"},
-    {USER_GAMEPAD_INPUT_SHOULDER_LEFT_CLICK, "/user/gamepad/input/shoulder_left/click"},
-    {INPUT_SHOULDER_LEFT_CLICK, "/input/shoulder_left/click"},
-    {INPUT_VOLUME_UP_CLICK, "/input/volume_up/click"},
-    {INPUT_TRIGGER_LEFT_VALUE, "/input/trigger_left/value"},
-    {INPUT_A_TOUCH, "/input/a/touch"},
-    {INPUT_VOLUME_DOWN_CLICK, "/input/volume_down/click"},
-    {USER_HEAD_INPUT_VOLUME_DOWN_CLICK, "/user/head/input/volume_down/click"},
-    {USER_HAND_RIGHT_INPUT_BACK_CLICK, "/user/hand/right/input/back/click"},
-    {USER_HAND_LEFT_INPUT_AIM_POSE, "/user/hand/left/input/aim/pose"},
-    {INPUT_THUMBSTICK_RIGHT_Y, "/input/thumbstick_right/y"},
-    {INTERACTION_PROFILES_OCULUS_TOUCH_CONTROLLER, "/interaction_profiles/oculus/touch_controller"},
-    {USER_GAMEPAD_INPUT_DPAD_LEFT_CLICK, "/user/gamepad/input/dpad_left/click"},
-    {USER_GAMEPAD_INPUT_THUMBSTICK_LEFT, "/user/gamepad/input/thumbstick_left"},
-    {USER_HAND_RIGHT_INPUT_THUMBSTICK_X, "/user/hand/right/input/thumbstick/x"},
-    {INPUT_TRIGGER_CLICK, "/input/trigger/click"},
-    {INTERACTION_PROFILES_KHR_SIMPLE_CONTROLLER, "/interaction_profiles/khr/simple_controller"},
-    {INPUT_AIM_POSE, "/input/aim/pose"},
-    {USER_HAND_LEFT_INPUT_B_CLICK, "/user/hand/left/input/b/click"},
-    {USER_HAND_LEFT_INPUT_SQUEEZE_VALUE, "/user/hand/left/input/squeeze/value"},
-    {USER_GAMEPAD_INPUT_SHOULDER_RIGHT_CLICK, "/user/gamepad/input/shoulder_right/click"},
-
-};
-
-
-
-
-struct PlaceholderActionId
-{
-    std::string name;
-    XrActionType type;
-    WellKnownStringIndex interactionProfileString;
-    WellKnownStringIndex subActionString;
-    WellKnownStringIndex componentString;
-    WellKnownStringIndex fullBindingString;
-};
-
-std::vector<PlaceholderActionId> PlaceholderActionIds =
-{
-    {"/interaction_profiles/khr/simple_controller/user/hand/left/input/aim/pose", XR_ACTION_TYPE_POSE_INPUT, INTERACTION_PROFILES_KHR_SIMPLE_CONTROLLER, USER_HAND_LEFT, INPUT_AIM_POSE, USER_HAND_LEFT_INPUT_AIM_POSE},
-    {"/interaction_profiles/khr/simple_controller/user/hand/left/input/select/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_KHR_SIMPLE_CONTROLLER, USER_HAND_LEFT, INPUT_SELECT_CLICK, USER_HAND_LEFT_INPUT_SELECT_CLICK},
-    {"/interaction_profiles/khr/simple_controller/user/hand/left/input/menu/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_KHR_SIMPLE_CONTROLLER, USER_HAND_LEFT, INPUT_MENU_CLICK, USER_HAND_LEFT_INPUT_MENU_CLICK},
-    {"/interaction_profiles/khr/simple_controller/user/hand/left/output/haptic", XR_ACTION_TYPE_VIBRATION_OUTPUT, INTERACTION_PROFILES_KHR_SIMPLE_CONTROLLER, USER_HAND_LEFT, OUTPUT_HAPTIC, USER_HAND_LEFT_OUTPUT_HAPTIC},
-    {"/interaction_profiles/khr/simple_controller/user/hand/left/input/grip/pose", XR_ACTION_TYPE_POSE_INPUT, INTERACTION_PROFILES_KHR_SIMPLE_CONTROLLER, USER_HAND_LEFT, INPUT_GRIP_POSE, USER_HAND_LEFT_INPUT_GRIP_POSE},
-    {"/interaction_profiles/khr/simple_controller/user/hand/right/input/aim/pose", XR_ACTION_TYPE_POSE_INPUT, INTERACTION_PROFILES_KHR_SIMPLE_CONTROLLER, USER_HAND_RIGHT, INPUT_AIM_POSE, USER_HAND_RIGHT_INPUT_AIM_POSE},
-    {"/interaction_profiles/khr/simple_controller/user/hand/right/input/select/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_KHR_SIMPLE_CONTROLLER, USER_HAND_RIGHT, INPUT_SELECT_CLICK, USER_HAND_RIGHT_INPUT_SELECT_CLICK},
-    {"/interaction_profiles/khr/simple_controller/user/hand/right/input/menu/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_KHR_SIMPLE_CONTROLLER, USER_HAND_RIGHT, INPUT_MENU_CLICK, USER_HAND_RIGHT_INPUT_MENU_CLICK},
-    {"/interaction_profiles/khr/simple_controller/user/hand/right/output/haptic", XR_ACTION_TYPE_VIBRATION_OUTPUT, INTERACTION_PROFILES_KHR_SIMPLE_CONTROLLER, USER_HAND_RIGHT, OUTPUT_HAPTIC, USER_HAND_RIGHT_OUTPUT_HAPTIC},
-    {"/interaction_profiles/khr/simple_controller/user/hand/right/input/grip/pose", XR_ACTION_TYPE_POSE_INPUT, INTERACTION_PROFILES_KHR_SIMPLE_CONTROLLER, USER_HAND_RIGHT, INPUT_GRIP_POSE, USER_HAND_RIGHT_INPUT_GRIP_POSE},
-    {"/interaction_profiles/google/daydream_controller/user/hand/left/input/trackpad/x", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_GOOGLE_DAYDREAM_CONTROLLER, USER_HAND_LEFT, INPUT_TRACKPAD_X, USER_HAND_LEFT_INPUT_TRACKPAD_X},
-    {"/interaction_profiles/google/daydream_controller/user/hand/left/input/trackpad", XR_ACTION_TYPE_VECTOR2F_INPUT, INTERACTION_PROFILES_GOOGLE_DAYDREAM_CONTROLLER, USER_HAND_LEFT, INPUT_TRACKPAD, USER_HAND_LEFT_INPUT_TRACKPAD},
-    {"/interaction_profiles/google/daydream_controller/user/hand/left/input/trackpad/y", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_GOOGLE_DAYDREAM_CONTROLLER, USER_HAND_LEFT, INPUT_TRACKPAD_Y, USER_HAND_LEFT_INPUT_TRACKPAD_Y},
-    {"/interaction_profiles/google/daydream_controller/user/hand/left/input/aim/pose", XR_ACTION_TYPE_POSE_INPUT, INTERACTION_PROFILES_GOOGLE_DAYDREAM_CONTROLLER, USER_HAND_LEFT, INPUT_AIM_POSE, USER_HAND_LEFT_INPUT_AIM_POSE},
-    {"/interaction_profiles/google/daydream_controller/user/hand/left/input/trackpad/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_GOOGLE_DAYDREAM_CONTROLLER, USER_HAND_LEFT, INPUT_TRACKPAD_CLICK, USER_HAND_LEFT_INPUT_TRACKPAD_CLICK},
-    {"/interaction_profiles/google/daydream_controller/user/hand/left/input/grip/pose", XR_ACTION_TYPE_POSE_INPUT, INTERACTION_PROFILES_GOOGLE_DAYDREAM_CONTROLLER, USER_HAND_LEFT, INPUT_GRIP_POSE, USER_HAND_LEFT_INPUT_GRIP_POSE},
-    {"/interaction_profiles/google/daydream_controller/user/hand/left/input/select/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_GOOGLE_DAYDREAM_CONTROLLER, USER_HAND_LEFT, INPUT_SELECT_CLICK, USER_HAND_LEFT_INPUT_SELECT_CLICK},
-    {"/interaction_profiles/google/daydream_controller/user/hand/left/input/trackpad/touch", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_GOOGLE_DAYDREAM_CONTROLLER, USER_HAND_LEFT, INPUT_TRACKPAD_TOUCH, USER_HAND_LEFT_INPUT_TRACKPAD_TOUCH},
-    {"/interaction_profiles/google/daydream_controller/user/hand/right/input/trackpad/x", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_GOOGLE_DAYDREAM_CONTROLLER, USER_HAND_RIGHT, INPUT_TRACKPAD_X, USER_HAND_RIGHT_INPUT_TRACKPAD_X},
-    {"/interaction_profiles/google/daydream_controller/user/hand/right/input/trackpad", XR_ACTION_TYPE_VECTOR2F_INPUT, INTERACTION_PROFILES_GOOGLE_DAYDREAM_CONTROLLER, USER_HAND_RIGHT, INPUT_TRACKPAD, USER_HAND_RIGHT_INPUT_TRACKPAD},
-    {"/interaction_profiles/google/daydream_controller/user/hand/right/input/trackpad/y", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_GOOGLE_DAYDREAM_CONTROLLER, USER_HAND_RIGHT, INPUT_TRACKPAD_Y, USER_HAND_RIGHT_INPUT_TRACKPAD_Y},
-    {"/interaction_profiles/google/daydream_controller/user/hand/right/input/aim/pose", XR_ACTION_TYPE_POSE_INPUT, INTERACTION_PROFILES_GOOGLE_DAYDREAM_CONTROLLER, USER_HAND_RIGHT, INPUT_AIM_POSE, USER_HAND_RIGHT_INPUT_AIM_POSE},
-    {"/interaction_profiles/google/daydream_controller/user/hand/right/input/trackpad/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_GOOGLE_DAYDREAM_CONTROLLER, USER_HAND_RIGHT, INPUT_TRACKPAD_CLICK, USER_HAND_RIGHT_INPUT_TRACKPAD_CLICK},
-    {"/interaction_profiles/google/daydream_controller/user/hand/right/input/grip/pose", XR_ACTION_TYPE_POSE_INPUT, INTERACTION_PROFILES_GOOGLE_DAYDREAM_CONTROLLER, USER_HAND_RIGHT, INPUT_GRIP_POSE, USER_HAND_RIGHT_INPUT_GRIP_POSE},
-    {"/interaction_profiles/google/daydream_controller/user/hand/right/input/select/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_GOOGLE_DAYDREAM_CONTROLLER, USER_HAND_RIGHT, INPUT_SELECT_CLICK, USER_HAND_RIGHT_INPUT_SELECT_CLICK},
-    {"/interaction_profiles/google/daydream_controller/user/hand/right/input/trackpad/touch", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_GOOGLE_DAYDREAM_CONTROLLER, USER_HAND_RIGHT, INPUT_TRACKPAD_TOUCH, USER_HAND_RIGHT_INPUT_TRACKPAD_TOUCH},
-    {"/interaction_profiles/htc/vive_controller/user/hand/left/input/trackpad/x", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_HTC_VIVE_CONTROLLER, USER_HAND_LEFT, INPUT_TRACKPAD_X, USER_HAND_LEFT_INPUT_TRACKPAD_X},
-    {"/interaction_profiles/htc/vive_controller/user/hand/left/input/trackpad", XR_ACTION_TYPE_VECTOR2F_INPUT, INTERACTION_PROFILES_HTC_VIVE_CONTROLLER, USER_HAND_LEFT, INPUT_TRACKPAD, USER_HAND_LEFT_INPUT_TRACKPAD},
-    {"/interaction_profiles/htc/vive_controller/user/hand/left/input/system/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_HTC_VIVE_CONTROLLER, USER_HAND_LEFT, INPUT_SYSTEM_CLICK, USER_HAND_LEFT_INPUT_SYSTEM_CLICK},
-    {"/interaction_profiles/htc/vive_controller/user/hand/left/input/trigger/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_HTC_VIVE_CONTROLLER, USER_HAND_LEFT, INPUT_TRIGGER_CLICK, USER_HAND_LEFT_INPUT_TRIGGER_CLICK},
-    {"/interaction_profiles/htc/vive_controller/user/hand/left/input/trackpad/y", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_HTC_VIVE_CONTROLLER, USER_HAND_LEFT, INPUT_TRACKPAD_Y, USER_HAND_LEFT_INPUT_TRACKPAD_Y},
-    {"/interaction_profiles/htc/vive_controller/user/hand/left/input/aim/pose", XR_ACTION_TYPE_POSE_INPUT, INTERACTION_PROFILES_HTC_VIVE_CONTROLLER, USER_HAND_LEFT, INPUT_AIM_POSE, USER_HAND_LEFT_INPUT_AIM_POSE},
-    {"/interaction_profiles/htc/vive_controller/user/hand/left/input/trackpad/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_HTC_VIVE_CONTROLLER, USER_HAND_LEFT, INPUT_TRACKPAD_CLICK, USER_HAND_LEFT_INPUT_TRACKPAD_CLICK},
-    {"/interaction_profiles/htc/vive_controller/user/hand/left/input/grip/pose", XR_ACTION_TYPE_POSE_INPUT, INTERACTION_PROFILES_HTC_VIVE_CONTROLLER, USER_HAND_LEFT, INPUT_GRIP_POSE, USER_HAND_LEFT_INPUT_GRIP_POSE},
-    {"/interaction_profiles/htc/vive_controller/user/hand/left/input/menu/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_HTC_VIVE_CONTROLLER, USER_HAND_LEFT, INPUT_MENU_CLICK, USER_HAND_LEFT_INPUT_MENU_CLICK},
-    {"/interaction_profiles/htc/vive_controller/user/hand/left/output/haptic", XR_ACTION_TYPE_VIBRATION_OUTPUT, INTERACTION_PROFILES_HTC_VIVE_CONTROLLER, USER_HAND_LEFT, OUTPUT_HAPTIC, USER_HAND_LEFT_OUTPUT_HAPTIC},
-    {"/interaction_profiles/htc/vive_controller/user/hand/left/input/trackpad/touch", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_HTC_VIVE_CONTROLLER, USER_HAND_LEFT, INPUT_TRACKPAD_TOUCH, USER_HAND_LEFT_INPUT_TRACKPAD_TOUCH},
-    {"/interaction_profiles/htc/vive_controller/user/hand/left/input/squeeze/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_HTC_VIVE_CONTROLLER, USER_HAND_LEFT, INPUT_SQUEEZE_CLICK, USER_HAND_LEFT_INPUT_SQUEEZE_CLICK},
-    {"/interaction_profiles/htc/vive_controller/user/hand/left/input/trigger/value", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_HTC_VIVE_CONTROLLER, USER_HAND_LEFT, INPUT_TRIGGER_VALUE, USER_HAND_LEFT_INPUT_TRIGGER_VALUE},
-    {"/interaction_profiles/htc/vive_controller/user/hand/right/input/trackpad/x", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_HTC_VIVE_CONTROLLER, USER_HAND_RIGHT, INPUT_TRACKPAD_X, USER_HAND_RIGHT_INPUT_TRACKPAD_X},
-    {"/interaction_profiles/htc/vive_controller/user/hand/right/input/trackpad", XR_ACTION_TYPE_VECTOR2F_INPUT, INTERACTION_PROFILES_HTC_VIVE_CONTROLLER, USER_HAND_RIGHT, INPUT_TRACKPAD, USER_HAND_RIGHT_INPUT_TRACKPAD},
-    {"/interaction_profiles/htc/vive_controller/user/hand/right/input/system/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_HTC_VIVE_CONTROLLER, USER_HAND_RIGHT, INPUT_SYSTEM_CLICK, USER_HAND_RIGHT_INPUT_SYSTEM_CLICK},
-    {"/interaction_profiles/htc/vive_controller/user/hand/right/input/trigger/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_HTC_VIVE_CONTROLLER, USER_HAND_RIGHT, INPUT_TRIGGER_CLICK, USER_HAND_RIGHT_INPUT_TRIGGER_CLICK},
-    {"/interaction_profiles/htc/vive_controller/user/hand/right/input/trackpad/y", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_HTC_VIVE_CONTROLLER, USER_HAND_RIGHT, INPUT_TRACKPAD_Y, USER_HAND_RIGHT_INPUT_TRACKPAD_Y},
-    {"/interaction_profiles/htc/vive_controller/user/hand/right/input/aim/pose", XR_ACTION_TYPE_POSE_INPUT, INTERACTION_PROFILES_HTC_VIVE_CONTROLLER, USER_HAND_RIGHT, INPUT_AIM_POSE, USER_HAND_RIGHT_INPUT_AIM_POSE},
-    {"/interaction_profiles/htc/vive_controller/user/hand/right/input/trackpad/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_HTC_VIVE_CONTROLLER, USER_HAND_RIGHT, INPUT_TRACKPAD_CLICK, USER_HAND_RIGHT_INPUT_TRACKPAD_CLICK},
-    {"/interaction_profiles/htc/vive_controller/user/hand/right/input/grip/pose", XR_ACTION_TYPE_POSE_INPUT, INTERACTION_PROFILES_HTC_VIVE_CONTROLLER, USER_HAND_RIGHT, INPUT_GRIP_POSE, USER_HAND_RIGHT_INPUT_GRIP_POSE},
-    {"/interaction_profiles/htc/vive_controller/user/hand/right/input/menu/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_HTC_VIVE_CONTROLLER, USER_HAND_RIGHT, INPUT_MENU_CLICK, USER_HAND_RIGHT_INPUT_MENU_CLICK},
-    {"/interaction_profiles/htc/vive_controller/user/hand/right/output/haptic", XR_ACTION_TYPE_VIBRATION_OUTPUT, INTERACTION_PROFILES_HTC_VIVE_CONTROLLER, USER_HAND_RIGHT, OUTPUT_HAPTIC, USER_HAND_RIGHT_OUTPUT_HAPTIC},
-    {"/interaction_profiles/htc/vive_controller/user/hand/right/input/trackpad/touch", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_HTC_VIVE_CONTROLLER, USER_HAND_RIGHT, INPUT_TRACKPAD_TOUCH, USER_HAND_RIGHT_INPUT_TRACKPAD_TOUCH},
-    {"/interaction_profiles/htc/vive_controller/user/hand/right/input/squeeze/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_HTC_VIVE_CONTROLLER, USER_HAND_RIGHT, INPUT_SQUEEZE_CLICK, USER_HAND_RIGHT_INPUT_SQUEEZE_CLICK},
-    {"/interaction_profiles/htc/vive_controller/user/hand/right/input/trigger/value", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_HTC_VIVE_CONTROLLER, USER_HAND_RIGHT, INPUT_TRIGGER_VALUE, USER_HAND_RIGHT_INPUT_TRIGGER_VALUE},
-    {"/interaction_profiles/htc/vive_pro/user/head/input/system/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_HTC_VIVE_PRO, USER_HEAD, INPUT_SYSTEM_CLICK, USER_HEAD_INPUT_SYSTEM_CLICK},
-    {"/interaction_profiles/htc/vive_pro/user/head/input/volume_up/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_HTC_VIVE_PRO, USER_HEAD, INPUT_VOLUME_UP_CLICK, USER_HEAD_INPUT_VOLUME_UP_CLICK},
-    {"/interaction_profiles/htc/vive_pro/user/head/input/volume_down/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_HTC_VIVE_PRO, USER_HEAD, INPUT_VOLUME_DOWN_CLICK, USER_HEAD_INPUT_VOLUME_DOWN_CLICK},
-    {"/interaction_profiles/htc/vive_pro/user/head/input/mute_mic/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_HTC_VIVE_PRO, USER_HEAD, INPUT_MUTE_MIC_CLICK, USER_HEAD_INPUT_MUTE_MIC_CLICK},
-    {"/interaction_profiles/microsoft/motion_controller/user/hand/left/input/trackpad/x", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_MICROSOFT_MOTION_CONTROLLER, USER_HAND_LEFT, INPUT_TRACKPAD_X, USER_HAND_LEFT_INPUT_TRACKPAD_X},
-    {"/interaction_profiles/microsoft/motion_controller/user/hand/left/input/trackpad", XR_ACTION_TYPE_VECTOR2F_INPUT, INTERACTION_PROFILES_MICROSOFT_MOTION_CONTROLLER, USER_HAND_LEFT, INPUT_TRACKPAD, USER_HAND_LEFT_INPUT_TRACKPAD},
-    {"/interaction_profiles/microsoft/motion_controller/user/hand/left/input/thumbstick/y", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_MICROSOFT_MOTION_CONTROLLER, USER_HAND_LEFT, INPUT_THUMBSTICK_Y, USER_HAND_LEFT_INPUT_THUMBSTICK_Y},
-    {"/interaction_profiles/microsoft/motion_controller/user/hand/left/input/trackpad/y", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_MICROSOFT_MOTION_CONTROLLER, USER_HAND_LEFT, INPUT_TRACKPAD_Y, USER_HAND_LEFT_INPUT_TRACKPAD_Y},
-    {"/interaction_profiles/microsoft/motion_controller/user/hand/left/input/aim/pose", XR_ACTION_TYPE_POSE_INPUT, INTERACTION_PROFILES_MICROSOFT_MOTION_CONTROLLER, USER_HAND_LEFT, INPUT_AIM_POSE, USER_HAND_LEFT_INPUT_AIM_POSE},
-    {"/interaction_profiles/microsoft/motion_controller/user/hand/left/input/trackpad/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_MICROSOFT_MOTION_CONTROLLER, USER_HAND_LEFT, INPUT_TRACKPAD_CLICK, USER_HAND_LEFT_INPUT_TRACKPAD_CLICK},
-    {"/interaction_profiles/microsoft/motion_controller/user/hand/left/input/thumbstick/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_MICROSOFT_MOTION_CONTROLLER, USER_HAND_LEFT, INPUT_THUMBSTICK_CLICK, USER_HAND_LEFT_INPUT_THUMBSTICK_CLICK},
-    {"/interaction_profiles/microsoft/motion_controller/user/hand/left/input/grip/pose", XR_ACTION_TYPE_POSE_INPUT, INTERACTION_PROFILES_MICROSOFT_MOTION_CONTROLLER, USER_HAND_LEFT, INPUT_GRIP_POSE, USER_HAND_LEFT_INPUT_GRIP_POSE},
-    {"/interaction_profiles/microsoft/motion_controller/user/hand/left/input/menu/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_MICROSOFT_MOTION_CONTROLLER, USER_HAND_LEFT, INPUT_MENU_CLICK, USER_HAND_LEFT_INPUT_MENU_CLICK},
-    {"/interaction_profiles/microsoft/motion_controller/user/hand/left/output/haptic", XR_ACTION_TYPE_VIBRATION_OUTPUT, INTERACTION_PROFILES_MICROSOFT_MOTION_CONTROLLER, USER_HAND_LEFT, OUTPUT_HAPTIC, USER_HAND_LEFT_OUTPUT_HAPTIC},
-    {"/interaction_profiles/microsoft/motion_controller/user/hand/left/input/trackpad/touch", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_MICROSOFT_MOTION_CONTROLLER, USER_HAND_LEFT, INPUT_TRACKPAD_TOUCH, USER_HAND_LEFT_INPUT_TRACKPAD_TOUCH},
-    {"/interaction_profiles/microsoft/motion_controller/user/hand/left/input/thumbstick/x", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_MICROSOFT_MOTION_CONTROLLER, USER_HAND_LEFT, INPUT_THUMBSTICK_X, USER_HAND_LEFT_INPUT_THUMBSTICK_X},
-    {"/interaction_profiles/microsoft/motion_controller/user/hand/left/input/thumbstick", XR_ACTION_TYPE_VECTOR2F_INPUT, INTERACTION_PROFILES_MICROSOFT_MOTION_CONTROLLER, USER_HAND_LEFT, INPUT_THUMBSTICK, USER_HAND_LEFT_INPUT_THUMBSTICK},
-    {"/interaction_profiles/microsoft/motion_controller/user/hand/left/input/squeeze/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_MICROSOFT_MOTION_CONTROLLER, USER_HAND_LEFT, INPUT_SQUEEZE_CLICK, USER_HAND_LEFT_INPUT_SQUEEZE_CLICK},
-    {"/interaction_profiles/microsoft/motion_controller/user/hand/left/input/trigger/value", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_MICROSOFT_MOTION_CONTROLLER, USER_HAND_LEFT, INPUT_TRIGGER_VALUE, USER_HAND_LEFT_INPUT_TRIGGER_VALUE},
-    {"/interaction_profiles/microsoft/motion_controller/user/hand/right/input/trackpad/x", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_MICROSOFT_MOTION_CONTROLLER, USER_HAND_RIGHT, INPUT_TRACKPAD_X, USER_HAND_RIGHT_INPUT_TRACKPAD_X},
-    {"/interaction_profiles/microsoft/motion_controller/user/hand/right/input/trackpad", XR_ACTION_TYPE_VECTOR2F_INPUT, INTERACTION_PROFILES_MICROSOFT_MOTION_CONTROLLER, USER_HAND_RIGHT, INPUT_TRACKPAD, USER_HAND_RIGHT_INPUT_TRACKPAD},
-    {"/interaction_profiles/microsoft/motion_controller/user/hand/right/input/thumbstick/y", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_MICROSOFT_MOTION_CONTROLLER, USER_HAND_RIGHT, INPUT_THUMBSTICK_Y, USER_HAND_RIGHT_INPUT_THUMBSTICK_Y},
-    {"/interaction_profiles/microsoft/motion_controller/user/hand/right/input/trackpad/y", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_MICROSOFT_MOTION_CONTROLLER, USER_HAND_RIGHT, INPUT_TRACKPAD_Y, USER_HAND_RIGHT_INPUT_TRACKPAD_Y},
-    {"/interaction_profiles/microsoft/motion_controller/user/hand/right/input/aim/pose", XR_ACTION_TYPE_POSE_INPUT, INTERACTION_PROFILES_MICROSOFT_MOTION_CONTROLLER, USER_HAND_RIGHT, INPUT_AIM_POSE, USER_HAND_RIGHT_INPUT_AIM_POSE},
-    {"/interaction_profiles/microsoft/motion_controller/user/hand/right/input/trackpad/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_MICROSOFT_MOTION_CONTROLLER, USER_HAND_RIGHT, INPUT_TRACKPAD_CLICK, USER_HAND_RIGHT_INPUT_TRACKPAD_CLICK},
-    {"/interaction_profiles/microsoft/motion_controller/user/hand/right/input/thumbstick/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_MICROSOFT_MOTION_CONTROLLER, USER_HAND_RIGHT, INPUT_THUMBSTICK_CLICK, USER_HAND_RIGHT_INPUT_THUMBSTICK_CLICK},
-    {"/interaction_profiles/microsoft/motion_controller/user/hand/right/input/grip/pose", XR_ACTION_TYPE_POSE_INPUT, INTERACTION_PROFILES_MICROSOFT_MOTION_CONTROLLER, USER_HAND_RIGHT, INPUT_GRIP_POSE, USER_HAND_RIGHT_INPUT_GRIP_POSE},
-    {"/interaction_profiles/microsoft/motion_controller/user/hand/right/input/menu/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_MICROSOFT_MOTION_CONTROLLER, USER_HAND_RIGHT, INPUT_MENU_CLICK, USER_HAND_RIGHT_INPUT_MENU_CLICK},
-    {"/interaction_profiles/microsoft/motion_controller/user/hand/right/output/haptic", XR_ACTION_TYPE_VIBRATION_OUTPUT, INTERACTION_PROFILES_MICROSOFT_MOTION_CONTROLLER, USER_HAND_RIGHT, OUTPUT_HAPTIC, USER_HAND_RIGHT_OUTPUT_HAPTIC},
-    {"/interaction_profiles/microsoft/motion_controller/user/hand/right/input/trackpad/touch", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_MICROSOFT_MOTION_CONTROLLER, USER_HAND_RIGHT, INPUT_TRACKPAD_TOUCH, USER_HAND_RIGHT_INPUT_TRACKPAD_TOUCH},
-    {"/interaction_profiles/microsoft/motion_controller/user/hand/right/input/thumbstick/x", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_MICROSOFT_MOTION_CONTROLLER, USER_HAND_RIGHT, INPUT_THUMBSTICK_X, USER_HAND_RIGHT_INPUT_THUMBSTICK_X},
-    {"/interaction_profiles/microsoft/motion_controller/user/hand/right/input/thumbstick", XR_ACTION_TYPE_VECTOR2F_INPUT, INTERACTION_PROFILES_MICROSOFT_MOTION_CONTROLLER, USER_HAND_RIGHT, INPUT_THUMBSTICK, USER_HAND_RIGHT_INPUT_THUMBSTICK},
-    {"/interaction_profiles/microsoft/motion_controller/user/hand/right/input/squeeze/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_MICROSOFT_MOTION_CONTROLLER, USER_HAND_RIGHT, INPUT_SQUEEZE_CLICK, USER_HAND_RIGHT_INPUT_SQUEEZE_CLICK},
-    {"/interaction_profiles/microsoft/motion_controller/user/hand/right/input/trigger/value", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_MICROSOFT_MOTION_CONTROLLER, USER_HAND_RIGHT, INPUT_TRIGGER_VALUE, USER_HAND_RIGHT_INPUT_TRIGGER_VALUE},
-    {"/interaction_profiles/microsoft/xbox_controller/user/gamepad/output/haptic_right", XR_ACTION_TYPE_VIBRATION_OUTPUT, INTERACTION_PROFILES_MICROSOFT_XBOX_CONTROLLER, USER_GAMEPAD, OUTPUT_HAPTIC_RIGHT, USER_GAMEPAD_OUTPUT_HAPTIC_RIGHT},
-    {"/interaction_profiles/microsoft/xbox_controller/user/gamepad/input/menu/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_MICROSOFT_XBOX_CONTROLLER, USER_GAMEPAD, INPUT_MENU_CLICK, USER_GAMEPAD_INPUT_MENU_CLICK},
-    {"/interaction_profiles/microsoft/xbox_controller/user/gamepad/input/x/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_MICROSOFT_XBOX_CONTROLLER, USER_GAMEPAD, INPUT_X_CLICK, USER_GAMEPAD_INPUT_X_CLICK},
-    {"/interaction_profiles/microsoft/xbox_controller/user/gamepad/input/thumbstick_right/x", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_MICROSOFT_XBOX_CONTROLLER, USER_GAMEPAD, INPUT_THUMBSTICK_RIGHT_X, USER_GAMEPAD_INPUT_THUMBSTICK_RIGHT_X},
-    {"/interaction_profiles/microsoft/xbox_controller/user/gamepad/input/thumbstick_right", XR_ACTION_TYPE_VECTOR2F_INPUT, INTERACTION_PROFILES_MICROSOFT_XBOX_CONTROLLER, USER_GAMEPAD, INPUT_THUMBSTICK_RIGHT, USER_GAMEPAD_INPUT_THUMBSTICK_RIGHT},
-    {"/interaction_profiles/microsoft/xbox_controller/user/gamepad/input/trigger_right/value", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_MICROSOFT_XBOX_CONTROLLER, USER_GAMEPAD, INPUT_TRIGGER_RIGHT_VALUE, USER_GAMEPAD_INPUT_TRIGGER_RIGHT_VALUE},
-    {"/interaction_profiles/microsoft/xbox_controller/user/gamepad/input/dpad_right/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_MICROSOFT_XBOX_CONTROLLER, USER_GAMEPAD, INPUT_DPAD_RIGHT_CLICK, USER_GAMEPAD_INPUT_DPAD_RIGHT_CLICK},
-    {"/interaction_profiles/microsoft/xbox_controller/user/gamepad/input/shoulder_left/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_MICROSOFT_XBOX_CONTROLLER, USER_GAMEPAD, INPUT_SHOULDER_LEFT_CLICK, USER_GAMEPAD_INPUT_SHOULDER_LEFT_CLICK},
-    {"/interaction_profiles/microsoft/xbox_controller/user/gamepad/input/a/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_MICROSOFT_XBOX_CONTROLLER, USER_GAMEPAD, INPUT_A_CLICK, USER_GAMEPAD_INPUT_A_CLICK},
-    {"/interaction_profiles/microsoft/xbox_controller/user/gamepad/input/thumbstick_left/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_MICROSOFT_XBOX_CONTROLLER, USER_GAMEPAD, INPUT_THUMBSTICK_LEFT_CLICK, USER_GAMEPAD_INPUT_THUMBSTICK_LEFT_CLICK},
-    {"/interaction_profiles/microsoft/xbox_controller/user/gamepad/input/shoulder_right/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_MICROSOFT_XBOX_CONTROLLER, USER_GAMEPAD, INPUT_SHOULDER_RIGHT_CLICK, USER_GAMEPAD_INPUT_SHOULDER_RIGHT_CLICK},
-    {"/interaction_profiles/microsoft/xbox_controller/user/gamepad/input/trigger_left/value", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_MICROSOFT_XBOX_CONTROLLER, USER_GAMEPAD, INPUT_TRIGGER_LEFT_VALUE, USER_GAMEPAD_INPUT_TRIGGER_LEFT_VALUE},
-    {"/interaction_profiles/microsoft/xbox_controller/user/gamepad/input/thumbstick_left/y", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_MICROSOFT_XBOX_CONTROLLER, USER_GAMEPAD, INPUT_THUMBSTICK_LEFT_Y, USER_GAMEPAD_INPUT_THUMBSTICK_LEFT_Y},
-    {"/interaction_profiles/microsoft/xbox_controller/user/gamepad/input/dpad_left/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_MICROSOFT_XBOX_CONTROLLER, USER_GAMEPAD, INPUT_DPAD_LEFT_CLICK, USER_GAMEPAD_INPUT_DPAD_LEFT_CLICK},
-    {"/interaction_profiles/microsoft/xbox_controller/user/gamepad/input/dpad_down/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_MICROSOFT_XBOX_CONTROLLER, USER_GAMEPAD, INPUT_DPAD_DOWN_CLICK, USER_GAMEPAD_INPUT_DPAD_DOWN_CLICK},
-    {"/interaction_profiles/microsoft/xbox_controller/user/gamepad/input/y/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_MICROSOFT_XBOX_CONTROLLER, USER_GAMEPAD, INPUT_Y_CLICK, USER_GAMEPAD_INPUT_Y_CLICK},
-    {"/interaction_profiles/microsoft/xbox_controller/user/gamepad/input/thumbstick_right/y", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_MICROSOFT_XBOX_CONTROLLER, USER_GAMEPAD, INPUT_THUMBSTICK_RIGHT_Y, USER_GAMEPAD_INPUT_THUMBSTICK_RIGHT_Y},
-    {"/interaction_profiles/microsoft/xbox_controller/user/gamepad/input/view/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_MICROSOFT_XBOX_CONTROLLER, USER_GAMEPAD, INPUT_VIEW_CLICK, USER_GAMEPAD_INPUT_VIEW_CLICK},
-    {"/interaction_profiles/microsoft/xbox_controller/user/gamepad/output/haptic_right_trigger", XR_ACTION_TYPE_VIBRATION_OUTPUT, INTERACTION_PROFILES_MICROSOFT_XBOX_CONTROLLER, USER_GAMEPAD, OUTPUT_HAPTIC_RIGHT_TRIGGER, USER_GAMEPAD_OUTPUT_HAPTIC_RIGHT_TRIGGER},
-    {"/interaction_profiles/microsoft/xbox_controller/user/gamepad/input/thumbstick_right/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_MICROSOFT_XBOX_CONTROLLER, USER_GAMEPAD, INPUT_THUMBSTICK_RIGHT_CLICK, USER_GAMEPAD_INPUT_THUMBSTICK_RIGHT_CLICK},
-    {"/interaction_profiles/microsoft/xbox_controller/user/gamepad/input/b/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_MICROSOFT_XBOX_CONTROLLER, USER_GAMEPAD, INPUT_B_CLICK, USER_GAMEPAD_INPUT_B_CLICK},
-    {"/interaction_profiles/microsoft/xbox_controller/user/gamepad/input/dpad_up/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_MICROSOFT_XBOX_CONTROLLER, USER_GAMEPAD, INPUT_DPAD_UP_CLICK, USER_GAMEPAD_INPUT_DPAD_UP_CLICK},
-    {"/interaction_profiles/microsoft/xbox_controller/user/gamepad/output/haptic_left_trigger", XR_ACTION_TYPE_VIBRATION_OUTPUT, INTERACTION_PROFILES_MICROSOFT_XBOX_CONTROLLER, USER_GAMEPAD, OUTPUT_HAPTIC_LEFT_TRIGGER, USER_GAMEPAD_OUTPUT_HAPTIC_LEFT_TRIGGER},
-    {"/interaction_profiles/microsoft/xbox_controller/user/gamepad/output/haptic_left", XR_ACTION_TYPE_VIBRATION_OUTPUT, INTERACTION_PROFILES_MICROSOFT_XBOX_CONTROLLER, USER_GAMEPAD, OUTPUT_HAPTIC_LEFT, USER_GAMEPAD_OUTPUT_HAPTIC_LEFT},
-    {"/interaction_profiles/microsoft/xbox_controller/user/gamepad/input/thumbstick_left/x", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_MICROSOFT_XBOX_CONTROLLER, USER_GAMEPAD, INPUT_THUMBSTICK_LEFT_X, USER_GAMEPAD_INPUT_THUMBSTICK_LEFT_X},
-    {"/interaction_profiles/microsoft/xbox_controller/user/gamepad/input/thumbstick_left", XR_ACTION_TYPE_VECTOR2F_INPUT, INTERACTION_PROFILES_MICROSOFT_XBOX_CONTROLLER, USER_GAMEPAD, INPUT_THUMBSTICK_LEFT, USER_GAMEPAD_INPUT_THUMBSTICK_LEFT},
-    {"/interaction_profiles/oculus/go_controller/user/hand/left/input/trackpad/x", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_OCULUS_GO_CONTROLLER, USER_HAND_LEFT, INPUT_TRACKPAD_X, USER_HAND_LEFT_INPUT_TRACKPAD_X},
-    {"/interaction_profiles/oculus/go_controller/user/hand/left/input/trackpad", XR_ACTION_TYPE_VECTOR2F_INPUT, INTERACTION_PROFILES_OCULUS_GO_CONTROLLER, USER_HAND_LEFT, INPUT_TRACKPAD, USER_HAND_LEFT_INPUT_TRACKPAD},
-    {"/interaction_profiles/oculus/go_controller/user/hand/left/input/system/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_OCULUS_GO_CONTROLLER, USER_HAND_LEFT, INPUT_SYSTEM_CLICK, USER_HAND_LEFT_INPUT_SYSTEM_CLICK},
-    {"/interaction_profiles/oculus/go_controller/user/hand/left/input/back/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_OCULUS_GO_CONTROLLER, USER_HAND_LEFT, INPUT_BACK_CLICK, USER_HAND_LEFT_INPUT_BACK_CLICK},
-    {"/interaction_profiles/oculus/go_controller/user/hand/left/input/trigger/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_OCULUS_GO_CONTROLLER, USER_HAND_LEFT, INPUT_TRIGGER_CLICK, USER_HAND_LEFT_INPUT_TRIGGER_CLICK},
-    {"/interaction_profiles/oculus/go_controller/user/hand/left/input/trackpad/y", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_OCULUS_GO_CONTROLLER, USER_HAND_LEFT, INPUT_TRACKPAD_Y, USER_HAND_LEFT_INPUT_TRACKPAD_Y},
-    {"/interaction_profiles/oculus/go_controller/user/hand/left/input/trackpad/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_OCULUS_GO_CONTROLLER, USER_HAND_LEFT, INPUT_TRACKPAD_CLICK, USER_HAND_LEFT_INPUT_TRACKPAD_CLICK},
-    {"/interaction_profiles/oculus/go_controller/user/hand/left/input/aim/pose", XR_ACTION_TYPE_POSE_INPUT, INTERACTION_PROFILES_OCULUS_GO_CONTROLLER, USER_HAND_LEFT, INPUT_AIM_POSE, USER_HAND_LEFT_INPUT_AIM_POSE},
-    {"/interaction_profiles/oculus/go_controller/user/hand/left/input/grip/pose", XR_ACTION_TYPE_POSE_INPUT, INTERACTION_PROFILES_OCULUS_GO_CONTROLLER, USER_HAND_LEFT, INPUT_GRIP_POSE, USER_HAND_LEFT_INPUT_GRIP_POSE},
-    {"/interaction_profiles/oculus/go_controller/user/hand/left/input/trackpad/touch", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_OCULUS_GO_CONTROLLER, USER_HAND_LEFT, INPUT_TRACKPAD_TOUCH, USER_HAND_LEFT_INPUT_TRACKPAD_TOUCH},
-    {"/interaction_profiles/oculus/go_controller/user/hand/right/input/trackpad/x", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_OCULUS_GO_CONTROLLER, USER_HAND_RIGHT, INPUT_TRACKPAD_X, USER_HAND_RIGHT_INPUT_TRACKPAD_X},
-    {"/interaction_profiles/oculus/go_controller/user/hand/right/input/trackpad", XR_ACTION_TYPE_VECTOR2F_INPUT, INTERACTION_PROFILES_OCULUS_GO_CONTROLLER, USER_HAND_RIGHT, INPUT_TRACKPAD, USER_HAND_RIGHT_INPUT_TRACKPAD},
-    {"/interaction_profiles/oculus/go_controller/user/hand/right/input/system/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_OCULUS_GO_CONTROLLER, USER_HAND_RIGHT, INPUT_SYSTEM_CLICK, USER_HAND_RIGHT_INPUT_SYSTEM_CLICK},
-    {"/interaction_profiles/oculus/go_controller/user/hand/right/input/back/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_OCULUS_GO_CONTROLLER, USER_HAND_RIGHT, INPUT_BACK_CLICK, USER_HAND_RIGHT_INPUT_BACK_CLICK},
-    {"/interaction_profiles/oculus/go_controller/user/hand/right/input/trigger/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_OCULUS_GO_CONTROLLER, USER_HAND_RIGHT, INPUT_TRIGGER_CLICK, USER_HAND_RIGHT_INPUT_TRIGGER_CLICK},
-    {"/interaction_profiles/oculus/go_controller/user/hand/right/input/trackpad/y", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_OCULUS_GO_CONTROLLER, USER_HAND_RIGHT, INPUT_TRACKPAD_Y, USER_HAND_RIGHT_INPUT_TRACKPAD_Y},
-    {"/interaction_profiles/oculus/go_controller/user/hand/right/input/trackpad/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_OCULUS_GO_CONTROLLER, USER_HAND_RIGHT, INPUT_TRACKPAD_CLICK, USER_HAND_RIGHT_INPUT_TRACKPAD_CLICK},
-    {"/interaction_profiles/oculus/go_controller/user/hand/right/input/aim/pose", XR_ACTION_TYPE_POSE_INPUT, INTERACTION_PROFILES_OCULUS_GO_CONTROLLER, USER_HAND_RIGHT, INPUT_AIM_POSE, USER_HAND_RIGHT_INPUT_AIM_POSE},
-    {"/interaction_profiles/oculus/go_controller/user/hand/right/input/grip/pose", XR_ACTION_TYPE_POSE_INPUT, INTERACTION_PROFILES_OCULUS_GO_CONTROLLER, USER_HAND_RIGHT, INPUT_GRIP_POSE, USER_HAND_RIGHT_INPUT_GRIP_POSE},
-    {"/interaction_profiles/oculus/go_controller/user/hand/right/input/trackpad/touch", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_OCULUS_GO_CONTROLLER, USER_HAND_RIGHT, INPUT_TRACKPAD_TOUCH, USER_HAND_RIGHT_INPUT_TRACKPAD_TOUCH},
-    {"/interaction_profiles/oculus/touch_controller/user/hand/left/input/thumbstick/y", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_OCULUS_TOUCH_CONTROLLER, USER_HAND_LEFT, INPUT_THUMBSTICK_Y, USER_HAND_LEFT_INPUT_THUMBSTICK_Y},
-    {"/interaction_profiles/oculus/touch_controller/user/hand/left/input/x/touch", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_OCULUS_TOUCH_CONTROLLER, USER_HAND_LEFT, INPUT_X_TOUCH, USER_HAND_LEFT_INPUT_X_TOUCH},
-    {"/interaction_profiles/oculus/touch_controller/user/hand/left/input/trigger/touch", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_OCULUS_TOUCH_CONTROLLER, USER_HAND_LEFT, INPUT_TRIGGER_TOUCH, USER_HAND_LEFT_INPUT_TRIGGER_TOUCH},
-    {"/interaction_profiles/oculus/touch_controller/user/hand/left/input/aim/pose", XR_ACTION_TYPE_POSE_INPUT, INTERACTION_PROFILES_OCULUS_TOUCH_CONTROLLER, USER_HAND_LEFT, INPUT_AIM_POSE, USER_HAND_LEFT_INPUT_AIM_POSE},
-    {"/interaction_profiles/oculus/touch_controller/user/hand/left/input/thumbstick/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_OCULUS_TOUCH_CONTROLLER, USER_HAND_LEFT, INPUT_THUMBSTICK_CLICK, USER_HAND_LEFT_INPUT_THUMBSTICK_CLICK},
-    {"/interaction_profiles/oculus/touch_controller/user/hand/left/input/grip/pose", XR_ACTION_TYPE_POSE_INPUT, INTERACTION_PROFILES_OCULUS_TOUCH_CONTROLLER, USER_HAND_LEFT, INPUT_GRIP_POSE, USER_HAND_LEFT_INPUT_GRIP_POSE},
-    {"/interaction_profiles/oculus/touch_controller/user/hand/left/input/thumbrest/touch", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_OCULUS_TOUCH_CONTROLLER, USER_HAND_LEFT, INPUT_THUMBREST_TOUCH, USER_HAND_LEFT_INPUT_THUMBREST_TOUCH},
-    {"/interaction_profiles/oculus/touch_controller/user/hand/left/input/menu/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_OCULUS_TOUCH_CONTROLLER, USER_HAND_LEFT, INPUT_MENU_CLICK, USER_HAND_LEFT_INPUT_MENU_CLICK},
-    {"/interaction_profiles/oculus/touch_controller/user/hand/left/output/haptic", XR_ACTION_TYPE_VIBRATION_OUTPUT, INTERACTION_PROFILES_OCULUS_TOUCH_CONTROLLER, USER_HAND_LEFT, OUTPUT_HAPTIC, USER_HAND_LEFT_OUTPUT_HAPTIC},
-    {"/interaction_profiles/oculus/touch_controller/user/hand/left/input/thumbstick/x", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_OCULUS_TOUCH_CONTROLLER, USER_HAND_LEFT, INPUT_THUMBSTICK_X, USER_HAND_LEFT_INPUT_THUMBSTICK_X},
-    {"/interaction_profiles/oculus/touch_controller/user/hand/left/input/thumbstick", XR_ACTION_TYPE_VECTOR2F_INPUT, INTERACTION_PROFILES_OCULUS_TOUCH_CONTROLLER, USER_HAND_LEFT, INPUT_THUMBSTICK, USER_HAND_LEFT_INPUT_THUMBSTICK},
-    {"/interaction_profiles/oculus/touch_controller/user/hand/left/input/squeeze/value", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_OCULUS_TOUCH_CONTROLLER, USER_HAND_LEFT, INPUT_SQUEEZE_VALUE, USER_HAND_LEFT_INPUT_SQUEEZE_VALUE},
-    {"/interaction_profiles/oculus/touch_controller/user/hand/left/input/thumbstick/touch", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_OCULUS_TOUCH_CONTROLLER, USER_HAND_LEFT, INPUT_THUMBSTICK_TOUCH, USER_HAND_LEFT_INPUT_THUMBSTICK_TOUCH},
-    {"/interaction_profiles/oculus/touch_controller/user/hand/left/input/y/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_OCULUS_TOUCH_CONTROLLER, USER_HAND_LEFT, INPUT_Y_CLICK, USER_HAND_LEFT_INPUT_Y_CLICK},
-    {"/interaction_profiles/oculus/touch_controller/user/hand/left/input/x/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_OCULUS_TOUCH_CONTROLLER, USER_HAND_LEFT, INPUT_X_CLICK, USER_HAND_LEFT_INPUT_X_CLICK},
-    {"/interaction_profiles/oculus/touch_controller/user/hand/left/input/trigger/value", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_OCULUS_TOUCH_CONTROLLER, USER_HAND_LEFT, INPUT_TRIGGER_VALUE, USER_HAND_LEFT_INPUT_TRIGGER_VALUE},
-    {"/interaction_profiles/oculus/touch_controller/user/hand/left/input/y/touch", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_OCULUS_TOUCH_CONTROLLER, USER_HAND_LEFT, INPUT_Y_TOUCH, USER_HAND_LEFT_INPUT_Y_TOUCH},
-    {"/interaction_profiles/oculus/touch_controller/user/hand/right/input/b/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_OCULUS_TOUCH_CONTROLLER, USER_HAND_RIGHT, INPUT_B_CLICK, USER_HAND_RIGHT_INPUT_B_CLICK},
-    {"/interaction_profiles/oculus/touch_controller/user/hand/right/input/system/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_OCULUS_TOUCH_CONTROLLER, USER_HAND_RIGHT, INPUT_SYSTEM_CLICK, USER_HAND_RIGHT_INPUT_SYSTEM_CLICK},
-    {"/interaction_profiles/oculus/touch_controller/user/hand/right/input/trigger/touch", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_OCULUS_TOUCH_CONTROLLER, USER_HAND_RIGHT, INPUT_TRIGGER_TOUCH, USER_HAND_RIGHT_INPUT_TRIGGER_TOUCH},
-    {"/interaction_profiles/oculus/touch_controller/user/hand/right/input/a/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_OCULUS_TOUCH_CONTROLLER, USER_HAND_RIGHT, INPUT_A_CLICK, USER_HAND_RIGHT_INPUT_A_CLICK},
-    {"/interaction_profiles/oculus/touch_controller/user/hand/right/input/thumbstick/y", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_OCULUS_TOUCH_CONTROLLER, USER_HAND_RIGHT, INPUT_THUMBSTICK_Y, USER_HAND_RIGHT_INPUT_THUMBSTICK_Y},
-    {"/interaction_profiles/oculus/touch_controller/user/hand/right/input/aim/pose", XR_ACTION_TYPE_POSE_INPUT, INTERACTION_PROFILES_OCULUS_TOUCH_CONTROLLER, USER_HAND_RIGHT, INPUT_AIM_POSE, USER_HAND_RIGHT_INPUT_AIM_POSE},
-    {"/interaction_profiles/oculus/touch_controller/user/hand/right/input/a/touch", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_OCULUS_TOUCH_CONTROLLER, USER_HAND_RIGHT, INPUT_A_TOUCH, USER_HAND_RIGHT_INPUT_A_TOUCH},
-    {"/interaction_profiles/oculus/touch_controller/user/hand/right/input/thumbstick/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_OCULUS_TOUCH_CONTROLLER, USER_HAND_RIGHT, INPUT_THUMBSTICK_CLICK, USER_HAND_RIGHT_INPUT_THUMBSTICK_CLICK},
-    {"/interaction_profiles/oculus/touch_controller/user/hand/right/input/grip/pose", XR_ACTION_TYPE_POSE_INPUT, INTERACTION_PROFILES_OCULUS_TOUCH_CONTROLLER, USER_HAND_RIGHT, INPUT_GRIP_POSE, USER_HAND_RIGHT_INPUT_GRIP_POSE},
-    {"/interaction_profiles/oculus/touch_controller/user/hand/right/input/thumbrest/touch", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_OCULUS_TOUCH_CONTROLLER, USER_HAND_RIGHT, INPUT_THUMBREST_TOUCH, USER_HAND_RIGHT_INPUT_THUMBREST_TOUCH},
-    {"/interaction_profiles/oculus/touch_controller/user/hand/right/input/squeeze/value", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_OCULUS_TOUCH_CONTROLLER, USER_HAND_RIGHT, INPUT_SQUEEZE_VALUE, USER_HAND_RIGHT_INPUT_SQUEEZE_VALUE},
-    {"/interaction_profiles/oculus/touch_controller/user/hand/right/output/haptic", XR_ACTION_TYPE_VIBRATION_OUTPUT, INTERACTION_PROFILES_OCULUS_TOUCH_CONTROLLER, USER_HAND_RIGHT, OUTPUT_HAPTIC, USER_HAND_RIGHT_OUTPUT_HAPTIC},
-    {"/interaction_profiles/oculus/touch_controller/user/hand/right/input/thumbstick/x", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_OCULUS_TOUCH_CONTROLLER, USER_HAND_RIGHT, INPUT_THUMBSTICK_X, USER_HAND_RIGHT_INPUT_THUMBSTICK_X},
-    {"/interaction_profiles/oculus/touch_controller/user/hand/right/input/thumbstick", XR_ACTION_TYPE_VECTOR2F_INPUT, INTERACTION_PROFILES_OCULUS_TOUCH_CONTROLLER, USER_HAND_RIGHT, INPUT_THUMBSTICK, USER_HAND_RIGHT_INPUT_THUMBSTICK},
-    {"/interaction_profiles/oculus/touch_controller/user/hand/right/input/b/touch", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_OCULUS_TOUCH_CONTROLLER, USER_HAND_RIGHT, INPUT_B_TOUCH, USER_HAND_RIGHT_INPUT_B_TOUCH},
-    {"/interaction_profiles/oculus/touch_controller/user/hand/right/input/thumbstick/touch", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_OCULUS_TOUCH_CONTROLLER, USER_HAND_RIGHT, INPUT_THUMBSTICK_TOUCH, USER_HAND_RIGHT_INPUT_THUMBSTICK_TOUCH},
-    {"/interaction_profiles/oculus/touch_controller/user/hand/right/input/trigger/value", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_OCULUS_TOUCH_CONTROLLER, USER_HAND_RIGHT, INPUT_TRIGGER_VALUE, USER_HAND_RIGHT_INPUT_TRIGGER_VALUE},
-    {"/interaction_profiles/valve/index_controller/user/hand/left/input/trackpad/x", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_VALVE_INDEX_CONTROLLER, USER_HAND_LEFT, INPUT_TRACKPAD_X, USER_HAND_LEFT_INPUT_TRACKPAD_X},
-    {"/interaction_profiles/valve/index_controller/user/hand/left/input/trackpad", XR_ACTION_TYPE_VECTOR2F_INPUT, INTERACTION_PROFILES_VALVE_INDEX_CONTROLLER, USER_HAND_LEFT, INPUT_TRACKPAD, USER_HAND_LEFT_INPUT_TRACKPAD},
-    {"/interaction_profiles/valve/index_controller/user/hand/left/input/trackpad/y", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_VALVE_INDEX_CONTROLLER, USER_HAND_LEFT, INPUT_TRACKPAD_Y, USER_HAND_LEFT_INPUT_TRACKPAD_Y},
-    {"/interaction_profiles/valve/index_controller/user/hand/left/input/squeeze/force", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_VALVE_INDEX_CONTROLLER, USER_HAND_LEFT, INPUT_SQUEEZE_FORCE, USER_HAND_LEFT_INPUT_SQUEEZE_FORCE},
-    {"/interaction_profiles/valve/index_controller/user/hand/left/output/haptic", XR_ACTION_TYPE_VIBRATION_OUTPUT, INTERACTION_PROFILES_VALVE_INDEX_CONTROLLER, USER_HAND_LEFT, OUTPUT_HAPTIC, USER_HAND_LEFT_OUTPUT_HAPTIC},
-    {"/interaction_profiles/valve/index_controller/user/hand/left/input/thumbstick/x", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_VALVE_INDEX_CONTROLLER, USER_HAND_LEFT, INPUT_THUMBSTICK_X, USER_HAND_LEFT_INPUT_THUMBSTICK_X},
-    {"/interaction_profiles/valve/index_controller/user/hand/left/input/thumbstick", XR_ACTION_TYPE_VECTOR2F_INPUT, INTERACTION_PROFILES_VALVE_INDEX_CONTROLLER, USER_HAND_LEFT, INPUT_THUMBSTICK, USER_HAND_LEFT_INPUT_THUMBSTICK},
-    {"/interaction_profiles/valve/index_controller/user/hand/left/input/b/touch", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_VALVE_INDEX_CONTROLLER, USER_HAND_LEFT, INPUT_B_TOUCH, USER_HAND_LEFT_INPUT_B_TOUCH},
-    {"/interaction_profiles/valve/index_controller/user/hand/left/input/thumbstick/touch", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_VALVE_INDEX_CONTROLLER, USER_HAND_LEFT, INPUT_THUMBSTICK_TOUCH, USER_HAND_LEFT_INPUT_THUMBSTICK_TOUCH},
-    {"/interaction_profiles/valve/index_controller/user/hand/left/input/trigger/value", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_VALVE_INDEX_CONTROLLER, USER_HAND_LEFT, INPUT_TRIGGER_VALUE, USER_HAND_LEFT_INPUT_TRIGGER_VALUE},
-    {"/interaction_profiles/valve/index_controller/user/hand/left/input/system/touch", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_VALVE_INDEX_CONTROLLER, USER_HAND_LEFT, INPUT_SYSTEM_TOUCH, USER_HAND_LEFT_INPUT_SYSTEM_TOUCH},
-    {"/interaction_profiles/valve/index_controller/user/hand/left/input/thumbstick/y", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_VALVE_INDEX_CONTROLLER, USER_HAND_LEFT, INPUT_THUMBSTICK_Y, USER_HAND_LEFT_INPUT_THUMBSTICK_Y},
-    {"/interaction_profiles/valve/index_controller/user/hand/left/input/trackpad/force", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_VALVE_INDEX_CONTROLLER, USER_HAND_LEFT, INPUT_TRACKPAD_FORCE, USER_HAND_LEFT_INPUT_TRACKPAD_FORCE},
-    {"/interaction_profiles/valve/index_controller/user/hand/left/input/thumbstick/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_VALVE_INDEX_CONTROLLER, USER_HAND_LEFT, INPUT_THUMBSTICK_CLICK, USER_HAND_LEFT_INPUT_THUMBSTICK_CLICK},
-    {"/interaction_profiles/valve/index_controller/user/hand/left/input/trigger/touch", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_VALVE_INDEX_CONTROLLER, USER_HAND_LEFT, INPUT_TRIGGER_TOUCH, USER_HAND_LEFT_INPUT_TRIGGER_TOUCH},
-    {"/interaction_profiles/valve/index_controller/user/hand/left/input/a/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_VALVE_INDEX_CONTROLLER, USER_HAND_LEFT, INPUT_A_CLICK, USER_HAND_LEFT_INPUT_A_CLICK},
-    {"/interaction_profiles/valve/index_controller/user/hand/left/input/a/touch", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_VALVE_INDEX_CONTROLLER, USER_HAND_LEFT, INPUT_A_TOUCH, USER_HAND_LEFT_INPUT_A_TOUCH},
-    {"/interaction_profiles/valve/index_controller/user/hand/left/input/trackpad/touch", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_VALVE_INDEX_CONTROLLER, USER_HAND_LEFT, INPUT_TRACKPAD_TOUCH, USER_HAND_LEFT_INPUT_TRACKPAD_TOUCH},
-    {"/interaction_profiles/valve/index_controller/user/hand/left/input/squeeze/value", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_VALVE_INDEX_CONTROLLER, USER_HAND_LEFT, INPUT_SQUEEZE_VALUE, USER_HAND_LEFT_INPUT_SQUEEZE_VALUE},
-    {"/interaction_profiles/valve/index_controller/user/hand/left/input/grip/pose", XR_ACTION_TYPE_POSE_INPUT, INTERACTION_PROFILES_VALVE_INDEX_CONTROLLER, USER_HAND_LEFT, INPUT_GRIP_POSE, USER_HAND_LEFT_INPUT_GRIP_POSE},
-    {"/interaction_profiles/valve/index_controller/user/hand/left/input/b/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_VALVE_INDEX_CONTROLLER, USER_HAND_LEFT, INPUT_B_CLICK, USER_HAND_LEFT_INPUT_B_CLICK},
-    {"/interaction_profiles/valve/index_controller/user/hand/left/input/system/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_VALVE_INDEX_CONTROLLER, USER_HAND_LEFT, INPUT_SYSTEM_CLICK, USER_HAND_LEFT_INPUT_SYSTEM_CLICK},
-    {"/interaction_profiles/valve/index_controller/user/hand/left/input/trigger/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_VALVE_INDEX_CONTROLLER, USER_HAND_LEFT, INPUT_TRIGGER_CLICK, USER_HAND_LEFT_INPUT_TRIGGER_CLICK},
-    {"/interaction_profiles/valve/index_controller/user/hand/left/input/aim/pose", XR_ACTION_TYPE_POSE_INPUT, INTERACTION_PROFILES_VALVE_INDEX_CONTROLLER, USER_HAND_LEFT, INPUT_AIM_POSE, USER_HAND_LEFT_INPUT_AIM_POSE},
-    {"/interaction_profiles/valve/index_controller/user/hand/right/input/trackpad/x", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_VALVE_INDEX_CONTROLLER, USER_HAND_RIGHT, INPUT_TRACKPAD_X, USER_HAND_RIGHT_INPUT_TRACKPAD_X},
-    {"/interaction_profiles/valve/index_controller/user/hand/right/input/trackpad", XR_ACTION_TYPE_VECTOR2F_INPUT, INTERACTION_PROFILES_VALVE_INDEX_CONTROLLER, USER_HAND_RIGHT, INPUT_TRACKPAD, USER_HAND_RIGHT_INPUT_TRACKPAD},
-    {"/interaction_profiles/valve/index_controller/user/hand/right/input/trackpad/y", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_VALVE_INDEX_CONTROLLER, USER_HAND_RIGHT, INPUT_TRACKPAD_Y, USER_HAND_RIGHT_INPUT_TRACKPAD_Y},
-    {"/interaction_profiles/valve/index_controller/user/hand/right/input/squeeze/force", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_VALVE_INDEX_CONTROLLER, USER_HAND_RIGHT, INPUT_SQUEEZE_FORCE, USER_HAND_RIGHT_INPUT_SQUEEZE_FORCE},
-    {"/interaction_profiles/valve/index_controller/user/hand/right/output/haptic", XR_ACTION_TYPE_VIBRATION_OUTPUT, INTERACTION_PROFILES_VALVE_INDEX_CONTROLLER, USER_HAND_RIGHT, OUTPUT_HAPTIC, USER_HAND_RIGHT_OUTPUT_HAPTIC},
-    {"/interaction_profiles/valve/index_controller/user/hand/right/input/thumbstick/x", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_VALVE_INDEX_CONTROLLER, USER_HAND_RIGHT, INPUT_THUMBSTICK_X, USER_HAND_RIGHT_INPUT_THUMBSTICK_X},
-    {"/interaction_profiles/valve/index_controller/user/hand/right/input/thumbstick", XR_ACTION_TYPE_VECTOR2F_INPUT, INTERACTION_PROFILES_VALVE_INDEX_CONTROLLER, USER_HAND_RIGHT, INPUT_THUMBSTICK, USER_HAND_RIGHT_INPUT_THUMBSTICK},
-    {"/interaction_profiles/valve/index_controller/user/hand/right/input/b/touch", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_VALVE_INDEX_CONTROLLER, USER_HAND_RIGHT, INPUT_B_TOUCH, USER_HAND_RIGHT_INPUT_B_TOUCH},
-    {"/interaction_profiles/valve/index_controller/user/hand/right/input/thumbstick/touch", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_VALVE_INDEX_CONTROLLER, USER_HAND_RIGHT, INPUT_THUMBSTICK_TOUCH, USER_HAND_RIGHT_INPUT_THUMBSTICK_TOUCH},
-    {"/interaction_profiles/valve/index_controller/user/hand/right/input/trigger/value", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_VALVE_INDEX_CONTROLLER, USER_HAND_RIGHT, INPUT_TRIGGER_VALUE, USER_HAND_RIGHT_INPUT_TRIGGER_VALUE},
-    {"/interaction_profiles/valve/index_controller/user/hand/right/input/system/touch", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_VALVE_INDEX_CONTROLLER, USER_HAND_RIGHT, INPUT_SYSTEM_TOUCH, USER_HAND_RIGHT_INPUT_SYSTEM_TOUCH},
-    {"/interaction_profiles/valve/index_controller/user/hand/right/input/thumbstick/y", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_VALVE_INDEX_CONTROLLER, USER_HAND_RIGHT, INPUT_THUMBSTICK_Y, USER_HAND_RIGHT_INPUT_THUMBSTICK_Y},
-    {"/interaction_profiles/valve/index_controller/user/hand/right/input/trackpad/force", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_VALVE_INDEX_CONTROLLER, USER_HAND_RIGHT, INPUT_TRACKPAD_FORCE, USER_HAND_RIGHT_INPUT_TRACKPAD_FORCE},
-    {"/interaction_profiles/valve/index_controller/user/hand/right/input/thumbstick/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_VALVE_INDEX_CONTROLLER, USER_HAND_RIGHT, INPUT_THUMBSTICK_CLICK, USER_HAND_RIGHT_INPUT_THUMBSTICK_CLICK},
-    {"/interaction_profiles/valve/index_controller/user/hand/right/input/trigger/touch", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_VALVE_INDEX_CONTROLLER, USER_HAND_RIGHT, INPUT_TRIGGER_TOUCH, USER_HAND_RIGHT_INPUT_TRIGGER_TOUCH},
-    {"/interaction_profiles/valve/index_controller/user/hand/right/input/a/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_VALVE_INDEX_CONTROLLER, USER_HAND_RIGHT, INPUT_A_CLICK, USER_HAND_RIGHT_INPUT_A_CLICK},
-    {"/interaction_profiles/valve/index_controller/user/hand/right/input/a/touch", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_VALVE_INDEX_CONTROLLER, USER_HAND_RIGHT, INPUT_A_TOUCH, USER_HAND_RIGHT_INPUT_A_TOUCH},
-    {"/interaction_profiles/valve/index_controller/user/hand/right/input/trackpad/touch", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_VALVE_INDEX_CONTROLLER, USER_HAND_RIGHT, INPUT_TRACKPAD_TOUCH, USER_HAND_RIGHT_INPUT_TRACKPAD_TOUCH},
-    {"/interaction_profiles/valve/index_controller/user/hand/right/input/squeeze/value", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_VALVE_INDEX_CONTROLLER, USER_HAND_RIGHT, INPUT_SQUEEZE_VALUE, USER_HAND_RIGHT_INPUT_SQUEEZE_VALUE},
-    {"/interaction_profiles/valve/index_controller/user/hand/right/input/grip/pose", XR_ACTION_TYPE_POSE_INPUT, INTERACTION_PROFILES_VALVE_INDEX_CONTROLLER, USER_HAND_RIGHT, INPUT_GRIP_POSE, USER_HAND_RIGHT_INPUT_GRIP_POSE},
-    {"/interaction_profiles/valve/index_controller/user/hand/right/input/b/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_VALVE_INDEX_CONTROLLER, USER_HAND_RIGHT, INPUT_B_CLICK, USER_HAND_RIGHT_INPUT_B_CLICK},
-    {"/interaction_profiles/valve/index_controller/user/hand/right/input/system/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_VALVE_INDEX_CONTROLLER, USER_HAND_RIGHT, INPUT_SYSTEM_CLICK, USER_HAND_RIGHT_INPUT_SYSTEM_CLICK},
-    {"/interaction_profiles/valve/index_controller/user/hand/right/input/trigger/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_VALVE_INDEX_CONTROLLER, USER_HAND_RIGHT, INPUT_TRIGGER_CLICK, USER_HAND_RIGHT_INPUT_TRIGGER_CLICK},
-    {"/interaction_profiles/valve/index_controller/user/hand/right/input/aim/pose", XR_ACTION_TYPE_POSE_INPUT, INTERACTION_PROFILES_VALVE_INDEX_CONTROLLER, USER_HAND_RIGHT, INPUT_AIM_POSE, USER_HAND_RIGHT_INPUT_AIM_POSE},
-    {"/interaction_profiles/hp/mixed_reality_controller/user/hand/left/input/thumbstick/y", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_HP_MIXED_REALITY_CONTROLLER, USER_HAND_LEFT, INPUT_THUMBSTICK_Y, USER_HAND_LEFT_INPUT_THUMBSTICK_Y},
-    {"/interaction_profiles/hp/mixed_reality_controller/user/hand/left/input/aim/pose", XR_ACTION_TYPE_POSE_INPUT, INTERACTION_PROFILES_HP_MIXED_REALITY_CONTROLLER, USER_HAND_LEFT, INPUT_AIM_POSE, USER_HAND_LEFT_INPUT_AIM_POSE},
-    {"/interaction_profiles/hp/mixed_reality_controller/user/hand/left/input/thumbstick/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_HP_MIXED_REALITY_CONTROLLER, USER_HAND_LEFT, INPUT_THUMBSTICK_CLICK, USER_HAND_LEFT_INPUT_THUMBSTICK_CLICK},
-    {"/interaction_profiles/hp/mixed_reality_controller/user/hand/left/input/grip/pose", XR_ACTION_TYPE_POSE_INPUT, INTERACTION_PROFILES_HP_MIXED_REALITY_CONTROLLER, USER_HAND_LEFT, INPUT_GRIP_POSE, USER_HAND_LEFT_INPUT_GRIP_POSE},
-    {"/interaction_profiles/hp/mixed_reality_controller/user/hand/left/input/menu/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_HP_MIXED_REALITY_CONTROLLER, USER_HAND_LEFT, INPUT_MENU_CLICK, USER_HAND_LEFT_INPUT_MENU_CLICK},
-    {"/interaction_profiles/hp/mixed_reality_controller/user/hand/left/output/haptic", XR_ACTION_TYPE_VIBRATION_OUTPUT, INTERACTION_PROFILES_HP_MIXED_REALITY_CONTROLLER, USER_HAND_LEFT, OUTPUT_HAPTIC, USER_HAND_LEFT_OUTPUT_HAPTIC},
-    {"/interaction_profiles/hp/mixed_reality_controller/user/hand/left/input/thumbstick/x", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_HP_MIXED_REALITY_CONTROLLER, USER_HAND_LEFT, INPUT_THUMBSTICK_X, USER_HAND_LEFT_INPUT_THUMBSTICK_X},
-    {"/interaction_profiles/hp/mixed_reality_controller/user/hand/left/input/thumbstick", XR_ACTION_TYPE_VECTOR2F_INPUT, INTERACTION_PROFILES_HP_MIXED_REALITY_CONTROLLER, USER_HAND_LEFT, INPUT_THUMBSTICK, USER_HAND_LEFT_INPUT_THUMBSTICK},
-    {"/interaction_profiles/hp/mixed_reality_controller/user/hand/left/input/squeeze/value", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_HP_MIXED_REALITY_CONTROLLER, USER_HAND_LEFT, INPUT_SQUEEZE_VALUE, USER_HAND_LEFT_INPUT_SQUEEZE_VALUE},
-    {"/interaction_profiles/hp/mixed_reality_controller/user/hand/left/input/y/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_HP_MIXED_REALITY_CONTROLLER, USER_HAND_LEFT, INPUT_Y_CLICK, USER_HAND_LEFT_INPUT_Y_CLICK},
-    {"/interaction_profiles/hp/mixed_reality_controller/user/hand/left/input/x/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_HP_MIXED_REALITY_CONTROLLER, USER_HAND_LEFT, INPUT_X_CLICK, USER_HAND_LEFT_INPUT_X_CLICK},
-    {"/interaction_profiles/hp/mixed_reality_controller/user/hand/left/input/trigger/value", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_HP_MIXED_REALITY_CONTROLLER, USER_HAND_LEFT, INPUT_TRIGGER_VALUE, USER_HAND_LEFT_INPUT_TRIGGER_VALUE},
-    {"/interaction_profiles/hp/mixed_reality_controller/user/hand/right/input/b/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_HP_MIXED_REALITY_CONTROLLER, USER_HAND_RIGHT, INPUT_B_CLICK, USER_HAND_RIGHT_INPUT_B_CLICK},
-    {"/interaction_profiles/hp/mixed_reality_controller/user/hand/right/input/thumbstick/y", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_HP_MIXED_REALITY_CONTROLLER, USER_HAND_RIGHT, INPUT_THUMBSTICK_Y, USER_HAND_RIGHT_INPUT_THUMBSTICK_Y},
-    {"/interaction_profiles/hp/mixed_reality_controller/user/hand/right/input/aim/pose", XR_ACTION_TYPE_POSE_INPUT, INTERACTION_PROFILES_HP_MIXED_REALITY_CONTROLLER, USER_HAND_RIGHT, INPUT_AIM_POSE, USER_HAND_RIGHT_INPUT_AIM_POSE},
-    {"/interaction_profiles/hp/mixed_reality_controller/user/hand/right/input/a/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_HP_MIXED_REALITY_CONTROLLER, USER_HAND_RIGHT, INPUT_A_CLICK, USER_HAND_RIGHT_INPUT_A_CLICK},
-    {"/interaction_profiles/hp/mixed_reality_controller/user/hand/right/input/thumbstick/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_HP_MIXED_REALITY_CONTROLLER, USER_HAND_RIGHT, INPUT_THUMBSTICK_CLICK, USER_HAND_RIGHT_INPUT_THUMBSTICK_CLICK},
-    {"/interaction_profiles/hp/mixed_reality_controller/user/hand/right/input/grip/pose", XR_ACTION_TYPE_POSE_INPUT, INTERACTION_PROFILES_HP_MIXED_REALITY_CONTROLLER, USER_HAND_RIGHT, INPUT_GRIP_POSE, USER_HAND_RIGHT_INPUT_GRIP_POSE},
-    {"/interaction_profiles/hp/mixed_reality_controller/user/hand/right/input/menu/click", XR_ACTION_TYPE_BOOLEAN_INPUT, INTERACTION_PROFILES_HP_MIXED_REALITY_CONTROLLER, USER_HAND_RIGHT, INPUT_MENU_CLICK, USER_HAND_RIGHT_INPUT_MENU_CLICK},
-    {"/interaction_profiles/hp/mixed_reality_controller/user/hand/right/output/haptic", XR_ACTION_TYPE_VIBRATION_OUTPUT, INTERACTION_PROFILES_HP_MIXED_REALITY_CONTROLLER, USER_HAND_RIGHT, OUTPUT_HAPTIC, USER_HAND_RIGHT_OUTPUT_HAPTIC},
-    {"/interaction_profiles/hp/mixed_reality_controller/user/hand/right/input/thumbstick/x", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_HP_MIXED_REALITY_CONTROLLER, USER_HAND_RIGHT, INPUT_THUMBSTICK_X, USER_HAND_RIGHT_INPUT_THUMBSTICK_X},
-    {"/interaction_profiles/hp/mixed_reality_controller/user/hand/right/input/thumbstick", XR_ACTION_TYPE_VECTOR2F_INPUT, INTERACTION_PROFILES_HP_MIXED_REALITY_CONTROLLER, USER_HAND_RIGHT, INPUT_THUMBSTICK, USER_HAND_RIGHT_INPUT_THUMBSTICK},
-    {"/interaction_profiles/hp/mixed_reality_controller/user/hand/right/input/squeeze/value", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_HP_MIXED_REALITY_CONTROLLER, USER_HAND_RIGHT, INPUT_SQUEEZE_VALUE, USER_HAND_RIGHT_INPUT_SQUEEZE_VALUE},
-    {"/interaction_profiles/hp/mixed_reality_controller/user/hand/right/input/trigger/value", XR_ACTION_TYPE_FLOAT_INPUT, INTERACTION_PROFILES_HP_MIXED_REALITY_CONTROLLER, USER_HAND_RIGHT, INPUT_TRIGGER_VALUE, USER_HAND_RIGHT_INPUT_TRIGGER_VALUE},
-
-};
-
-
 // Just in case everything is terrible and every proc has to be synchronized
 std::recursive_mutex gSynchronizeEveryProcMutex;
 bool gSynchronizeEveryProc = true; // XXX Currently true because of both layer view loss and ReleaseSwapchainImage VALIDATION_FAILURE
@@ -525,6 +102,22 @@ std::recursive_mutex EndFrameMutex;
 // On OVR I get regular deadlocks in one thread in runtime ReleaseSwapchainImage and in another thread in ApplyHapticFeedback.
 std::recursive_mutex HapticQuirkMutex;
 
+// Locating an action space reuses a sync from earlier in the same frame;
+// set OVERLAYS_API_LAYER_SYNC_EVERY_LOCATE for apps which SyncActions
+// again within a frame and expect locates to sync too
+bool gSyncActionsEveryLocate = false;
+
+// Overlay xrLocateSpace calls within this long of a located sample are
+// extrapolated from its velocities instead of going to Main; set
+// OVERLAYS_API_LAYER_POSE_EXTRAPOLATION_MS to change, 0 to always go to Main
+XrDuration gPoseExtrapolationWindow = 20000000;
+
+// Every placeholder Action is created when Main attaches its ActionSets, so
+// an Overlay connecting later still gets input; set
+// OVERLAYS_API_LAYER_LAZY_PLACEHOLDERS to create only those the Overlays
+// connected by then asked for
+bool gLazyPlaceholderActions = false;
+
 
 const std::set<HandleTypePair> OverlaysLayerNoObjectInfo = {};
 
@@ -535,11 +128,6 @@ uint64_t GetNextLocalHandle()
 }
 
 
-std::unique_lock<std::recursive_mutex> GetSyncActionsLock()
-{
-    static std::recursive_mutex syncActionsMutex;
-    return std::unique_lock<std::recursive_mutex>(syncActionsMutex);
-}
 
 
 std::string PathToString(XrInstance instance, XrPath path)
@@ -560,9 +148,9 @@ std::string PathToString(XrInstance instance, XrPath path)
     }
 
     if(result != XR_SUCCESS) {
-        if(instanceInfo->OverlaysLayerPathToWellKnownString.count(path) > 0) {
-            auto index = instanceInfo->OverlaysLayerPathToWellKnownString.at(path);
-            auto str = OverlaysLayerWellKnownStrings.at(index);
+        WellKnownStringIndex index;
+        if(instanceInfo->OverlaysLayerPathToWellKnownString.Find(path, &index)) {
+            auto str = OverlaysLayerWellKnownStrings[index];
             sprintf(buffer, "<PathToString failed?! %08llX, \"%s\">", path, str);
             return buffer;
         } else {
@@ -616,100 +204,218 @@ void ClearActionState(XrActionType actionType, ActionStateUnion* stateUnion)
     }
 }
 
-// NB: Does not change lastChangeTime or changedSinceLastSync since those depend on the previously sync'd action state
-void MergeActionState(XrActionType actionType, const ActionStateUnion* toMergeUnion, ActionStateUnion *accumulatedUnion)
+// Whether an Overlay holding state b of an action of actionType would see
+// anything different in a.  lastChangeTime only moves along with
+// currentState, which also sets changedSinceLastSync, so it isn't compared.
+bool ActionStatesDiffer(XrActionType actionType, const ActionStateUnion& a, const ActionStateUnion& b)
 {
     switch(actionType) {
-        case XR_ACTION_TYPE_BOOLEAN_INPUT: {
-            const auto& toMerge = toMergeUnion->booleanState;
-            auto& accumulated = accumulatedUnion->booleanState;
+        case XR_ACTION_TYPE_BOOLEAN_INPUT:
+            return (a.booleanState.isActive != b.booleanState.isActive) ||
+                (a.booleanState.currentState != b.booleanState.currentState) ||
+                (a.booleanState.changedSinceLastSync != b.booleanState.changedSinceLastSync);
+        case XR_ACTION_TYPE_FLOAT_INPUT:
+            return (a.floatState.isActive != b.floatState.isActive) ||
+                (a.floatState.currentState != b.floatState.currentState) ||
+                (a.floatState.changedSinceLastSync != b.floatState.changedSinceLastSync);
+        case XR_ACTION_TYPE_VECTOR2F_INPUT:
+            return (a.vector2fState.isActive != b.vector2fState.isActive) ||
+                (a.vector2fState.currentState.x != b.vector2fState.currentState.x) ||
+                (a.vector2fState.currentState.y != b.vector2fState.currentState.y) ||
+                (a.vector2fState.changedSinceLastSync != b.vector2fState.changedSinceLastSync);
+        case XR_ACTION_TYPE_POSE_INPUT:
+            return a.poseState.isActive != b.poseState.isActive;
+        default:
+            // No placeholder; always the empty state
+            return false;
+    }
+}
 
-            if(!accumulated.isActive) {
-                accumulated = toMerge;
-            } else {
-                accumulated.currentState |= toMerge.currentState;
-            }
+uint32_t ActionStateStore::GetSlot(XrAction action, XrPath subactionPath, XrActionType actionType)
+{
+    auto it = slotsByActionAndSubactionPath.find({action, subactionPath});
+    if(it != slotsByActionAndSubactionPath.end()) {
+        return it->second;
+    }
+
+    uint32_t slot = (uint32_t)actionTypes.size();
+    actionTypes.push_back(actionType);
+    isActive.push_back(XR_FALSE);
+    booleanStates.push_back(XR_FALSE);
+    floatStates.push_back(0.0f);
+    vector2fStates.push_back({0.0f, 0.0f});
+    changedSinceLastSync.push_back(XR_FALSE);
+    lastChangeTimes.push_back(0);
+    previousIsActive.push_back(XR_FALSE);
+    previousBooleanStates.push_back(XR_FALSE);
+    previousFloatStates.push_back(0.0f);
+    previousVector2fStates.push_back({0.0f, 0.0f});
+    previousLastChangeTimes.push_back(0);
+
+    slotsByActionAndSubactionPath.insert({{action, subactionPath}, slot});
+    slotsByAction[action].push_back(slot);
+    return slot;
+}
+
+bool ActionStateStore::FindSlot(XrAction action, XrPath subactionPath, uint32_t* slot) const
+{
+    auto it = slotsByActionAndSubactionPath.find({action, subactionPath});
+    if(it == slotsByActionAndSubactionPath.end()) {
+        return false;
+    }
+    *slot = it->second;
+    return true;
+}
+
+void ActionStateStore::SavePrevious()
+{
+    std::copy(isActive.begin(), isActive.end(), previousIsActive.begin());
+    std::copy(booleanStates.begin(), booleanStates.end(), previousBooleanStates.begin());
+    std::copy(floatStates.begin(), floatStates.end(), previousFloatStates.begin());
+    std::copy(vector2fStates.begin(), vector2fStates.end(), previousVector2fStates.begin());
+    std::copy(lastChangeTimes.begin(), lastChangeTimes.end(), previousLastChangeTimes.begin());
+}
+
+void ActionStateStore::ClearAction(XrAction action)
+{
+    auto it = slotsByAction.find(action);
+    if(it == slotsByAction.end()) {
+        return;
+    }
+    for(uint32_t slot: it->second) {
+        isActive[slot] = XR_FALSE;
+        booleanStates[slot] = XR_FALSE;
+        floatStates[slot] = 0.0f;
+        vector2fStates[slot] = {0.0f, 0.0f};
+        changedSinceLastSync[slot] = XR_FALSE;
+        lastChangeTimes[slot] = 0;
+    }
+}
+
+void ActionStateStore::Set(uint32_t slot, const ActionStateUnion* state)
+{
+    switch(actionTypes[slot]) {
+        case XR_ACTION_TYPE_BOOLEAN_INPUT: {
+            const auto& s = state->booleanState;
+            isActive[slot] = s.isActive;
+            booleanStates[slot] = s.currentState;
+            changedSinceLastSync[slot] = s.changedSinceLastSync;
+            lastChangeTimes[slot] = s.lastChangeTime;
             break;
         }
         case XR_ACTION_TYPE_FLOAT_INPUT: {
-            auto& toMerge = toMergeUnion->floatState;
-            auto& accumulated = accumulatedUnion->floatState;
-
-            if(!accumulated.isActive) {
-                accumulated = toMerge;
-            } else {
-                accumulated.currentState = std::max(accumulated.currentState, toMerge.currentState);
-            }
+            const auto& s = state->floatState;
+            isActive[slot] = s.isActive;
+            floatStates[slot] = s.currentState;
+            changedSinceLastSync[slot] = s.changedSinceLastSync;
+            lastChangeTimes[slot] = s.lastChangeTime;
             break;
         }
         case XR_ACTION_TYPE_VECTOR2F_INPUT: {
-            auto& toMerge = toMergeUnion->vector2fState;
-            auto& accumulated = accumulatedUnion->vector2fState;
-            float mergesq = toMerge.currentState.x * toMerge.currentState.x + toMerge.currentState.y * toMerge.currentState.y;
-            float accumsq = accumulated.currentState.x * accumulated.currentState.x + accumulated.currentState.y * accumulated.currentState.y;
-            if(!accumulated.isActive) {
-                accumulated = toMerge;
-            } else {
-                if(mergesq > accumsq) {
-                    accumulated.currentState = toMerge.currentState;
-                }
-            }
+            const auto& s = state->vector2fState;
+            isActive[slot] = s.isActive;
+            vector2fStates[slot] = s.currentState;
+            changedSinceLastSync[slot] = s.changedSinceLastSync;
+            lastChangeTimes[slot] = s.lastChangeTime;
             break;
         }
         case XR_ACTION_TYPE_POSE_INPUT: {
-            auto& toMerge = toMergeUnion->poseState;
-            auto& accumulated = accumulatedUnion->poseState;
-            accumulated.isActive |= toMerge.isActive;
+            isActive[slot] = state->poseState.isActive;
             break;
         }
     }
 }
 
-// Updates currentState changedSinceLastSync and lastChangeTime if
-// previous was active and current is active and state has changed
-void UpdateActionStateLastChange(XrActionType actionType, const ActionStateUnion *previousState, ActionStateUnion *currentState)
+void ActionStateStore::SetLanes(const uint32_t* slots, size_t count, const ActionStateLanes& lanes)
+{
+    for(size_t i = 0; i < count; i++) {
+        uint32_t slot = slots[i];
+        isActive[slot] = lanes.isActive[i];
+
+        switch(actionTypes[slot]) {
+            case XR_ACTION_TYPE_BOOLEAN_INPUT:
+                booleanStates[slot] = lanes.booleanStates[i];
+                break;
+            case XR_ACTION_TYPE_FLOAT_INPUT:
+                floatStates[slot] = lanes.floatStates[i];
+                break;
+            case XR_ACTION_TYPE_VECTOR2F_INPUT:
+                vector2fStates[slot] = { lanes.floatStates[i], lanes.yStates[i] };
+                break;
+            default:
+                continue;
+        }
+
+        changedSinceLastSync[slot] = lanes.changedSinceLastSync[i];
+        lastChangeTimes[slot] = lanes.lastChangeTimes[i];
+    }
+}
+
+// Sets changedSinceLastSync and keeps the previous lastChangeTime of
+// slots which were active at the previous sync and still are
+void ActionStateStore::UpdateLastChange(const uint32_t* slots, size_t count)
+{
+    for(size_t i = 0; i < count; i++) {
+        uint32_t slot = slots[i];
+        if(!isActive[slot] || !previousIsActive[slot]) {
+            continue;
+        }
+
+        bool changed;
+        switch(actionTypes[slot]) {
+            case XR_ACTION_TYPE_BOOLEAN_INPUT:
+                changed = booleanStates[slot] != previousBooleanStates[slot];
+                break;
+            case XR_ACTION_TYPE_FLOAT_INPUT:
+                changed = floatStates[slot] != previousFloatStates[slot];
+                break;
+            case XR_ACTION_TYPE_VECTOR2F_INPUT:
+                changed = (vector2fStates[slot].x != previousVector2fStates[slot].x) || (vector2fStates[slot].y != previousVector2fStates[slot].y);
+                break;
+            default:
+                continue;
+        }
+
+        if(changed) {
+            changedSinceLastSync[slot] = XR_TRUE;
+        } else {
+            lastChangeTimes[slot] = previousLastChangeTimes[slot];
+        }
+    }
+}
+
+void ActionStateStore::Get(uint32_t slot, ActionStateUnion* state) const
 {
+    XrActionType actionType = actionTypes[slot];
+    ClearActionState(actionType, state);
+
     switch(actionType) {
         case XR_ACTION_TYPE_BOOLEAN_INPUT: {
-            const auto& previous = previousState->booleanState;
-            auto& current = currentState->booleanState;
-
-            if(current.isActive && previous.isActive) {
-                if(current.currentState != previous.currentState) {
-                    current.changedSinceLastSync = XR_TRUE;
-                } else {
-                    current.lastChangeTime = previous.lastChangeTime;
-                }
-            }
+            auto& s = state->booleanState;
+            s.isActive = isActive[slot];
+            s.currentState = booleanStates[slot];
+            s.changedSinceLastSync = changedSinceLastSync[slot];
+            s.lastChangeTime = lastChangeTimes[slot];
             break;
         }
         case XR_ACTION_TYPE_FLOAT_INPUT: {
-            auto& previous = previousState->floatState;
-            auto& current = currentState->floatState;
-
-            if(current.isActive && previous.isActive) {
-                if(current.currentState != previous.currentState) {
-                    current.changedSinceLastSync = XR_TRUE;
-                } else {
-                    current.lastChangeTime = previous.lastChangeTime;
-                }
-            }
+            auto& s = state->floatState;
+            s.isActive = isActive[slot];
+            s.currentState = floatStates[slot];
+            s.changedSinceLastSync = changedSinceLastSync[slot];
+            s.lastChangeTime = lastChangeTimes[slot];
             break;
         }
         case XR_ACTION_TYPE_VECTOR2F_INPUT: {
-            auto& previous = previousState->vector2fState;
-            auto& current = currentState->vector2fState;
-
-            if(current.isActive && previous.isActive) {
-                if((current.currentState.x != previous.currentState.x) || (current.currentState.y != previous.currentState.y)) {
-                    current.changedSinceLastSync = XR_TRUE;
-                } else {
-                    current.lastChangeTime = previous.lastChangeTime;
-                }
-            }
+            auto& s = state->vector2fState;
+            s.isActive = isActive[slot];
+            s.currentState = vector2fStates[slot];
+            s.changedSinceLastSync = changedSinceLastSync[slot];
+            s.lastChangeTime = lastChangeTimes[slot];
             break;
         }
         case XR_ACTION_TYPE_POSE_INPUT: {
+            state->poseState.isActive = isActive[slot];
             break;
         }
     }
@@ -734,164 +440,94 @@ void LogWindowsError(HRESULT result, const char *xrfunc, const char* what, const
     LocalFree(messageBuf);
 }
 
-static std::map<DXGI_FORMAT, DXGI_FORMAT> TypedFormatToTypelessFormat = {
-    { DXGI_FORMAT_R32G32B32A32_FLOAT, DXGI_FORMAT_R32G32B32A32_TYPELESS },
-    { DXGI_FORMAT_R32G32B32A32_UINT, DXGI_FORMAT_R32G32B32A32_TYPELESS },
-    { DXGI_FORMAT_R32G32B32A32_SINT, DXGI_FORMAT_R32G32B32A32_TYPELESS },
-    { DXGI_FORMAT_R32G32B32_FLOAT, DXGI_FORMAT_R32G32B32_TYPELESS },
-    { DXGI_FORMAT_R32G32B32_UINT, DXGI_FORMAT_R32G32B32_TYPELESS },
-    { DXGI_FORMAT_R32G32B32_SINT, DXGI_FORMAT_R32G32B32_TYPELESS },
-    { DXGI_FORMAT_R16G16B16A16_FLOAT, DXGI_FORMAT_R16G16B16A16_TYPELESS },
-    { DXGI_FORMAT_R16G16B16A16_UNORM, DXGI_FORMAT_R16G16B16A16_TYPELESS },
-    { DXGI_FORMAT_R16G16B16A16_UINT, DXGI_FORMAT_R16G16B16A16_TYPELESS },
-    { DXGI_FORMAT_R16G16B16A16_SNORM, DXGI_FORMAT_R16G16B16A16_TYPELESS },
-    { DXGI_FORMAT_R16G16B16A16_SINT, DXGI_FORMAT_R16G16B16A16_TYPELESS },
-    { DXGI_FORMAT_R32G32_FLOAT, DXGI_FORMAT_R32G32_TYPELESS },
-    { DXGI_FORMAT_R32G32_UINT, DXGI_FORMAT_R32G32_TYPELESS },
-    { DXGI_FORMAT_R32G32_SINT, DXGI_FORMAT_R32G32_TYPELESS },
-    { DXGI_FORMAT_D32_FLOAT_S8X24_UINT, DXGI_FORMAT_R32G8X24_TYPELESS },
-    { DXGI_FORMAT_R32_FLOAT_X8X24_TYPELESS, DXGI_FORMAT_R32G8X24_TYPELESS },
-    { DXGI_FORMAT_X32_TYPELESS_G8X24_UINT, DXGI_FORMAT_R32G8X24_TYPELESS },
-    { DXGI_FORMAT_R10G10B10A2_UNORM, DXGI_FORMAT_R10G10B10A2_TYPELESS },
-    { DXGI_FORMAT_R10G10B10A2_UINT, DXGI_FORMAT_R10G10B10A2_TYPELESS },
-    { DXGI_FORMAT_R8G8B8A8_UNORM, DXGI_FORMAT_R8G8B8A8_TYPELESS },
-    { DXGI_FORMAT_R8G8B8A8_UNORM_SRGB, DXGI_FORMAT_R8G8B8A8_TYPELESS },
-    { DXGI_FORMAT_R8G8B8A8_UINT, DXGI_FORMAT_R8G8B8A8_TYPELESS },
-    { DXGI_FORMAT_R8G8B8A8_SNORM, DXGI_FORMAT_R8G8B8A8_TYPELESS },
-    { DXGI_FORMAT_R8G8B8A8_SINT, DXGI_FORMAT_R8G8B8A8_TYPELESS },
-    { DXGI_FORMAT_R16G16_FLOAT, DXGI_FORMAT_R16G16_TYPELESS },
-    { DXGI_FORMAT_R16G16_UNORM, DXGI_FORMAT_R16G16_TYPELESS },
-    { DXGI_FORMAT_R16G16_UINT, DXGI_FORMAT_R16G16_TYPELESS },
-    { DXGI_FORMAT_R16G16_SNORM, DXGI_FORMAT_R16G16_TYPELESS },
-    { DXGI_FORMAT_R16G16_SINT, DXGI_FORMAT_R16G16_TYPELESS },
-    { DXGI_FORMAT_D32_FLOAT, DXGI_FORMAT_R32_TYPELESS },
-    { DXGI_FORMAT_R32_FLOAT, DXGI_FORMAT_R32_TYPELESS },
-    { DXGI_FORMAT_R32_UINT, DXGI_FORMAT_R32_TYPELESS },
-    { DXGI_FORMAT_R32_SINT, DXGI_FORMAT_R32_TYPELESS },
-    { DXGI_FORMAT_D24_UNORM_S8_UINT, DXGI_FORMAT_R24G8_TYPELESS },
-    { DXGI_FORMAT_R24_UNORM_X8_TYPELESS, DXGI_FORMAT_R24G8_TYPELESS },
-    { DXGI_FORMAT_X24_TYPELESS_G8_UINT, DXGI_FORMAT_R24G8_TYPELESS },
-    { DXGI_FORMAT_R8G8_UNORM, DXGI_FORMAT_R8G8_TYPELESS },
-    { DXGI_FORMAT_R8G8_UINT, DXGI_FORMAT_R8G8_TYPELESS },
-    { DXGI_FORMAT_R8G8_SNORM, DXGI_FORMAT_R8G8_TYPELESS },
-    { DXGI_FORMAT_R8G8_SINT, DXGI_FORMAT_R8G8_TYPELESS },
-    { DXGI_FORMAT_R16_FLOAT, DXGI_FORMAT_R16_TYPELESS, },
-    { DXGI_FORMAT_D16_UNORM, DXGI_FORMAT_R16_TYPELESS, },
-    { DXGI_FORMAT_R16_UNORM, DXGI_FORMAT_R16_TYPELESS, },
-    { DXGI_FORMAT_R16_UINT, DXGI_FORMAT_R16_TYPELESS, },
-    { DXGI_FORMAT_R16_SNORM, DXGI_FORMAT_R16_TYPELESS, },
-    { DXGI_FORMAT_R16_SINT, DXGI_FORMAT_R16_TYPELESS, },
-    { DXGI_FORMAT_R8_UNORM, DXGI_FORMAT_R8_TYPELESS },
-    { DXGI_FORMAT_R8_UINT, DXGI_FORMAT_R8_TYPELESS },
-    { DXGI_FORMAT_R8_SNORM, DXGI_FORMAT_R8_TYPELESS },
-    { DXGI_FORMAT_R8_SINT, DXGI_FORMAT_R8_TYPELESS },
-    { DXGI_FORMAT_A8_UNORM, DXGI_FORMAT_R8_TYPELESS },
-    { DXGI_FORMAT_BC1_UNORM, DXGI_FORMAT_BC1_TYPELESS },
-    { DXGI_FORMAT_BC1_UNORM_SRGB, DXGI_FORMAT_BC1_TYPELESS },
-    { DXGI_FORMAT_BC2_UNORM, DXGI_FORMAT_BC2_TYPELESS },
-    { DXGI_FORMAT_BC2_UNORM_SRGB, DXGI_FORMAT_BC2_TYPELESS },
-    { DXGI_FORMAT_BC3_UNORM, DXGI_FORMAT_BC3_TYPELESS },
-    { DXGI_FORMAT_BC3_UNORM_SRGB, DXGI_FORMAT_BC3_TYPELESS },
-    { DXGI_FORMAT_BC4_UNORM, DXGI_FORMAT_BC4_TYPELESS },
-    { DXGI_FORMAT_BC4_SNORM, DXGI_FORMAT_BC4_TYPELESS },
-    { DXGI_FORMAT_BC5_UNORM, DXGI_FORMAT_BC5_TYPELESS },
-    { DXGI_FORMAT_BC5_SNORM, DXGI_FORMAT_BC5_TYPELESS },
-    // DXGI_FORMAT_B5G6R5_UNORM,
-    // DXGI_FORMAT_B5G5R5A1_UNORM,
-    // DXGI_FORMAT_B8G8R8A8_UNORM,
-    // DXGI_FORMAT_B8G8R8X8_UNORM,
-    // DXGI_FORMAT_R10G10B10_XR_BIAS_A2_UNORM,
-    { DXGI_FORMAT_B8G8R8A8_UNORM_SRGB, DXGI_FORMAT_B8G8R8A8_TYPELESS },
-    { DXGI_FORMAT_B8G8R8X8_UNORM_SRGB, DXGI_FORMAT_B8G8R8X8_TYPELESS },
-    { DXGI_FORMAT_BC6H_UF16, DXGI_FORMAT_BC6H_TYPELESS },
-    { DXGI_FORMAT_BC6H_SF16, DXGI_FORMAT_BC6H_TYPELESS },
-    { DXGI_FORMAT_BC7_UNORM, DXGI_FORMAT_BC7_TYPELESS },
-    { DXGI_FORMAT_BC7_UNORM_SRGB, DXGI_FORMAT_BC7_TYPELESS },
-    // DXGI_FORMAT_AYUV,
-    // DXGI_FORMAT_Y410,
-    // DXGI_FORMAT_Y416,
-    // DXGI_FORMAT_NV12,
-    // DXGI_FORMAT_P010,
-    // DXGI_FORMAT_P016,
-    // DXGI_FORMAT_420_OPAQUE,
-    // DXGI_FORMAT_YUY2,
-    // DXGI_FORMAT_Y210,
-    // DXGI_FORMAT_Y216,
-    // DXGI_FORMAT_NV11,
-    // DXGI_FORMAT_AI44,
-    // DXGI_FORMAT_IA44,
-    // DXGI_FORMAT_P8,
-    // DXGI_FORMAT_A8P8,
-    // DXGI_FORMAT_B4G4R4A4_UNORM,
-    // DXGI_FORMAT_P208,
-    // DXGI_FORMAT_V208,
-    // DXGI_FORMAT_V408,
-    // DXGI_FORMAT_SAMPLER_FEEDBACK_MIN_MIP_OPAQUE,
-    // DXGI_FORMAT_SAMPLER_FEEDBACK_MIP_REGION_USED_OPAQUE,
-    // DXGI_FORMAT_FORCE_UINT
-};
-
-bool OverlaySwapchain::CreateTextures(XrInstance instance, ID3D11Device *d3d11, DWORD mainProcessId)
-{
-    for(int i = 0; i < swapchainTextures.size(); i++) {
-        D3D11_TEXTURE2D_DESC desc;
-        desc.Width = width;
-        desc.Height = height;
-        desc.MipLevels = desc.ArraySize = 1;
-        desc.SampleDesc.Count = 1;
-        desc.SampleDesc.Quality = 0;
-        desc.Usage = D3D11_USAGE_DEFAULT;
-        desc.BindFlags = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_RENDER_TARGET;
-        desc.CPUAccessFlags = 0;
-        desc.MiscFlags = D3D11_RESOURCE_MISC_SHARED_NTHANDLE | D3D11_RESOURCE_MISC_SHARED_KEYEDMUTEX;
-
-        if(TypedFormatToTypelessFormat.count(format) > 0) {
-            desc.Format = TypedFormatToTypelessFormat.at(format);
-        } else {
-            desc.Format = format;
-        }
+// Tell Main to close its side of images leaving the pool; the caller's
+// images must stay alive until then, or their handle values could be reused
+static void DiscardPooledSharedImages(XrInstance instance, const std::vector<OverlaySharedImagePool::Entry>& discarded)
+{
+    if(discarded.empty()) {
+        return;
+    }
+    std::vector<HANDLE> handles;
+    for(const auto& entry: discarded) {
+        handles.push_back(entry.handle.image);
+    }
+    XrResult result = RPCCallDiscardSharedImages(instance, (uint32_t)handles.size(), handles.data());
+    if(!XR_SUCCEEDED(result)) {
+        OverlaysLayerLogMessage(instance, XR_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT, "xrDestroySwapchain",
+            OverlaysLayerNoObjectInfo, "Couldn't tell the main process to discard pooled swapchain images");
+    }
+}
 
-        HRESULT result;
-        if((result = d3d11->CreateTexture2D(&desc, NULL, &swapchainTextures[i])) != S_OK) {
-            LogWindowsError(result, "xrCreateSwapchain", "CreateTexture2D", __FILE__, __LINE__);
-            return false;
-        }
+bool OverlaySwapchain::CreateImages(XrInstance instance, const GraphicsPeer& mainProcess, OverlaySharedImagePool& pool)
+{
+    SharedImageDesc desc = GetDesc();
 
-        {
-            IDXGIResource1* sharedResource = NULL;
-            if((result = swapchainTextures[i]->QueryInterface(__uuidof(IDXGIResource1), (LPVOID*) &sharedResource)) != S_OK) {
-                LogWindowsError(result, "xrCreateSwapchain", "QueryInterface", __FILE__, __LINE__);
-                return false;
+    {
+        // Take every image from the pool or none of them, newest first
+        std::unique_lock<std::mutex> lock(pool.mutex);
+        std::vector<size_t> matches;
+        for(size_t i = pool.entries.size(); (i > 0) && (matches.size() < swapchainImages.size()); i--) {
+            const auto& entry = pool.entries[i - 1];
+            if((entry.backend == backend) && (entry.desc == desc)) {
+                matches.push_back(i - 1);
             }
-
-            HANDLE thisProcessHandle = GetCurrentProcess();
-            HANDLE hostProcessHandle;
-            hostProcessHandle = OpenProcess(PROCESS_ALL_ACCESS, TRUE, mainProcessId);
-            if(hostProcessHandle == NULL) {
-                LogWindowsLastError("xrCreateSwapchain", "OpenProcess", __FILE__, __LINE__);
-                return false;
+        }
+        if(matches.size() == swapchainImages.size()) {
+            for(size_t i = 0; i < matches.size(); i++) {
+                auto& entry = pool.entries[matches[i]];
+                swapchainImages[i] = entry.image;
+                swapchainHandles[i] = entry.handle;
+                releaseCounts[i] = entry.releaseCount;
             }
+            // matches are in decreasing order, so erasing doesn't move the ones left
+            for(size_t index: matches) {
+                pool.entries.erase(pool.entries.begin() + index);
+            }
+            return true;
+        }
+    }
 
-            HANDLE handle;
+    return backend->CreateSharedImages(desc, (uint32_t)swapchainImages.size(), mainProcess, swapchainImages, swapchainHandles);
+}
 
-            // Get the Shared Handle for the texture. This is still local to this process but is an actual HANDLE
-            if((result = sharedResource->CreateSharedHandle(NULL,
-                DXGI_SHARED_RESOURCE_READ, // GENERIC_ALL | DXGI_SHARED_RESOURCE_READ | DXGI_SHARED_RESOURCE_WRITE,
-                NULL, &handle)) != S_OK) {
+void OverlaySwapchain::RecycleImages(XrInstance instance, OverlaySharedImagePool& pool)
+{
+    // Main owns images it created
+    if(zeroCopy) {
+        return;
+    }
 
-                LogWindowsError(result, "xrCreateSwapchain", "CreateSharedHandle", __FILE__, __LINE__);
-                return false;
-            }
-            
-            // Duplicate the handle so "Host" RPC service process can use it
-            if(!DuplicateHandle(thisProcessHandle, handle, hostProcessHandle, &swapchainHandles[i], 0, TRUE, DUPLICATE_SAME_ACCESS)) {
-                LogWindowsLastError("xrCreateSwapchain", "DuplicateHandle", __FILE__, __LINE__);
-                return false;
-            }
-            CloseHandle(handle);
-            sharedResource->Release();
+    std::vector<OverlaySharedImagePool::Entry> discarded;
+    {
+        std::unique_lock<std::mutex> lock(pool.mutex);
+        for(size_t i = 0; i < swapchainImages.size(); i++) {
+            pool.entries.push_back({backend, GetDesc(), swapchainImages[i], swapchainHandles[i], releaseCounts[i]});
+        }
+        while(pool.entries.size() > OverlaySharedImagePool::maxImages) {
+            discarded.push_back(pool.entries.front());
+            pool.entries.pop_front();
+        }
+    }
+    swapchainImages.clear();
+
+    DiscardPooledSharedImages(instance, discarded);
+}
+
+bool OverlaySwapchain::OpenImages(XrInstance instance, const GraphicsPeer& mainProcess, const std::vector<SharedImageHandle>& handles)
+{
+    std::vector<SharedImageHandle> received = handles;
+    if(!ReceivePeerHandles(mainProcess, received, SharedImageWaitTimeoutMs)) {
+        return false;
+    }
+
+    for(size_t i = 0; i < handles.size(); i++) {
+        swapchainImages[i] = backend->OpenSharedImage(received[i], GetDesc(), mainProcess);
+        if(!swapchainImages[i]) {
+            return false;
         }
+        swapchainHandles[i] = handles[i];
     }
+    zeroCopy = true;
     return true;
 }
 
@@ -966,58 +602,68 @@ OptionalSessionStateChange SessionStateTracker::GetAndDoPendingStateChange(MainS
 }
 
 
-SwapchainCachedData::~SwapchainCachedData()
+void SwapchainImageDamage::Add(const XrRect2Di* newRects, uint32_t count)
 {
-    for(HANDLE acquired : remoteImagesAcquired) {
-        IDXGIKeyedMutex* keyedMutex;
-        ID3D11Texture2D *sharedTexture;
-        auto it = handleTextureMap.find(acquired);
-        if(it != handleTextureMap.end()) {
-            sharedTexture = it->second;
-            HRESULT result = sharedTexture->QueryInterface( __uuidof(IDXGIKeyedMutex), (LPVOID*)&keyedMutex);
-            if(result == S_OK) {
-                keyedMutex->ReleaseSync(KEYED_MUTEX_OVERLAY);
-                keyedMutex->Release();
-            }
+    if(wholeImage) {
+        return;
+    }
+
+    rects.insert(rects.end(), newRects, newRects + count);
+
+    if(rects.size() > maxRects) {
+        int64_t left = rects[0].offset.x;
+        int64_t top = rects[0].offset.y;
+        int64_t right = left + rects[0].extent.width;
+        int64_t bottom = top + rects[0].extent.height;
+        for(const auto& rect: rects) {
+            left = std::min<int64_t>(left, rect.offset.x);
+            top = std::min<int64_t>(top, rect.offset.y);
+            right = std::max<int64_t>(right, int64_t(rect.offset.x) + rect.extent.width);
+            bottom = std::max<int64_t>(bottom, int64_t(rect.offset.y) + rect.extent.height);
         }
+        XrRect2Di bounds { { (int32_t)left, (int32_t)top }, { (int32_t)(right - left), (int32_t)(bottom - top) } };
+        rects.assign(1, bounds);
     }
-    remoteImagesAcquired.clear();
-    for(auto shared : handleTextureMap) {
-        shared.second->Release();
-        CloseHandle(shared.first);
-    }
-    for(auto texture : swapchainImages) {
-        texture->Release();
-    }
-    handleTextureMap.clear();
 }
 
-ID3D11Texture2D* SwapchainCachedData::getSharedTexture(ID3D11Device *d3d11Device, HANDLE sourceHandle)
+// Open all of the Overlay's images up front, so Main's frame never waits on opening one
+bool SwapchainCachedData::openSharedImages(const HANDLE* images, const HANDLE* fences, uint32_t count, MainSharedImagePool& pool)
 {
-    ID3D11Texture2D *sharedTexture;
+    sharedImages.resize(count);
+    sharedHandles.resize(count);
+    releaseCounts.assign(count, 0);
 
-    ID3D11Device1 *device1;
+    std::vector<uint32_t> toOpen;
+    std::vector<SharedImageHandle> received;
+    for(uint32_t i = 0; i < count; i++) {
+        sharedHandles[i] = SharedImageHandle { images[i], fences[i] };
+
+        // The Overlay may have recycled the image from a destroyed swapchain
+        auto pooled = pool.find(images[i]);
+        if(pooled != pool.end()) {
+            sharedImages[i] = pooled->second.image;
+            releaseCounts[i] = pooled->second.releaseCount;
+            pool.erase(pooled);
+            continue;
+        }
 
-    HRESULT result;
+        toOpen.push_back(i);
+        received.push_back(sharedHandles[i]);
+    }
 
-    if((result = d3d11Device->QueryInterface(__uuidof (ID3D11Device1), (void **)&device1)) != S_OK) {
-        LogWindowsError(result, nullptr, "QueryInterface", __FILE__, __LINE__);
-        return nullptr;
+    // The Overlay shared the ones it just created together
+    if(!received.empty() && !ReceivePeerHandles(overlayProcess, received, SharedImageWaitTimeoutMs)) {
+        return false;
     }
 
-    auto it = handleTextureMap.find(sourceHandle);
-    if(it == handleTextureMap.end()) {
-        if((result = device1->OpenSharedResource1(sourceHandle, __uuidof(ID3D11Texture2D), (LPVOID*) &sharedTexture)) != S_OK) {
-            LogWindowsError(result, nullptr, "OpenSharedResource1", __FILE__, __LINE__);
-            return nullptr;
+    for(size_t j = 0; j < toOpen.size(); j++) {
+        sharedImages[toOpen[j]] = backend->OpenSharedImage(received[j], desc, overlayProcess);
+        if(!sharedImages[toOpen[j]]) {
+            return false;
         }
-        handleTextureMap.insert({sourceHandle, sharedTexture});
-    } else  {
-        sharedTexture = it->second;
     }
-    device1->Release();
 
-    return sharedTexture;
+    return true;
 }
 
 
@@ -1236,6 +882,31 @@ XrResult OverlaysLayerXrCreateApiLayerInstance(const XrInstanceCreateInfo *insta
             OverlaysLayerNoObjectInfo, fmt("gSynchronizeEveryProc set to %s", gSynchronizeEveryProc ? "true" : "false").c_str());
     }
 
+    const char *sync_every_locate_env = getenv("OVERLAYS_API_LAYER_SYNC_EVERY_LOCATE");
+    if(sync_every_locate_env) {
+        std::string sync_every_locate = sync_every_locate_env;
+        std::set<std::string> truths {"true", "TRUE", "True", "1", "yes"};
+        gSyncActionsEveryLocate = (truths.count(sync_every_locate) > 0);
+        OverlaysLayerLogMessage(XR_NULL_HANDLE, XR_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT, "xrCreateInstance", 
+            OverlaysLayerNoObjectInfo, fmt("gSyncActionsEveryLocate set to %s", gSyncActionsEveryLocate ? "true" : "false").c_str());
+    }
+
+    const char *extrapolation_env = getenv("OVERLAYS_API_LAYER_POSE_EXTRAPOLATION_MS");
+    if(extrapolation_env) {
+        gPoseExtrapolationWindow = std::max((XrDuration)0, (XrDuration)(atof(extrapolation_env) * 1000000.0));
+        OverlaysLayerLogMessage(XR_NULL_HANDLE, XR_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT, "xrCreateInstance", 
+            OverlaysLayerNoObjectInfo, fmt("gPoseExtrapolationWindow set to %lld ns", (long long)gPoseExtrapolationWindow).c_str());
+    }
+
+    const char *lazy_placeholders_env = getenv("OVERLAYS_API_LAYER_LAZY_PLACEHOLDERS");
+    if(lazy_placeholders_env) {
+        std::string lazy_placeholders = lazy_placeholders_env;
+        std::set<std::string> truths {"true", "TRUE", "True", "1", "yes"};
+        gLazyPlaceholderActions = (truths.count(lazy_placeholders) > 0);
+        OverlaysLayerLogMessage(XR_NULL_HANDLE, XR_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT, "xrCreateInstance", 
+            OverlaysLayerNoObjectInfo, fmt("gLazyPlaceholderActions set to %s", gLazyPlaceholderActions ? "true" : "false").c_str());
+    }
+
     // Validate the API layer info and next API layer info structures before we try to use them
     if (!apiLayerInfo ||
         XR_LOADER_INTERFACE_STRUCT_API_LAYER_CREATE_INFO != apiLayerInfo->structType ||
@@ -1289,24 +960,21 @@ XrResult OverlaysLayerXrCreateApiLayerInstance(const XrInstanceCreateInfo *insta
 
     // Create XrPaths for well-known strings.  We can use the compile-time fixed string enums to pass strings and paths over RPC
     // XXX This should be on CreateInstance in the instance info
-    instanceInfo->OverlaysLayerWellKnownStringToPath.insert({WellKnownStringIndex::NULL_PATH, XR_NULL_PATH});
-    instanceInfo->OverlaysLayerPathToWellKnownString.insert({XR_NULL_PATH, WellKnownStringIndex::NULL_PATH});
-    for(auto& w : OverlaysLayerWellKnownStrings) {
+    instanceInfo->OverlaysLayerWellKnownStringToPath.assign(WellKnownStringCount, XR_NULL_PATH);
+    for(uint32_t i = 1; i < WellKnownStringCount; i++) {
         XrPath path;
-        XrResult result2 = instanceInfo->downchain->StringToPath(*instance, w.second, &path);
+        XrResult result2 = instanceInfo->downchain->StringToPath(*instance, OverlaysLayerWellKnownStrings[i], &path);
         if(result2 != XR_SUCCESS) {
             OverlaysLayerLogMessage(*instance, XR_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT, "xrCreateInstance", 
-                OverlaysLayerNoObjectInfo, fmt("Could not create path from \"%s\".", w.second).c_str());
+                OverlaysLayerNoObjectInfo, fmt("Could not create path from \"%s\".", OverlaysLayerWellKnownStrings[i]).c_str());
             return XR_ERROR_INITIALIZATION_FAILED;
         }
-        instanceInfo->OverlaysLayerWellKnownStringToPath.insert({w.first, path});
-        instanceInfo->OverlaysLayerPathToWellKnownString.insert({path, w.first});
+        instanceInfo->OverlaysLayerWellKnownStringToPath[i] = path;
     }
-    for(auto& id : PlaceholderActionIds) {
-        XrPath profilePath = instanceInfo->OverlaysLayerWellKnownStringToPath.at(id.interactionProfileString);
-        XrPath subactionPath = instanceInfo->OverlaysLayerWellKnownStringToPath.at(id.subActionString);
-        XrPath componentPath = instanceInfo->OverlaysLayerWellKnownStringToPath.at(id.componentString);
-        XrPath fullBindingPath = instanceInfo->OverlaysLayerWellKnownStringToPath.at(id.fullBindingString);
+    instanceInfo->OverlaysLayerPathToWellKnownString.Build(instanceInfo->OverlaysLayerWellKnownStringToPath);
+    for(const auto& binding : PlaceholderBindings) {
+        XrPath subactionPath = instanceInfo->OverlaysLayerWellKnownStringToPath.at(PlaceholderTopLevels[binding.topLevel]);
+        XrPath fullBindingPath = instanceInfo->OverlaysLayerWellKnownStringToPath.at(binding.fullBindingString);
 
         instanceInfo->OverlaysLayerBindingToSubaction.insert({fullBindingPath, subactionPath});
 
@@ -1334,6 +1002,19 @@ NegotiationChannels gNegotiationChannels;
 
 XrInstance gMainSessionInstance;
 MainSessionContext::Ptr gMainSessionContext;
+
+// Identifies the Main app's current frame, so SyncActions can be shared
+// within it; 0 if there's no Main session to count frames
+uint64_t GetMainFrameGeneration()
+{
+    auto mainSession = gMainSessionContext;
+    if(!mainSession) {
+        return 0;
+    }
+    auto l = mainSession->GetLock();
+    return mainSession->waitFrameCount + 1;
+}
+
 DWORD gMainProcessId;   // Set by Overlay to check for main process unexpected exit
 HANDLE gMainMutexHandle; // Held by Main for duration of operation as Main Session
 
@@ -1413,7 +1094,17 @@ bool OpenRPCChannels(XrInstance instance, DWORD otherProcessId, DWORD overlayId,
     ch.instance = instance;
 
     ch.otherProcessId = otherProcessId;
+    // Held for the life of the connection; shared swapchain images are duplicated into it
     ch.otherProcessHandle = OpenProcess(PROCESS_ALL_ACCESS, TRUE, ch.otherProcessId);
+    if (ch.otherProcessHandle == NULL) {
+        DWORD lastError = GetLastError();
+        LPVOID messageBuf;
+        FormatMessageA(FORMAT_MESSAGE_ALLOCATE_BUFFER | FORMAT_MESSAGE_FROM_SYSTEM | FORMAT_MESSAGE_IGNORE_INSERTS, nullptr, lastError, MAKELANGID(LANG_NEUTRAL, SUBLANG_DEFAULT), (LPSTR) &messageBuf, 0, nullptr);
+        OverlaysLayerLogMessage(instance, XR_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT, "no function", 
+            OverlaysLayerNoObjectInfo, fmt("Could not open the other process: OpenProcess error was %d (%s)", lastError, messageBuf).c_str());
+        LocalFree(messageBuf);
+        return false;
+    }
 
     ch.mutexHandle = CreateMutexA(NULL, TRUE, fmt(RPCChannels::mutexNameTemplate, overlayId).c_str());
     if (ch.mutexHandle == NULL) {
@@ -1523,6 +1214,23 @@ const T* FindStructInChain(const void *head, XrStructureType type)
     return nullptr;
 }
 
+// Unlink and free every structure of type after the head of a chain copied
+// with CopyXrStructChainWithMalloc, wherever it appears
+void RemoveStructsFromCopiedChain(XrInstance instance, XrBaseInStructure* head, XrStructureType type)
+{
+    XrBaseInStructure* p = head;
+    while(p->next) {
+        XrBaseInStructure* next = const_cast<XrBaseInStructure*>(p->next);
+        if(next->type == type) {
+            p->next = next->next;
+            next->next = nullptr;
+            FreeXrStructChainWithFree(instance, next);
+        } else {
+            p = next;
+        }
+    }
+}
+
 bool FindExtensionInList(const char* extension, uint32_t extensionsCount, const char * const* extensions)
 {
     for(uint32_t i = 0; i < extensionsCount; i++) {
@@ -1789,6 +1497,24 @@ bool CreateMainSessionNegotiateThread(XrInstance instance, XrSession hostingSess
     return true;
 }
 
+GraphicsBackend::Ptr CreateGraphicsBackendForSession(XrInstance instance, const XrSessionCreateInfo* createInfo, ID3D11Device *d3d11Device)
+{
+    auto errorFunc = [instance](const char* xrfunc, const char* message) {
+        OverlaysLayerLogMessage(instance, XR_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT, xrfunc, OverlaysLayerNoObjectInfo, message);
+    };
+    if(d3d11Device) {
+        return CreateD3D11GraphicsBackend(d3d11Device, errorFunc);
+    }
+#if defined(XR_USE_GRAPHICS_API_VULKAN)
+    const XrGraphicsBindingVulkanKHR* vulkanBinding = FindStructInChain<XrGraphicsBindingVulkanKHR>(createInfo->next, XR_TYPE_GRAPHICS_BINDING_VULKAN_KHR);
+    if(vulkanBinding) {
+        return CreateVulkanGraphicsBackend(vulkanBinding, errorFunc);
+    }
+#endif
+    // Headless session; nothing samples the images, keep them in shared memory
+    return CreateCpuGraphicsBackend(errorFunc);
+}
+
 XrResult OverlaysLayerCreateSessionMain(XrInstance instance, const XrSessionCreateInfo* createInfo, XrSession* session, ID3D11Device *d3d11Device)
 {
     auto synchronizeEveryProcLock = gSynchronizeEveryProc ? std::unique_lock<std::recursive_mutex>(gSynchronizeEveryProcMutex) : std::unique_lock<std::recursive_mutex>();
@@ -1813,17 +1539,23 @@ XrResult OverlaysLayerCreateSessionMain(XrInstance instance, const XrSessionCrea
     info->localHandle = *session;
     info->isProxied = false;
     info->d3d11Device = d3d11Device;
+    info->graphicsBackend = CreateGraphicsBackendForSession(instance, createInfo, d3d11Device);
+    if(!info->graphicsBackend) {
+        return XR_ERROR_GRAPHICS_DEVICE_INVALID;
+    }
 
-    ID3D11Multithread* d3dMultithread;
-    HRESULT hr = d3d11Device->QueryInterface(__uuidof(ID3D11Multithread), reinterpret_cast<void**>(&d3dMultithread));
-    if(hr != S_OK) {
-        LogWindowsError(hr, "xrCreateSession", "QueryInterface", __FILE__, __LINE__);
-        return XR_ERROR_RUNTIME_FAILURE;
+    if(d3d11Device) {
+        ID3D11Multithread* d3dMultithread;
+        HRESULT hr = d3d11Device->QueryInterface(__uuidof(ID3D11Multithread), reinterpret_cast<void**>(&d3dMultithread));
+        if(hr != S_OK) {
+            LogWindowsError(hr, "xrCreateSession", "QueryInterface", __FILE__, __LINE__);
+            return XR_ERROR_RUNTIME_FAILURE;
+        }
+        d3dMultithread->SetMultithreadProtected(TRUE);
+        d3dMultithread->Release();
     }
-    d3dMultithread->SetMultithreadProtected(TRUE);
-    d3dMultithread->Release();
 
-    // create placeholder Actions
+    // create placeholder ActionSet
 
     XrActionSetCreateInfo createActionSetInfo { XR_TYPE_ACTION_SET_CREATE_INFO, nullptr, "overlaysapilayer", "overlays API layer synthetic actionset", 1 };
     XrResult result2 = instanceInfo->downchain->CreateActionSet(instance, &createActionSetInfo, &info->placeholderActionSet);
@@ -1833,37 +1565,7 @@ XrResult OverlaysLayerCreateSessionMain(XrInstance instance, const XrSessionCrea
         return XR_ERROR_INITIALIZATION_FAILED;
     }
 
-    int i=1;
-    for(auto& id : PlaceholderActionIds) {
-        char placeholderNameString[64];
-        sprintf(placeholderNameString, "overlays%d", i++);
-
-        XrActionCreateInfo createActionInfo { XR_TYPE_ACTION_CREATE_INFO };
-        strcpy(createActionInfo.actionName, placeholderNameString);
-        strcpy(createActionInfo.localizedActionName, placeholderNameString);
-        createActionInfo.actionType = id.type;
-        createActionInfo.countSubactionPaths = 1;
-        XrPath subactionPath = instanceInfo->OverlaysLayerWellKnownStringToPath.at(id.subActionString);
-        createActionInfo.subactionPaths = &subactionPath;
-
-        XrAction action;
-        XrResult result2 = instanceInfo->downchain->CreateAction(info->placeholderActionSet, &createActionInfo, &action);
-        if(result2 != XR_SUCCESS) {
-            OverlaysLayerLogMessage(instance, XR_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT, "xrCreateSession", 
-                OverlaysLayerNoObjectInfo, fmt("Could not create session placeholder action for %s.", id.name).c_str());
-            return XR_ERROR_INITIALIZATION_FAILED;
-        }
-
-        XrPath fullBindingPath = instanceInfo->OverlaysLayerWellKnownStringToPath.at(id.fullBindingString);
-        XrPath interactionProfilePath = instanceInfo->OverlaysLayerWellKnownStringToPath.at(id.interactionProfileString);
-
-        info->placeholderActions.insert({fullBindingPath, {action, id.type}});
-        info->placeholderActionsByProfileAndFullBinding.insert({{interactionProfilePath, fullBindingPath}, {action, id.type}});
-        info->placeholderActionNames.insert({action, id.name});
-
-        info->bindingsByProfile[interactionProfilePath].push_back({action, fullBindingPath});
-        info->bindingsByAction[action] = fullBindingPath;
-    }
+    // placeholder Actions are created in xrAttachSessionActionSets for the bindings Overlays have asked for by then
 
     for(XrPath p: instanceInfo->OverlaysLayerAllSubactionPaths) {
         info->currentInteractionProfileBySubactionPath.insert({p, XR_NULL_PATH});
@@ -2016,6 +1718,10 @@ XrResult OverlaysLayerCreateSessionOverlay(
     info->localHandle = *session;
     info->isProxied = true;
     info->d3d11Device = d3d11Device;
+    info->graphicsBackend = CreateGraphicsBackendForSession(instance, createInfo, d3d11Device);
+    if(!info->graphicsBackend) {
+        return XR_ERROR_GRAPHICS_DEVICE_INVALID;
+    }
 
     for(XrPath p: instanceInfo->OverlaysLayerAllSubactionPaths) {
         info->currentInteractionProfileBySubactionPath.insert({p, XR_NULL_PATH});
@@ -2043,7 +1749,9 @@ XrResult OverlaysLayerCreateSession(XrInstance instance, const XrSessionCreateIn
             // XXX save off requested API in Overlay, match against Main API
             // XXX save off requested API in Main, match against Overlay API
             if( (p->type == XR_TYPE_GRAPHICS_BINDING_D3D12_KHR) ||
+#if !defined(XR_USE_GRAPHICS_API_VULKAN)
                 (p->type == XR_TYPE_GRAPHICS_BINDING_VULKAN_KHR) ||
+#endif
                 (p->type == XR_TYPE_GRAPHICS_BINDING_OPENGL_WIN32_KHR) ||
                 (p->type == XR_TYPE_GRAPHICS_BINDING_OPENGL_XLIB_KHR) ||
                 (p->type == XR_TYPE_GRAPHICS_BINDING_OPENGL_XCB_KHR) ||
@@ -2060,11 +1768,11 @@ XrResult OverlaysLayerCreateSession(XrInstance instance, const XrSessionCreateIn
 
         if(!cio) {
             if(PrintDebugInfo) OverlaysLayerLogMessage(XR_NULL_HANDLE, XR_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT, "xrCreateSession", OverlaysLayerNoObjectInfo, "Creating Main Session");  // XXX DEBUG
-            result = OverlaysLayerCreateSessionMain(instance, createInfo, session, d3dbinding->device);
+            result = OverlaysLayerCreateSessionMain(instance, createInfo, session, d3dbinding ? d3dbinding->device : nullptr);
             if(PrintDebugInfo) OverlaysLayerLogMessage(XR_NULL_HANDLE, XR_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT, "xrCreateSession", OverlaysLayerNoObjectInfo, fmt("result of Create Main Session is %d, session is %08X", result, *session).c_str());  // XXX DEBUG
         } else {
             if(PrintDebugInfo) OverlaysLayerLogMessage(XR_NULL_HANDLE, XR_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT, "xrCreateSession", OverlaysLayerNoObjectInfo, "Creating Overlay Session");  // XXX DEBUG
-            result = OverlaysLayerCreateSessionOverlay(instance, createInfo, session, cio, d3dbinding->device);
+            result = OverlaysLayerCreateSessionOverlay(instance, createInfo, session, cio, d3dbinding ? d3dbinding->device : nullptr);
             if(PrintDebugInfo) OverlaysLayerLogMessage(XR_NULL_HANDLE, XR_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT, "xrCreateSession", OverlaysLayerNoObjectInfo, fmt("result of Create Overlay Session is %d, session is %08X", result, *session).c_str());  // XXX DEBUG
         }
 
@@ -2106,30 +1814,78 @@ XrResult OverlaysLayerCreateSwapchainMainAsOverlay(ConnectionToOverlay::Ptr conn
         return result;
     }
 
-    std::vector<XrSwapchainImageD3D11KHR> swapchainImages(count);
-    std::vector<ID3D11Texture2D*> swapchainTextures(count);
-    for(uint32_t i = 0; i < count; i++) {
-        swapchainImages[i].type = XR_TYPE_SWAPCHAIN_IMAGE_D3D11_KHR;
-        swapchainImages[i].next = nullptr;
-    }
-    result = sessionInfo->downchain->EnumerateSwapchainImages(actualHandle, count, &count, reinterpret_cast<XrSwapchainImageBaseHeader*>(swapchainImages.data()));
-    if(!XR_SUCCEEDED(result)) {
-        OverlaysLayerLogMessage(XR_NULL_HANDLE, XR_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT, "xrCreateSwapchain",
-            OverlaysLayerNoObjectInfo, "Couldn't call EnumerateSwapchainImages to get swapchain images.");
-        return result;
-    }
+    GraphicsBackend::Ptr backend = sessionInfo->graphicsBackend;
+    std::vector<GraphicsImage::Ptr> swapchainImages(count);
+    std::vector<SharedImageHandle> sharedHandles;
+    SharedImageDesc desc { createInfo->width, createInfo->height, createInfo->format, createInfo->arraySize, createInfo->mipCount, createInfo->sampleCount };
 
-    for(uint32_t i = 0; i < count; i++) {
-        swapchainTextures[i] = swapchainImages[i].texture;
+    if(backend->GetSwapchainImageType() == XR_TYPE_UNKNOWN) {
+
+        // The runtime can't hand us images of this backend, so we make stand-ins.
+        // If they can be shared, the Overlay renders straight into them and nothing is copied.
+        // Only the CPU backend gets here; images the runtime allocates are
+        // never shareable, so D3D11 and Vulkan swapchains are always copied.
+        if(backend->CanShareSwapchainImages()) {
+            if(!backend->CreateSharedImages(desc, count, connection->conn.GetGraphicsPeer(), swapchainImages, sharedHandles)) {
+                return XR_ERROR_RUNTIME_FAILURE;
+            }
+        } else {
+            for(uint32_t i = 0; i < count; i++) {
+                swapchainImages[i] = backend->CreateLocalImage(desc);
+                if(!swapchainImages[i]) {
+                    return XR_ERROR_RUNTIME_FAILURE;
+                }
+            }
+        }
+
+    } else {
+
+        size_t structSize = backend->GetSwapchainImageStructSize();
+        std::vector<uint8_t> imageStructs(structSize * count);
+        for(uint32_t i = 0; i < count; i++) {
+            auto image = reinterpret_cast<XrSwapchainImageBaseHeader*>(imageStructs.data() + structSize * i);
+            image->type = backend->GetSwapchainImageType();
+            image->next = nullptr;
+        }
+        result = sessionInfo->downchain->EnumerateSwapchainImages(actualHandle, count, &count, reinterpret_cast<XrSwapchainImageBaseHeader*>(imageStructs.data()));
+        if(!XR_SUCCEEDED(result)) {
+            OverlaysLayerLogMessage(XR_NULL_HANDLE, XR_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT, "xrCreateSwapchain",
+                OverlaysLayerNoObjectInfo, "Couldn't call EnumerateSwapchainImages to get swapchain images.");
+            return result;
+        }
+
+        for(uint32_t i = 0; i < count; i++) {
+            swapchainImages[i] = backend->WrapSwapchainImage(reinterpret_cast<XrSwapchainImageBaseHeader*>(imageStructs.data() + structSize * i));
+        }
     }
 
     *swapchainCount = count;
 
     OverlaysLayerXrSwapchainHandleInfo::Ptr swapchainInfo = std::make_shared<OverlaysLayerXrSwapchainHandleInfo>(session, sessionInfo->parentInstance, sessionInfo->downchain);
-    swapchainInfo->mainAsOverlaySwapchain = std::make_shared<SwapchainCachedData>(*swapchain, swapchainTextures);
+    swapchainInfo->mainAsOverlaySwapchain = std::make_shared<SwapchainCachedData>(*swapchain, backend, connection->conn.GetGraphicsPeer(), swapchainImages, desc);
+    if(!sharedHandles.empty()) {
+        auto& mainAsOverlaySwapchain = swapchainInfo->mainAsOverlaySwapchain;
+        mainAsOverlaySwapchain->zeroCopy = true;
+        mainAsOverlaySwapchain->sharedImages = swapchainImages;
+        mainAsOverlaySwapchain->sharedHandles = sharedHandles;
+        mainAsOverlaySwapchain->releaseCounts.assign(count, 0);
+    }
     swapchainInfo->actualHandle = actualHandle;
     swapchainInfo->localHandle = localHandle;
 
+    {
+        auto mainSession = gMainSessionContext;
+        auto lock = mainSession->GetLock();
+        uint32_t slot = mainSession->AllocateSwapchainSlot(swapchainInfo);
+        if(slot == MainSessionContext::invalidSwapchainSlot) {
+            OverlaysLayerLogMessage(XR_NULL_HANDLE, XR_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT, "xrCreateSwapchain",
+                OverlaysLayerNoObjectInfo, fmt("Overlay swapchain count would exceed the API layer's limit of %d.", MainSessionContext::maxSwapchainSlots).c_str());
+            sessionInfo->downchain->DestroySwapchain(actualHandle);
+            return XR_ERROR_LIMIT_REACHED;
+        }
+        swapchainInfo->mainAsOverlaySwapchain->inFlightSlot = slot;
+    }
+
     OverlaysLayerAddHandleInfoForXrSwapchain(*swapchain, swapchainInfo);
 
     return result;
@@ -2164,12 +1920,47 @@ XrResult OverlaysLayerCreateSwapchainOverlay(XrInstance instance, XrSession sess
     swapchainInfo->localHandle = localHandle;
     swapchainInfo->isProxied = true;
 
-    OverlaySwapchain::Ptr overlaySwapchain = std::make_shared<OverlaySwapchain>(*swapchain, swapchainCount, createInfo);
+    OverlaySwapchain::Ptr overlaySwapchain = std::make_shared<OverlaySwapchain>(*swapchain, sessionInfo->graphicsBackend, swapchainCount, createInfo);
     swapchainInfo->overlaySwapchain = overlaySwapchain;
 
-    if(!overlaySwapchain->CreateTextures(instance, sessionInfo->d3d11Device, gConnectionToMain->conn.otherProcessId)) {
+    // Render directly into Main's images if Main could share them, otherwise make our own for Main to copy from
+    std::vector<HANDLE> sharedImages(swapchainCount);
+    std::vector<HANDLE> sharedFences(swapchainCount);
+    uint32_t sharedCount = 0;
+    XrResult sharedResult = RPCCallGetSwapchainSharedImages(instance, actualHandle, swapchainCount, &sharedCount, sharedImages.data(), sharedFences.data());
+    if(!XR_SUCCEEDED(sharedResult)) {
+        OverlaysLayerLogMessage(instance, XR_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT, "xrCreateSwapchain",
+            OverlaysLayerNoObjectInfo, "Couldn't get shared swapchain images from the main process");
+        return sharedResult;
+    }
+
+    bool created;
+    if(sharedCount == swapchainCount) {
+        std::vector<SharedImageHandle> sharedHandles(swapchainCount);
+        for(uint32_t i = 0; i < swapchainCount; i++) {
+            sharedHandles[i] = SharedImageHandle { sharedImages[i], sharedFences[i] };
+        }
+        created = overlaySwapchain->OpenImages(instance, gConnectionToMain->conn.GetGraphicsPeer(), sharedHandles);
+    } else {
+        created = overlaySwapchain->CreateImages(instance, gConnectionToMain->conn.GetGraphicsPeer(), gConnectionToMain->sharedImagePool);
+        // Main opens them all now rather than on its frame thread at first use
+        if(created) {
+            for(uint32_t i = 0; i < swapchainCount; i++) {
+                sharedImages[i] = overlaySwapchain->swapchainHandles[i].image;
+                sharedFences[i] = overlaySwapchain->swapchainHandles[i].fence;
+            }
+            XrResult setResult = RPCCallSetSwapchainSharedImages(instance, actualHandle, swapchainCount, sharedImages.data(), sharedFences.data());
+            if(!XR_SUCCEEDED(setResult)) {
+                OverlaysLayerLogMessage(instance, XR_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT, "xrCreateSwapchain",
+                    OverlaysLayerNoObjectInfo, "Main couldn't open the shared swapchain images");
+                return setResult;
+            }
+        }
+    }
+
+    if(!created) {
         OverlaysLayerLogMessage(instance, XR_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT, "xrCreateSwapchain",
-            OverlaysLayerNoObjectInfo, "Couldn't create D3D local resources for swapchain images");
+            OverlaysLayerNoObjectInfo, "Couldn't create local resources for swapchain images");
         // XXX This leaks the session in main process if the Session is not closed.
         return XR_ERROR_INITIALIZATION_FAILED;
     }
@@ -2179,40 +1970,139 @@ XrResult OverlaysLayerCreateSwapchainOverlay(XrInstance instance, XrSession sess
     return result;
 }
 
-XrResult OverlaysLayerDestroySwapchainMainAsOverlay(ConnectionToOverlay::Ptr connection, XrSwapchain swapchain)
+XrResult OverlaysLayerGetSwapchainSharedImagesMainAsOverlay(ConnectionToOverlay::Ptr connection, XrSwapchain swapchain, uint32_t imageCapacityInput, uint32_t* imageCountOutput, HANDLE* images, HANDLE* fences)
 {
+    auto synchronizeEveryProcLock = gSynchronizeEveryProc ? std::unique_lock<std::recursive_mutex>(gSynchronizeEveryProcMutex) : std::unique_lock<std::recursive_mutex>();
+
     OverlaysLayerXrSwapchainHandleInfo::Ptr swapchainInfo = OverlaysLayerGetHandleInfoFromXrSwapchain(swapchain);
 
-    OverlaysLayerRemoveXrSwapchainHandleInfo(swapchain);
+    // Zero images means the Overlay creates and shares its own
+    auto& sharedHandles = swapchainInfo->mainAsOverlaySwapchain->sharedHandles;
+    if(!swapchainInfo->mainAsOverlaySwapchain->zeroCopy) {
+        *imageCountOutput = 0;
+        return XR_SUCCESS;
+    }
+    *imageCountOutput = (uint32_t)sharedHandles.size();
 
-    // XXX anything here?  Need to manage error returns as if this was a runtime?  invalid handle will be caught by GetHandleInfo...
+    if(imageCapacityInput == 0) {
+        return XR_SUCCESS;
+    }
+
+    if(imageCapacityInput < sharedHandles.size()) {
+        return XR_ERROR_SIZE_INSUFFICIENT;
+    }
+
+    for(size_t i = 0; i < sharedHandles.size(); i++) {
+        images[i] = sharedHandles[i].image;
+        fences[i] = sharedHandles[i].fence;
+    }
 
     return XR_SUCCESS;
 }
 
-XrResult OverlaysLayerDestroySwapchainOverlay(XrInstance instance, XrSwapchain swapchain)
+XrResult OverlaysLayerSetSwapchainSharedImagesMainAsOverlay(ConnectionToOverlay::Ptr connection, XrSwapchain swapchain, uint32_t imageCount, const HANDLE* images, const HANDLE* fences)
 {
-    OverlaysLayerXrSwapchainHandleInfo::Ptr swapchainInfo = OverlaysLayerGetHandleInfoFromXrSwapchain(swapchain);
+    auto synchronizeEveryProcLock = gSynchronizeEveryProc ? std::unique_lock<std::recursive_mutex>(gSynchronizeEveryProcMutex) : std::unique_lock<std::recursive_mutex>();
 
-    XrResult result = RPCCallDestroySwapchain(swapchainInfo->parentInstance, swapchainInfo->actualHandle);
+    OverlaysLayerXrSwapchainHandleInfo::Ptr swapchainInfo = OverlaysLayerGetHandleInfoFromXrSwapchain(swapchain);
+    auto& mainAsOverlaySwapchain = swapchainInfo->mainAsOverlaySwapchain;
 
-    OverlaysLayerRemoveXrSwapchainHandleInfo(swapchain);
+    if(mainAsOverlaySwapchain->zeroCopy || (imageCount != mainAsOverlaySwapchain->swapchainImages.size())) {
+        OverlaysLayerLogMessage(XR_NULL_HANDLE, XR_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT, "xrCreateSwapchain",
+            OverlaysLayerNoObjectInfo, fmt("overlay sent %d shared images for a swapchain of %d", imageCount, (int)mainAsOverlaySwapchain->swapchainImages.size()).c_str());
+        return XR_ERROR_VALIDATION_FAILURE;
+    }
 
-    // XXX anything here?
+    if(!mainAsOverlaySwapchain->openSharedImages(images, fences, imageCount, connection->sharedImagePool)) {
+        OverlaysLayerLogMessage(XR_NULL_HANDLE, XR_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT, "xrCreateSwapchain",
+            OverlaysLayerNoObjectInfo, "Couldn't open the overlay's shared swapchain images");
+        return XR_ERROR_RUNTIME_FAILURE;
+    }
 
-    return result;
+    return XR_SUCCESS;
 }
 
-
-XrResult OverlaysLayerCreateReferenceSpaceMainAsOverlay(ConnectionToOverlay::Ptr connection, XrSession session, const XrReferenceSpaceCreateInfo* createInfo, XrSpace* space)
+XrResult OverlaysLayerDestroySwapchainMainAsOverlay(ConnectionToOverlay::Ptr connection, XrSwapchain swapchain, XrBool32* imagesPooled)
 {
-    auto synchronizeEveryProcLock = gSynchronizeEveryProc ? std::unique_lock<std::recursive_mutex>(gSynchronizeEveryProcMutex) : std::unique_lock<std::recursive_mutex>();
+    OverlaysLayerXrSwapchainHandleInfo::Ptr swapchainInfo = OverlaysLayerGetHandleInfoFromXrSwapchain(swapchain);
 
-    OverlaysLayerXrSessionHandleInfo::Ptr sessionInfo = OverlaysLayerGetHandleInfoFromXrSession(session);
+    // Signal the Overlay's images it released, since it may pool and reuse
+    // them, and let the runtime have its images before the swapchain goes
+    FlushPendingSwapchainReleases(connection, swapchain);
+    WaitForReleasesAfterFlush(connection, swapchain);
 
-    auto createInfoCopy = GetSharedCopyHandlesRestored(sessionInfo->parentInstance, "xrCreateSwapchain", createInfo);
+    bool inFlight;
+    {
+        // Compositor may still be reading the images; the slot keeps the swapchain until it isn't
+        auto mainSession = gMainSessionContext;
+        auto lock = mainSession->GetLock();
+        inFlight = mainSession->IsSwapchainInFlight(swapchainInfo->mainAsOverlaySwapchain->inFlightSlot);
+        mainSession->ReleaseSwapchainSlot(swapchainInfo->mainAsOverlaySwapchain->inFlightSlot);
+    }
 
-    XrResult result = sessionInfo->downchain->CreateReferenceSpace(sessionInfo->actualHandle, createInfoCopy.get(), space);
+    // Keep the Overlay's images open; it pools them for its next swapchain.
+    // Images of a swapchain submitted in a frame still in flight go with the
+    // swapchain instead, so the Overlay can't render into one while anything
+    // from those frames may still touch it.
+    auto& mainAsOverlaySwapchain = swapchainInfo->mainAsOverlaySwapchain;
+    // A lost image's fence can't be trusted, so nothing of this swapchain is pooled
+    *imagesPooled = XR_FALSE;
+    bool anyLost = std::find(mainAsOverlaySwapchain->sharedImageLost.begin(), mainAsOverlaySwapchain->sharedImageLost.end(), true) != mainAsOverlaySwapchain->sharedImageLost.end();
+    if(!mainAsOverlaySwapchain->zeroCopy && !inFlight && !anyLost) {
+        for(size_t i = 0; i < mainAsOverlaySwapchain->sharedImages.size(); i++) {
+            if(mainAsOverlaySwapchain->sharedImages[i]) {
+                connection->sharedImagePool[mainAsOverlaySwapchain->sharedHandles[i].image] = PooledSharedImage { mainAsOverlaySwapchain->sharedImages[i], mainAsOverlaySwapchain->releaseCounts[i] };
+            }
+        }
+        mainAsOverlaySwapchain->sharedImages.clear();
+        *imagesPooled = XR_TRUE;
+    }
+
+    OverlaysLayerRemoveXrSwapchainHandleInfo(swapchain);
+
+    // XXX anything here?  Need to manage error returns as if this was a runtime?  invalid handle will be caught by GetHandleInfo...
+
+    return XR_SUCCESS;
+}
+
+XrResult OverlaysLayerDiscardSharedImagesMainAsOverlay(ConnectionToOverlay::Ptr connection, uint32_t imageCount, const HANDLE* images)
+{
+    // Opened images close their handles when released
+    for(uint32_t i = 0; i < imageCount; i++) {
+        connection->sharedImagePool.erase(images[i]);
+    }
+    return XR_SUCCESS;
+}
+
+XrResult OverlaysLayerDestroySwapchainOverlay(XrInstance instance, XrSwapchain swapchain)
+{
+    OverlaysLayerXrSwapchainHandleInfo::Ptr swapchainInfo = OverlaysLayerGetHandleInfoFromXrSwapchain(swapchain);
+
+    XrBool32 imagesPooled = XR_FALSE;
+    XrResult result = RPCCallDestroySwapchain(swapchainInfo->parentInstance, swapchainInfo->actualHandle, &imagesPooled);
+
+    // Main only keeps its side of the images if the compositor was done with them
+    if(XR_SUCCEEDED(result) && imagesPooled) {
+        swapchainInfo->overlaySwapchain->RecycleImages(swapchainInfo->parentInstance, gConnectionToMain->sharedImagePool);
+    }
+
+    OverlaysLayerRemoveXrSwapchainHandleInfo(swapchain);
+
+    // XXX anything here?
+
+    return result;
+}
+
+
+XrResult OverlaysLayerCreateReferenceSpaceMainAsOverlay(ConnectionToOverlay::Ptr connection, XrSession session, const XrReferenceSpaceCreateInfo* createInfo, XrSpace* space)
+{
+    auto synchronizeEveryProcLock = gSynchronizeEveryProc ? std::unique_lock<std::recursive_mutex>(gSynchronizeEveryProcMutex) : std::unique_lock<std::recursive_mutex>();
+
+    OverlaysLayerXrSessionHandleInfo::Ptr sessionInfo = OverlaysLayerGetHandleInfoFromXrSession(session);
+
+    auto createInfoCopy = GetSharedCopyHandlesRestored(sessionInfo->parentInstance, "xrCreateSwapchain", createInfo);
+
+    XrResult result = sessionInfo->downchain->CreateReferenceSpace(sessionInfo->actualHandle, createInfoCopy.get(), space);
 
     XrSpace actualHandle = *space;
     XrSpace localHandle = (XrSpace)GetNextLocalHandle();
@@ -2295,6 +2185,52 @@ XrResult OverlaysLayerGetReferenceSpaceBoundsRectOverlay(XrInstance instance, Xr
     return RPCCallGetReferenceSpaceBoundsRect(instance, sessionInfo->actualHandle, referenceSpaceType, bounds);
 }
 
+// Each SyncActions replaces the runtime's active ActionSets, so a sync of
+// the Main app's ActionSets voids the placeholders' sync for locating and
+// the other way around.  States Got before then are stale too, even if the
+// placeholders are synced again in the same frame and get back the same
+// generation.
+void InvalidatePlaceholderSync(OverlaysLayerXrSessionHandleInfo::Ptr sessionInfo)
+{
+    auto& cache = sessionInfo->placeholderStates;
+    std::unique_lock<std::mutex> cacheLock(cache.mutex);
+    cache.generation = 0;
+    std::fill(cache.fetchedGenerations.begin(), cache.fetchedGenerations.end(), 0);
+}
+
+void InvalidateMainLocateSync(OverlaysLayerXrSessionHandleInfo::Ptr sessionInfo)
+{
+    auto lock = sessionInfo->GetLock();
+    sessionInfo->locateSyncedActionSets.clear();
+}
+
+// Sync the placeholder ActionSet so Overlay action spaces can be located,
+// sharing the sync with every other locate and SyncActionsAndGetState this
+// frame.  Caller holds the session's SyncActions lock through its locates.
+XrResult SyncPlaceholdersForLocate(OverlaysLayerXrSessionHandleInfo::Ptr sessionInfo)
+{
+    uint64_t generation = GetMainFrameGeneration();
+    auto& cache = sessionInfo->placeholderStates;
+    std::unique_lock<std::mutex> cacheLock(cache.mutex);
+
+    if(gSyncActionsEveryLocate || (generation == 0) || (cache.generation != generation) || (cache.syncResult != XR_SUCCESS)) {
+        XrActiveActionSet activeActionSet { sessionInfo->placeholderActionSet, XR_NULL_PATH };
+        XrActionsSyncInfo syncInfo { XR_TYPE_ACTIONS_SYNC_INFO, nullptr, 1, &activeActionSet };
+
+        cache.syncResult = sessionInfo->downchain->SyncActions(sessionInfo->actualHandle, &syncInfo);
+        cache.generation = generation;
+        InvalidateMainLocateSync(sessionInfo);
+    }
+    XrResult result = cache.syncResult;
+    cacheLock.unlock();
+
+    if(result != XR_SUCCESS) {
+        OverlaysLayerLogMessage(XR_NULL_HANDLE, XR_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT, "xrLocateSpace",
+            OverlaysLayerNoObjectInfo, "failed to SyncActions on placeHolder ActionSets to locate a space");
+    }
+    return result;
+}
+
 XrResult OverlaysLayerLocateSpaceMainAsOverlay(ConnectionToOverlay::Ptr connection, XrSpace space, XrSpace baseSpace, XrTime time, XrSpaceLocation* location)
 {
     auto synchronizeEveryProcLock = gSynchronizeEveryProc ? std::unique_lock<std::recursive_mutex>(gSynchronizeEveryProcMutex) : std::unique_lock<std::recursive_mutex>();
@@ -2307,17 +2243,11 @@ XrResult OverlaysLayerLocateSpaceMainAsOverlay(ConnectionToOverlay::Ptr connecti
 
     if(spaceInfo->spaceType == SPACE_ACTION) {
 
-
-        XrActiveActionSet activeActionSet { sessionInfo->placeholderActionSet, XR_NULL_PATH };
-        XrActionsSyncInfo syncInfo { XR_TYPE_ACTIONS_SYNC_INFO, nullptr, 1, &activeActionSet };
-        auto sessionInfo = OverlaysLayerGetHandleInfoFromXrSession(spaceInfo->parentHandle);
         {
-            auto syncActionsLock = GetSyncActionsLock();
+            auto syncActionsLock = sessionInfo->GetSyncActionsLock();
 
-            result = spaceInfo->downchain->SyncActions(sessionInfo->actualHandle, &syncInfo);
+            result = SyncPlaceholdersForLocate(sessionInfo);
             if(result != XR_SUCCESS) {
-                OverlaysLayerLogMessage(XR_NULL_HANDLE, XR_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT, "xrLocateSpace",
-                    OverlaysLayerNoObjectInfo, "failed to SyncActions on placeHolder ActionSets to locate a space");
                 return result;
             }
 
@@ -2336,6 +2266,48 @@ XrResult OverlaysLayerLocateSpaceMainAsOverlay(ConnectionToOverlay::Ptr connecti
     return result;
 }
 
+XrResult OverlaysLayerLocateSpacesMainAsOverlay(ConnectionToOverlay::Ptr connection, XrTime time, uint32_t spaceCount, const XrSpace* spaces, const XrSpace* baseSpaces, XrSpaceLocation* locations, XrResult* results)
+{
+    auto synchronizeEveryProcLock = gSynchronizeEveryProc ? std::unique_lock<std::recursive_mutex>(gSynchronizeEveryProcMutex) : std::unique_lock<std::recursive_mutex>();
+
+    if(spaceCount == 0) {
+        return XR_SUCCESS;
+    }
+
+    // The runtime interface this layer is built against has no xrLocateSpaces,
+    // so each space is still a downchain LocateSpace, but the batch looks up
+    // the session, takes the locks and syncs the placeholders once, and no
+    // SyncActions by the Main app can come between its locates
+    auto sessionInfo = OverlaysLayerGetHandleInfoFromXrSession(OverlaysLayerGetHandleInfoFromXrSpace(spaces[0])->parentHandle);
+    auto syncActionsLock = sessionInfo->GetSyncActionsLock();
+
+    bool placeholdersSynced = false;
+    XrResult syncResult = XR_SUCCESS;
+
+    for(uint32_t i = 0; i < spaceCount; i++) {
+        auto spaceInfo = OverlaysLayerGetHandleInfoFromXrSpace(spaces[i]);
+        auto baseSpaceInfo = OverlaysLayerGetHandleInfoFromXrSpace(baseSpaces[i]);
+
+        if(spaceInfo->spaceType == SPACE_ACTION) {
+            if(!placeholdersSynced) {
+                syncResult = SyncPlaceholdersForLocate(sessionInfo);
+                placeholdersSynced = true;
+            }
+            if(syncResult != XR_SUCCESS) {
+                results[i] = syncResult;
+                continue;
+            }
+        }
+
+        results[i] = sessionInfo->downchain->LocateSpace(spaceInfo->actualHandle, baseSpaceInfo->actualHandle, time, &locations[i]);
+        if(results[i] == XR_SUCCESS) {
+            SubstituteLocalHandles(spaceInfo->parentInstance, (XrBaseOutStructure *)&locations[i]);
+        }
+    }
+
+    return XR_SUCCESS;
+}
+
 // XXX PUNT - if space was created with subactionPath NULL_PATH, this will probably fail or crash.
 bool SynchronizeActionSpaceWithMain(XrInstance instance, XrSpace space)
 {
@@ -2402,10 +2374,99 @@ bool SynchronizeActionSpaceWithMain(XrInstance instance, XrSpace space)
     return true;
 }
 
+// Locate spaces[i] relative to baseSpaces[i] for every i in one round trip
+// to Main.  Action spaces Main can't locate yet come back not locatable, as
+// from xrLocateSpace.
+XrResult OverlaysLayerLocateSpacesOverlay(XrInstance instance, XrTime time, uint32_t spaceCount, const XrSpace* spaces, const XrSpace* baseSpaces, XrSpaceLocation* locations, XrResult* results)
+{
+    std::vector<XrSpace> actualSpaces;
+    std::vector<XrSpace> actualBaseSpaces;
+    std::vector<uint32_t> locatedIndices;
+
+    for(uint32_t i = 0; i < spaceCount; i++) {
+        auto spaceInfo = OverlaysLayerGetHandleInfoFromXrSpace(spaces[i]);
+        auto baseSpaceInfo = OverlaysLayerGetHandleInfoFromXrSpace(baseSpaces[i]);
+
+        results[i] = XR_SUCCESS;
+        if(spaceInfo->spaceType == SPACE_ACTION) {
+            if((spaceInfo->action->bindLocation == BIND_PENDING) || !SynchronizeActionSpaceWithMain(instance, spaces[i])) {
+                locations[i].locationFlags = 0;
+                continue;
+            }
+        }
+
+        actualSpaces.push_back(spaceInfo->actualHandle);
+        actualBaseSpaces.push_back(baseSpaceInfo->actualHandle);
+        locatedIndices.push_back(i);
+    }
+
+    if(locatedIndices.empty()) {
+        return XR_SUCCESS;
+    }
+
+    // Gather the locations to fill; their next chains are the caller's and are filled in place
+    std::vector<XrSpaceLocation> located;
+    for(uint32_t i: locatedIndices) {
+        located.push_back(locations[i]);
+    }
+    std::vector<XrResult> locatedResults(locatedIndices.size());
+
+    XrResult result = RPCCallLocateSpaces(instance, time, (uint32_t)locatedIndices.size(), actualSpaces.data(), actualBaseSpaces.data(), located.data(), locatedResults.data());
+    if(result != XR_SUCCESS) {
+        return result;
+    }
+
+    for(size_t j = 0; j < locatedIndices.size(); j++) {
+        XrSpaceLocation& location = locations[locatedIndices[j]];
+        location.locationFlags = located[j].locationFlags;
+        location.pose = located[j].pose;
+        results[locatedIndices[j]] = locatedResults[j];
+        if(locatedResults[j] == XR_SUCCESS) {
+            SubstituteLocalHandles(instance, (XrBaseOutStructure *)&location);
+        }
+    }
+
+    return XR_SUCCESS;
+}
+
 XrResult OverlaysLayerLocateSpaceOverlay(XrInstance instance, XrSpace space, XrSpace baseSpace, XrTime time, XrSpaceLocation* location)
 {
     auto spaceInfo = OverlaysLayerGetHandleInfoFromXrSpace(space);
     auto baseSpaceInfo = OverlaysLayerGetHandleInfoFromXrSpace(baseSpace);
+    auto sessionInfo = OverlaysLayerGetHandleInfoFromXrSession(spaceInfo->parentHandle);
+
+    // XXX Locations with chained structs like XrSpaceVelocity are located one at a time
+    if(location->next == nullptr) {
+        auto locateWithMain = [&](const std::vector<XrSpace>& spaces, XrTime locateTime, std::vector<SpacePoseSample>& located) {
+            std::vector<XrSpace> baseSpaces(spaces.size(), baseSpace);
+            std::vector<XrSpaceVelocity> velocities(spaces.size(), { XR_TYPE_SPACE_VELOCITY });
+            std::vector<XrSpaceLocation> locations(spaces.size(), { XR_TYPE_SPACE_LOCATION });
+            for(size_t i = 0; i < spaces.size(); i++) {
+                locations[i].next = &velocities[i];
+            }
+            std::vector<XrResult> results(spaces.size());
+
+            if(OverlaysLayerLocateSpacesOverlay(instance, locateTime, (uint32_t)spaces.size(), spaces.data(), baseSpaces.data(), locations.data(), results.data()) != XR_SUCCESS) {
+                return false;
+            }
+            for(size_t i = 0; i < spaces.size(); i++) {
+                located[i] = SpacePoseSample { results[i], locations[i], velocities[i] };
+                located[i].location.next = nullptr;
+                located[i].velocity.next = nullptr;
+            }
+            return true;
+        };
+
+        auto& cache = sessionInfo->spaceLocations;
+        std::unique_lock<std::mutex> cacheLock(cache.mutex);
+
+        XrResult result;
+        if(cache.Locate(space, baseSpace, time, gPoseExtrapolationWindow, locateWithMain, location, &result)) {
+            return result;
+        }
+
+        // Otherwise the cache is off, the sample can't be extrapolated, or Main couldn't be asked; locate it by itself below
+    }
 
     XrResult result;
 
@@ -2455,13 +2516,35 @@ XrResult OverlaysLayerLocateSpaceMain(XrInstance parentInstance, XrSpace space,
         XrActiveActionSet activeActionSet { actionSetInfo->handle, spaceInfo->actionSpaceCreateInfo->subactionPath };
         XrActionsSyncInfo syncInfo { XR_TYPE_ACTIONS_SYNC_INFO, nullptr, 1, &activeActionSet };
         { 
-            auto syncActionsLock = GetSyncActionsLock();
+            auto syncActionsLock = sessionInfo->GetSyncActionsLock();
 
-            result = spaceInfo->downchain->SyncActions(sessionInfo->actualHandle, &syncInfo);
-            if(result != XR_SUCCESS) {
-                OverlaysLayerLogMessage(XR_NULL_HANDLE, XR_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT, "xrLocateSpace",
-                        OverlaysLayerNoObjectInfo, "failed to SyncActions before reading placeHolder action to locate a space");
-                return result;
+            // Skip the sync if the app or an earlier locate already synced this ActionSet this frame
+            uint64_t generation = GetMainFrameGeneration();
+            bool alreadySynced = false;
+            {
+                auto lock = sessionInfo->GetLock();
+                if(sessionInfo->locateSyncGeneration != generation) {
+                    sessionInfo->locateSyncedActionSets.clear();
+                    sessionInfo->locateSyncGeneration = generation;
+                }
+                alreadySynced = !gSyncActionsEveryLocate && (generation != 0) &&
+                    ((sessionInfo->locateSyncedActionSets.count({activeActionSet.actionSet, activeActionSet.subactionPath}) > 0) ||
+                    (sessionInfo->locateSyncedActionSets.count({activeActionSet.actionSet, XR_NULL_PATH}) > 0));
+            }
+
+            if(!alreadySynced) {
+                result = spaceInfo->downchain->SyncActions(sessionInfo->actualHandle, &syncInfo);
+                InvalidatePlaceholderSync(sessionInfo);
+                if(result != XR_SUCCESS) {
+                    OverlaysLayerLogMessage(XR_NULL_HANDLE, XR_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT, "xrLocateSpace",
+                            OverlaysLayerNoObjectInfo, "failed to SyncActions before reading placeHolder action to locate a space");
+                    return result;
+                }
+
+                // Only this ActionSet is active now
+                auto lock = sessionInfo->GetLock();
+                sessionInfo->locateSyncedActionSets.clear();
+                sessionInfo->locateSyncedActionSets.insert({activeActionSet.actionSet, activeActionSet.subactionPath});
             }
 
             result = spaceInfo->downchain->LocateSpace(spaceInfo->actualHandle, baseSpaceInfo->actualHandle, time, location);
@@ -2525,6 +2608,13 @@ XrResult OverlaysLayerDestroySpaceMainAsOverlay(ConnectionToOverlay::Ptr connect
 XrResult OverlaysLayerDestroySpaceOverlay(XrInstance instance, XrSpace space)
 {
     OverlaysLayerXrSpaceHandleInfo::Ptr spaceInfo = OverlaysLayerGetHandleInfoFromXrSpace(space);
+    auto sessionInfo = OverlaysLayerGetHandleInfoFromXrSession(spaceInfo->parentHandle);
+
+    {
+        auto& cache = sessionInfo->spaceLocations;
+        std::unique_lock<std::mutex> cacheLock(cache.mutex);
+        cache.Forget(space);
+    }
 
     // XXX This will need to be smart about ActionSpaces?
 
@@ -2603,6 +2693,22 @@ XrResult OverlaysLayerDestroySessionOverlay(XrInstance instance, XrSession sessi
 {
     OverlaysLayerXrSessionHandleInfo::Ptr sessionInfo = OverlaysLayerGetHandleInfoFromXrSession(session);
 
+    // Pooled images belong to this session's device, so no later session can use them
+    std::vector<OverlaySharedImagePool::Entry> discarded;
+    {
+        auto& pool = gConnectionToMain->sharedImagePool;
+        std::unique_lock<std::mutex> lock(pool.mutex);
+        for(auto it = pool.entries.begin(); it != pool.entries.end(); ) {
+            if(it->backend == sessionInfo->graphicsBackend) {
+                discarded.push_back(*it);
+                it = pool.entries.erase(it);
+            } else {
+                it++;
+            }
+        }
+    }
+    DiscardPooledSharedImages(instance, discarded);
+
     XrResult result = RPCCallDestroySession(instance, sessionInfo->actualHandle);
 
     if(!XR_SUCCEEDED(result)) {
@@ -2653,11 +2759,11 @@ XrResult OverlaysLayerEnumerateSwapchainImagesOverlay(
     auto& overlaySwapchain = swapchainInfo->overlaySwapchain;
 
     if(imageCapacityInput == 0) {
-        *imageCountOutput = (uint32_t)overlaySwapchain->swapchainTextures.size();
+        *imageCountOutput = (uint32_t)overlaySwapchain->swapchainImages.size();
         return XR_SUCCESS;
     }
 
-    if(images[0].type != XR_TYPE_SWAPCHAIN_IMAGE_D3D11_KHR) {
+    if((overlaySwapchain->backend->GetSwapchainImageType() == XR_TYPE_UNKNOWN) || (images[0].type != overlaySwapchain->backend->GetSwapchainImageType())) {
         OverlaysLayerXrInstanceHandleInfo::Ptr info = OverlaysLayerGetHandleInfoFromXrInstance(instance);
 
         char structTypeName[XR_MAX_STRUCTURE_NAME_SIZE];
@@ -2666,15 +2772,16 @@ XrResult OverlaysLayerEnumerateSwapchainImagesOverlay(
             sprintf(structTypeName, "<type %08X>", images[0].type);
         }
         OverlaysLayerLogMessage(XR_NULL_HANDLE, XR_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT, "xrEnumerateSwapchainImages",
-            OverlaysLayerNoObjectInfo, fmt("images structure type is %s and not XR_TYPE_SWAPCHAIN_IMAGE_D3D11_KHR.", structTypeName).c_str());
+            OverlaysLayerNoObjectInfo, fmt("images structure type is %s and not the type for the session's graphics API.", structTypeName).c_str());
         return XR_ERROR_VALIDATION_FAILURE;
     }
 
     // (If storage is provided) Give back the "local" swapchainimages (rendertarget) for rendering
-    auto sci = reinterpret_cast<XrSwapchainImageD3D11KHR*>(images);
-    uint32_t toWrite = std::min(imageCapacityInput, (uint32_t)overlaySwapchain->swapchainTextures.size());
+    size_t structSize = overlaySwapchain->backend->GetSwapchainImageStructSize();
+    uint32_t toWrite = std::min(imageCapacityInput, (uint32_t)overlaySwapchain->swapchainImages.size());
     for(uint32_t i = 0; i < toWrite; i++) {
-        sci[i].texture = overlaySwapchain->swapchainTextures[i];
+        auto image = reinterpret_cast<XrSwapchainImageBaseHeader*>(reinterpret_cast<uint8_t*>(images) + structSize * i);
+        overlaySwapchain->backend->FillSwapchainImage(overlaySwapchain->swapchainImages[i].get(), image);
     }
 
     *imageCountOutput = toWrite;
@@ -2968,17 +3075,43 @@ XrResult OverlaysLayerEndSessionOverlay(XrInstance instance, XrSession session)
         return result;
     }
 
+    // Main dropped our layers
+    sessionInfo->lastSubmittedLayers.clear();
+
     return result;
 }
 
+// An Overlay can only be seen if Main is itself visible and the Overlay's
+// recently submitted layers weren't all culled, see OverlayCullHysteresis.
+// The layers are always placed above Main's layers (sessionLayersPlacement
+// is unsigned), so Main's layers can't hide an Overlay.  Called once per
+// Overlay xrWaitFrame.
+bool ComputeOverlayVisibility(MainSessionContext::Ptr mainSession, MainAsOverlaySessionContext::Ptr ctx)
+{
+    XrSessionState mainState = mainSession->sessionState.sessionState;
+    if((mainState != XR_SESSION_STATE_VISIBLE) && (mainState != XR_SESSION_STATE_FOCUSED)) {
+        return false;
+    }
+
+    auto lock = ctx->GetLock();
+    return ctx->cullHysteresis.ShouldRender();
+}
+
 XrResult OverlaysLayerWaitFrameMainAsOverlay(ConnectionToOverlay::Ptr connection, XrSession session, const XrFrameWaitInfo* frameWaitInfo, XrFrameState* frameState)
 {
     auto mainSession = gMainSessionContext;
     auto lock2 = mainSession->GetLock();
+
+    bool visible = ComputeOverlayVisibility(mainSession, connection->ctx);
+    {
+        auto lock3 = connection->ctx->GetLock();
+        connection->ctx->visible = visible;
+    }
+
     // XXX this is incomplete; need to descend next chain and copy as possible from saved requirements.
     frameState->predictedDisplayTime = mainSession->sessionState.savedFrameState->predictedDisplayTime;
     frameState->predictedDisplayPeriod = mainSession->sessionState.savedFrameState->predictedDisplayPeriod;
-    frameState->shouldRender = mainSession->sessionState.savedFrameState->shouldRender;
+    frameState->shouldRender = mainSession->sessionState.savedFrameState->shouldRender && visible;
 
     mainSession->sessionState.IncrementPredictedDisplayTime();
 
@@ -2998,6 +3131,12 @@ XrResult OverlaysLayerWaitFrameOverlay(XrInstance instance, XrSession session, c
         return result;
     }
 
+    {
+        auto& cache = sessionInfo->spaceLocations;
+        std::unique_lock<std::mutex> cacheLock(cache.mutex);
+        cache.frame++;
+    }
+
     return result;
 }
 
@@ -3061,6 +3200,9 @@ XrResult OverlaysLayerAcquireSwapchainImageOverlay(XrInstance instance, XrSwapch
 
     swapchainInfo->overlaySwapchain->acquired.push_back(*index);
 
+    // Layout transitions of new images reach the GPU before the application renders to them
+    swapchainInfo->overlaySwapchain->backend->Flush();
+
     return result;
 }
 
@@ -3070,38 +3212,28 @@ XrResult OverlaysLayerWaitSwapchainImageMainAsOverlay(ConnectionToOverlay::Ptr c
 
     OverlaysLayerXrSwapchainHandleInfo::Ptr swapchainInfo = OverlaysLayerGetHandleInfoFromXrSwapchain(swapchain);
 
-    auto waitInfoCopy = GetSharedCopyHandlesRestored(swapchainInfo->parentInstance, "xrWaitSwapchainImage", waitInfo);
-
-    XrResult result = swapchainInfo->downchain->WaitSwapchainImage(swapchainInfo->actualHandle, waitInfoCopy.get());
-
+    // The runtime waits for one image at a time, so the last one must be released first
+    XrResult result = FlushPendingSwapchainReleases(connection, swapchain);
     if(!XR_SUCCEEDED(result)) {
         return result;
     }
 
-    auto& mainAsOverlaySwapchain = swapchainInfo->mainAsOverlaySwapchain;
-    if(mainAsOverlaySwapchain->remoteImagesAcquired.find(sourceImage) != mainAsOverlaySwapchain->remoteImagesAcquired.end()) {
-        IDXGIKeyedMutex* keyedMutex;
-        {
-            ID3D11Device* d3d11Device;
-            {
-                OverlaysLayerXrSessionHandleInfo::Ptr sessionInfo = OverlaysLayerGetHandleInfoFromXrSession(swapchainInfo->parentHandle);
-                d3d11Device = sessionInfo->d3d11Device;
-            }
+    // Main's xrEndFrame can't happen while this thread holds the lock it takes
+    if(synchronizeEveryProcLock.owns_lock()) {
+        synchronizeEveryProcLock.unlock();
+    }
+    if(!WaitForReleasesAfterFlush(connection, swapchain)) {
+        OverlaysLayerLogMessage(XR_NULL_HANDLE, XR_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT, "xrWaitSwapchainImage",
+            OverlaysLayerNoObjectInfo, fmt("Main didn't submit the copy of the last released image within %d ms", SharedImageWaitTimeoutMs).c_str());
+        return XR_ERROR_RUNTIME_FAILURE;
+    }
 
-            ID3D11Texture2D *sharedTexture = mainAsOverlaySwapchain->getSharedTexture(d3d11Device, sourceImage);
-            HRESULT result = sharedTexture->QueryInterface( __uuidof(IDXGIKeyedMutex), (LPVOID*)&keyedMutex);
-            if(result != S_OK) {
-                LogWindowsError(result, "xrWaitSwapchainImage", "QueryInterface", __FILE__, __LINE__);
-                return XR_ERROR_RUNTIME_FAILURE;
-            }
-        }
-        mainAsOverlaySwapchain->remoteImagesAcquired.erase(sourceImage);
-        HRESULT result = keyedMutex->ReleaseSync(SwapchainCachedData::KEYED_MUTEX_OVERLAY);
-        keyedMutex->Release();
-        if(result != S_OK) {
-            LogWindowsError(result, "xrWaitSwapchainImage", "ReleaseSync", __FILE__, __LINE__);
-            return XR_ERROR_RUNTIME_FAILURE;
-        }
+    auto waitInfoCopy = GetSharedCopyHandlesRestored(swapchainInfo->parentInstance, "xrWaitSwapchainImage", waitInfo);
+
+    result = swapchainInfo->downchain->WaitSwapchainImage(swapchainInfo->actualHandle, waitInfoCopy.get());
+
+    if(!XR_SUCCEEDED(result)) {
+        return result;
     }
 
     return result;
@@ -3118,7 +3250,7 @@ XrResult OverlaysLayerWaitSwapchainImageOverlay(XrInstance instance, XrSwapchain
     auto& overlaySwapchain = swapchainInfo->overlaySwapchain;
 
     uint32_t wasWaited = overlaySwapchain->acquired[0];
-    HANDLE sourceImage = overlaySwapchain->swapchainHandles[wasWaited];
+    HANDLE sourceImage = overlaySwapchain->swapchainHandles[wasWaited].image;
 
     auto waitInfoCopy = GetSharedCopyHandlesRestored(swapchainInfo->parentInstance, "xrWaitSwapchainImage", waitInfo);
 
@@ -3129,126 +3261,364 @@ XrResult OverlaysLayerWaitSwapchainImageOverlay(XrInstance instance, XrSwapchain
     }
 
     overlaySwapchain->waited = true;
-    IDXGIKeyedMutex* keyedMutex;
-    HRESULT hresult;
 
-    hresult = overlaySwapchain->swapchainTextures[wasWaited]->QueryInterface( __uuidof(IDXGIKeyedMutex), (LPVOID*)&keyedMutex);
-    if(hresult != S_OK) {
-        LogWindowsError(result, "xrWaitSwapchainImage", "QueryInterface", __FILE__, __LINE__);
-        return XR_ERROR_RUNTIME_FAILURE;
-    }
-    hresult = keyedMutex->AcquireSync(SwapchainCachedData::KEYED_MUTEX_OVERLAY, INFINITE); // XXX INFINITE timeout
-    keyedMutex->Release();
-    if(hresult != S_OK) {
-        LogWindowsError(result, "xrWaitSwapchainImage", "AcquireSync", __FILE__, __LINE__);
+    // Don't render over what Main hasn't read yet
+    uint64_t mainReleased = MainReleasedFenceValue(overlaySwapchain->releaseCounts[wasWaited]);
+    if(!overlaySwapchain->backend->WaitImage(overlaySwapchain->swapchainImages[wasWaited].get(), mainReleased, SharedImageWaitTimeoutMs)) {
+        OverlaysLayerLogMessage(instance, XR_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT, "xrWaitSwapchainImage",
+            OverlaysLayerNoObjectInfo, fmt("Main didn't finish reading swapchain image %d within %d ms", wasWaited, SharedImageWaitTimeoutMs).c_str());
         return XR_ERROR_RUNTIME_FAILURE;
     }
 
     return result;
 }
 
-XrResult OverlaysLayerReleaseSwapchainImageMainAsOverlay(ConnectionToOverlay::Ptr connection, XrSwapchain swapchain, const XrSwapchainImageReleaseInfo* releaseInfo, HANDLE sourceImage)
+// Wait for the Overlay to finish rendering to its image which, released
+// for the releaseCount'th time.  On failure the image is lost.
+bool WaitForOverlayRelease(SwapchainCachedData::Ptr mainAsOverlaySwapchain, GraphicsImage* sharedImage, uint32_t which, uint64_t releaseCount)
 {
-    auto synchronizeEveryProcLock = gSynchronizeEveryProc ? std::unique_lock<std::recursive_mutex>(gSynchronizeEveryProcMutex) : std::unique_lock<std::recursive_mutex>();
-
-    OverlaysLayerXrSwapchainHandleInfo::Ptr swapchainInfo = OverlaysLayerGetHandleInfoFromXrSwapchain(swapchain);
-
-    auto& mainAsOverlaySwapchain = swapchainInfo->mainAsOverlaySwapchain;
+    if(mainAsOverlaySwapchain->sharedImageLost[which]) {
+        return false;
+    }
+    if(!mainAsOverlaySwapchain->backend->WaitImage(sharedImage, OverlayReleasedFenceValue(releaseCount), SharedImageWaitTimeoutMs)) {
+        OverlaysLayerLogMessage(XR_NULL_HANDLE, XR_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT, "xrReleaseSwapchainImage",
+            OverlaysLayerNoObjectInfo, fmt("Overlay didn't finish rendering to swapchain image %d within %d ms; the image is lost", which, SharedImageWaitTimeoutMs).c_str());
+        mainAsOverlaySwapchain->sharedImageLost[which] = true;
+        return false;
+    }
+    return true;
+}
 
-    ID3D11Device* d3d11Device;
+// Do the copies and runtime releases the Overlay's xrReleaseSwapchainImages
+// put off, all of them or only onlySwapchain's.  Copies are recorded
+// together and flushed once, and the runtime's images are released under
+// one hold of HapticQuirkMutex.
+//
+// If shownSwapchains is given, releases into swapchains not in it are left
+// pending without a copy; nothing submitted shows them, and a runtime
+// image is never released without the Overlay's content.  They are done
+// once a submitted layer shows the swapchain or the Overlay waits on it again.
+XrResult FlushPendingSwapchainReleases(ConnectionToOverlay::Ptr connection, XrSwapchain onlySwapchain, const std::set<XrSwapchain>* shownSwapchains)
+{
+    std::vector<MainAsOverlaySessionContext::PendingSwapchainRelease> pending;
+    if(!connection->ctx) {
+        return XR_SUCCESS;
+    }
     {
-        OverlaysLayerXrSessionHandleInfo::Ptr sessionInfo = OverlaysLayerGetHandleInfoFromXrSession(swapchainInfo->parentHandle);
-        d3d11Device = sessionInfo->d3d11Device;
+        auto lock = connection->ctx->GetLock();
+        auto& pendingReleases = connection->ctx->pendingReleases;
+        for(auto it = pendingReleases.begin(); it != pendingReleases.end(); ) {
+            XrSwapchain swapchain = it->swapchainInfo->localHandle;
+            if(((onlySwapchain == XR_NULL_HANDLE) || (swapchain == onlySwapchain)) &&
+                (!shownSwapchains || (shownSwapchains->count(swapchain) > 0))) {
+                pending.push_back(std::move(*it));
+                it = pendingReleases.erase(it);
+            } else {
+                it++;
+            }
+        }
     }
 
-    ID3D11Texture2D *sharedTexture = mainAsOverlaySwapchain->getSharedTexture(d3d11Device, sourceImage);
+    if(pending.empty()) {
+        return XR_SUCCESS;
+    }
 
-    {
-        IDXGIKeyedMutex* keyedMutex;
-        HRESULT result;
-        result = sharedTexture->QueryInterface( __uuidof(IDXGIKeyedMutex), (LPVOID*)&keyedMutex);
-        if(result != S_OK) {
-            LogWindowsError(result, "xrReleaseSwapchainImage", "QueryInterface", __FILE__, __LINE__);
-            return XR_ERROR_RUNTIME_FAILURE;
+    XrResult result = XR_SUCCESS;
+    std::vector<GraphicsBackend*> backends;
+
+    for(auto& release: pending) {
+        auto& mainAsOverlaySwapchain = release.swapchainInfo->mainAsOverlaySwapchain;
+        auto& backend = mainAsOverlaySwapchain->backend;
+        if(std::find(backends.begin(), backends.end(), backend.get()) == backends.end()) {
+            backends.push_back(backend.get());
         }
-        result = keyedMutex->AcquireSync(SwapchainCachedData::KEYED_MUTEX_MAIN, INFINITE); // XXX INFINITE timeout
-        keyedMutex->Release();
-        if(result != S_OK) {
-            LogWindowsError(result, "xrReleaseSwapchainImage", "AcquireSync", __FILE__, __LINE__);
-            return XR_ERROR_RUNTIME_FAILURE;
+
+        // The Overlay may still be rendering to an image whose wait failed,
+        // and signaling it would release a keyed mutex never acquired or
+        // put a timeline out of order, so it is neither copied nor
+        // signaled again.  The runtime's image keeps its old content and
+        // its damage, and is still released.
+        if(!WaitForOverlayRelease(mainAsOverlaySwapchain, release.sharedImage.get(), release.which, release.releaseCount)) {
+            result = XR_ERROR_SESSION_LOST;
+            continue;
         }
-    }
 
-    mainAsOverlaySwapchain->remoteImagesAcquired.insert(sourceImage);
-    int which = mainAsOverlaySwapchain->acquired[0];
-    mainAsOverlaySwapchain->acquired.erase(mainAsOverlaySwapchain->acquired.begin());
+        auto& damage = mainAsOverlaySwapchain->imageDamage[release.which];
+        GraphicsImage* destination = mainAsOverlaySwapchain->swapchainImages[release.which].get();
+        if(damage.wholeImage) {
+            backend->CopyImage(destination, release.sharedImage.get());
+        } else if(!damage.rects.empty()) {
+            backend->CopyImageRegions(destination, release.sharedImage.get(), damage.rects.data(), (uint32_t)damage.rects.size());
+        }
+        damage.Clear();
 
-    ID3D11Device* d3dDevice;
-    sharedTexture->GetDevice(&d3dDevice);
-    ID3D11DeviceContext* d3dContext;
-    d3dDevice->GetImmediateContext(&d3dContext);
-    d3dContext->CopyResource(mainAsOverlaySwapchain->swapchainImages[which], sharedTexture);
+        // The Overlay may render to this image again once the copy is done
+        if(!backend->SignalImage(release.sharedImage.get(), MainReleasedFenceValue(release.releaseCount))) {
+            result = XR_ERROR_RUNTIME_FAILURE;
+        }
+    }
 
-    auto releaseInfoCopy = GetSharedCopyHandlesRestored(swapchainInfo->parentInstance, "xrReleaseSwapchainImage", releaseInfo);
+    bool held = false;
+    for(auto backend: backends) {
+        held = !backend->FlushFromRPCThread() || held;
+    }
 
-	XrResult result = XR_SUCCESS;
-    {
-        std::unique_lock<std::recursive_mutex> HapticQuirkLock(HapticQuirkMutex);
-        result = swapchainInfo->downchain->ReleaseSwapchainImage(swapchainInfo->actualHandle, releaseInfoCopy.get());
-        if(result != XR_SUCCESS) DebugBreak(); // XXX
+    // The runtime may read an image as soon as it's released, so images
+    // whose copies are held wait for Main's xrEndFrame to submit them
+    if(held) {
+        auto lock = connection->ctx->GetLock();
+        auto& releasesAfterFlush = connection->ctx->releasesAfterFlush;
+        releasesAfterFlush.insert(releasesAfterFlush.end(), pending.begin(), pending.end());
+        return result;
     }
 
-    return result;
+    XrResult releaseResult = ReleaseRuntimeSwapchainImages(pending);
+    return XR_SUCCEEDED(releaseResult) ? result : releaseResult;
 }
 
-XrResult OverlaysLayerReleaseSwapchainImageOverlay(XrInstance instance, XrSwapchain swapchain, const XrSwapchainImageReleaseInfo* releaseInfo)
+// Release the runtime's images of Overlay releases whose copies the GPU has
+// been given, under one hold of HapticQuirkMutex
+XrResult ReleaseRuntimeSwapchainImages(const std::vector<MainAsOverlaySessionContext::PendingSwapchainRelease>& releases)
 {
-    OverlaysLayerXrSwapchainHandleInfo::Ptr swapchainInfo = OverlaysLayerGetHandleInfoFromXrSwapchain(swapchain);
+    XrResult result = XR_SUCCESS;
+    std::unique_lock<std::recursive_mutex> HapticQuirkLock(HapticQuirkMutex);
+    for(auto& release: releases) {
+        XrResult releaseResult = release.swapchainInfo->downchain->ReleaseSwapchainImage(release.swapchainInfo->actualHandle, release.releaseInfo.get());
+        if(!XR_SUCCEEDED(releaseResult)) {
+            OverlaysLayerLogMessage(XR_NULL_HANDLE, XR_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT, "xrReleaseSwapchainImage",
+                OverlaysLayerNoObjectInfo, fmt("runtime failed to release an overlay swapchain image with %d", releaseResult).c_str());
+            result = releaseResult;
+        }
+    }
+    return result;
+}
 
-    if(!swapchainInfo->overlaySwapchain->waited) {
-        return XR_ERROR_CALL_ORDER_INVALID;
+// Called from Main's xrEndFrame right after its Flush submitted the copies
+// held by FlushPendingSwapchainReleases, and before the runtime gets layers
+// that may show those images
+void ReleaseSwapchainImagesAfterFlush()
+{
+    std::vector<ConnectionToOverlay::Ptr> connections;
+    {
+        std::unique_lock<std::recursive_mutex> connectionLock(gConnectionsToOverlayByProcessIdMutex);
+        connections = gConnectionsToOverlayInDepthOrder;
     }
 
-    auto& overlaySwapchain = swapchainInfo->overlaySwapchain;
+    for(auto& overlayconn: connections) {
+        MainAsOverlaySessionContext::Ptr ctx;
+        {
+            auto lock = overlayconn->GetLock();
+            ctx = overlayconn->ctx;
+        }
+        if(!ctx) {
+            continue;
+        }
 
-    uint32_t beingReleased = overlaySwapchain->acquired[0];
+        std::vector<MainAsOverlaySessionContext::PendingSwapchainRelease> releases;
+        {
+            auto lock = ctx->GetLock();
+            releases = ctx->releasesAfterFlush;
+        }
+        if(releases.empty()) {
+            continue;
+        }
 
-    overlaySwapchain->acquired.erase(overlaySwapchain->acquired.begin());
+        // Failures were logged; the Overlay only hears of them as later runtime errors
+        ReleaseRuntimeSwapchainImages(releases);
 
-    IDXGIKeyedMutex* keyedMutex;
-    HRESULT hresult = overlaySwapchain->swapchainTextures[beingReleased]->QueryInterface( __uuidof(IDXGIKeyedMutex), (LPVOID*)&keyedMutex);
-    if(hresult != S_OK) {
-        LogWindowsError(hresult, "xrReleaseSwapchainImage", "QueryInterface", __FILE__, __LINE__);
-        return XR_ERROR_RUNTIME_FAILURE;
-    }
-    hresult = keyedMutex->ReleaseSync(SwapchainCachedData::KEYED_MUTEX_MAIN);
-    keyedMutex->Release();
-    if(hresult != S_OK) {
-        LogWindowsError(hresult, "xrReleaseSwapchainImage", "ReleaseSync", __FILE__, __LINE__);
-        return XR_ERROR_RUNTIME_FAILURE;
+        // The RPC thread only adds to the end
+        auto lock = ctx->GetLock();
+        ctx->releasesAfterFlush.erase(ctx->releasesAfterFlush.begin(), ctx->releasesAfterFlush.begin() + releases.size());
+        ctx->releasesAfterFlushDone.notify_all();
     }
+}
 
-    HANDLE sourceImage = overlaySwapchain->swapchainHandles[beingReleased];
+// Wait for Main's xrEndFrame to release the runtime images of swapchain held by FlushPendingSwapchainReleases
+bool WaitForReleasesAfterFlush(ConnectionToOverlay::Ptr connection, XrSwapchain swapchain)
+{
+    auto ctx = connection->ctx;
+    if(!ctx) {
+        return true;
+    }
+    auto lock = ctx->GetLock();
+    return ctx->releasesAfterFlushDone.wait_for(lock, std::chrono::milliseconds(SharedImageWaitTimeoutMs), [&]() {
+        return std::none_of(ctx->releasesAfterFlush.begin(), ctx->releasesAfterFlush.end(),
+            [&](const MainAsOverlaySessionContext::PendingSwapchainRelease& release) { return release.swapchainInfo->localHandle == swapchain; });
+    });
+}
 
-    auto releaseInfoCopy = GetSharedCopyHandlesRestored(instance, "xrReleaseSwapchainImage", releaseInfo);
-    XrResult result = RPCCallReleaseSwapchainImage(instance, swapchainInfo->actualHandle, releaseInfoCopy.get(), sourceImage);
+// The Overlay rendered into the runtime's image itself, so there is no
+// copy to put off and the runtime gets the image right away.  Only the CPU
+// backend makes zero-copy swapchains, and its waits and signals happen on
+// the CPU, so nothing is held for Main's next xrEndFrame.
+XrResult ReleaseZeroCopySwapchainImage(OverlaysLayerXrSwapchainHandleInfo::Ptr swapchainInfo, GraphicsImage* image, uint32_t which, uint64_t releaseCount, const XrSwapchainImageReleaseInfo* releaseInfo)
+{
+    auto& backend = swapchainInfo->mainAsOverlaySwapchain->backend;
 
-    if(!XR_SUCCEEDED(result)) {
-        DebugBreak(); // XXX
-        return result;
+    // A lost image isn't signaled again, see FlushPendingSwapchainReleases
+    XrResult result = XR_SUCCESS;
+    if(!WaitForOverlayRelease(swapchainInfo->mainAsOverlaySwapchain, image, which, releaseCount)) {
+        result = XR_ERROR_SESSION_LOST;
+    } else {
+        // The Overlay may render to this image again once the compositor is done with it
+        if(!backend->SignalImage(image, MainReleasedFenceValue(releaseCount))) {
+            result = XR_ERROR_RUNTIME_FAILURE;
+        }
+        backend->FlushFromRPCThread();
     }
 
-    swapchainInfo->overlaySwapchain->waited = false;
+    auto releaseInfoCopy = GetSharedCopyHandlesRestored(swapchainInfo->parentInstance, "xrReleaseSwapchainImage", releaseInfo);
+    {
+        std::unique_lock<std::recursive_mutex> HapticQuirkLock(HapticQuirkMutex);
+        XrResult releaseResult = swapchainInfo->downchain->ReleaseSwapchainImage(swapchainInfo->actualHandle, releaseInfoCopy.get());
+        if(!XR_SUCCEEDED(releaseResult)) {
+            result = releaseResult;
+        }
+    }
 
     return result;
 }
 
-XrResult OverlaysLayerEndFrameMainAsOverlay(ConnectionToOverlay::Ptr connection, XrSession session, const XrFrameEndInfo* frameEndInfo)
+XrResult OverlaysLayerReleaseSwapchainImageMainAsOverlay(ConnectionToOverlay::Ptr connection, XrSwapchain swapchain, const XrSwapchainImageReleaseInfo* releaseInfo, HANDLE sourceImage, XrBool32 hasDamageRects, uint32_t damageRectCount, const XrRect2Di* damageRects)
 {
-    std::unique_lock<std::recursive_mutex> EndFrameLock(EndFrameMutex);
-    OverlaysLayerXrSessionHandleInfo::Ptr sessionInfo = OverlaysLayerGetHandleInfoFromXrSession(session);
+    auto synchronizeEveryProcLock = gSynchronizeEveryProc ? std::unique_lock<std::recursive_mutex>(gSynchronizeEveryProcMutex) : std::unique_lock<std::recursive_mutex>();
 
-    XrResult result = XR_SUCCESS;
+    OverlaysLayerXrSwapchainHandleInfo::Ptr swapchainInfo = OverlaysLayerGetHandleInfoFromXrSwapchain(swapchain);
+
+    auto& mainAsOverlaySwapchain = swapchainInfo->mainAsOverlaySwapchain;
+
+    // The Overlay's images are indexed like ours, so sourceImage only confirms which one was released
+    int which = mainAsOverlaySwapchain->acquired[0];
+    if((which >= (int)mainAsOverlaySwapchain->sharedImages.size()) || !mainAsOverlaySwapchain->sharedImages[which] ||
+        (mainAsOverlaySwapchain->sharedHandles[which].image != sourceImage)) {
+        OverlaysLayerLogMessage(XR_NULL_HANDLE, XR_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT, "xrReleaseSwapchainImage",
+            OverlaysLayerNoObjectInfo, "overlay released an image Main didn't open when the swapchain was created");
+        return XR_ERROR_RUNTIME_FAILURE;
+    }
+    mainAsOverlaySwapchain->acquired.erase(mainAsOverlaySwapchain->acquired.begin());
+
+    GraphicsImage::Ptr sharedImage = mainAsOverlaySwapchain->sharedImages[which];
+    uint64_t releaseCount = ++mainAsOverlaySwapchain->releaseCounts[which];
+
+    if(mainAsOverlaySwapchain->zeroCopy) {
+        return ReleaseZeroCopySwapchainImage(swapchainInfo, sharedImage.get(), which, releaseCount, releaseInfo);
+    }
+
+    // Every one of our images is now behind by what changed in this release.
+    // No rectangles at all says the Overlay didn't change the image, so only
+    // images still behind from earlier releases get copied to.
+    for(auto& damage: mainAsOverlaySwapchain->imageDamage) {
+        if(hasDamageRects) {
+            damage.Add(damageRects, damageRectCount);
+        } else {
+            damage.AddWholeImage();
+        }
+    }
+
+    // The copy and the runtime's release wait for the Overlay's xrEndFrame,
+    // so runtime failures are reported there
+    auto releaseInfoCopy = GetSharedCopyHandlesRestored(swapchainInfo->parentInstance, "xrReleaseSwapchainImage", releaseInfo);
+    {
+        auto lock = connection->ctx->GetLock();
+        connection->ctx->pendingReleases.push_back({swapchainInfo, sharedImage, (uint32_t)which, releaseCount, releaseInfoCopy});
+    }
+
+    return XR_SUCCESS;
+}
+
+XrResult OverlaysLayerReleaseSwapchainImageOverlay(XrInstance instance, XrSwapchain swapchain, const XrSwapchainImageReleaseInfo* releaseInfo)
+{
+    OverlaysLayerXrSwapchainHandleInfo::Ptr swapchainInfo = OverlaysLayerGetHandleInfoFromXrSwapchain(swapchain);
+
+    if(!swapchainInfo->overlaySwapchain->waited) {
+        return XR_ERROR_CALL_ORDER_INVALID;
+    }
+
+    auto& overlaySwapchain = swapchainInfo->overlaySwapchain;
+
+    uint32_t beingReleased = overlaySwapchain->acquired[0];
+
+    overlaySwapchain->acquired.erase(overlaySwapchain->acquired.begin());
+
+    uint64_t releaseCount = ++overlaySwapchain->releaseCounts[beingReleased];
+    if(!overlaySwapchain->backend->SignalImage(overlaySwapchain->swapchainImages[beingReleased].get(), OverlayReleasedFenceValue(releaseCount))) {
+        return XR_ERROR_RUNTIME_FAILURE;
+    }
+    overlaySwapchain->backend->Flush();
+
+    HANDLE sourceImage = overlaySwapchain->swapchainHandles[beingReleased].image;
+
+    // Damage rectangles go to Main as RPC arguments; the runtime doesn't know the structure
+    auto damageInfo = FindStructInChain<XrSwapchainImageReleaseDamageInfoEXTX>(releaseInfo->next, XR_TYPE_SWAPCHAIN_IMAGE_RELEASE_DAMAGE_INFO_EXTX);
+
+    auto releaseInfoCopy = GetSharedCopyHandlesRestored(instance, "xrReleaseSwapchainImage", releaseInfo);
+    RemoveStructsFromCopiedChain(instance, reinterpret_cast<XrBaseInStructure*>(releaseInfoCopy.get()), XR_TYPE_SWAPCHAIN_IMAGE_RELEASE_DAMAGE_INFO_EXTX);
+    XrResult result = RPCCallReleaseSwapchainImage(instance, swapchainInfo->actualHandle, releaseInfoCopy.get(), sourceImage,
+        damageInfo ? XR_TRUE : XR_FALSE, damageInfo ? damageInfo->rectCount : 0, damageInfo ? damageInfo->rects : nullptr);
+
+    if(!XR_SUCCEEDED(result)) {
+        DebugBreak(); // XXX
+        return result;
+    }
+
+    swapchainInfo->overlaySwapchain->waited = false;
+
+    OverlaysLayerXrSessionHandleInfo::Ptr sessionInfo = OverlaysLayerGetHandleInfoFromXrSession(swapchainInfo->parentHandle);
+    sessionInfo->swapchainReleasedSinceEndFrame = true;
+
+    return result;
+}
+
+// Add the swapchains p can show anything from.  Layers with no area show
+// nothing.  False if p is of a type we don't know, so what it shows is unknown.
+bool AddSwapchainsShownByLayer(const XrCompositionLayerBaseHeader* p, std::set<XrSwapchain>& swapchains)
+{
+    switch(p->type) {
+        case XR_TYPE_COMPOSITION_LAYER_QUAD: {
+            auto p2 = reinterpret_cast<const XrCompositionLayerQuad*>(p);
+            if(LayerHasVisibleArea(p)) {
+                swapchains.insert(p2->subImage.swapchain);
+            }
+            return true;
+        }
+        case XR_TYPE_COMPOSITION_LAYER_PROJECTION: {
+            auto p2 = reinterpret_cast<const XrCompositionLayerProjection*>(p);
+            for(uint32_t j = 0; j < p2->viewCount; j++) {
+                const XrRect2Di& rect = p2->views[j].subImage.imageRect;
+                if((rect.extent.width > 0) && (rect.extent.height > 0)) {
+                    swapchains.insert(p2->views[j].subImage.swapchain);
+                    // Depth is submitted with its view
+                    auto depthInfo = FindStructInChain<XrCompositionLayerDepthInfoKHR>(p2->views[j].next, XR_TYPE_COMPOSITION_LAYER_DEPTH_INFO_KHR);
+                    if(depthInfo) {
+                        swapchains.insert(depthInfo->subImage.swapchain);
+                    }
+                }
+            }
+            return true;
+        }
+        default: {
+            return false;
+        }
+    }
+}
+
+XrResult OverlaysLayerEndFrameMainAsOverlay(ConnectionToOverlay::Ptr connection, XrSession session, const XrFrameEndInfo* frameEndInfo)
+{
+    // Content must be in the runtime's images before Main can submit these
+    // layers.  Which swapchains need it is decided by the layers themselves,
+    // not by the visibility the Overlay was told in xrWaitFrame.
+    std::set<XrSwapchain> shownSwapchains;
+    bool shownKnown = true;
+    for(uint32_t i = 0; shownKnown && (i < frameEndInfo->layerCount); i++) {
+        shownKnown = AddSwapchainsShownByLayer(frameEndInfo->layers[i], shownSwapchains);
+    }
+    XrResult result = FlushPendingSwapchainReleases(connection, XR_NULL_HANDLE, shownKnown ? &shownSwapchains : nullptr);
+    if(!XR_SUCCEEDED(result)) {
+        return result;
+    }
+
+    std::unique_lock<std::recursive_mutex> EndFrameLock(EndFrameMutex);
+    OverlaysLayerXrSessionHandleInfo::Ptr sessionInfo = OverlaysLayerGetHandleInfoFromXrSession(session);
 
     // TODO: validate blend mode matches main session
     //
@@ -3285,38 +3655,152 @@ XrResult OverlaysLayerEndFrameMainAsOverlay(ConnectionToOverlay::Ptr connection,
     return result;
 }
 
+XrResult OverlaysLayerEndFrameUnchangedMainAsOverlay(ConnectionToOverlay::Ptr connection, XrSession session)
+{
+    // Main keeps compositing the layers it already has, which show whatever
+    // was last released into their swapchains
+    std::set<XrSwapchain> shownSwapchains;
+    bool shownKnown = true;
+    {
+        auto lock = connection->ctx->GetLock();
+        for(size_t i = 0; shownKnown && (i < connection->ctx->overlayLayers.size()); i++) {
+            shownKnown = AddSwapchainsShownByLayer(connection->ctx->overlayLayers[i].get(), shownSwapchains);
+        }
+    }
+    return FlushPendingSwapchainReleases(connection, XR_NULL_HANDLE, shownKnown ? &shownSwapchains : nullptr);
+}
+
+bool SwapchainSubImagesEqual(const XrSwapchainSubImage& a, const XrSwapchainSubImage& b)
+{
+    return (a.swapchain == b.swapchain) && (a.imageArrayIndex == b.imageArrayIndex) &&
+        (a.imageRect.offset.x == b.imageRect.offset.x) && (a.imageRect.offset.y == b.imageRect.offset.y) &&
+        (a.imageRect.extent.width == b.imageRect.extent.width) && (a.imageRect.extent.height == b.imageRect.extent.height);
+}
+
+bool PosesEqual(const XrPosef& a, const XrPosef& b)
+{
+    return (a.orientation.x == b.orientation.x) && (a.orientation.y == b.orientation.y) && (a.orientation.z == b.orientation.z) && (a.orientation.w == b.orientation.w) &&
+        (a.position.x == b.position.x) && (a.position.y == b.position.y) && (a.position.z == b.position.z);
+}
+
+// True only if a and b are certainly the same layer; types we don't
+// compare and layers with extension structs chained are never equal
+bool CompositionLayersEqual(const XrCompositionLayerBaseHeader* a, const XrCompositionLayerBaseHeader* b)
+{
+    if((a->type != b->type) || a->next || b->next || (a->layerFlags != b->layerFlags) || (a->space != b->space)) {
+        return false;
+    }
+
+    switch(a->type) {
+        case XR_TYPE_COMPOSITION_LAYER_QUAD: {
+            auto a2 = reinterpret_cast<const XrCompositionLayerQuad*>(a);
+            auto b2 = reinterpret_cast<const XrCompositionLayerQuad*>(b);
+            return (a2->eyeVisibility == b2->eyeVisibility) && SwapchainSubImagesEqual(a2->subImage, b2->subImage) &&
+                PosesEqual(a2->pose, b2->pose) && (a2->size.width == b2->size.width) && (a2->size.height == b2->size.height);
+        }
+        case XR_TYPE_COMPOSITION_LAYER_PROJECTION: {
+            auto a2 = reinterpret_cast<const XrCompositionLayerProjection*>(a);
+            auto b2 = reinterpret_cast<const XrCompositionLayerProjection*>(b);
+            if(a2->viewCount != b2->viewCount) {
+                return false;
+            }
+            for(uint32_t j = 0; j < a2->viewCount; j++) {
+                const XrCompositionLayerProjectionView& va = a2->views[j];
+                const XrCompositionLayerProjectionView& vb = b2->views[j];
+                if(va.next || vb.next || !PosesEqual(va.pose, vb.pose) || !SwapchainSubImagesEqual(va.subImage, vb.subImage) ||
+                    (va.fov.angleLeft != vb.fov.angleLeft) || (va.fov.angleRight != vb.fov.angleRight) ||
+                    (va.fov.angleUp != vb.fov.angleUp) || (va.fov.angleDown != vb.fov.angleDown)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        default: {
+            return false;
+        }
+    }
+}
+
 XrResult OverlaysLayerEndFrameOverlay(XrInstance instance, XrSession session, const XrFrameEndInfo* frameEndInfo)
 {
     OverlaysLayerXrSessionHandleInfo::Ptr sessionInfo = OverlaysLayerGetHandleInfoFromXrSession(session);
 
+    // Layers that match what Main already has don't need to be sent again.
+    // Swapchains can have been released since; Main composites whatever
+    // image each swapchain last released either way.  The application can
+    // say so itself with XrFrameEndInfoUnchangedEXTX, but only if Main has
+    // the previous frame's layers.
+    bool unchanged = (frameEndInfo->layerCount == sessionInfo->lastSubmittedLayers.size()) &&
+        (sessionInfo->lastSubmittedBlendMode != XR_ENVIRONMENT_BLEND_MODE_MAX_ENUM);
+    if(unchanged && !FindStructInChain<XrFrameEndInfoUnchangedEXTX>(frameEndInfo->next, XR_TYPE_FRAME_END_INFO_UNCHANGED_EXTX)) {
+        unchanged = (frameEndInfo->environmentBlendMode == sessionInfo->lastSubmittedBlendMode);
+        for(uint32_t i = 0; unchanged && (i < frameEndInfo->layerCount); i++) {
+            unchanged = CompositionLayersEqual(frameEndInfo->layers[i], sessionInfo->lastSubmittedLayers[i].get());
+        }
+    }
+
+    if(unchanged) {
+        // With no swapchain released since the last xrEndFrame Main has
+        // nothing to copy or release, and it keeps compositing the layers
+        // it has without hearing from us
+        if(!sessionInfo->swapchainReleasedSinceEndFrame) {
+            return XR_SUCCESS;
+        }
+        XrResult result = RPCCallEndFrameUnchanged(instance, sessionInfo->actualHandle);
+        if(XR_SUCCEEDED(result)) {
+            sessionInfo->swapchainReleasedSinceEndFrame = false;
+        }
+        return result;
+    }
+
     auto frameEndInfoCopy = GetSharedCopyHandlesRestored(instance, "xrEndFrame", frameEndInfo);
+    RemoveStructsFromCopiedChain(instance, reinterpret_cast<XrBaseInStructure*>(frameEndInfoCopy.get()), XR_TYPE_FRAME_END_INFO_UNCHANGED_EXTX);
 
     XrResult result = RPCCallEndFrame(instance, sessionInfo->actualHandle, frameEndInfoCopy.get());
 
+    sessionInfo->lastSubmittedLayers.clear();
+    sessionInfo->lastSubmittedBlendMode = XR_ENVIRONMENT_BLEND_MODE_MAX_ENUM;
+
+    if(XR_SUCCEEDED(result)) {
+        sessionInfo->swapchainReleasedSinceEndFrame = false;
+        for(uint32_t i = 0; i < frameEndInfo->layerCount; i++) {
+            std::shared_ptr<const XrCompositionLayerBaseHeader> copy(reinterpret_cast<const XrCompositionLayerBaseHeader*>(CopyXrStructChainWithMalloc(instance, frameEndInfo->layers[i])), [instance](const XrCompositionLayerBaseHeader*p){ FreeXrStructChainWithFree(instance, p);});
+            if(!copy) {
+                // Just send everything next time
+                sessionInfo->lastSubmittedLayers.clear();
+                break;
+            }
+            sessionInfo->lastSubmittedLayers.push_back(copy);
+        }
+        if(sessionInfo->lastSubmittedLayers.size() == frameEndInfo->layerCount) {
+            sessionInfo->lastSubmittedBlendMode = frameEndInfo->environmentBlendMode;
+        }
+    }
+
     return result;
 }
 
-void AddSwapchainsFromLayers(OverlaysLayerXrSessionHandleInfo::Ptr sessionInfo, std::shared_ptr<const XrCompositionLayerBaseHeader> p, std::set<std::shared_ptr<OverlaysLayerXrSwapchainHandleInfo>> swapchains)
+void AddSwapchainsFromLayers(OverlaysLayerXrSessionHandleInfo::Ptr sessionInfo, std::shared_ptr<const XrCompositionLayerBaseHeader> p, MainSessionContext::SwapchainSlotSet& swapchains)
 {
     switch(p->type) {
         case XR_TYPE_COMPOSITION_LAYER_QUAD: {
             auto p2 = reinterpret_cast<const XrCompositionLayerQuad*>(p.get());
             OverlaysLayerXrSwapchainHandleInfo::Ptr swapchainInfo = OverlaysLayerGetHandleInfoFromXrSwapchain(p2->subImage.swapchain);
-            swapchains.insert(swapchainInfo);
+            swapchains.set(swapchainInfo->mainAsOverlaySwapchain->inFlightSlot);
             break;
         }
         case XR_TYPE_COMPOSITION_LAYER_PROJECTION: {
             auto p2 = reinterpret_cast<const XrCompositionLayerProjection*>(p.get());
             for(uint32_t j = 0; j < p2->viewCount; j++) {
                 OverlaysLayerXrSwapchainHandleInfo::Ptr swapchainInfo = OverlaysLayerGetHandleInfoFromXrSwapchain(p2->views[j].subImage.swapchain);
-                swapchains.insert(swapchainInfo);
+                swapchains.set(swapchainInfo->mainAsOverlaySwapchain->inFlightSlot);
             }
             break;
         }
         case XR_TYPE_COMPOSITION_LAYER_DEPTH_INFO_KHR: {
             auto p2 = reinterpret_cast<const XrCompositionLayerDepthInfoKHR*>(p.get());
             OverlaysLayerXrSwapchainHandleInfo::Ptr swapchainInfo = OverlaysLayerGetHandleInfoFromXrSwapchain(p2->subImage.swapchain);
-            swapchains.insert(swapchainInfo);
+            swapchains.set(swapchainInfo->mainAsOverlaySwapchain->inFlightSlot);
             break;
         }
         default: {
@@ -3334,6 +3818,31 @@ void AddSwapchainsFromLayers(OverlaysLayerXrSessionHandleInfo::Ptr sessionInfo,
     }
 }
 
+// Layers with no area can't contribute anything to the composited frame
+bool LayerHasVisibleArea(const XrCompositionLayerBaseHeader* p)
+{
+    switch(p->type) {
+        case XR_TYPE_COMPOSITION_LAYER_QUAD: {
+            auto p2 = reinterpret_cast<const XrCompositionLayerQuad*>(p);
+            return (p2->size.width > 0.0f) && (p2->size.height > 0.0f) &&
+                (p2->subImage.imageRect.extent.width > 0) && (p2->subImage.imageRect.extent.height > 0);
+        }
+        case XR_TYPE_COMPOSITION_LAYER_PROJECTION: {
+            auto p2 = reinterpret_cast<const XrCompositionLayerProjection*>(p);
+            for(uint32_t j = 0; j < p2->viewCount; j++) {
+                const XrRect2Di& rect = p2->views[j].subImage.imageRect;
+                if((rect.extent.width > 0) && (rect.extent.height > 0)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+        default: {
+            return true;
+        }
+    }
+}
+
 XrResult OverlaysLayerEndFrameMain(XrInstance parentInstance, XrSession session, const XrFrameEndInfo* frameEndInfo)
 {
     auto synchronizeEveryProcLock = gSynchronizeEveryProc ? std::unique_lock<std::recursive_mutex>(gSynchronizeEveryProcMutex) : std::unique_lock<std::recursive_mutex>();
@@ -3349,7 +3858,7 @@ XrResult OverlaysLayerEndFrameMain(XrInstance parentInstance, XrSession session,
         layersMerged.push_back(frameEndInfo->layers[i]);
     }
 
-    std::set<std::shared_ptr<OverlaysLayerXrSwapchainHandleInfo>> swapchainsInFlight;
+    MainSessionContext::SwapchainSlotSet swapchainsInFlight;
 
     {
         std::unique_lock<std::recursive_mutex> connectionLock(gConnectionsToOverlayByProcessIdMutex);
@@ -3359,10 +3868,13 @@ XrResult OverlaysLayerEndFrameMain(XrInstance parentInstance, XrSession session,
                 auto lock = overlayconn->GetLock();
                 if(overlayconn->ctx) {
                     auto lock2 = overlayconn->ctx->GetLock();
+                    bool anyLayerVisible = false;
                     for(uint32_t i = 0; i < overlayconn->ctx->overlayLayers.size(); i++) {
                         AddSwapchainsFromLayers(sessionInfo, overlayconn->ctx->overlayLayers[i], swapchainsInFlight);
                         layersMerged.push_back(overlayconn->ctx->overlayLayers[i].get());
+                        anyLayerVisible = anyLayerVisible || LayerHasVisibleArea(overlayconn->ctx->overlayLayers[i].get());
                     }
+                    overlayconn->ctx->cullHysteresis.UpdateFromLayers(!overlayconn->ctx->overlayLayers.empty(), anyLayerVisible);
                 }
                 connectionLock.lock();
             }
@@ -3372,7 +3884,7 @@ XrResult OverlaysLayerEndFrameMain(XrInstance parentInstance, XrSession session,
     {
         auto mainSession = gMainSessionContext;
         auto lock2 = mainSession->GetLock();
-        mainSession->swapchainsInFlight = swapchainsInFlight;
+        mainSession->SetSwapchainsSubmitted(swapchainsInFlight);
     }
 
     // Malloc this struct and the layer pointers array and then deep copy "next" and the layer pointers.
@@ -3401,6 +3913,11 @@ XrResult OverlaysLayerEndFrameMain(XrInstance parentInstance, XrSession session,
 
     auto frameEndInfoMergedCopy = GetSharedCopyHandlesRestored(sessionInfo->parentInstance, "xrEndFrame", frameEndInfoMerged.get());
 
+    // Copies into Overlay swapchains and signals to the Overlays held back
+    // from the application's queue go ahead of the runtime reading the layers
+    sessionInfo->graphicsBackend->Flush();
+    ReleaseSwapchainImagesAfterFlush();
+
     auto sessLock = sessionInfo->GetLock();
     XrResult result = sessionInfo->downchain->EndFrame(sessionInfo->actualHandle, frameEndInfoMergedCopy.get());
 
@@ -3523,8 +4040,8 @@ XrResult OverlaysLayerSuggestInteractionProfileBindings(XrInstance instance, con
             std::vector<XrActionSuggestedBinding>(suggestedBindings->suggestedBindings, suggestedBindings->suggestedBindings + suggestedBindings->countSuggestedBindings);
 
         for(auto it: instanceInfo->profilesToBindings[suggestedBindings->interactionProfile]) {
-            auto found = instanceInfo->OverlaysLayerPathToWellKnownString.find(it.binding);
-            if(found == instanceInfo->OverlaysLayerPathToWellKnownString.end()) {
+            WellKnownStringIndex found;
+            if(!instanceInfo->OverlaysLayerPathToWellKnownString.Find(it.binding, &found)) {
                 OverlaysLayerLogMessage(instance, XR_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT, "xrSuggestInteractionProfileBindings",
                     OverlaysLayerNoObjectInfo,
                     fmt("Application suggested binding \"%s\", which this API layer does not know; binding will be ignored", PathToString(instance, it.binding).c_str()).c_str());
@@ -3656,14 +4173,15 @@ XrResult OverlaysLayerCreateActionSpaceFromBinding(ConnectionToOverlay::Ptr conn
     auto sessionInfo = OverlaysLayerGetHandleInfoFromXrSession(session); 
     auto instanceInfo = OverlaysLayerGetHandleInfoFromXrInstance(sessionInfo->parentInstance);
 
-    XrPath bindingPath = instanceInfo->OverlaysLayerWellKnownStringToPath.at(bindingString); // These two .at()s must succeed; adding new binding paths would require enabling an extension which API Layer doesn't support
-    XrPath profilePath = instanceInfo->OverlaysLayerWellKnownStringToPath.at(profileString);
-
-    XrAction actualActionHandle = sessionInfo->placeholderActionsByProfileAndFullBinding.at({profilePath, bindingPath}).first; // This .at() must succeed; adding new binding paths would require enabling an extension which API Layer doesn't support
+    XrPath subactionPath;
+    XrAction actualActionHandle = FindPlaceholderAction(sessionInfo, profileString, bindingString, nullptr, &subactionPath);
+    if(actualActionHandle == XR_NULL_HANDLE) {
+        return XR_ERROR_PATH_UNSUPPORTED; // No Overlay asked for this binding before Main attached
+    }
 
     XrActionSpaceCreateInfo createInfo { XR_TYPE_ACTION_SPACE_CREATE_INFO };
     createInfo.action = actualActionHandle;
-    createInfo.subactionPath = instanceInfo->OverlaysLayerBindingToSubaction.at(bindingPath); // This .at() must succeed; adding new binding paths would require enabling an extension which API Layer doesn't support
+    createInfo.subactionPath = subactionPath;
     createInfo.poseInActionSpace = *poseInActionSpace; 
     XrResult result = sessionInfo->downchain->CreateActionSpace(sessionInfo->actualHandle, &createInfo, space);
 
@@ -3722,10 +4240,159 @@ XrResult OverlaysLayerAttachSessionActionSetsOverlay(XrInstance parentInstance,
         }
     }
 
+    // Ask Main for placeholder Actions for our bindings; if Main already attached, it has whatever it created then
+    std::vector<WellKnownStringIndex> profileStrings;
+    std::vector<WellKnownStringIndex> bindingStrings;
+    for(const auto& [interactionProfile, bindings] : instanceInfo->profilesToBindings) {
+        WellKnownStringIndex profileString;
+        if(!instanceInfo->OverlaysLayerPathToWellKnownString.Find(interactionProfile, &profileString)) {
+            continue;
+        }
+        for(const auto& binding: bindings) {
+            WellKnownStringIndex bindingString;
+            if(instanceInfo->OverlaysLayerPathToWellKnownString.Find(binding.binding, &bindingString)) {
+                profileStrings.push_back(profileString);
+                bindingStrings.push_back(bindingString);
+            }
+        }
+    }
+
+    if(profileStrings.size() > 0) {
+        result = RPCCallRequestPlaceholderActions(parentInstance, sessionInfo->actualHandle, (uint32_t)profileStrings.size(), profileStrings.data(), bindingStrings.data());
+        if(result != XR_SUCCESS) {
+            OverlaysLayerLogMessage(parentInstance, XR_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT, "xrAttachSessionActionSets",
+                OverlaysLayerNoObjectInfo, fmt("Couldn't request placeholder actions from Main, RequestPlaceholderActions returned %d", result).c_str());
+        }
+    }
+
     sessionInfo->actionSetsWereAttached = true;
     return XR_SUCCESS;
 }
 
+// Placeholder Action and subaction path standing in for an Overlay's
+// profile and binding; XR_NULL_HANDLE if Main didn't create one
+XrAction FindPlaceholderAction(OverlaysLayerXrSessionHandleInfo::Ptr sessionInfo, WellKnownStringIndex profileString, WellKnownStringIndex bindingString, XrActionType *type, XrPath *subactionPath)
+{
+    uint32_t profile, component, topLevel;
+    if(!FindPlaceholderCell(profileString, bindingString, &profile, &component, &topLevel)) {
+        return XR_NULL_HANDLE;
+    }
+
+    XrAction action = sessionInfo->placeholderActionTable[profile][component];
+    if(action != XR_NULL_HANDLE) {
+        auto instanceInfo = OverlaysLayerGetHandleInfoFromXrInstance(sessionInfo->parentInstance);
+        if(type) {
+            *type = PlaceholderCells[profile][component].type;
+        }
+        if(subactionPath) {
+            *subactionPath = instanceInfo->OverlaysLayerWellKnownStringToPath[PlaceholderTopLevels[topLevel]];
+        }
+    }
+    return action;
+}
+
+// Create all the placeholder Actions, since an Overlay may connect after the
+// ActionSets are attached and no Actions can be added then.  With
+// gLazyPlaceholderActions only the bindings Overlays requested are created,
+// or all of them if no Overlay has asked yet.
+XrResult CreatePlaceholderActions(XrInstance instance, OverlaysLayerXrSessionHandleInfo::Ptr info)
+{
+    auto instanceInfo = OverlaysLayerGetHandleInfoFromXrInstance(instance);
+    auto lock = info->GetLock();
+
+    bool createAll = !gLazyPlaceholderActions || info->requestedPlaceholders.none();
+    int created = 0;
+    int available = 0;
+
+    for(uint32_t profile = 0; profile < PlaceholderProfileCount; profile++) {
+        const char *profileString = OverlaysLayerWellKnownStrings[PlaceholderProfiles[profile]];
+        XrPath interactionProfilePath = instanceInfo->OverlaysLayerWellKnownStringToPath.at(PlaceholderProfiles[profile]);
+
+        for(uint32_t component = 0; component < PlaceholderComponentCount; component++) {
+            const PlaceholderCell& cell = PlaceholderCells[profile][component];
+            uint32_t cellIndex = profile * PlaceholderComponentCount + component;
+            if(cell.subactionMask == 0) {
+                continue;
+            }
+            available++;
+            if(!createAll && !info->requestedPlaceholders.test(cellIndex)) {
+                continue;
+            }
+
+            const char *componentString = OverlaysLayerWellKnownStrings[PlaceholderComponents[component]];
+            std::string name = std::string(profileString) + componentString;
+
+            std::vector<XrPath> subactionPaths;
+            std::vector<XrPath> fullBindingPaths;
+            for(uint32_t topLevel = 0; topLevel < PlaceholderTopLevelCount; topLevel++) {
+                if(cell.subactionMask & (1u << topLevel)) {
+                    const char *topLevelString = OverlaysLayerWellKnownStrings[PlaceholderTopLevels[topLevel]];
+                    subactionPaths.push_back(instanceInfo->OverlaysLayerWellKnownStringToPath.at(PlaceholderTopLevels[topLevel]));
+                    fullBindingPaths.push_back(instanceInfo->OverlaysLayerWellKnownStringToPath.at(FindWellKnownString((std::string(topLevelString) + componentString).c_str()))); // generate_placeholder_actions.py checked every full binding is well-known
+                }
+            }
+
+            char placeholderNameString[64];
+            sprintf(placeholderNameString, "overlays%u", cellIndex + 1);
+
+            XrActionCreateInfo createActionInfo { XR_TYPE_ACTION_CREATE_INFO };
+            strcpy(createActionInfo.actionName, placeholderNameString);
+            strcpy(createActionInfo.localizedActionName, placeholderNameString);
+            createActionInfo.actionType = cell.type;
+            createActionInfo.countSubactionPaths = (uint32_t)subactionPaths.size();
+            createActionInfo.subactionPaths = subactionPaths.data();
+
+            XrAction action;
+            XrResult result = instanceInfo->downchain->CreateAction(info->placeholderActionSet, &createActionInfo, &action);
+            if(result != XR_SUCCESS) {
+                OverlaysLayerLogMessage(instance, XR_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT, "xrAttachSessionActionSets", 
+                    OverlaysLayerNoObjectInfo, fmt("Could not create session placeholder action for %s.", name.c_str()).c_str());
+                return XR_ERROR_INITIALIZATION_FAILED;
+            }
+
+            info->placeholderActionTable[profile][component] = action;
+            info->placeholderActionNames.insert({action, name});
+
+            for(XrPath fullBindingPath: fullBindingPaths) {
+                info->bindingsByProfile[interactionProfilePath].push_back({action, fullBindingPath});
+            }
+            created++;
+        }
+    }
+
+    OverlaysLayerLogMessage(instance, XR_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT, "xrAttachSessionActionSets",
+        OverlaysLayerNoObjectInfo, fmt("Created %d of %d placeholder actions", created, available).c_str());
+
+    info->placeholderActionsCreated = true;
+    return XR_SUCCESS;
+}
+
+XrResult OverlaysLayerRequestPlaceholderActionsMainAsOverlay(ConnectionToOverlay::Ptr connection, XrSession session, uint32_t countProfileAndBindings, const WellKnownStringIndex *profileStrings, const WellKnownStringIndex *bindingStrings)
+{
+    auto synchronizeEveryProcLock = gSynchronizeEveryProc ? std::unique_lock<std::recursive_mutex>(gSynchronizeEveryProcMutex) : std::unique_lock<std::recursive_mutex>();
+
+    auto sessionInfo = OverlaysLayerGetHandleInfoFromXrSession(session);
+    auto lock = sessionInfo->GetLock();
+
+    for(uint32_t i = 0; i < countProfileAndBindings; i++) {
+        uint32_t profile, component, topLevel;
+        if(!FindPlaceholderCell(profileStrings[i], bindingStrings[i], &profile, &component, &topLevel)) {
+            continue; // not a binding of that profile; the Overlay's own suggestion is invalid and gets no state
+        }
+
+        if(!sessionInfo->placeholderActionsCreated) {
+            sessionInfo->requestedPlaceholders.set(profile * PlaceholderComponentCount + component);
+
+        } else if(sessionInfo->placeholderActionTable[profile][component] == XR_NULL_HANDLE) {
+            OverlaysLayerLogMessage(sessionInfo->parentInstance, XR_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT, "xrAttachSessionActionSets",
+                OverlaysLayerNoObjectInfo,
+                fmt("Main ActionSets were already attached without a placeholder for \"%s%s\"; it will not be active", OverlaysLayerWellKnownStrings[profileStrings[i]], OverlaysLayerWellKnownStrings[bindingStrings[i]]).c_str());
+        }
+    }
+
+    return XR_SUCCESS;
+}
+
 XrResult OverlaysLayerAttachSessionActionSetsMain(XrInstance parentInstance, XrSession session, const XrSessionActionSetsAttachInfo* attachInfo)
 {
     auto synchronizeEveryProcLock = gSynchronizeEveryProc ? std::unique_lock<std::recursive_mutex>(gSynchronizeEveryProcMutex) : std::unique_lock<std::recursive_mutex>();
@@ -3741,6 +4408,11 @@ XrResult OverlaysLayerAttachSessionActionSetsMain(XrInstance parentInstance, XrS
         return XR_ERROR_ACTIONSETS_ALREADY_ATTACHED;
     }
 
+    result = CreatePlaceholderActions(parentInstance, sessionInfo);
+    if(result != XR_SUCCESS) {
+        return result;
+    }
+
     auto instanceInfo = OverlaysLayerGetHandleInfoFromXrInstance(parentInstance);
     for(auto profileAndBindings : instanceInfo->profilesToBindings) {
         XrPath interactionProfile = profileAndBindings.first;
@@ -3771,13 +4443,14 @@ XrResult OverlaysLayerAttachSessionActionSetsMain(XrInstance parentInstance, XrS
             OverlaysLayerLogMessage(sessionInfo->parentInstance, XR_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT, "xrAttachSessionActionSets",
                 OverlaysLayerNoObjectInfo,
                 fmt("interactionProfile \"%s\"", PathToString(sessionInfo->parentInstance, interactionProfile).c_str()).c_str());
-            for (const auto& actionBinding : sessionInfo->bindingsByProfile.at(interactionProfile)) { // This must succeed; interactionProfile is from suggested bindings and adding new binding paths would require enabling an extension which API Layer doesn't support
+            static const std::vector<XrActionSuggestedBinding> noBindings;
+            auto placeholderBindings = sessionInfo->bindingsByProfile.find(interactionProfile); // Overlays may not have asked for any placeholder for this profile
+            for (const auto& actionBinding : (placeholderBindings == sessionInfo->bindingsByProfile.end()) ? noBindings : placeholderBindings->second) {
                 newBindings.push_back(actionBinding);
                 XrPath binding = actionBinding.binding;
-                XrPath recorded = sessionInfo->bindingsByAction[actionBinding.action];
                 OverlaysLayerLogMessage(sessionInfo->parentInstance, XR_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT, "xrAttachSessionActionSets",
                     OverlaysLayerNoObjectInfo,
-                    fmt("Suggested \"%s\" for placeholder action \"%s\"", PathToString(sessionInfo->parentInstance, binding).c_str(), PathToString(sessionInfo->parentInstance, recorded).c_str()).c_str());
+                    fmt("Suggested \"%s\" for placeholder action \"%s\"", PathToString(sessionInfo->parentInstance, binding).c_str(), sessionInfo->placeholderActionNames.at(actionBinding.action).c_str()).c_str());
             }
         }
         
@@ -3878,14 +4551,47 @@ XrResult OverlaysLayerAttachSessionActionSets(XrSession session, const XrSession
     }
 }
 
-struct ActionGetInfo
+XrResult GetActionState(OverlaysLayerXrSessionHandleInfo::Ptr sessionInfo, const ActionGetInfo& whatToGet, ActionStateUnion *stateUnion)
 {
-    XrAction action;
-    XrActionType actionType;
-    XrPath subactionPath;
-};
+    XrResult result = XR_SUCCESS;
+    XrActionStateGetInfo get { XR_TYPE_ACTION_STATE_GET_INFO, nullptr, whatToGet.action, whatToGet.subactionPath};
+
+    switch(whatToGet.actionType) {
+        case XR_ACTION_TYPE_BOOLEAN_INPUT: {
+            auto *state = &stateUnion->booleanState;
+            state->type = XR_TYPE_ACTION_STATE_BOOLEAN;
+            state->next = nullptr;
+            result = sessionInfo->downchain->GetActionStateBoolean(sessionInfo->actualHandle, &get, state);
+            break;
+        }
+        case XR_ACTION_TYPE_FLOAT_INPUT: {
+            auto *state = &stateUnion->floatState;
+            state->type = XR_TYPE_ACTION_STATE_FLOAT;
+            state->next = nullptr;
+            result = sessionInfo->downchain->GetActionStateFloat(sessionInfo->actualHandle, &get, state);
+            break;
+        }
+        case XR_ACTION_TYPE_VECTOR2F_INPUT: {
+            auto *state = &stateUnion->vector2fState;
+            state->type = XR_TYPE_ACTION_STATE_VECTOR2F;
+            state->next = nullptr;
+            result = sessionInfo->downchain->GetActionStateVector2f(sessionInfo->actualHandle, &get, state);
+            break;
+        }
+        case XR_ACTION_TYPE_POSE_INPUT: {
+            auto *state = &stateUnion->poseState;
+            state->type = XR_TYPE_ACTION_STATE_POSE;
+            state->next = nullptr;
+            result = sessionInfo->downchain->GetActionStatePose(sessionInfo->actualHandle, &get, state);
+            break;
+        }
+    }
 
-typedef std::vector<ActionGetInfo> ActionGetInfoList;
+    if(result != XR_SUCCESS) {
+        OverlaysLayerLogMessage(XR_NULL_HANDLE, XR_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT, "xrSyncActions", OverlaysLayerNoObjectInfo, "Couldn't get state in bulk update");
+    }
+    return result;
+}
 
 XrResult GetActionStates(XrSession session, const ActionGetInfoList& actionsToGet, ActionStateUnion *states)
 {
@@ -3893,62 +4599,43 @@ XrResult GetActionStates(XrSession session, const ActionGetInfoList& actionsToGe
 
     auto synchronizeEveryProcLock = gSynchronizeEveryProc ? std::unique_lock<std::recursive_mutex>(gSynchronizeEveryProcMutex) : std::unique_lock<std::recursive_mutex>();
 
-	auto sessionInfo = OverlaysLayerGetHandleInfoFromXrSession(session);
+    auto sessionInfo = OverlaysLayerGetHandleInfoFromXrSession(session);
+
+    for(size_t i = 0; i < actionsToGet.size(); i++) {
+        result = GetActionState(sessionInfo, actionsToGet[i], &states[i]);
+        if(result != XR_SUCCESS) {
+            return result;
+        }
+    }
+
+    return result;
+}
 
-    uint32_t index = 0;
-    for(const auto& whatToGet: actionsToGet) {
-        XrActionStateGetInfo get { XR_TYPE_ACTION_STATE_GET_INFO, nullptr, whatToGet.action, whatToGet.subactionPath};
+// Get the placeholder states at cache indices not yet fetched this
+// generation, one action type at a time, then copy all of them out.
+// Caller holds cache.mutex.
+XrResult GetPlaceholderActionStates(OverlaysLayerXrSessionHandleInfo::Ptr sessionInfo, PlaceholderStateCache& cache, const std::vector<uint32_t>& indices, ActionStateUnion *states)
+{
+    static const XrActionType actionTypes[] = { XR_ACTION_TYPE_BOOLEAN_INPUT, XR_ACTION_TYPE_FLOAT_INPUT, XR_ACTION_TYPE_VECTOR2F_INPUT, XR_ACTION_TYPE_POSE_INPUT };
 
-        switch(whatToGet.actionType) {
-            case XR_ACTION_TYPE_BOOLEAN_INPUT: {
-                auto *state = reinterpret_cast<XrActionStateBoolean*>(&states[index]);
-                state->type = XR_TYPE_ACTION_STATE_BOOLEAN;
-                state->next = nullptr;
-                result = sessionInfo->downchain->GetActionStateBoolean(sessionInfo->actualHandle, &get, state);
-                if(result != XR_SUCCESS) {
-                    OverlaysLayerLogMessage(XR_NULL_HANDLE, XR_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT, "xrSyncActions", OverlaysLayerNoObjectInfo, "Couldn't get state in bulk update");
-                    return result;
-                }
-                break;
-            }
-            case XR_ACTION_TYPE_FLOAT_INPUT: {
-                auto *state = reinterpret_cast<XrActionStateFloat*>(&states[index]);
-                state->type = XR_TYPE_ACTION_STATE_FLOAT;
-                state->next = nullptr;
-                result = sessionInfo->downchain->GetActionStateFloat(sessionInfo->actualHandle, &get, state);
-                if(result != XR_SUCCESS) {
-                    OverlaysLayerLogMessage(XR_NULL_HANDLE, XR_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT, "xrSyncActions", OverlaysLayerNoObjectInfo, "Couldn't get state in bulk update");
-                    return result;
-                }
-                break;
+    for(XrActionType actionType: actionTypes) {
+        for(uint32_t index: indices) {
+            if((index == PlaceholderStateCache::NoPlaceholder) || (cache.gets[index].actionType != actionType) || ((cache.generation != 0) && (cache.fetchedGenerations[index] == cache.generation))) {
+                continue;
             }
-            case XR_ACTION_TYPE_VECTOR2F_INPUT: {
-                auto *state = reinterpret_cast<XrActionStateVector2f*>(&states[index]);
-                state->type = XR_TYPE_ACTION_STATE_VECTOR2F;
-                state->next = nullptr;
-                result = sessionInfo->downchain->GetActionStateVector2f(sessionInfo->actualHandle, &get, state);
-                if(result != XR_SUCCESS) {
-                    OverlaysLayerLogMessage(XR_NULL_HANDLE, XR_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT, "xrSyncActions", OverlaysLayerNoObjectInfo, "Couldn't get state in bulk update");
-                    return result;
-                }
-                break;
-            }
-            case XR_ACTION_TYPE_POSE_INPUT: {
-                auto *state = reinterpret_cast<XrActionStatePose*>(&states[index]);
-                state->type = XR_TYPE_ACTION_STATE_POSE;
-                state->next = nullptr;
-                result = sessionInfo->downchain->GetActionStatePose(sessionInfo->actualHandle, &get, state);
-                if(result != XR_SUCCESS) {
-                    OverlaysLayerLogMessage(XR_NULL_HANDLE, XR_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT, "xrSyncActions", OverlaysLayerNoObjectInfo, "Couldn't get state in bulk update");
-                    return result;
-                }
-                break;
+            XrResult result = GetActionState(sessionInfo, cache.gets[index], &cache.states[index]);
+            if(result != XR_SUCCESS) {
+                return result;
             }
+            cache.fetchedGenerations[index] = cache.generation;
         }
-        index ++;
     }
 
-    return result;
+    for(size_t i = 0; i < indices.size(); i++) {
+        states[i] = (indices[i] == PlaceholderStateCache::NoPlaceholder) ? ActionStateUnion{} : cache.states[indices[i]];
+    }
+
+    return XR_SUCCESS;
 }
 
 XrResult OverlaysLayerGetCurrentInteractionProfile(XrSession session, XrPath topLevelUserPath, XrInteractionProfileState* interactionProfile)
@@ -3982,10 +4669,76 @@ XrResult OverlaysLayerGetCurrentInteractionProfile(XrSession session, XrPath top
     }
 }
 
+// Fill changedIndices and changedStates with the states which differ from
+// what this connection acknowledged receiving for the same bindings, or
+// with all of them if that's unknown or a snapshot is due.  actionTypes
+// are those of the placeholder Actions the states were Got from.
+void EncodeActionStateDelta(ConnectionToOverlay::Ptr connection, XrSession session,
+    uint32_t countProfileAndBindings, const WellKnownStringIndex *profileStrings, const WellKnownStringIndex *bindingStrings,
+    const std::vector<XrActionType>& actionTypes, const std::vector<ActionStateUnion>& states, uint64_t acknowledgedGeneration, uint64_t *stateGeneration,
+    uint32_t *changedCount, uint32_t *changedIndices, ActionStateUnion *changedStates)
+{
+    if(!connection->actionStateBaselines) {
+        connection->actionStateBaselines = std::make_shared<ActionStateBaselines>();
+    }
+    auto& baselines = *connection->actionStateBaselines;
+
+    // FNV-1a over the session and the binding list
+    uint64_t key = 0xcbf29ce484222325ULL;
+    auto mix = [&key](uint64_t value) {
+        for(int i = 0; i < 8; i++) {
+            key = (key ^ ((value >> (i * 8)) & 0xFF)) * 0x100000001b3ULL;
+        }
+    };
+    mix((uint64_t)session);
+    mix(countProfileAndBindings);
+    for(uint32_t i = 0; i < countProfileAndBindings; i++) {
+        mix(((uint64_t)profileStrings[i] << 32) | (uint64_t)bindingStrings[i]);
+    }
+
+    auto it = baselines.baselines.find(key);
+    bool haveBaseline = (it != baselines.baselines.end()) &&
+        (it->second.session == session) &&
+        std::equal(profileStrings, profileStrings + countProfileAndBindings, it->second.profileStrings.begin(), it->second.profileStrings.end()) &&
+        std::equal(bindingStrings, bindingStrings + countProfileAndBindings, it->second.bindingStrings.begin(), it->second.bindingStrings.end());
+
+    if(!haveBaseline) {
+        if(baselines.baselines.size() >= ActionStateBaselines::maxBaselines) {
+            baselines.baselines.clear();
+        }
+        ActionStateBaseline& baseline = baselines.baselines[key];
+        baseline.session = session;
+        baseline.profileStrings.assign(profileStrings, profileStrings + countProfileAndBindings);
+        baseline.bindingStrings.assign(bindingStrings, bindingStrings + countProfileAndBindings);
+        it = baselines.baselines.find(key);
+    }
+    ActionStateBaseline& baseline = it->second;
+
+    bool sendAll = !haveBaseline || (baseline.generation == 0) || (acknowledgedGeneration != baseline.generation) ||
+        (baseline.deltasSinceSnapshot >= ActionStateBaselines::snapshotInterval);
+
+    *changedCount = 0;
+    for(uint32_t i = 0; i < countProfileAndBindings; i++) {
+        // A binding whose placeholder appeared since the baseline has a state of a different type
+        if(sendAll || (actionTypes[i] != baseline.actionTypes[i]) || ActionStatesDiffer(actionTypes[i], states[i], baseline.states[i])) {
+            changedIndices[*changedCount] = i;
+            changedStates[*changedCount] = states[i];
+            (*changedCount)++;
+        }
+    }
+
+    baseline.actionTypes = actionTypes;
+    baseline.states = states;
+    baseline.deltasSinceSnapshot = sendAll ? 0 : (baseline.deltasSinceSnapshot + 1);
+    baseline.generation = baselines.nextGeneration++;
+    *stateGeneration = baseline.generation;
+}
+
 XrResult OverlaysLayerSyncActionsAndGetStateMainAsOverlay(
     ConnectionToOverlay::Ptr connection, XrSession session,
     uint32_t countProfileAndBindings, const WellKnownStringIndex *profileStrings, const WellKnownStringIndex *bindingStrings,   /* input is profiles and bindings for which to Get */
-    ActionStateUnion *states,                                                                                                   /* output is result of Get */
+    uint64_t acknowledgedGeneration, uint64_t *stateGeneration,                                                                 /* input is generation Overlay has, output is generation sent */
+    uint32_t *changedCount, uint32_t *changedIndices, ActionStateUnion *changedStates,                                          /* output is results of Get which changed since acknowledgedGeneration */
     uint32_t countSubactionStrings, const WellKnownStringIndex *subactionStrings,                                               /* input is subactionPaths for which to get current interaction Profile */
     WellKnownStringIndex *interactionProfileStrings)                                                                            /* output is current interaction profiles */
 {
@@ -3996,10 +4749,23 @@ XrResult OverlaysLayerSyncActionsAndGetStateMainAsOverlay(
     auto sessionInfo = OverlaysLayerGetHandleInfoFromXrSession(session);
     auto instanceInfo = OverlaysLayerGetHandleInfoFromXrInstance(sessionInfo->parentInstance);
 
-    XrActiveActionSet activeActionSet { sessionInfo->placeholderActionSet, XR_NULL_PATH };
-    XrActionsSyncInfo syncInfo { XR_TYPE_ACTIONS_SYNC_INFO, nullptr, 1, &activeActionSet };
+    // Every Overlay syncing in the same frame shares one sync of the placeholders and one Get of each;
+    // the first to arrive syncs and the others wait for it, then read what it got
+    uint64_t generation = GetMainFrameGeneration();
+
+    auto syncActionsLock = sessionInfo->GetSyncActionsLock();
+    auto& cache = sessionInfo->placeholderStates;
+    std::unique_lock<std::mutex> cacheLock(cache.mutex);
 
-    result = sessionInfo->downchain->SyncActions(sessionInfo->actualHandle, &syncInfo);
+    if((generation == 0) || (cache.generation != generation)) {
+        XrActiveActionSet activeActionSet { sessionInfo->placeholderActionSet, XR_NULL_PATH };
+        XrActionsSyncInfo syncInfo { XR_TYPE_ACTIONS_SYNC_INFO, nullptr, 1, &activeActionSet };
+
+        cache.syncResult = sessionInfo->downchain->SyncActions(sessionInfo->actualHandle, &syncInfo);
+        cache.generation = generation;
+        InvalidateMainLocateSync(sessionInfo);
+    }
+    result = cache.syncResult;
 
     if(result == XR_SESSION_NOT_FOCUSED) {
         return XR_SESSION_NOT_FOCUSED;
@@ -4010,26 +4776,34 @@ XrResult OverlaysLayerSyncActionsAndGetStateMainAsOverlay(
     }
 
     ActionGetInfoList actionsToGet;
+    std::vector<XrActionType> actionTypes;
+    std::vector<uint32_t> cacheIndices;
 
     for(uint32_t i = 0; i < countProfileAndBindings; i++) {
-        XrPath profilePath = instanceInfo->OverlaysLayerWellKnownStringToPath.at(profileStrings[i]); // These two at()s must succeed; adding new binding paths would require enabling an extension which API Layer doesn't support
-        XrPath bindingPath = instanceInfo->OverlaysLayerWellKnownStringToPath.at(bindingStrings[i]);
-        auto it = sessionInfo->placeholderActionsByProfileAndFullBinding.find({profilePath, bindingPath});
-        if(it == sessionInfo->placeholderActionsByProfileAndFullBinding.end()) {
-            DebugBreak();
-        }
-			
-        XrAction action = it->second.first;
-        XrActionType type = it->second.second;
-        XrPath subactionPath = instanceInfo->OverlaysLayerBindingToSubaction.at(bindingPath); // This .at() must succeed; adding new binding paths would require enabling an extension which API Layer doesn't support
+        XrActionType type;
+        XrPath subactionPath;
+        XrAction action = FindPlaceholderAction(sessionInfo, profileStrings[i], bindingStrings[i], &type, &subactionPath);
+        if(action == XR_NULL_HANDLE) {
+            // No Overlay asked for this binding before Main attached; it reads as inactive
+            actionsToGet.push_back({ XR_NULL_HANDLE, XR_ACTION_TYPE_MAX_ENUM, XR_NULL_PATH });
+            actionTypes.push_back(XR_ACTION_TYPE_MAX_ENUM);
+            cacheIndices.push_back(PlaceholderStateCache::NoPlaceholder);
+            continue;
+        }
+
         actionsToGet.push_back({ action, type, subactionPath });
+        actionTypes.push_back(type);
+        cacheIndices.push_back(cache.GetIndex(action, subactionPath, type));
 
         if(false) printf("for %s%s, I think I'm getting action %s\n",
-            PathToString(sessionInfo->parentInstance, profilePath).c_str(),
-            PathToString(sessionInfo->parentInstance, bindingPath).c_str(),
+            OverlaysLayerWellKnownStrings[profileStrings[i]],
+            OverlaysLayerWellKnownStrings[bindingStrings[i]],
             sessionInfo->placeholderActionNames.at(action).c_str());
     }
-    result = GetActionStates(session, actionsToGet, states);
+    std::vector<ActionStateUnion> states(countProfileAndBindings);
+    result = GetPlaceholderActionStates(sessionInfo, cache, cacheIndices, states.data());
+    cacheLock.unlock();
+    syncActionsLock.unlock();
 
     if(result != XR_SUCCESS) {
         return result;
@@ -4040,7 +4814,7 @@ XrResult OverlaysLayerSyncActionsAndGetStateMainAsOverlay(
         auto got = actionsToGet[i];
         XrPath profilePath = instanceInfo->OverlaysLayerWellKnownStringToPath.at(profileStrings[i]); // This .at() must succeed; it was translated by the overlay side to a well-known string
         XrPath bindingPath = instanceInfo->OverlaysLayerWellKnownStringToPath.at(bindingStrings[i]); // This .at() must succeed; it was translated by the overlay side to a well-known string
-        if(got.actionType == XR_ACTION_TYPE_BOOLEAN_INPUT) {
+        if((got.action != XR_NULL_HANDLE) && (got.actionType == XR_ACTION_TYPE_BOOLEAN_INPUT)) {
             XrActionStateBoolean *boolean = (XrActionStateBoolean*)&states[i];
             printf("for %s%s, I got for action %s {state = %s, active = %s}\n",
                 PathToString(sessionInfo->parentInstance, profilePath).c_str(),
@@ -4071,218 +4845,384 @@ XrResult OverlaysLayerSyncActionsAndGetStateMainAsOverlay(
         }
     }
 
+    if(result == XR_SUCCESS) {
+        EncodeActionStateDelta(connection, session, countProfileAndBindings, profileStrings, bindingStrings, actionTypes, states,
+            acknowledgedGeneration, stateGeneration, changedCount, changedIndices, changedStates);
+    }
+
     return result;
 }
 
-void ClearSessionLastSyncedActiveActionSets(OverlaysLayerXrSessionHandleInfo::Ptr sessionInfo, const XrActionsSyncInfo* syncInfo)
+uint64_t HashActiveActionSets(uint32_t count, const XrActiveActionSet* activeActionSets)
 {
-    for(auto activeActionSet: sessionInfo->lastSyncedActiveActionSets) {
-        XrActionSet actionSet = activeActionSet.actionSet;
-        auto actionSetInfo = OverlaysLayerGetHandleInfoFromXrActionSet(actionSet);
-        XrPath subactionPath = activeActionSet.subactionPath;
-        for(auto actionInfo: actionSetInfo->childActions) {
-            actionInfo->stateBySubactionPath.clear();
+    // FNV-1a over the count and then each handle and subaction path in order
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    auto mix = [&hash](uint64_t value) {
+        for(int i = 0; i < 8; i++) {
+            hash = (hash ^ ((value >> (i * 8)) & 0xFF)) * 0x100000001b3ULL;
         }
+    };
+
+    mix(count);
+    for(uint32_t i = 0; i < count; i++) {
+        mix((uint64_t)activeActionSets[i].actionSet);
+        mix(activeActionSets[i].subactionPath);
     }
+    return hash;
 }
 
-void ClearSyncedActiveActionSets(XrInstance parentInstance, XrSession session, const XrActionsSyncInfo* syncInfo)
+// Find each action in the active ActionSets once, with the subaction paths it is synced for
+XrResult CollectSyncActionsPlanActions(SyncActionsPlan::Ptr plan, const XrActionsSyncInfo* syncInfo, bool isProxied, std::vector<std::set<XrPath>>& actionSubactionPaths)
 {
+    plan->activeActionSets.assign(syncInfo->activeActionSets, syncInfo->activeActionSets + syncInfo->countActiveActionSets);
+
+    std::map<OverlaysLayerXrActionSetHandleInfo::Ptr, std::set<XrPath>> actionSetInfoSubactionPaths;
+    std::vector<OverlaysLayerXrActionSetHandleInfo::Ptr> actionSetInfosInOrder;
     for(uint32_t i = 0; i < syncInfo->countActiveActionSets; i++) {
-        XrActionSet actionSet = syncInfo->activeActionSets[i].actionSet;
-        auto actionSetInfo = OverlaysLayerGetHandleInfoFromXrActionSet(actionSet);
-        XrPath subactionPath = syncInfo->activeActionSets[i].subactionPath;
-        for(auto actionInfo: actionSetInfo->childActions) {
-            actionInfo->stateBySubactionPath.clear();
+        auto actionSetInfo = OverlaysLayerGetHandleInfoFromXrActionSet(syncInfo->activeActionSets[i].actionSet);
+        plan->actionSetInfos.push_back(actionSetInfo);
+        if(actionSetInfoSubactionPaths.count(actionSetInfo) == 0) {
+            actionSetInfosInOrder.push_back(actionSetInfo);
         }
+        actionSetInfoSubactionPaths[actionSetInfo].insert(syncInfo->activeActionSets[i].subactionPath);
     }
-}
 
-void GetPreviousActionStates(XrInstance parentInstance, XrSession session, const XrActionsSyncInfo* syncInfo, std::unordered_map <OverlaysLayerXrActionHandleInfo::Ptr, std::unordered_map<XrPath, ActionStateUnion>> &previousActionStates)
-{
-    for(uint32_t i = 0; i < syncInfo->countActiveActionSets; i++) {
-        auto actionSetInfo = OverlaysLayerGetHandleInfoFromXrActionSet(syncInfo->activeActionSets[i].actionSet);
+    std::map<OverlaysLayerXrActionHandleInfo::Ptr, uint32_t> actionIndices;
+    for(const auto& actionSetInfo : actionSetInfosInOrder) {
+        const auto& subactionPaths = actionSetInfoSubactionPaths.at(actionSetInfo); // at() succeeds; filled in the loop above
         for(auto actionInfo: actionSetInfo->childActions) {
-            previousActionStates.insert({actionInfo, actionInfo->stateBySubactionPath});
+            if(isProxied) {
+                for(auto subactionPath: subactionPaths) {
+                    if((subactionPath != XR_NULL_PATH) && (actionInfo->subactionPaths.count(subactionPath) == 0)) {
+                        return XR_ERROR_PATH_UNSUPPORTED;
+                    }
+                }
+            }
+
+            auto [it, inserted] = actionIndices.insert({actionInfo, (uint32_t)plan->actions.size()});
+            if(inserted) {
+                plan->actions.push_back(actionInfo);
+                actionSubactionPaths.push_back({});
+            }
+            auto& paths = actionSubactionPaths[it->second];
+            paths.insert(subactionPaths.begin(), subactionPaths.end());
+
+            // Main Gets every subaction path of an action synced for all of them, and always the merged state
+            if(!isProxied) {
+                if(subactionPaths.count(XR_NULL_PATH) > 0) {
+                    paths.insert(actionInfo->subactionPaths.begin(), actionInfo->subactionPaths.end());
+                }
+                paths.insert(XR_NULL_PATH);
+            }
         }
     }
+
+    return XR_SUCCESS;
 }
 
-XrResult OverlaysLayerSyncActionsOverlay(XrInstance parentInstance, XrSession session, const XrActionsSyncInfo* syncInfo)
+// Group the states merged into each slot by action type, so a sync can
+// merge a round of distinct slots at a time
+void CompileMergeBatches(SyncActionsPlan::Ptr plan, const ActionStateStore& store, const std::vector<uint32_t>& bindingSlots, const std::vector<uint32_t>& bindingMergedSlots)
 {
-    XrResult result = XR_SUCCESS;
+    std::map<XrActionType, std::map<uint32_t, std::vector<uint32_t>>> statesBySlotByType;
+    for(uint32_t i = 0; i < bindingSlots.size(); i++) {
+        for(uint32_t slot: { bindingSlots[i], bindingMergedSlots[i] }) {
+            statesBySlotByType[store.actionTypes[slot]][slot].push_back(i);
+        }
+    }
 
-    auto sessionInfo = OverlaysLayerGetHandleInfoFromXrSession(session);
-    auto instanceInfo = OverlaysLayerGetHandleInfoFromXrInstance(parentInstance);
+    for(const auto& [actionType, statesBySlot]: statesBySlotByType) {
+        SyncActionsPlan::MergeBatch batch;
+        batch.actionType = actionType;
 
-    // Make queryable data structures for data spread across activeActionSets
-    std::set<OverlaysLayerXrActionSetHandleInfo::Ptr> actionSetInfos;
-    std::unordered_map<OverlaysLayerXrActionSetHandleInfo::Ptr, std::set<XrPath>> actionSetInfoSubactionPaths;
-    std::set<OverlaysLayerXrActionHandleInfo::Ptr> actionInfos;
-    std::unordered_map<OverlaysLayerXrActionHandleInfo::Ptr, std::set<XrPath>> actionInfoSubactionPaths;
+        for(const auto& [slot, stateIndices]: statesBySlot) {
+            batch.slots.push_back(slot);
+        }
+        std::stable_sort(batch.slots.begin(), batch.slots.end(), [&statesBySlot](uint32_t a, uint32_t b) {
+            return statesBySlot.at(a).size() > statesBySlot.at(b).size();
+        });
+
+        size_t roundCount = statesBySlot.at(batch.slots[0]).size();
+        for(size_t round = 0; round < roundCount; round++) {
+            batch.roundOffsets.push_back((uint32_t)batch.stateIndices.size());
+            for(uint32_t slot: batch.slots) {
+                const auto& stateIndices = statesBySlot.at(slot);
+                if(stateIndices.size() <= round) {
+                    break;
+                }
+                batch.stateIndices.push_back(stateIndices[round]);
+            }
+        }
+        batch.roundOffsets.push_back((uint32_t)batch.stateIndices.size());
 
-    for(uint32_t i = 0; i < syncInfo->countActiveActionSets; i++) {
-        auto actionSetInfo = OverlaysLayerGetHandleInfoFromXrActionSet(syncInfo->activeActionSets[i].actionSet);
-        XrPath subactionPath = syncInfo->activeActionSets[i].subactionPath;
-        actionSetInfos.insert(actionSetInfo);
-        actionSetInfoSubactionPaths[actionSetInfo].insert(subactionPath);
+        batch.accumulated.Resize(batch.slots.size());
+        batch.merging.Resize(batch.slots.size());
+        plan->mergeBatches.push_back(std::move(batch));
     }
+}
 
-    for(const auto& [actionSetInfo, subactionPaths] : actionSetInfoSubactionPaths) {
-        for(auto actionInfo: actionSetInfo->childActions) {
-            actionInfos.insert(actionInfo);
-            for(auto subactionPath: subactionPaths) {
-                if((subactionPath != XR_NULL_PATH) && (actionInfo->subactionPaths.count(subactionPath) == 0)) {
-                    return XR_ERROR_PATH_UNSUPPORTED;
-                }
-                actionInfoSubactionPaths[actionInfo].insert(subactionPath);
+// Merge the fetched states of a batch's rounds into its accumulated lanes
+void MergeSyncActionsPlanStates(SyncActionsPlan::MergeBatch& batch, const std::vector<ActionStateUnion>& states)
+{
+    batch.accumulated.Clear();
+    ActionStateLanes accumulated = batch.accumulated.Lanes();
+    ActionStateLanes merging = batch.merging.Lanes();
+
+    for(size_t round = 0; round + 1 < batch.roundOffsets.size(); round++) {
+        uint32_t first = batch.roundOffsets[round];
+        uint32_t count = batch.roundOffsets[round + 1] - first;
+
+        for(uint32_t lane = 0; lane < count; lane++) {
+            const ActionStateUnion& state = states[batch.stateIndices[first + lane]];
+            switch(batch.actionType) {
+                case XR_ACTION_TYPE_BOOLEAN_INPUT:
+                    merging.isActive[lane] = state.booleanState.isActive;
+                    merging.booleanStates[lane] = state.booleanState.currentState;
+                    merging.changedSinceLastSync[lane] = state.booleanState.changedSinceLastSync;
+                    merging.lastChangeTimes[lane] = state.booleanState.lastChangeTime;
+                    break;
+                case XR_ACTION_TYPE_FLOAT_INPUT:
+                    merging.isActive[lane] = state.floatState.isActive;
+                    merging.floatStates[lane] = state.floatState.currentState;
+                    merging.changedSinceLastSync[lane] = state.floatState.changedSinceLastSync;
+                    merging.lastChangeTimes[lane] = state.floatState.lastChangeTime;
+                    break;
+                case XR_ACTION_TYPE_VECTOR2F_INPUT:
+                    merging.isActive[lane] = state.vector2fState.isActive;
+                    merging.floatStates[lane] = state.vector2fState.currentState.x;
+                    merging.yStates[lane] = state.vector2fState.currentState.y;
+                    merging.changedSinceLastSync[lane] = state.vector2fState.changedSinceLastSync;
+                    merging.lastChangeTimes[lane] = state.vector2fState.lastChangeTime;
+                    break;
+                default:
+                    merging.isActive[lane] = state.poseState.isActive;
+                    break;
             }
         }
+
+        MergeActionStateLanes(batch.actionType, count, accumulated, merging);
     }
+}
 
-    // Figure out which placeholder actions (interaction profile and binding) to query on Main side
-    std::vector<WellKnownStringIndex> profileStrings;
-    std::vector<WellKnownStringIndex> fullBindingStrings;
-    std::vector<OverlaysLayerXrActionHandleInfo::Ptr> bindingAppliesToActionInfo;
-    std::vector<XrPath> bindingMergesToSubactionPath;
+SyncActionsPlan::Ptr CompileSyncActionsPlanOverlay(XrInstance parentInstance, OverlaysLayerXrSessionHandleInfo::Ptr sessionInfo, const XrActionsSyncInfo* syncInfo)
+{
+    auto& store = sessionInfo->actionStates;
+    auto instanceInfo = OverlaysLayerGetHandleInfoFromXrInstance(parentInstance);
+    auto plan = std::make_shared<SyncActionsPlan>();
 
-    for(const auto& [actionInfo, subactionPaths] : actionInfoSubactionPaths) {
+    std::vector<std::set<XrPath>> actionSubactionPaths;
+    plan->compileResult = CollectSyncActionsPlanActions(plan, syncInfo, true, actionSubactionPaths);
+    if(plan->compileResult != XR_SUCCESS) {
+        return plan;
+    }
 
-        for(auto [profilePath, fullBindingPaths]: actionInfo->suggestedBindingsByProfile) {
+    // Each binding merges into its subaction path and XR_NULL_PATH
+    std::vector<uint32_t> bindingSlots;
+    std::vector<uint32_t> bindingMergedSlots;
 
-            for(auto fullBindingPath: fullBindingPaths) {
+    // Figure out which placeholder actions (interaction profile and binding) to query on Main side
+    for(uint32_t actionIndex = 0; actionIndex < plan->actions.size(); actionIndex++) {
+        auto actionInfo = plan->actions[actionIndex];
+        const auto& subactionPaths = actionSubactionPaths[actionIndex];
+        XrAction action = actionInfo->handle;
+        XrActionType actionType = actionInfo->createInfo->actionType;
 
-                if(instanceInfo->OverlaysLayerBindingToSubaction.count(fullBindingPath) > 0) {
-                    XrPath bindingSubactionPath = instanceInfo->OverlaysLayerBindingToSubaction.at(fullBindingPath); // This .at() must succeed; adding new binding paths would require enabling an extension which API Layer doesn't support
+        for(const auto& [profilePath, fullBindingPaths]: actionInfo->suggestedBindingsByProfile) {
 
-                    for(auto subactionPath: subactionPaths) {
+            for(auto fullBindingPath: fullBindingPaths) {
 
-                        if((subactionPath == XR_NULL_PATH) || (subactionPath == bindingSubactionPath)) {
+                if(instanceInfo->OverlaysLayerBindingToSubaction.count(fullBindingPath) == 0) {
+                    OverlaysLayerLogMessage(parentInstance, XR_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT, "xrSyncActions",
+                        OverlaysLayerNoObjectInfo,
+                        fmt("OverlaysLayerSyncActionsOverlay: unknown suggested binding \"%s\" for action \"%s\"", PathToString(parentInstance, fullBindingPath).c_str(), actionInfo->createInfo->actionName).c_str());
+                    continue;
+                }
 
-                            WellKnownStringIndex fullBindingString = instanceInfo->OverlaysLayerPathToWellKnownString.at(fullBindingPath); // These two .at()s must succeed; adding new binding paths would require enabling an extension which API Layer doesn't support
-                            WellKnownStringIndex profileString = instanceInfo->OverlaysLayerPathToWellKnownString.at(profilePath);
+                XrPath bindingSubactionPath = instanceInfo->OverlaysLayerBindingToSubaction.at(fullBindingPath); // This .at() must succeed; checked above
 
-                            // get profile and full path which the main process side of the API layer maps to a placeholder action
+                if((subactionPaths.count(XR_NULL_PATH) == 0) && (subactionPaths.count(bindingSubactionPath) == 0)) {
+                    continue;
+                }
 
-                            profileStrings.push_back(profileString);
-                            fullBindingStrings.push_back(fullBindingString);
-                            bindingAppliesToActionInfo.push_back(actionInfo);
-                            bindingMergesToSubactionPath.push_back(bindingSubactionPath);
+                WellKnownStringIndex fullBindingString = instanceInfo->OverlaysLayerPathToWellKnownString.at(fullBindingPath); // These two .at()s must succeed; adding new binding paths would require enabling an extension which API Layer doesn't support
+                WellKnownStringIndex profileString = instanceInfo->OverlaysLayerPathToWellKnownString.at(profilePath);
 
-                            if(PrintDebugInfo) {
-                                OverlaysLayerLogMessage(parentInstance, XR_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT, "xrSyncActions",
-                                    OverlaysLayerNoObjectInfo,
-                                    fmt("I think I'm probing placeholder \"%s%s\" for an action", OverlaysLayerWellKnownStrings.at(profileString), OverlaysLayerWellKnownStrings.at(fullBindingString)).c_str());
-                            }
-                        }
-                    }
-                } else {
-                    OverlaysLayerLogMessage(parentInstance, XR_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT, "xrSyncActions",
+                // get profile and full path which the main process side of the API layer maps to a placeholder action
+                plan->profileStrings.push_back(profileString);
+                plan->fullBindingStrings.push_back(fullBindingString);
+                bindingSlots.push_back(store.GetSlot(action, bindingSubactionPath, actionType));
+                bindingMergedSlots.push_back(store.GetSlot(action, XR_NULL_PATH, actionType));
+
+                if(PrintDebugInfo) {
+                    OverlaysLayerLogMessage(parentInstance, XR_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT, "xrSyncActions",
                         OverlaysLayerNoObjectInfo,
-                        fmt("OverlaysLayerSyncActionsOverlay: unknown suggested binding \"%s\" for action \"%s\"", PathToString(sessionInfo->parentInstance, fullBindingPath).c_str(), actionInfo->createInfo->actionName).c_str());
+                        fmt("I think I'm probing placeholder \"%s%s\" for an action", OverlaysLayerWellKnownStrings[profileString], OverlaysLayerWellKnownStrings[fullBindingString]).c_str());
                 }
             }
         }
-    }
 
-    std::vector<ActionStateUnion> states(fullBindingStrings.size());
+        // Syncing for all subaction paths updates every one of them and the merged state
+        if(subactionPaths.count(XR_NULL_PATH) != 0) {
+            for(auto subactionPath: actionInfo->subactionPaths) {
+                plan->updateSlots.push_back(store.GetSlot(action, subactionPath, actionType));
+            }
+            if(actionInfo->subactionPaths.count(XR_NULL_PATH) == 0) {
+                plan->updateSlots.push_back(store.GetSlot(action, XR_NULL_PATH, actionType));
+            }
+        } else {
+            for(auto subactionPath: subactionPaths) {
+                plan->updateSlots.push_back(store.GetSlot(action, subactionPath, actionType));
+            }
+        }
+    }
 
-    std::vector<WellKnownStringIndex> topLevelStrings;
     for(XrPath subactionPath: instanceInfo->OverlaysLayerAllSubactionPaths) {
-        topLevelStrings.push_back(instanceInfo->OverlaysLayerPathToWellKnownString.at(subactionPath)); // This .at() must succeed, it was constructed by a table of known strings.
+        plan->topLevelStrings.push_back(instanceInfo->OverlaysLayerPathToWellKnownString.at(subactionPath)); // This .at() must succeed, it was constructed by a table of known strings.
     }
 
-    std::vector<WellKnownStringIndex> currentInteractionProfileStrings(topLevelStrings.size());
+    CompileMergeBatches(plan, store, bindingSlots, bindingMergedSlots);
 
-    result = RPCCallSyncActionsAndGetState(parentInstance, session, (uint32_t)fullBindingStrings.size(), profileStrings.data(), fullBindingStrings.data(), states.data(), (uint32_t)topLevelStrings.size(), topLevelStrings.data(), currentInteractionProfileStrings.data());
+    plan->states.resize(plan->fullBindingStrings.size());
+    plan->changedIndices.resize(plan->fullBindingStrings.size());
+    plan->changedStates.resize(plan->fullBindingStrings.size());
+    plan->currentInteractionProfileStrings.resize(plan->topLevelStrings.size());
 
-    if(result == XR_SUCCESS) {
+    return plan;
+}
 
-        // Save off previous action's states
-        std::unordered_map <OverlaysLayerXrActionHandleInfo::Ptr, std::unordered_map<XrPath, ActionStateUnion>> previousActionStates;
-        GetPreviousActionStates(sessionInfo->parentInstance, session, syncInfo, previousActionStates);
+SyncActionsPlan::Ptr CompileSyncActionsPlanMain(XrInstance parentInstance, OverlaysLayerXrSessionHandleInfo::Ptr sessionInfo, const XrActionsSyncInfo* syncInfo)
+{
+    auto& store = sessionInfo->actionStates;
+    auto plan = std::make_shared<SyncActionsPlan>();
 
-        // On all actions in previous ActionSet and in this ActionSet, clear state
-        ClearSessionLastSyncedActiveActionSets(sessionInfo, syncInfo);
-        ClearSyncedActiveActionSets(sessionInfo->parentInstance, session, syncInfo);
-
-        // Merge all fetched state
-        for(size_t i = 0; i < fullBindingStrings.size(); i++) {
-            OverlaysLayerXrActionHandleInfo::Ptr actionInfo = bindingAppliesToActionInfo.at(i); // at() succeeds; vector lookup
-            XrPath subactionPath = bindingMergesToSubactionPath.at(i); // at() succeeds; vector lookup
-
-            if(false)if(actionInfo->createInfo->actionType == XR_ACTION_TYPE_BOOLEAN_INPUT) { // XXX debug
-                const std::string& profile = OverlaysLayerWellKnownStrings.at(profileStrings.at(i));
-                const std::string& fullBinding = OverlaysLayerWellKnownStrings.at(fullBindingStrings.at(i));
-                XrActionStateBoolean* boolean = (XrActionStateBoolean*)&states[i];
-                printf("for action \"%s\", subactionPath \"%s\" I fetched %s%s; currentState is %s, active is %s, changedSinceLastSync is %d\n",
-                    actionInfo->createInfo->actionName,
-                    PathToString(sessionInfo->parentInstance, subactionPath).c_str(),
-                    profile.c_str(), fullBinding.c_str(),
-                    boolean->currentState ? "true" : "false", boolean->isActive ? "true" : "false",
-                    boolean->changedSinceLastSync);
-            } 
+    std::vector<std::set<XrPath>> actionSubactionPaths;
+    plan->compileResult = CollectSyncActionsPlanActions(plan, syncInfo, false, actionSubactionPaths);
+    if(plan->compileResult != XR_SUCCESS) {
+        return plan;
+    }
 
-            /* merge all states that are represented under this subactionPath */
-            if(actionInfo->stateBySubactionPath.count(subactionPath) == 0) {
-                ActionStateUnion actionStateUnion;
-                ClearActionState(actionInfo->createInfo->actionType, &actionStateUnion);
-                actionInfo->stateBySubactionPath[subactionPath] = actionStateUnion;
-            }
-            MergeActionState(actionInfo->createInfo->actionType, &states[i], &actionInfo->stateBySubactionPath.at(subactionPath)); // This at() will succeed because previous if-clause populates it if empty
+    auto syncInfoCopy = GetSharedCopyHandlesRestored(parentInstance, "xrSyncActions", syncInfo);
+    plan->downchainActiveActionSets.assign(syncInfoCopy->activeActionSets, syncInfoCopy->activeActionSets + syncInfoCopy->countActiveActionSets);
 
-            /* merge all states */
-            if(actionInfo->stateBySubactionPath.count(XR_NULL_PATH) == 0) {
-                ActionStateUnion actionStateUnion;
-                ClearActionState(actionInfo->createInfo->actionType, &actionStateUnion);
-                actionInfo->stateBySubactionPath[XR_NULL_PATH] = actionStateUnion;
-            }
-            MergeActionState(actionInfo->createInfo->actionType, &states[i], &actionInfo->stateBySubactionPath.at(XR_NULL_PATH)); // This at() will succeed because previous if-clause populates it if empty
-
-            if(false) if(actionInfo->createInfo->actionType == XR_ACTION_TYPE_BOOLEAN_INPUT) { // XXX debug
-                XrActionStateBoolean* boolean = (XrActionStateBoolean*)&actionInfo->stateBySubactionPath.at(subactionPath);
-                printf("for action \"%s\", subactionPath \"%s\", merged state is now currentState is %s, active is %s, changedSinceLastSync is %d\n",
-                    actionInfo->createInfo->actionName,
-                    PathToString(sessionInfo->parentInstance, subactionPath).c_str(),
-                    boolean->currentState ? "true" : "false", boolean->isActive ? "true" : "false",
-                    boolean->changedSinceLastSync);
-            } 
+    for(uint32_t actionIndex = 0; actionIndex < plan->actions.size(); actionIndex++) {
+        auto actionInfo = plan->actions[actionIndex];
+        for(auto subactionPath: actionSubactionPaths[actionIndex]) {
+            plan->actionsToGet.push_back({ actionInfo->handle, actionInfo->createInfo->actionType, subactionPath });
+            plan->getSlots.push_back(store.GetSlot(actionInfo->handle, subactionPath, actionInfo->createInfo->actionType));
         }
+    }
 
-        // On all actions in current state and all subactionPaths, set lastSyncTime and changedSinceLastSync 
-        for(const auto& [actionInfo, subactionPaths] : actionInfoSubactionPaths) {
+    // Main updates exactly what it Gets
+    plan->updateSlots = plan->getSlots;
 
-            std::set<XrPath> subactionPathsToUpdate;
+    plan->states.resize(plan->actionsToGet.size());
 
-            if(subactionPaths.count(XR_NULL_PATH) != 0) {
-                subactionPathsToUpdate = actionInfo->subactionPaths;
-                subactionPathsToUpdate.insert(XR_NULL_PATH);
-            } else {
-                subactionPathsToUpdate = subactionPaths;
-            }
+    return plan;
+}
 
-            for(auto subactionPath: subactionPathsToUpdate) {
-                if(previousActionStates.count(actionInfo) != 0) {
-                    auto previousStates = previousActionStates.at(actionInfo);
-                    if(previousStates.count(subactionPath) != 0) {
-                        auto previousState = previousStates.at(subactionPath);
-                        UpdateActionStateLastChange(actionInfo->createInfo->actionType, &previousState, &actionInfo->stateBySubactionPath.at(subactionPath)); // This .at() will succeed because previous loop populated all updated subactionPaths and XR_NULL_PATH
-                        if(false) if(actionInfo->createInfo->actionType == XR_ACTION_TYPE_BOOLEAN_INPUT) { // XXX debug
-                            XrActionStateBoolean* booleanState = &actionInfo->stateBySubactionPath.at(subactionPath).booleanState;
-                            printf("for action \"%s\", subactionPath \"%s\"; changedSinceLastSync is %d, last time is %lld\n",
-                                actionInfo->createInfo->actionName,
-                                PathToString(sessionInfo->parentInstance, subactionPath).c_str(),
-                                booleanState->changedSinceLastSync, booleanState->lastChangeTime);
-                        } 
-                    }
-                }
+// Return the plan for these active ActionSets, compiling and caching it the first time
+SyncActionsPlan::Ptr GetSyncActionsPlan(XrInstance parentInstance, OverlaysLayerXrSessionHandleInfo::Ptr sessionInfo, const XrActionsSyncInfo* syncInfo)
+{
+    constexpr size_t maxCachedSyncActionsPlans = 32;
+
+    uint64_t signature = HashActiveActionSets(syncInfo->countActiveActionSets, syncInfo->activeActionSets);
+
+    {
+        auto l = sessionInfo->GetLock();
+        auto it = sessionInfo->syncActionsPlans.find(signature);
+        if(it != sessionInfo->syncActionsPlans.end()) {
+            const auto& plan = it->second;
+            bool matches = (plan->activeActionSets.size() == syncInfo->countActiveActionSets);
+            for(uint32_t i = 0; matches && (i < syncInfo->countActiveActionSets); i++) {
+                matches = (plan->activeActionSets[i].actionSet == syncInfo->activeActionSets[i].actionSet) &&
+                    (plan->activeActionSets[i].subactionPath == syncInfo->activeActionSets[i].subactionPath) &&
+                    (plan->actionSetInfos[i] == OverlaysLayerGetHandleInfoFromXrActionSet(syncInfo->activeActionSets[i].actionSet));
             }
+            if(matches) {
+                return plan;
+            }
+        }
+    }
+
+    auto plan = sessionInfo->isProxied ? CompileSyncActionsPlanOverlay(parentInstance, sessionInfo, syncInfo) : CompileSyncActionsPlanMain(parentInstance, sessionInfo, syncInfo);
+
+    auto l = sessionInfo->GetLock();
+    if(sessionInfo->syncActionsPlans.size() >= maxCachedSyncActionsPlans) {
+        sessionInfo->syncActionsPlans.clear();
+    }
+    sessionInfo->syncActionsPlans[signature] = plan;
+
+    return plan;
+}
+
+// Clear the state of every subaction path of the plan's actions
+void ClearSyncActionsPlanStates(ActionStateStore& store, SyncActionsPlan::Ptr plan)
+{
+    if(plan) {
+        for(const auto& actionInfo: plan->actions) {
+            store.ClearAction(actionInfo->handle);
+        }
+    }
+}
+
+XrResult OverlaysLayerSyncActionsOverlay(XrInstance parentInstance, XrSession session, const XrActionsSyncInfo* syncInfo)
+{
+    XrResult result = XR_SUCCESS;
+
+    auto sessionInfo = OverlaysLayerGetHandleInfoFromXrSession(session);
+    auto instanceInfo = OverlaysLayerGetHandleInfoFromXrInstance(parentInstance);
+
+    // The plan's scratch states and the ActionStateStore are this session's alone
+    auto syncActionsLock = sessionInfo->GetSyncActionsLock();
+
+    // Action spaces may become locatable or not with this sync
+    {
+        auto& cache = sessionInfo->spaceLocations;
+        std::unique_lock<std::mutex> cacheLock(cache.mutex);
+        cache.Clear();
+    }
+
+    auto plan = GetSyncActionsPlan(parentInstance, sessionInfo, syncInfo);
+    if(plan->compileResult != XR_SUCCESS) {
+        return plan->compileResult;
+    }
+
+    uint64_t stateGeneration = 0;
+    uint32_t changedCount = 0;
+    result = RPCCallSyncActionsAndGetState(parentInstance, session, (uint32_t)plan->fullBindingStrings.size(), plan->profileStrings.data(), plan->fullBindingStrings.data(),
+        plan->stateGeneration, &stateGeneration, &changedCount, plan->changedIndices.data(), plan->changedStates.data(),
+        (uint32_t)plan->topLevelStrings.size(), plan->topLevelStrings.data(), plan->currentInteractionProfileStrings.data());
+
+    if(result == XR_SUCCESS) {
+
+        // Patch what changed into the states from the previous sync with this plan
+        for(uint32_t i = 0; i < changedCount; i++) {
+            plan->states[plan->changedIndices[i]] = plan->changedStates[i];
+        }
+        plan->stateGeneration = stateGeneration;
+
+        auto& store = sessionInfo->actionStates;
+
+        // Save off previous action's states
+        store.SavePrevious();
+
+        // On all actions in previous ActionSet and in this ActionSet, clear state
+        ClearSyncActionsPlanStates(store, sessionInfo->lastSyncActionsPlan);
+        ClearSyncActionsPlanStates(store, plan);
+        sessionInfo->lastSyncActionsPlan = plan;
+
+        // Merge all fetched state into its subaction path and into all subaction paths
+        for(auto& batch: plan->mergeBatches) {
+            MergeSyncActionsPlanStates(batch, plan->states);
+            store.SetLanes(batch.slots.data(), batch.slots.size(), batch.accumulated.Lanes());
         }
 
+        store.UpdateLastChange(plan->updateSlots.data(), plan->updateSlots.size());
+
         // Store the interaction profiles current for allowlisted top-level paths
-        for(uint32_t i = 0; i < topLevelStrings.size(); i++) {
-            XrPath topLevelPath = instanceInfo->OverlaysLayerWellKnownStringToPath.at(topLevelStrings[i]); // This .at() must succeed; adding new binding paths would require enabling an extension which API Layer doesn't support
-            XrPath interactionProfile = instanceInfo->OverlaysLayerWellKnownStringToPath.at(currentInteractionProfileStrings[i]); // This .at() must succeed; adding new binding paths would require enabling an extension which API Layer doesn't support
+        for(uint32_t i = 0; i < plan->topLevelStrings.size(); i++) {
+            XrPath topLevelPath = instanceInfo->OverlaysLayerWellKnownStringToPath.at(plan->topLevelStrings[i]); // This .at() must succeed; adding new binding paths would require enabling an extension which API Layer doesn't support
+            XrPath interactionProfile = instanceInfo->OverlaysLayerWellKnownStringToPath.at(plan->currentInteractionProfileStrings[i]); // This .at() must succeed; adding new binding paths would require enabling an extension which API Layer doesn't support
             XrPath previousProfile = sessionInfo->currentInteractionProfileBySubactionPath.at(topLevelPath); // This .at() must succeed because currentInteractionProfileBySubactionPath.at was filled with all possible topLevelPaths in CreateSessionMain()
             if(previousProfile != interactionProfile) {
                 auto l = sessionInfo->GetLock();
@@ -4306,16 +5246,21 @@ XrResult OverlaysLayerSyncActionsMain(XrInstance parentInstance, XrSession sessi
     auto sessionInfo = OverlaysLayerGetHandleInfoFromXrSession(session);
     auto instanceInfo = OverlaysLayerGetHandleInfoFromXrInstance(parentInstance);
 
-    // Sync all the actions requested by the Main app
-    {
-        auto syncInfoSave = syncInfo;
-        auto syncInfoCopy = GetSharedCopyHandlesRestored(sessionInfo->parentInstance, "xrSyncActions", syncInfo);
-        syncInfo = syncInfoCopy.get();
+    // No Overlay's placeholder sync may come between this sync and the Gets below
+    auto syncActionsLock = sessionInfo->GetSyncActionsLock();
 
-        result = sessionInfo->downchain->SyncActions(sessionInfo->actualHandle, syncInfo);
+    auto plan = GetSyncActionsPlan(parentInstance, sessionInfo, syncInfo);
 
-        syncInfo = syncInfoSave;
+    // Sync all the actions requested by the Main app
+    if(syncInfo->next == nullptr) {
+        XrActionsSyncInfo downchainSyncInfo { XR_TYPE_ACTIONS_SYNC_INFO, nullptr, (uint32_t)plan->downchainActiveActionSets.size(), plan->downchainActiveActionSets.data() };
+        result = sessionInfo->downchain->SyncActions(sessionInfo->actualHandle, &downchainSyncInfo);
+    } else {
+        // Extension structs may carry handles of their own
+        auto syncInfoCopy = GetSharedCopyHandlesRestored(sessionInfo->parentInstance, "xrSyncActions", syncInfo);
+        result = sessionInfo->downchain->SyncActions(sessionInfo->actualHandle, syncInfoCopy.get());
     }
+    InvalidatePlaceholderSync(sessionInfo);
 
     if(result == XR_SESSION_NOT_FOCUSED) {
         return XR_SESSION_NOT_FOCUSED;
@@ -4325,42 +5270,18 @@ XrResult OverlaysLayerSyncActionsMain(XrInstance parentInstance, XrSession sessi
         return result;
     }
 
-    // Make queryable data structures for data spread across activeActionSets
-    std::set<OverlaysLayerXrActionSetHandleInfo::Ptr> actionSetInfos;
-    std::unordered_map<OverlaysLayerXrActionSetHandleInfo::Ptr, std::set<XrPath>> actionSetInfoSubactionPaths;
-    std::set<OverlaysLayerXrActionHandleInfo::Ptr> actionInfos;
-    std::unordered_map<OverlaysLayerXrActionHandleInfo::Ptr, std::set<XrPath>> actionInfoSubactionPaths;
-
-    for(uint32_t i = 0; i < syncInfo->countActiveActionSets; i++) {
-        auto actionSetInfo = OverlaysLayerGetHandleInfoFromXrActionSet(syncInfo->activeActionSets[i].actionSet);
-        XrPath subactionPath = syncInfo->activeActionSets[i].subactionPath;
-        actionSetInfos.insert(actionSetInfo);
-        actionSetInfoSubactionPaths[actionSetInfo].insert(subactionPath);
-    }
-
-    for(const auto& [actionSetInfo, subactionPaths] : actionSetInfoSubactionPaths) {
-        for(auto actionInfo: actionSetInfo->childActions) {
-            actionInfos.insert(actionInfo);
-            for(auto subactionPath: subactionPaths) {
-                actionInfoSubactionPaths[actionInfo].insert(subactionPath);
-            }
-            if(subactionPaths.count(XR_NULL_PATH) > 0) {
-                actionInfoSubactionPaths[actionInfo].insert(actionInfo->subactionPaths.begin(), actionInfo->subactionPaths.end());
-            }
-            actionInfoSubactionPaths[actionInfo].insert(XR_NULL_PATH);
-        }
-    }
-
-    ActionGetInfoList actionsToGet;
-    for(const auto& [actionInfo, subactionPaths] : actionInfoSubactionPaths) {
-        for(auto subactionPath: subactionPaths) {
-            actionsToGet.push_back({ actionInfo->handle, actionInfo->createInfo->actionType, subactionPath });
+    // Action spaces of these ActionSets locate against this sync for the rest of the frame
+    {
+        uint64_t generation = GetMainFrameGeneration();
+        auto lock = sessionInfo->GetLock();
+        sessionInfo->locateSyncedActionSets.clear();
+        sessionInfo->locateSyncGeneration = generation;
+        for(uint32_t i = 0; i < syncInfo->countActiveActionSets; i++) {
+            sessionInfo->locateSyncedActionSets.insert({syncInfo->activeActionSets[i].actionSet, syncInfo->activeActionSets[i].subactionPath});
         }
     }
 
-    std::vector<ActionStateUnion> states(actionsToGet.size());
-
-    result = GetActionStates(session, actionsToGet, states.data());
+    result = GetActionStates(session, plan->actionsToGet, plan->states.data());
 
     if(result != XR_SUCCESS) {
         return result;
@@ -4368,59 +5289,22 @@ XrResult OverlaysLayerSyncActionsMain(XrInstance parentInstance, XrSession sessi
 
     if(result == XR_SUCCESS) {
 
-        std::unordered_map <OverlaysLayerXrActionHandleInfo::Ptr, std::unordered_map<XrPath, ActionStateUnion>> previousActionStates;
+        auto& store = sessionInfo->actionStates;
 
         // Save off previous actions' states
-        GetPreviousActionStates(sessionInfo->parentInstance, session, syncInfo, previousActionStates);
+        store.SavePrevious();
 
         // On all actions in previous ActionSet and in this ActionSet, clear state
-        ClearSessionLastSyncedActiveActionSets(sessionInfo, syncInfo);
-        ClearSyncedActiveActionSets(sessionInfo->parentInstance, session, syncInfo);
-
-        uint32_t index = 0;
-        for(const auto& actionGetInfo: actionsToGet) {
-
-            auto actionInfo = OverlaysLayerGetHandleInfoFromXrAction(actionGetInfo.action);
-            auto subactionPath = actionGetInfo.subactionPath;
-            actionInfo->stateBySubactionPath.insert({subactionPath, states[index]});
-
-            if(false) if(actionInfo->createInfo->actionType == XR_ACTION_TYPE_BOOLEAN_INPUT) { // XXX debug
-                XrActionStateBoolean* boolean = (XrActionStateBoolean*)&states[index];
-                printf("for action \"%s\", subactionPath \"%s\"; currentState is %s, active is %s\n",
-                    actionInfo->createInfo->actionName,
-                    PathToString(sessionInfo->parentInstance, subactionPath).c_str(),
-                    boolean->currentState ? "true" : "false", boolean->isActive ? "true" : "false");
-            } 
-            if(false) if(actionInfo->createInfo->actionType == XR_ACTION_TYPE_FLOAT_INPUT) { // XXX debug
-                XrActionStateFloat* floatState = (XrActionStateFloat*)&states[index];
-                printf("for action \"%s\", subactionPath \"%s\"; currentState is %f, active is %s\n",
-                    actionInfo->createInfo->actionName,
-                    PathToString(sessionInfo->parentInstance, subactionPath).c_str(),
-                    floatState->currentState, floatState->isActive ? "true" : "false");
-            } 
-            index ++;
-        }
+        ClearSyncActionsPlanStates(store, sessionInfo->lastSyncActionsPlan);
+        ClearSyncActionsPlanStates(store, plan);
+        sessionInfo->lastSyncActionsPlan = plan;
 
-        // On all actions in current state and all subactionPaths, set lastSyncTime and changedSinceLastSync 
-        for(const auto& [actionInfo, subactionPaths] : actionInfoSubactionPaths) {
-            for(auto subactionPath: subactionPaths) {
-                if(previousActionStates.count(actionInfo) != 0) {
-                    auto previousStates = previousActionStates.at(actionInfo);
-                    if(previousStates.count(subactionPath) != 0) {
-                        auto previousState = previousStates.at(subactionPath);
-                        UpdateActionStateLastChange(actionInfo->createInfo->actionType, &previousState, &actionInfo->stateBySubactionPath.at(subactionPath)); // This .at() will succeed because previous loop populated all updated subactionPaths and XR_NULL_PATH
-                        if(false) if(actionInfo->createInfo->actionType == XR_ACTION_TYPE_FLOAT_INPUT) { // XXX debug
-                            XrActionStateFloat* floatState = &actionInfo->stateBySubactionPath.at(subactionPath).floatState;
-                            printf("for action \"%s\", subactionPath \"%s\"; changedSinceLastSync is %d, last time is %lld\n",
-                                actionInfo->createInfo->actionName,
-                                PathToString(sessionInfo->parentInstance, subactionPath).c_str(),
-                                floatState->changedSinceLastSync, floatState->lastChangeTime);
-                        } 
-                    }
-                }
-            }
+        for(size_t i = 0; i < plan->actionsToGet.size(); i++) {
+            store.Set(plan->getSlots[i], &plan->states[i]);
         }
 
+        store.UpdateLastChange(plan->updateSlots.data(), plan->updateSlots.size());
+
         // update interaction profiles and mark whether we need to synthesize an EVENT_DATA_INTERACTION_PROFILE_CHANGE
         for(XrPath p: instanceInfo->OverlaysLayerAllSubactionPaths) {
 
@@ -4460,7 +5344,6 @@ XrResult OverlaysLayerSyncActions(XrSession session, const XrActionsSyncInfo* sy
         } else {
             result = OverlaysLayerSyncActionsMain(sessionInfo->parentInstance, session, syncInfo);
         }
-        sessionInfo->lastSyncedActiveActionSets.assign(syncInfo->activeActionSets, syncInfo->activeActionSets + syncInfo->countActiveActionSets);
 
         return result;
 
@@ -4489,16 +5372,17 @@ XrResult OverlaysLayerGetActionStateBoolean(XrSession session, const XrActionSta
             return XR_ERROR_PATH_UNSUPPORTED; 
         }
 
-        if(actionInfo->stateBySubactionPath.count(getInfo->subactionPath) == 0) {
-
-            ActionStateUnion actionStateUnion;
-            ClearActionState(actionInfo->createInfo->actionType, &actionStateUnion);
-            *state = actionStateUnion.booleanState;
+        auto sessionInfo = OverlaysLayerGetHandleInfoFromXrSession(session);
 
+        // Never synced reads as inactive
+        ActionStateUnion actionStateUnion;
+        uint32_t slot;
+        if(sessionInfo->actionStates.FindSlot(getInfo->action, getInfo->subactionPath, &slot)) {
+            sessionInfo->actionStates.Get(slot, &actionStateUnion);
         } else {
-
-            *state = actionInfo->stateBySubactionPath.at(getInfo->subactionPath).booleanState;
+            ClearActionState(actionInfo->createInfo->actionType, &actionStateUnion);
         }
+        *state = actionStateUnion.booleanState;
         
         return XR_SUCCESS;
 
@@ -4527,28 +5411,17 @@ XrResult OverlaysLayerGetActionStateFloat(XrSession session, const XrActionState
             return XR_ERROR_PATH_UNSUPPORTED; 
         }
 
-        if(actionInfo->stateBySubactionPath.count(getInfo->subactionPath) == 0) {
-
-            ActionStateUnion actionStateUnion;
-            ClearActionState(actionInfo->createInfo->actionType, &actionStateUnion);
-            *state = actionStateUnion.floatState;
-
-            // XXX debug
-            if(false) printf("for action \"%s\", subactionPath \"%s\"; GetActionState stored inActive.\n",
-                actionInfo->createInfo->actionName,
-                PathToString(actionInfo->parentInstance, getInfo->subactionPath).c_str());
+        auto sessionInfo = OverlaysLayerGetHandleInfoFromXrSession(session);
 
+        // Never synced reads as inactive
+        ActionStateUnion actionStateUnion;
+        uint32_t slot;
+        if(sessionInfo->actionStates.FindSlot(getInfo->action, getInfo->subactionPath, &slot)) {
+            sessionInfo->actionStates.Get(slot, &actionStateUnion);
         } else {
-
-            *state = actionInfo->stateBySubactionPath.at(getInfo->subactionPath).floatState;
-
-            // XXX debug
-            if(false) printf("for action \"%s\", subactionPath \"%s\"; GetActionState yielded %f, active %d, changed %d, last time is %lld\n",
-                actionInfo->createInfo->actionName,
-                PathToString(actionInfo->parentInstance, getInfo->subactionPath).c_str(),
-                state->currentState, state->isActive,
-                state->changedSinceLastSync, state->lastChangeTime);
+            ClearActionState(actionInfo->createInfo->actionType, &actionStateUnion);
         }
+        *state = actionStateUnion.floatState;
         
         return XR_SUCCESS;
 
@@ -4577,16 +5450,17 @@ XrResult OverlaysLayerGetActionStateVector2f(XrSession session, const XrActionSt
             return XR_ERROR_PATH_UNSUPPORTED; 
         }
 
-        if(actionInfo->stateBySubactionPath.count(getInfo->subactionPath) == 0) {
-
-            ActionStateUnion actionStateUnion;
-            ClearActionState(actionInfo->createInfo->actionType, &actionStateUnion);
-            *state = actionStateUnion.vector2fState;
+        auto sessionInfo = OverlaysLayerGetHandleInfoFromXrSession(session);
 
+        // Never synced reads as inactive
+        ActionStateUnion actionStateUnion;
+        uint32_t slot;
+        if(sessionInfo->actionStates.FindSlot(getInfo->action, getInfo->subactionPath, &slot)) {
+            sessionInfo->actionStates.Get(slot, &actionStateUnion);
         } else {
-
-            *state = actionInfo->stateBySubactionPath.at(getInfo->subactionPath).vector2fState;
+            ClearActionState(actionInfo->createInfo->actionType, &actionStateUnion);
         }
+        *state = actionStateUnion.vector2fState;
         
         return XR_SUCCESS;
 
@@ -4615,16 +5489,17 @@ XrResult OverlaysLayerGetActionStatePose(XrSession session, const XrActionStateG
             return XR_ERROR_PATH_UNSUPPORTED; 
         }
 
-        if(actionInfo->stateBySubactionPath.count(getInfo->subactionPath) == 0) {
-
-            ActionStateUnion actionStateUnion;
-            ClearActionState(actionInfo->createInfo->actionType, &actionStateUnion);
-            *state = actionStateUnion.poseState;
+        auto sessionInfo = OverlaysLayerGetHandleInfoFromXrSession(session);
 
+        // Never synced reads as inactive
+        ActionStateUnion actionStateUnion;
+        uint32_t slot;
+        if(sessionInfo->actionStates.FindSlot(getInfo->action, getInfo->subactionPath, &slot)) {
+            sessionInfo->actionStates.Get(slot, &actionStateUnion);
         } else {
-
-            *state = actionInfo->stateBySubactionPath.at(getInfo->subactionPath).poseState;
+            ClearActionState(actionInfo->createInfo->actionType, &actionStateUnion);
         }
+        *state = actionStateUnion.poseState;
         
         
         return XR_SUCCESS;
@@ -4683,12 +5558,13 @@ XrResult OverlaysLayerApplyHapticFeedbackMainAsOverlay(ConnectionToOverlay::Ptr
     auto hapticFeedbackCopy = GetSharedCopyHandlesRestored(sessionInfo->parentInstance, "xrStopHapticFeedback", hapticFeedback);
 
     for(uint32_t i = 0; i < profileStringCount; i++) {
-        XrPath bindingPath = instanceInfo->OverlaysLayerWellKnownStringToPath.at(bindingStrings[i]); // This .at() must succeed; adding new binding paths would require enabling an extension which API Layer doesn't support
-        XrPath profilePath = instanceInfo->OverlaysLayerWellKnownStringToPath.at(profileStrings[i]); // This .at() must succeed; adding new binding paths would require enabling an extension which API Layer doesn't support
-
-        XrAction actualActionHandle = sessionInfo->placeholderActionsByProfileAndFullBinding.at({profilePath, bindingPath}).first; // This .at() must succeed; adding new binding paths would require enabling an extension which API Layer doesn't support
+        XrPath subactionPath;
+        XrAction actualActionHandle = FindPlaceholderAction(sessionInfo, profileStrings[i], bindingStrings[i], nullptr, &subactionPath);
+        if(actualActionHandle == XR_NULL_HANDLE) {
+            continue; // No Overlay asked for this binding before Main attached
+        }
 
-        XrHapticActionInfo hapticActionInfo { XR_TYPE_HAPTIC_ACTION_INFO, nullptr, actualActionHandle, XR_NULL_PATH };
+        XrHapticActionInfo hapticActionInfo { XR_TYPE_HAPTIC_ACTION_INFO, nullptr, actualActionHandle, subactionPath };
 
         XrResult result = sessionInfo->downchain->ApplyHapticFeedback(sessionInfo->actualHandle, &hapticActionInfo, hapticFeedbackCopy.get());
 
@@ -4708,12 +5584,13 @@ XrResult OverlaysLayerStopHapticFeedbackMainAsOverlay(ConnectionToOverlay::Ptr c
     auto instanceInfo = OverlaysLayerGetHandleInfoFromXrInstance(sessionInfo->parentInstance);
 
     for(uint32_t i = 0; i < profileStringCount; i++) {
-        XrPath bindingPath = instanceInfo->OverlaysLayerWellKnownStringToPath.at(bindingStrings[i]); // This .at() must succeed; adding new binding paths would require enabling an extension which API Layer doesn't support
-        XrPath profilePath = instanceInfo->OverlaysLayerWellKnownStringToPath.at(profileStrings[i]); // This .at() must succeed; adding new binding paths would require enabling an extension which API Layer doesn't support
-
-        XrAction actualActionHandle = sessionInfo->placeholderActionsByProfileAndFullBinding.at({profilePath, bindingPath}).first; // This .at() must succeed; adding new binding paths would require enabling an extension which API Layer doesn't support
+        XrPath subactionPath;
+        XrAction actualActionHandle = FindPlaceholderAction(sessionInfo, profileStrings[i], bindingStrings[i], nullptr, &subactionPath);
+        if(actualActionHandle == XR_NULL_HANDLE) {
+            continue; // No Overlay asked for this binding before Main attached
+        }
 
-        XrHapticActionInfo hapticActionInfo { XR_TYPE_HAPTIC_ACTION_INFO, nullptr, actualActionHandle, XR_NULL_PATH };
+        XrHapticActionInfo hapticActionInfo { XR_TYPE_HAPTIC_ACTION_INFO, nullptr, actualActionHandle, subactionPath };
 
         XrResult result = sessionInfo->downchain->StopHapticFeedback(sessionInfo->actualHandle, &hapticActionInfo);
     }
@@ -4915,12 +5792,11 @@ XrResult OverlaysLayerGetInputSourceLocalizedNameOverlay( XrInstance instance, X
     auto sessionInfo = OverlaysLayerGetHandleInfoFromXrSession(session);
     auto instanceInfo = OverlaysLayerGetHandleInfoFromXrInstance(instance);
 
-    if(instanceInfo->OverlaysLayerPathToWellKnownString.count(getInfo->sourcePath) == 0) {
+    WellKnownStringIndex sourceString;
+    if(!instanceInfo->OverlaysLayerPathToWellKnownString.Find(getInfo->sourcePath, &sourceString)) {
         return XR_ERROR_PATH_UNSUPPORTED;
     }
 
-    WellKnownStringIndex sourceString = instanceInfo->OverlaysLayerPathToWellKnownString.at(getInfo->sourcePath); // This .at() must succeed; adding new binding paths would require enabling an extension which API Layer doesn't support
-
     return RPCCallGetInputSourceLocalizedName(sessionInfo->parentInstance, sessionInfo->actualHandle, getInfo, sourceString, bufferCapacityInput, bufferCountOutput, buffer);
 }
 
@@ -23,13 +23,27 @@
 #include <openxr/openxr.h>
 #include <mutex>
 #include <new>
+#include <array>
+#include <map>
 #include <set>
 #include <unordered_map>
 #include <queue>
+#include <deque>
 #include <functional>
 #include <memory>
 #include <thread>
+#include <condition_variable>
 #include <atomic>
+#include <bitset>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+
+#include "action_state_merge.h"
+#include "graphics_backend.h"
+#include "overlay_visibility.h"
+#include "pose_extrapolation.h"
+#include "xr_extx_overlay_damage.h"
 
 struct OverlaysLayerXrException
 {
@@ -302,7 +316,9 @@ struct RPCChannels
     HANDLE mainResponseSema;
 
     DWORD otherProcessId;
-    HANDLE otherProcessHandle;
+    HANDLE otherProcessHandle;      // open for as long as the channel is
+
+    GraphicsPeer GetGraphicsPeer() const { return GraphicsPeer { otherProcessId, otherProcessHandle }; }
 
     constexpr static char *shmemNameTemplate = "LUNARG_XR_EXTX_overlay_rpc_shmem_%u";
     constexpr static char *overlayRequestSemaNameTemplate = "LUNARG_XR_EXTX_overlay_rpc_overlay_request_sema_%u";
@@ -488,31 +504,82 @@ struct MainSessionSessionState : public SessionStateTracker
 
 };
 
+// Regions of one of Main's swapchain images that are out of date with what
+// the Overlay last released.  Main's images are a ring, so an image has to
+// catch up on the damage of every release since it was last copied to.
+struct SwapchainImageDamage
+{
+    constexpr static size_t maxRects = 16;     // past this, track only the bounding rectangle
+    bool wholeImage = true;     // never copied to, or damage since then is unknown
+    std::vector<XrRect2Di> rects;
+
+    void Add(const XrRect2Di* newRects, uint32_t count);
+    void AddWholeImage()
+    {
+        wholeImage = true;
+        rects.clear();
+    }
+    void Clear()
+    {
+        wholeImage = false;
+        rects.clear();
+    }
+};
+
 // Bookkeeping of SwapchainImages for copying remote SwapchainImages on ReleaseSwapchainImage
-struct SwapchainCachedData
+// An image's fence reaches OverlayReleasedFenceValue(n) when the Overlay has
+// finished rendering to it for the nth time, and MainReleasedFenceValue(n)
+// when Main has finished reading that content.  Both sides count releases.
+inline uint64_t OverlayReleasedFenceValue(uint64_t releaseCount) { return releaseCount * 2 - 1; }
+inline uint64_t MainReleasedFenceValue(uint64_t releaseCount) { return releaseCount * 2; }
+
+// How long either side waits on the CPU for the other to reach a fence
+// value before giving up on the image; a process that stopped responding
+// shouldn't hang the other one
+constexpr uint32_t SharedImageWaitTimeoutMs = 2000;
+
+// Opened images of the Overlay's destroyed swapchains, by the Overlay's
+// image handle, until the Overlay reuses them for a new swapchain or discards them
+struct PooledSharedImage
 {
-    enum {
-        KEYED_MUTEX_OVERLAY = 0,
-        KEYED_MUTEX_MAIN = 1,
-    };
+    GraphicsImage::Ptr image;
+    uint64_t releaseCount;      // see OverlayReleasedFenceValue
+};
+typedef std::unordered_map<HANDLE, PooledSharedImage> MainSharedImagePool;
 
+struct SwapchainCachedData
+{
     XrSwapchain swapchain;
-    std::vector<ID3D11Texture2D*> swapchainImages;
-    std::set<HANDLE> remoteImagesAcquired;
-    std::unordered_map<HANDLE, ID3D11Texture2D*> handleTextureMap;
+    GraphicsBackend::Ptr backend;
+    GraphicsPeer overlayProcess;
+    std::vector<GraphicsImage::Ptr> swapchainImages;
     std::vector<uint32_t>   acquired;
-
-    SwapchainCachedData(XrSwapchain swapchain_, const std::vector<ID3D11Texture2D*>& swapchainImages_) :
+    uint32_t                inFlightSlot;   // index into MainSessionContext in-flight tracking
+    bool                    zeroCopy;       // Overlay renders directly into swapchainImages
+
+    // The Overlay's images, opened when it creates the swapchain (or
+    // swapchainImages if zeroCopy), indexed like swapchainImages
+    std::vector<GraphicsImage::Ptr> sharedImages;
+    std::vector<SharedImageHandle> sharedHandles;   // sharedImages as handles valid in the Overlay process
+    std::vector<uint64_t>   releaseCounts;  // Overlay releases of each of sharedImages so far
+    std::vector<SwapchainImageDamage> imageDamage;  // per swapchainImages
+    std::vector<bool>       sharedImageLost;    // sharedImages whose fence the Overlay didn't reach in time, so never copied from or signaled again
+    SharedImageDesc         desc;           // of the Overlay's images
+
+    SwapchainCachedData(XrSwapchain swapchain_, GraphicsBackend::Ptr backend_, const GraphicsPeer& overlayProcess_, const std::vector<GraphicsImage::Ptr>& swapchainImages_, const SharedImageDesc& desc_) :
         swapchain(swapchain_),
-        swapchainImages(swapchainImages_)
+        backend(backend_),
+        overlayProcess(overlayProcess_),
+        swapchainImages(swapchainImages_),
+        inFlightSlot(0xFFFFFFFF),
+        zeroCopy(false),
+        imageDamage(swapchainImages_.size()),
+        sharedImageLost(swapchainImages_.size(), false),
+        desc(desc_)
     {
-        for(auto texture : swapchainImages) {
-            texture->AddRef();
-        }
     }
 
-    ~SwapchainCachedData();
-    ID3D11Texture2D* getSharedTexture(ID3D11Device *d3d11Device, HANDLE sourceHandle);
+    bool openSharedImages(const HANDLE* images, const HANDLE* fences, uint32_t count, MainSharedImagePool& pool);
 
     typedef std::shared_ptr<SwapchainCachedData> Ptr;
 };
@@ -523,12 +590,79 @@ struct MainSessionContext
 {
     XrSession session;
     MainSessionSessionState sessionState;
-    std::set<std::shared_ptr<OverlaysLayerXrSwapchainHandleInfo>> swapchainsInFlight;
+
+    // Overlay swapchains are given small slot indices in Main so that the
+    // set of swapchains submitted in a frame is a flat bitset.  The
+    // compositor may still be reading a swapchain submitted in the previous
+    // xrEndFrame, so a swapchain is in flight if it was submitted in any of
+    // the last framesTrackedInFlight frames.
+    constexpr static uint32_t maxSwapchainSlots = 256;
+    constexpr static uint32_t invalidSwapchainSlot = 0xFFFFFFFF;
+    constexpr static uint32_t framesTrackedInFlight = 2;
+    typedef std::bitset<maxSwapchainSlots> SwapchainSlotSet;
+
+    SwapchainSlotSet swapchainsInFlight[framesTrackedInFlight];
+    uint64_t endFrameCount = 0;
+    // Holds each slot's swapchain alive until it is both destroyed and no longer in flight
+    std::vector<std::shared_ptr<OverlaysLayerXrSwapchainHandleInfo>> swapchainSlots;
+    SwapchainSlotSet swapchainSlotsDestroyed;
+
+    uint64_t waitFrameCount = 0;    // identifies the frame for state shared by everything within it
 
     MainSessionContext(XrSession session) :
         session(session)
     {}
 
+    uint32_t AllocateSwapchainSlot(std::shared_ptr<OverlaysLayerXrSwapchainHandleInfo> swapchainInfo)
+    {
+        for(uint32_t slot = 0; slot < swapchainSlots.size(); slot++) {
+            if(!swapchainSlots[slot]) {
+                swapchainSlots[slot] = swapchainInfo;
+                return slot;
+            }
+        }
+        if(swapchainSlots.size() == maxSwapchainSlots) {
+            return invalidSwapchainSlot;
+        }
+        swapchainSlots.push_back(swapchainInfo);
+        return (uint32_t)(swapchainSlots.size() - 1);
+    }
+
+    bool IsSwapchainInFlight(uint32_t slot) const
+    {
+        for(uint32_t i = 0; i < framesTrackedInFlight; i++) {
+            if(swapchainsInFlight[i].test(slot)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Slot is freed now if the compositor isn't holding it, otherwise after it drops out of flight
+    void ReleaseSwapchainSlot(uint32_t slot)
+    {
+        if(IsSwapchainInFlight(slot)) {
+            swapchainSlotsDestroyed.set(slot);
+        } else {
+            swapchainSlots[slot].reset();
+        }
+    }
+
+    void SetSwapchainsSubmitted(const SwapchainSlotSet& submitted)
+    {
+        endFrameCount++;
+        swapchainsInFlight[endFrameCount % framesTrackedInFlight] = submitted;
+
+        if(swapchainSlotsDestroyed.any()) {
+            for(uint32_t slot = 0; slot < swapchainSlots.size(); slot++) {
+                if(swapchainSlotsDestroyed.test(slot) && !IsSwapchainInFlight(slot)) {
+                    swapchainSlotsDestroyed.reset(slot);
+                    swapchainSlots[slot].reset();
+                }
+            }
+        }
+    }
+
     std::recursive_mutex mutex;
     std::unique_lock<std::recursive_mutex> GetLock()
     {
@@ -555,6 +689,29 @@ struct MainAsOverlaySessionContext
     constexpr static int maxOverlayCompositionLayers = 16;
     std::vector<std::shared_ptr<const XrCompositionLayerBaseHeader>> overlayLayers;
 
+    // Fed by Main's xrEndFrame with whether this Overlay's layers could be seen
+    OverlayCullHysteresis cullHysteresis;
+    // Computed in the Overlay's xrWaitFrame; if false the Overlay is told not to render
+    bool visible = true;
+
+    // Overlay xrReleaseSwapchainImages whose copies and runtime releases are
+    // done together at the Overlay's next xrEndFrame that shows them, see
+    // FlushPendingSwapchainReleases
+    struct PendingSwapchainRelease
+    {
+        std::shared_ptr<OverlaysLayerXrSwapchainHandleInfo> swapchainInfo;
+        GraphicsImage::Ptr sharedImage;
+        uint32_t which;             // runtime image to copy into and release
+        uint64_t releaseCount;      // see OverlayReleasedFenceValue
+        std::shared_ptr<XrSwapchainImageReleaseInfo> releaseInfo;   // handles restored for the runtime
+    };
+    std::vector<PendingSwapchainRelease> pendingReleases;
+    // Of those, ones whose copies the backend held for Main's next Flush.
+    // Main's xrEndFrame releases them right after it, see
+    // ReleaseSwapchainImagesAfterFlush, and notifies releasesAfterFlushDone.
+    std::vector<PendingSwapchainRelease> releasesAfterFlush;
+    std::condition_variable_any releasesAfterFlushDone;
+
     // This structure needs to be locked because Main could Destroy its
     // shared XrSession and all of its children and that would need to go
     // through here to mark those handles destroyed.
@@ -582,6 +739,8 @@ struct MainAsOverlaySessionContext
     typedef std::shared_ptr<MainAsOverlaySessionContext> Ptr;
 };
 
+struct ActionStateBaselines;
+
 struct ConnectionToOverlay
 {
     bool closed = false;
@@ -589,6 +748,8 @@ struct ConnectionToOverlay
     RPCChannels conn;
     MainAsOverlaySessionContext::Ptr ctx = nullptr;
     std::thread thread;
+    MainSharedImagePool sharedImagePool;    // only touched from RPCs, which are serialized
+    std::shared_ptr<ActionStateBaselines> actionStateBaselines;    // only touched from RPCs, which are serialized
 
     ConnectionToOverlay(const RPCChannels& conn) :
         conn(conn)
@@ -608,9 +769,30 @@ struct ConnectionToOverlay
     typedef std::shared_ptr<ConnectionToOverlay> Ptr;
 };
 
+// Shared images of destroyed swapchains, kept so an Overlay recreating a
+// swapchain with the same description doesn't allocate and share new
+// images.  Main keeps its opened counterparts (MainSharedImagePool) until
+// told they are discarded.
+struct OverlaySharedImagePool
+{
+    struct Entry
+    {
+        GraphicsBackend::Ptr backend;
+        SharedImageDesc desc;
+        GraphicsImage::Ptr image;
+        SharedImageHandle handle;
+        uint64_t releaseCount;
+    };
+
+    std::mutex mutex;
+    std::deque<Entry> entries;  // oldest first
+    static constexpr size_t maxImages = 16;
+};
+
 struct ConnectionToMain
 {
     RPCChannels conn;
+    OverlaySharedImagePool sharedImagePool;
     typedef std::shared_ptr<ConnectionToMain> Ptr;
 };
 
@@ -633,32 +815,47 @@ uint64_t GetNextLocalHandle();
 struct OverlaySwapchain
 {
     XrSwapchain             swapchain;
-    std::vector<ID3D11Texture2D*> swapchainTextures;
-    std::vector<HANDLE>          swapchainHandles;
+    GraphicsBackend::Ptr    backend;
+    std::vector<GraphicsImage::Ptr> swapchainImages;
+    std::vector<SharedImageHandle> swapchainHandles;
+    std::vector<uint64_t>   releaseCounts;  // per swapchainImages, see OverlayReleasedFenceValue
     std::vector<uint32_t>   acquired;
     bool                    waited;
+    bool                    zeroCopy;       // swapchainImages were created by Main
     int                     width;
     int                     height;
-    DXGI_FORMAT             format;
+    int64_t                 format;
+    uint32_t                arraySize;
+    uint32_t                mipCount;
+    uint32_t                sampleCount;
 
 
-    OverlaySwapchain(XrSwapchain sc, size_t count, const XrSwapchainCreateInfo* createInfo) :
+    OverlaySwapchain(XrSwapchain sc, GraphicsBackend::Ptr backend_, size_t count, const XrSwapchainCreateInfo* createInfo) :
         swapchain(sc),
-        swapchainTextures(count),
+        backend(backend_),
+        swapchainImages(count),
         swapchainHandles(count),
+        releaseCounts(count),
         waited(false),
+        zeroCopy(false),
         width(createInfo->width),
         height(createInfo->height),
-        format(static_cast<DXGI_FORMAT>(createInfo->format))
+        format(createInfo->format),
+        arraySize(createInfo->arraySize),
+        mipCount(createInfo->mipCount),
+        sampleCount(createInfo->sampleCount)
     {
     }
-    bool CreateTextures(XrInstance instance, ID3D11Device *d3d11, DWORD mainProcessId);
+    SharedImageDesc GetDesc() const
+    {
+        return SharedImageDesc { (uint32_t)width, (uint32_t)height, format, arraySize, mipCount, sampleCount };
+    }
+    bool CreateImages(XrInstance instance, const GraphicsPeer& mainProcess, OverlaySharedImagePool& pool);
+    void RecycleImages(XrInstance instance, OverlaySharedImagePool& pool);
+    bool OpenImages(XrInstance instance, const GraphicsPeer& mainProcess, const std::vector<SharedImageHandle>& handles);
     ~OverlaySwapchain()
     {
-        // XXX Need to AcquireSync from remote side?
-        for(int i = 0; i < swapchainTextures.size(); i++) {
-            swapchainTextures[i]->Release();
-        }
+        // XXX Need to wait for Main to finish reading from our images?
     }
     typedef std::shared_ptr<OverlaySwapchain> Ptr;
 };
@@ -775,6 +972,40 @@ union ActionStateUnion
     XrActionStatePose poseState;
 };
 
+// A session's synced action state, as parallel arrays indexed by one slot
+// per (action, subaction path).  Each array only means something for slots
+// of its action type; pose actions only have isActive.  The previous*
+// arrays hold the state as of the previous sync for change detection.
+struct ActionStateStore
+{
+    std::vector<XrActionType> actionTypes;
+    std::vector<XrBool32> isActive;
+    std::vector<XrBool32> booleanStates;
+    std::vector<float> floatStates;
+    std::vector<XrVector2f> vector2fStates;
+    std::vector<XrBool32> changedSinceLastSync;
+    std::vector<XrTime> lastChangeTimes;
+
+    std::vector<XrBool32> previousIsActive;
+    std::vector<XrBool32> previousBooleanStates;
+    std::vector<float> previousFloatStates;
+    std::vector<XrVector2f> previousVector2fStates;
+    std::vector<XrTime> previousLastChangeTimes;
+
+    std::map<std::pair<XrAction, XrPath>, uint32_t> slotsByActionAndSubactionPath;
+    std::unordered_map<XrAction, std::vector<uint32_t>> slotsByAction;
+
+    uint32_t GetSlot(XrAction action, XrPath subactionPath, XrActionType actionType);   // adds an inactive slot the first time
+    bool FindSlot(XrAction action, XrPath subactionPath, uint32_t* slot) const;
+
+    void SavePrevious();
+    void ClearAction(XrAction action);
+    void Set(uint32_t slot, const ActionStateUnion* state);
+    void SetLanes(const uint32_t* slots, size_t count, const ActionStateLanes& lanes);  // lane i to slots[i]
+    void UpdateLastChange(const uint32_t* slots, size_t count);
+    void Get(uint32_t slot, ActionStateUnion* state) const;
+};
+
 enum WellKnownStringIndex {
     NULL_PATH = 0,
     USER_HAND_LEFT_INPUT_GRIP_POSE = 1,
@@ -946,6 +1177,1339 @@ enum WellKnownStringIndex {
 
 }; // Existing entries will need to not change for subsequent versions for backward compatibility after the first public release
 
+constexpr uint32_t WellKnownStringCount = 167;  // including NULL_PATH
+
+constexpr uint32_t HashWellKnownString(const char *str, uint32_t seed)
+{
+    uint32_t h = 2166136261u ^ seed;
+    for(; *str; str++) {
+        h = (h ^ (unsigned char)*str) * 16777619u;
+    }
+    h ^= h >> 15;
+    h *= 0x2C1B3C6Du;
+    h ^= h >> 12;
+    return h;
+}
+
+constexpr bool WellKnownStringsEqual(const char *a, const char *b)
+{
+    for(; *a && (*a == *b); a++, b++);
+    return *a == *b;
+}
+
+struct WellKnownStringHashSlot
+{
+    const char *string;                 // nullptr if no string hashes here
+    WellKnownStringIndex index;
+};
+
+constexpr uint32_t WellKnownStringHashBucketCount = 64;
+constexpr uint32_t WellKnownStringHashSlotCount = 256;
+
+inline constexpr uint32_t WellKnownStringHashSeeds[WellKnownStringHashBucketCount] = {
+    1, 1, 1, 1, 1, 4, 1, 2,
+    0, 7, 1, 5, 1, 1, 1, 1,
+    3, 1, 3, 0, 2, 7, 1, 1,
+    2, 1, 4, 4, 10, 7, 4, 0,
+    0, 3, 1, 13, 1, 18, 1, 1,
+    0, 5, 0, 7, 3, 9, 1, 2,
+    0, 1, 4, 1, 1, 3, 7, 6,
+    1, 1, 4, 10, 1, 4, 1, 4,
+};
+
+inline constexpr WellKnownStringHashSlot WellKnownStringHashSlots[WellKnownStringHashSlotCount] = {
+    {nullptr, NULL_PATH},
+    {nullptr, NULL_PATH},
+    {"/user/hand/right/input/a/click", USER_HAND_RIGHT_INPUT_A_CLICK},
+    {"/user/hand/right/input/thumbstick", USER_HAND_RIGHT_INPUT_THUMBSTICK},
+    {"/input/trigger_right/value", INPUT_TRIGGER_RIGHT_VALUE},
+    {"/input/dpad_left/click", INPUT_DPAD_LEFT_CLICK},
+    {"/input/squeeze/force", INPUT_SQUEEZE_FORCE},
+    {"/user/hand/left/output/haptic", USER_HAND_LEFT_OUTPUT_HAPTIC},
+    {nullptr, NULL_PATH},
+    {"/user/head/input/system/click", USER_HEAD_INPUT_SYSTEM_CLICK},
+    {"/user/hand/right/input/squeeze/click", USER_HAND_RIGHT_INPUT_SQUEEZE_CLICK},
+    {"/user/hand/right/input/system/touch", USER_HAND_RIGHT_INPUT_SYSTEM_TOUCH},
+    {nullptr, NULL_PATH},
+    {"/output/haptic_left_trigger", OUTPUT_HAPTIC_LEFT_TRIGGER},
+    {nullptr, NULL_PATH},
+    {"/input/shoulder_right/click", INPUT_SHOULDER_RIGHT_CLICK},
+    {"/user/gamepad", USER_GAMEPAD},
+    {"/user/hand/left/input/squeeze/click", USER_HAND_LEFT_INPUT_SQUEEZE_CLICK},
+    {"/user/gamepad/input/thumbstick_left/y", USER_GAMEPAD_INPUT_THUMBSTICK_LEFT_Y},
+    {"/user/hand/left/input/trackpad/x", USER_HAND_LEFT_INPUT_TRACKPAD_X},
+    {"/input/b/touch", INPUT_B_TOUCH},
+    {"/input/volume_down/click", INPUT_VOLUME_DOWN_CLICK},
+    {"/user/hand/left/input/trigger/touch", USER_HAND_LEFT_INPUT_TRIGGER_TOUCH},
+    {"/interaction_profiles/hp/mixed_reality_controller", INTERACTION_PROFILES_HP_MIXED_REALITY_CONTROLLER},
+    {"/interaction_profiles/oculus/touch_controller", INTERACTION_PROFILES_OCULUS_TOUCH_CONTROLLER},
+    {"/user/gamepad/input/thumbstick_right/x", USER_GAMEPAD_INPUT_THUMBSTICK_RIGHT_X},
+    {"/user/hand/left/input/b/touch", USER_HAND_LEFT_INPUT_B_TOUCH},
+    {"/user/hand/left/input/trigger/click", USER_HAND_LEFT_INPUT_TRIGGER_CLICK},
+    {nullptr, NULL_PATH},
+    {"/user/hand/left/input/select/click", USER_HAND_LEFT_INPUT_SELECT_CLICK},
+    {"/interaction_profiles/microsoft/motion_controller", INTERACTION_PROFILES_MICROSOFT_MOTION_CONTROLLER},
+    {"/user/hand/left/input/squeeze/force", USER_HAND_LEFT_INPUT_SQUEEZE_FORCE},
+    {"/input/thumbstick", INPUT_THUMBSTICK},
+    {nullptr, NULL_PATH},
+    {nullptr, NULL_PATH},
+    {"/user/gamepad/input/x/click", USER_GAMEPAD_INPUT_X_CLICK},
+    {nullptr, NULL_PATH},
+    {"/user/hand/right/input/grip/pose", USER_HAND_RIGHT_INPUT_GRIP_POSE},
+    {"/user/gamepad/input/thumbstick_right", USER_GAMEPAD_INPUT_THUMBSTICK_RIGHT},
+    {"/user/gamepad/input/b/click", USER_GAMEPAD_INPUT_B_CLICK},
+    {"/user/hand/left/input/thumbstick/touch", USER_HAND_LEFT_INPUT_THUMBSTICK_TOUCH},
+    {"/user/hand/right/input/system/click", USER_HAND_RIGHT_INPUT_SYSTEM_CLICK},
+    {nullptr, NULL_PATH},
+    {nullptr, NULL_PATH},
+    {nullptr, NULL_PATH},
+    {"/input/system/click", INPUT_SYSTEM_CLICK},
+    {"/input/grip/pose", INPUT_GRIP_POSE},
+    {"/interaction_profiles/google/daydream_controller", INTERACTION_PROFILES_GOOGLE_DAYDREAM_CONTROLLER},
+    {nullptr, NULL_PATH},
+    {"/input/trigger/click", INPUT_TRIGGER_CLICK},
+    {"/user/hand/left/input/thumbrest/touch", USER_HAND_LEFT_INPUT_THUMBREST_TOUCH},
+    {"/input/view/click", INPUT_VIEW_CLICK},
+    {nullptr, NULL_PATH},
+    {"/user/gamepad/input/dpad_down/click", USER_GAMEPAD_INPUT_DPAD_DOWN_CLICK},
+    {"/user/hand/left/input/thumbstick/x", USER_HAND_LEFT_INPUT_THUMBSTICK_X},
+    {"/input/y/touch", INPUT_Y_TOUCH},
+    {"/input/dpad_down/click", INPUT_DPAD_DOWN_CLICK},
+    {"/user/hand/right/input/select/click", USER_HAND_RIGHT_INPUT_SELECT_CLICK},
+    {nullptr, NULL_PATH},
+    {nullptr, NULL_PATH},
+    {nullptr, NULL_PATH},
+    {nullptr, NULL_PATH},
+    {nullptr, NULL_PATH},
+    {"/user/hand/right/input/b/click", USER_HAND_RIGHT_INPUT_B_CLICK},
+    {"/user/hand/left/input/thumbstick", USER_HAND_LEFT_INPUT_THUMBSTICK},
+    {"/input/thumbstick_right/y", INPUT_THUMBSTICK_RIGHT_Y},
+    {"/user/hand/left/input/trackpad/touch", USER_HAND_LEFT_INPUT_TRACKPAD_TOUCH},
+    {"/output/haptic_right_trigger", OUTPUT_HAPTIC_RIGHT_TRIGGER},
+    {nullptr, NULL_PATH},
+    {"/user/hand/right/input/b/touch", USER_HAND_RIGHT_INPUT_B_TOUCH},
+    {"/user/hand/right/input/aim/pose", USER_HAND_RIGHT_INPUT_AIM_POSE},
+    {"/user/hand/left/input/trackpad/click", USER_HAND_LEFT_INPUT_TRACKPAD_CLICK},
+    {"/input/thumbstick/y", INPUT_THUMBSTICK_Y},
+    {"/user/hand/right/input/menu/click", USER_HAND_RIGHT_INPUT_MENU_CLICK},
+    {"/input/mute_mic/click", INPUT_MUTE_MIC_CLICK},
+    {"/user/head/input/volume_down/click", USER_HEAD_INPUT_VOLUME_DOWN_CLICK},
+    {nullptr, NULL_PATH},
+    {nullptr, NULL_PATH},
+    {nullptr, NULL_PATH},
+    {"/user/hand/left/input/system/click", USER_HAND_LEFT_INPUT_SYSTEM_CLICK},
+    {"/input/trigger_left/value", INPUT_TRIGGER_LEFT_VALUE},
+    {nullptr, NULL_PATH},
+    {"/user/gamepad/input/thumbstick_right/click", USER_GAMEPAD_INPUT_THUMBSTICK_RIGHT_CLICK},
+    {"/input/trackpad/y", INPUT_TRACKPAD_Y},
+    {"/user/gamepad/input/dpad_up/click", USER_GAMEPAD_INPUT_DPAD_UP_CLICK},
+    {"/input/system/touch", INPUT_SYSTEM_TOUCH},
+    {"/user/hand/left/input/system/touch", USER_HAND_LEFT_INPUT_SYSTEM_TOUCH},
+    {"/user/hand/left/input/grip/pose", USER_HAND_LEFT_INPUT_GRIP_POSE},
+    {"/user/gamepad/input/thumbstick_right/y", USER_GAMEPAD_INPUT_THUMBSTICK_RIGHT_Y},
+    {"/input/thumbstick/touch", INPUT_THUMBSTICK_TOUCH},
+    {"/user/hand/right/input/trigger/click", USER_HAND_RIGHT_INPUT_TRIGGER_CLICK},
+    {"/user/hand/right", USER_HAND_RIGHT},
+    {"/user/hand/right/input/squeeze/force", USER_HAND_RIGHT_INPUT_SQUEEZE_FORCE},
+    {nullptr, NULL_PATH},
+    {nullptr, NULL_PATH},
+    {"/input/trackpad/x", INPUT_TRACKPAD_X},
+    {"/user/gamepad/input/thumbstick_left/x", USER_GAMEPAD_INPUT_THUMBSTICK_LEFT_X},
+    {nullptr, NULL_PATH},
+    {nullptr, NULL_PATH},
+    {"/user/hand/left/input/squeeze/value", USER_HAND_LEFT_INPUT_SQUEEZE_VALUE},
+    {nullptr, NULL_PATH},
+    {"/user/hand/left/input/a/click", USER_HAND_LEFT_INPUT_A_CLICK},
+    {"/input/a/touch", INPUT_A_TOUCH},
+    {"/user/hand/right/input/trackpad/y", USER_HAND_RIGHT_INPUT_TRACKPAD_Y},
+    {"/input/x/click", INPUT_X_CLICK},
+    {nullptr, NULL_PATH},
+    {nullptr, NULL_PATH},
+    {"/input/thumbstick_right/x", INPUT_THUMBSTICK_RIGHT_X},
+    {"/user/hand/left/input/y/click", USER_HAND_LEFT_INPUT_Y_CLICK},
+    {nullptr, NULL_PATH},
+    {nullptr, NULL_PATH},
+    {"/input/trigger/touch", INPUT_TRIGGER_TOUCH},
+    {nullptr, NULL_PATH},
+    {"/input/trackpad/force", INPUT_TRACKPAD_FORCE},
+    {"/user/hand/right/input/squeeze/value", USER_HAND_RIGHT_INPUT_SQUEEZE_VALUE},
+    {nullptr, NULL_PATH},
+    {"/user/hand/right/input/back/click", USER_HAND_RIGHT_INPUT_BACK_CLICK},
+    {"/interaction_profiles/valve/index_controller", INTERACTION_PROFILES_VALVE_INDEX_CONTROLLER},
+    {nullptr, NULL_PATH},
+    {"/user/gamepad/input/shoulder_right/click", USER_GAMEPAD_INPUT_SHOULDER_RIGHT_CLICK},
+    {"/user/gamepad/input/thumbstick_left", USER_GAMEPAD_INPUT_THUMBSTICK_LEFT},
+    {"/input/thumbstick_left", INPUT_THUMBSTICK_LEFT},
+    {"/input/thumbstick_left/x", INPUT_THUMBSTICK_LEFT_X},
+    {nullptr, NULL_PATH},
+    {nullptr, NULL_PATH},
+    {"/user/hand/left/input/back/click", USER_HAND_LEFT_INPUT_BACK_CLICK},
+    {"/interaction_profiles/khr/simple_controller", INTERACTION_PROFILES_KHR_SIMPLE_CONTROLLER},
+    {"/user/hand/left/input/a/touch", USER_HAND_LEFT_INPUT_A_TOUCH},
+    {"/input/trackpad/touch", INPUT_TRACKPAD_TOUCH},
+    {"/input/shoulder_left/click", INPUT_SHOULDER_LEFT_CLICK},
+    {nullptr, NULL_PATH},
+    {nullptr, NULL_PATH},
+    {nullptr, NULL_PATH},
+    {"/input/x/touch", INPUT_X_TOUCH},
+    {nullptr, NULL_PATH},
+    {nullptr, NULL_PATH},
+    {nullptr, NULL_PATH},
+    {nullptr, NULL_PATH},
+    {"/input/thumbstick/x", INPUT_THUMBSTICK_X},
+    {"/user/hand/left/input/x/touch", USER_HAND_LEFT_INPUT_X_TOUCH},
+    {nullptr, NULL_PATH},
+    {"/input/aim/pose", INPUT_AIM_POSE},
+    {nullptr, NULL_PATH},
+    {"/input/trackpad/click", INPUT_TRACKPAD_CLICK},
+    {"/user/hand/right/input/thumbstick/touch", USER_HAND_RIGHT_INPUT_THUMBSTICK_TOUCH},
+    {nullptr, NULL_PATH},
+    {nullptr, NULL_PATH},
+    {"/user/hand/right/input/thumbstick/y", USER_HAND_RIGHT_INPUT_THUMBSTICK_Y},
+    {nullptr, NULL_PATH},
+    {"/user/gamepad/input/shoulder_left/click", USER_GAMEPAD_INPUT_SHOULDER_LEFT_CLICK},
+    {"/input/select/click", INPUT_SELECT_CLICK},
+    {nullptr, NULL_PATH},
+    {"/output/haptic_left", OUTPUT_HAPTIC_LEFT},
+    {"/user/head", USER_HEAD},
+    {"/user/gamepad/output/haptic_right_trigger", USER_GAMEPAD_OUTPUT_HAPTIC_RIGHT_TRIGGER},
+    {"/user/gamepad/input/menu/click", USER_GAMEPAD_INPUT_MENU_CLICK},
+    {nullptr, NULL_PATH},
+    {"/user/hand/left/input/x/click", USER_HAND_LEFT_INPUT_X_CLICK},
+    {"/interaction_profiles/microsoft/xbox_controller", INTERACTION_PROFILES_MICROSOFT_XBOX_CONTROLLER},
+    {nullptr, NULL_PATH},
+    {nullptr, NULL_PATH},
+    {nullptr, NULL_PATH},
+    {nullptr, NULL_PATH},
+    {nullptr, NULL_PATH},
+    {"/input/a/click", INPUT_A_CLICK},
+    {"/user/gamepad/input/a/click", USER_GAMEPAD_INPUT_A_CLICK},
+    {"/interaction_profiles/oculus/go_controller", INTERACTION_PROFILES_OCULUS_GO_CONTROLLER},
+    {"/output/haptic_right", OUTPUT_HAPTIC_RIGHT},
+    {nullptr, NULL_PATH},
+    {"/user/gamepad/input/dpad_right/click", USER_GAMEPAD_INPUT_DPAD_RIGHT_CLICK},
+    {"/user/gamepad/input/trigger_left/value", USER_GAMEPAD_INPUT_TRIGGER_LEFT_VALUE},
+    {nullptr, NULL_PATH},
+    {nullptr, NULL_PATH},
+    {"/user/hand/right/input/thumbstick/click", USER_HAND_RIGHT_INPUT_THUMBSTICK_CLICK},
+    {nullptr, NULL_PATH},
+    {nullptr, NULL_PATH},
+    {"/user/gamepad/input/view/click", USER_GAMEPAD_INPUT_VIEW_CLICK},
+    {nullptr, NULL_PATH},
+    {nullptr, NULL_PATH},
+    {nullptr, NULL_PATH},
+    {"/input/dpad_up/click", INPUT_DPAD_UP_CLICK},
+    {nullptr, NULL_PATH},
+    {nullptr, NULL_PATH},
+    {nullptr, NULL_PATH},
+    {nullptr, NULL_PATH},
+    {nullptr, NULL_PATH},
+    {"/input/y/click", INPUT_Y_CLICK},
+    {"/input/thumbstick_right/click", INPUT_THUMBSTICK_RIGHT_CLICK},
+    {"/user/gamepad/output/haptic_right", USER_GAMEPAD_OUTPUT_HAPTIC_RIGHT},
+    {"/user/hand/left/input/thumbstick/y", USER_HAND_LEFT_INPUT_THUMBSTICK_Y},
+    {"/input/dpad_right/click", INPUT_DPAD_RIGHT_CLICK},
+    {"/user/gamepad/input/trigger_right/value", USER_GAMEPAD_INPUT_TRIGGER_RIGHT_VALUE},
+    {"/input/thumbstick/click", INPUT_THUMBSTICK_CLICK},
+    {nullptr, NULL_PATH},
+    {"/input/trackpad", INPUT_TRACKPAD},
+    {nullptr, NULL_PATH},
+    {"/user/hand/left/input/trigger/value", USER_HAND_LEFT_INPUT_TRIGGER_VALUE},
+    {"/input/thumbrest/touch", INPUT_THUMBREST_TOUCH},
+    {"/user/hand/left/input/trackpad/y", USER_HAND_LEFT_INPUT_TRACKPAD_Y},
+    {nullptr, NULL_PATH},
+    {"/user/gamepad/output/haptic_left_trigger", USER_GAMEPAD_OUTPUT_HAPTIC_LEFT_TRIGGER},
+    {nullptr, NULL_PATH},
+    {"/input/thumbstick_left/y", INPUT_THUMBSTICK_LEFT_Y},
+    {nullptr, NULL_PATH},
+    {nullptr, NULL_PATH},
+    {"/input/back/click", INPUT_BACK_CLICK},
+    {"/user/hand/left/input/trackpad", USER_HAND_LEFT_INPUT_TRACKPAD},
+    {nullptr, NULL_PATH},
+    {"/user/gamepad/input/thumbstick_left/click", USER_GAMEPAD_INPUT_THUMBSTICK_LEFT_CLICK},
+    {nullptr, NULL_PATH},
+    {nullptr, NULL_PATH},
+    {"/user/hand/left/input/menu/click", USER_HAND_LEFT_INPUT_MENU_CLICK},
+    {"/user/hand/right/input/trackpad/force", USER_HAND_RIGHT_INPUT_TRACKPAD_FORCE},
+    {"/input/volume_up/click", INPUT_VOLUME_UP_CLICK},
+    {"/user/hand/right/output/haptic", USER_HAND_RIGHT_OUTPUT_HAPTIC},
+    {"/user/hand/right/input/trackpad/touch", USER_HAND_RIGHT_INPUT_TRACKPAD_TOUCH},
+    {"/user/hand/left/input/trackpad/force", USER_HAND_LEFT_INPUT_TRACKPAD_FORCE},
+    {"/input/b/click", INPUT_B_CLICK},
+    {"/user/hand/right/input/trackpad", USER_HAND_RIGHT_INPUT_TRACKPAD},
+    {"/interaction_profiles/htc/vive_pro", INTERACTION_PROFILES_HTC_VIVE_PRO},
+    {nullptr, NULL_PATH},
+    {nullptr, NULL_PATH},
+    {"/user/head/input/volume_up/click", USER_HEAD_INPUT_VOLUME_UP_CLICK},
+    {"/user/hand/right/input/a/touch", USER_HAND_RIGHT_INPUT_A_TOUCH},
+    {"/user/gamepad/input/dpad_left/click", USER_GAMEPAD_INPUT_DPAD_LEFT_CLICK},
+    {"/user/hand/left", USER_HAND_LEFT},
+    {"/user/hand/right/input/trigger/value", USER_HAND_RIGHT_INPUT_TRIGGER_VALUE},
+    {"/user/hand/left/input/aim/pose", USER_HAND_LEFT_INPUT_AIM_POSE},
+    {"/input/squeeze/value", INPUT_SQUEEZE_VALUE},
+    {"/user/hand/right/input/thumbstick/x", USER_HAND_RIGHT_INPUT_THUMBSTICK_X},
+    {"/user/hand/right/input/trigger/touch", USER_HAND_RIGHT_INPUT_TRIGGER_TOUCH},
+    {"/input/thumbstick_right", INPUT_THUMBSTICK_RIGHT},
+    {"/user/gamepad/input/y/click", USER_GAMEPAD_INPUT_Y_CLICK},
+    {"/user/hand/right/input/thumbrest/touch", USER_HAND_RIGHT_INPUT_THUMBREST_TOUCH},
+    {"/input/thumbstick_left/click", INPUT_THUMBSTICK_LEFT_CLICK},
+    {"/output/haptic", OUTPUT_HAPTIC},
+    {nullptr, NULL_PATH},
+    {nullptr, NULL_PATH},
+    {nullptr, NULL_PATH},
+    {"/user/hand/left/input/b/click", USER_HAND_LEFT_INPUT_B_CLICK},
+    {"/input/squeeze/click", INPUT_SQUEEZE_CLICK},
+    {"/input/trigger/value", INPUT_TRIGGER_VALUE},
+    {"/user/head/input/mute_mic/click", USER_HEAD_INPUT_MUTE_MIC_CLICK},
+    {nullptr, NULL_PATH},
+    {nullptr, NULL_PATH},
+    {"/user/hand/left/input/thumbstick/click", USER_HAND_LEFT_INPUT_THUMBSTICK_CLICK},
+    {nullptr, NULL_PATH},
+    {nullptr, NULL_PATH},
+    {"/user/hand/left/input/y/touch", USER_HAND_LEFT_INPUT_Y_TOUCH},
+    {"/user/hand/right/input/trackpad/click", USER_HAND_RIGHT_INPUT_TRACKPAD_CLICK},
+    {"/interaction_profiles/htc/vive_controller", INTERACTION_PROFILES_HTC_VIVE_CONTROLLER},
+    {"/input/menu/click", INPUT_MENU_CLICK},
+    {nullptr, NULL_PATH},
+    {"/user/hand/right/input/trackpad/x", USER_HAND_RIGHT_INPUT_TRACKPAD_X},
+    {"/user/gamepad/output/haptic_left", USER_GAMEPAD_OUTPUT_HAPTIC_LEFT},
+    {nullptr, NULL_PATH},
+};
+
+// WellKnownStringIndex for str, or NULL_PATH if str isn't a well-known string
+constexpr WellKnownStringIndex FindWellKnownString(const char *str)
+{
+    uint32_t seed = WellKnownStringHashSeeds[HashWellKnownString(str, 0) % WellKnownStringHashBucketCount];
+    const WellKnownStringHashSlot& slot = WellKnownStringHashSlots[HashWellKnownString(str, seed) % WellKnownStringHashSlotCount];
+    return (slot.string && WellKnownStringsEqual(slot.string, str)) ? slot.index : NULL_PATH;
+}
+
+constexpr std::array<const char *, WellKnownStringCount> MakeWellKnownStringTable()
+{
+    std::array<const char *, WellKnownStringCount> strings {};
+    for(const auto& slot: WellKnownStringHashSlots) {
+        if(slot.string) {
+            strings[slot.index] = slot.string;
+        }
+    }
+    return strings;
+}
+
+// String for each WellKnownStringIndex; nullptr for NULL_PATH
+inline constexpr std::array<const char *, WellKnownStringCount> OverlaysLayerWellKnownStrings = MakeWellKnownStringTable();
+
+static_assert(FindWellKnownString("/interaction_profiles/khr/simple_controller") == INTERACTION_PROFILES_KHR_SIMPLE_CONTROLLER, "well-known string hash doesn't find its strings");
+static_assert(FindWellKnownString("/interaction_profiles/khr/not_a_controller") == NULL_PATH, "well-known string hash finds strings it doesn't have");
+
+// Placeholder actions Main creates for Overlays, one for each cell of
+// PlaceholderCells, i.e. interaction profile and input component, with a
+// subaction path for every top-level path in the cell's subactionMask
+
+constexpr uint32_t PlaceholderTopLevelCount = 4;
+inline constexpr WellKnownStringIndex PlaceholderTopLevels[PlaceholderTopLevelCount] = {
+    USER_GAMEPAD,
+    USER_HAND_LEFT,
+    USER_HAND_RIGHT,
+    USER_HEAD,
+};
+
+constexpr uint32_t PlaceholderProfileCount = 10;
+inline constexpr WellKnownStringIndex PlaceholderProfiles[PlaceholderProfileCount] = {
+    INTERACTION_PROFILES_GOOGLE_DAYDREAM_CONTROLLER,
+    INTERACTION_PROFILES_HP_MIXED_REALITY_CONTROLLER,
+    INTERACTION_PROFILES_HTC_VIVE_CONTROLLER,
+    INTERACTION_PROFILES_HTC_VIVE_PRO,
+    INTERACTION_PROFILES_KHR_SIMPLE_CONTROLLER,
+    INTERACTION_PROFILES_MICROSOFT_MOTION_CONTROLLER,
+    INTERACTION_PROFILES_MICROSOFT_XBOX_CONTROLLER,
+    INTERACTION_PROFILES_OCULUS_GO_CONTROLLER,
+    INTERACTION_PROFILES_OCULUS_TOUCH_CONTROLLER,
+    INTERACTION_PROFILES_VALVE_INDEX_CONTROLLER,
+};
+
+constexpr uint32_t PlaceholderComponentCount = 58;
+inline constexpr WellKnownStringIndex PlaceholderComponents[PlaceholderComponentCount] = {
+    INPUT_A_CLICK,
+    INPUT_A_TOUCH,
+    INPUT_AIM_POSE,
+    INPUT_B_CLICK,
+    INPUT_B_TOUCH,
+    INPUT_BACK_CLICK,
+    INPUT_DPAD_DOWN_CLICK,
+    INPUT_DPAD_LEFT_CLICK,
+    INPUT_DPAD_RIGHT_CLICK,
+    INPUT_DPAD_UP_CLICK,
+    INPUT_GRIP_POSE,
+    INPUT_MENU_CLICK,
+    INPUT_MUTE_MIC_CLICK,
+    INPUT_SELECT_CLICK,
+    INPUT_SHOULDER_LEFT_CLICK,
+    INPUT_SHOULDER_RIGHT_CLICK,
+    INPUT_SQUEEZE_CLICK,
+    INPUT_SQUEEZE_FORCE,
+    INPUT_SQUEEZE_VALUE,
+    INPUT_SYSTEM_CLICK,
+    INPUT_SYSTEM_TOUCH,
+    INPUT_THUMBREST_TOUCH,
+    INPUT_THUMBSTICK,
+    INPUT_THUMBSTICK_CLICK,
+    INPUT_THUMBSTICK_TOUCH,
+    INPUT_THUMBSTICK_X,
+    INPUT_THUMBSTICK_Y,
+    INPUT_THUMBSTICK_LEFT,
+    INPUT_THUMBSTICK_LEFT_CLICK,
+    INPUT_THUMBSTICK_LEFT_X,
+    INPUT_THUMBSTICK_LEFT_Y,
+    INPUT_THUMBSTICK_RIGHT,
+    INPUT_THUMBSTICK_RIGHT_CLICK,
+    INPUT_THUMBSTICK_RIGHT_X,
+    INPUT_THUMBSTICK_RIGHT_Y,
+    INPUT_TRACKPAD,
+    INPUT_TRACKPAD_CLICK,
+    INPUT_TRACKPAD_FORCE,
+    INPUT_TRACKPAD_TOUCH,
+    INPUT_TRACKPAD_X,
+    INPUT_TRACKPAD_Y,
+    INPUT_TRIGGER_CLICK,
+    INPUT_TRIGGER_TOUCH,
+    INPUT_TRIGGER_VALUE,
+    INPUT_TRIGGER_LEFT_VALUE,
+    INPUT_TRIGGER_RIGHT_VALUE,
+    INPUT_VIEW_CLICK,
+    INPUT_VOLUME_DOWN_CLICK,
+    INPUT_VOLUME_UP_CLICK,
+    INPUT_X_CLICK,
+    INPUT_X_TOUCH,
+    INPUT_Y_CLICK,
+    INPUT_Y_TOUCH,
+    OUTPUT_HAPTIC,
+    OUTPUT_HAPTIC_LEFT,
+    OUTPUT_HAPTIC_LEFT_TRIGGER,
+    OUTPUT_HAPTIC_RIGHT,
+    OUTPUT_HAPTIC_RIGHT_TRIGGER,
+};
+
+struct PlaceholderCell
+{
+    XrActionType type;          // XR_ACTION_TYPE_MAX_ENUM if the profile doesn't have the component
+    uint32_t subactionMask;     // bit i is PlaceholderTopLevels[i]
+};
+
+inline constexpr PlaceholderCell PlaceholderCells[PlaceholderProfileCount][PlaceholderComponentCount] = {
+    { // /interaction_profiles/google/daydream_controller
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_POSE_INPUT, 0x6},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_POSE_INPUT, 0x6},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_BOOLEAN_INPUT, 0x6},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_VECTOR2F_INPUT, 0x6},
+        {XR_ACTION_TYPE_BOOLEAN_INPUT, 0x6},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_FLOAT_INPUT, 0x6},
+        {XR_ACTION_TYPE_FLOAT_INPUT, 0x6},
+        {XR_ACTION_TYPE_FLOAT_INPUT, 0x6},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+    },
+    { // /interaction_profiles/hp/mixed_reality_controller
+        {XR_ACTION_TYPE_BOOLEAN_INPUT, 0x4},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_POSE_INPUT, 0x6},
+        {XR_ACTION_TYPE_BOOLEAN_INPUT, 0x4},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_POSE_INPUT, 0x6},
+        {XR_ACTION_TYPE_BOOLEAN_INPUT, 0x6},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_FLOAT_INPUT, 0x6},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_VECTOR2F_INPUT, 0x6},
+        {XR_ACTION_TYPE_BOOLEAN_INPUT, 0x6},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_FLOAT_INPUT, 0x6},
+        {XR_ACTION_TYPE_FLOAT_INPUT, 0x6},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_FLOAT_INPUT, 0x6},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_BOOLEAN_INPUT, 0x2},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_BOOLEAN_INPUT, 0x2},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_VIBRATION_OUTPUT, 0x6},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+    },
+    { // /interaction_profiles/htc/vive_controller
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_POSE_INPUT, 0x6},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_POSE_INPUT, 0x6},
+        {XR_ACTION_TYPE_BOOLEAN_INPUT, 0x6},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_BOOLEAN_INPUT, 0x6},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_BOOLEAN_INPUT, 0x6},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_VECTOR2F_INPUT, 0x6},
+        {XR_ACTION_TYPE_BOOLEAN_INPUT, 0x6},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_FLOAT_INPUT, 0x6},
+        {XR_ACTION_TYPE_FLOAT_INPUT, 0x6},
+        {XR_ACTION_TYPE_FLOAT_INPUT, 0x6},
+        {XR_ACTION_TYPE_BOOLEAN_INPUT, 0x6},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_FLOAT_INPUT, 0x6},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_VIBRATION_OUTPUT, 0x6},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+    },
+    { // /interaction_profiles/htc/vive_pro
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_BOOLEAN_INPUT, 0x8},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_BOOLEAN_INPUT, 0x8},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_BOOLEAN_INPUT, 0x8},
+        {XR_ACTION_TYPE_BOOLEAN_INPUT, 0x8},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+    },
+    { // /interaction_profiles/khr/simple_controller
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_POSE_INPUT, 0x6},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_POSE_INPUT, 0x6},
+        {XR_ACTION_TYPE_BOOLEAN_INPUT, 0x6},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_BOOLEAN_INPUT, 0x6},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_VIBRATION_OUTPUT, 0x6},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+    },
+    { // /interaction_profiles/microsoft/motion_controller
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_POSE_INPUT, 0x6},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_POSE_INPUT, 0x6},
+        {XR_ACTION_TYPE_BOOLEAN_INPUT, 0x6},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_BOOLEAN_INPUT, 0x6},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_VECTOR2F_INPUT, 0x6},
+        {XR_ACTION_TYPE_BOOLEAN_INPUT, 0x6},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_FLOAT_INPUT, 0x6},
+        {XR_ACTION_TYPE_FLOAT_INPUT, 0x6},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_VECTOR2F_INPUT, 0x6},
+        {XR_ACTION_TYPE_BOOLEAN_INPUT, 0x6},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_FLOAT_INPUT, 0x6},
+        {XR_ACTION_TYPE_FLOAT_INPUT, 0x6},
+        {XR_ACTION_TYPE_FLOAT_INPUT, 0x6},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_FLOAT_INPUT, 0x6},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_VIBRATION_OUTPUT, 0x6},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+    },
+    { // /interaction_profiles/microsoft/xbox_controller
+        {XR_ACTION_TYPE_BOOLEAN_INPUT, 0x1},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_BOOLEAN_INPUT, 0x1},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_BOOLEAN_INPUT, 0x1},
+        {XR_ACTION_TYPE_BOOLEAN_INPUT, 0x1},
+        {XR_ACTION_TYPE_BOOLEAN_INPUT, 0x1},
+        {XR_ACTION_TYPE_BOOLEAN_INPUT, 0x1},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_BOOLEAN_INPUT, 0x1},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_BOOLEAN_INPUT, 0x1},
+        {XR_ACTION_TYPE_BOOLEAN_INPUT, 0x1},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_VECTOR2F_INPUT, 0x1},
+        {XR_ACTION_TYPE_BOOLEAN_INPUT, 0x1},
+        {XR_ACTION_TYPE_FLOAT_INPUT, 0x1},
+        {XR_ACTION_TYPE_FLOAT_INPUT, 0x1},
+        {XR_ACTION_TYPE_VECTOR2F_INPUT, 0x1},
+        {XR_ACTION_TYPE_BOOLEAN_INPUT, 0x1},
+        {XR_ACTION_TYPE_FLOAT_INPUT, 0x1},
+        {XR_ACTION_TYPE_FLOAT_INPUT, 0x1},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_FLOAT_INPUT, 0x1},
+        {XR_ACTION_TYPE_FLOAT_INPUT, 0x1},
+        {XR_ACTION_TYPE_BOOLEAN_INPUT, 0x1},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_BOOLEAN_INPUT, 0x1},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_BOOLEAN_INPUT, 0x1},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_VIBRATION_OUTPUT, 0x1},
+        {XR_ACTION_TYPE_VIBRATION_OUTPUT, 0x1},
+        {XR_ACTION_TYPE_VIBRATION_OUTPUT, 0x1},
+        {XR_ACTION_TYPE_VIBRATION_OUTPUT, 0x1},
+    },
+    { // /interaction_profiles/oculus/go_controller
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_POSE_INPUT, 0x6},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_BOOLEAN_INPUT, 0x6},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_POSE_INPUT, 0x6},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_BOOLEAN_INPUT, 0x6},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_VECTOR2F_INPUT, 0x6},
+        {XR_ACTION_TYPE_BOOLEAN_INPUT, 0x6},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_FLOAT_INPUT, 0x6},
+        {XR_ACTION_TYPE_FLOAT_INPUT, 0x6},
+        {XR_ACTION_TYPE_FLOAT_INPUT, 0x6},
+        {XR_ACTION_TYPE_BOOLEAN_INPUT, 0x6},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+    },
+    { // /interaction_profiles/oculus/touch_controller
+        {XR_ACTION_TYPE_BOOLEAN_INPUT, 0x4},
+        {XR_ACTION_TYPE_FLOAT_INPUT, 0x4},
+        {XR_ACTION_TYPE_POSE_INPUT, 0x6},
+        {XR_ACTION_TYPE_BOOLEAN_INPUT, 0x4},
+        {XR_ACTION_TYPE_FLOAT_INPUT, 0x4},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_POSE_INPUT, 0x6},
+        {XR_ACTION_TYPE_BOOLEAN_INPUT, 0x2},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_FLOAT_INPUT, 0x6},
+        {XR_ACTION_TYPE_BOOLEAN_INPUT, 0x4},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_FLOAT_INPUT, 0x6},
+        {XR_ACTION_TYPE_VECTOR2F_INPUT, 0x6},
+        {XR_ACTION_TYPE_BOOLEAN_INPUT, 0x6},
+        {XR_ACTION_TYPE_FLOAT_INPUT, 0x6},
+        {XR_ACTION_TYPE_FLOAT_INPUT, 0x6},
+        {XR_ACTION_TYPE_FLOAT_INPUT, 0x6},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_FLOAT_INPUT, 0x6},
+        {XR_ACTION_TYPE_FLOAT_INPUT, 0x6},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_BOOLEAN_INPUT, 0x2},
+        {XR_ACTION_TYPE_FLOAT_INPUT, 0x2},
+        {XR_ACTION_TYPE_BOOLEAN_INPUT, 0x2},
+        {XR_ACTION_TYPE_FLOAT_INPUT, 0x2},
+        {XR_ACTION_TYPE_VIBRATION_OUTPUT, 0x6},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+    },
+    { // /interaction_profiles/valve/index_controller
+        {XR_ACTION_TYPE_BOOLEAN_INPUT, 0x6},
+        {XR_ACTION_TYPE_FLOAT_INPUT, 0x6},
+        {XR_ACTION_TYPE_POSE_INPUT, 0x6},
+        {XR_ACTION_TYPE_BOOLEAN_INPUT, 0x6},
+        {XR_ACTION_TYPE_FLOAT_INPUT, 0x6},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_POSE_INPUT, 0x6},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_FLOAT_INPUT, 0x6},
+        {XR_ACTION_TYPE_FLOAT_INPUT, 0x6},
+        {XR_ACTION_TYPE_BOOLEAN_INPUT, 0x6},
+        {XR_ACTION_TYPE_FLOAT_INPUT, 0x6},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_VECTOR2F_INPUT, 0x6},
+        {XR_ACTION_TYPE_BOOLEAN_INPUT, 0x6},
+        {XR_ACTION_TYPE_FLOAT_INPUT, 0x6},
+        {XR_ACTION_TYPE_FLOAT_INPUT, 0x6},
+        {XR_ACTION_TYPE_FLOAT_INPUT, 0x6},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_VECTOR2F_INPUT, 0x6},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_FLOAT_INPUT, 0x6},
+        {XR_ACTION_TYPE_FLOAT_INPUT, 0x6},
+        {XR_ACTION_TYPE_FLOAT_INPUT, 0x6},
+        {XR_ACTION_TYPE_FLOAT_INPUT, 0x6},
+        {XR_ACTION_TYPE_BOOLEAN_INPUT, 0x6},
+        {XR_ACTION_TYPE_FLOAT_INPUT, 0x6},
+        {XR_ACTION_TYPE_FLOAT_INPUT, 0x6},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_VIBRATION_OUTPUT, 0x6},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+        {XR_ACTION_TYPE_MAX_ENUM, 0},
+    },
+};
+
+struct PlaceholderBinding
+{
+    WellKnownStringIndex fullBindingString;
+    uint8_t topLevel;           // index into PlaceholderTopLevels
+    uint8_t component;          // index into PlaceholderComponents
+};
+
+constexpr uint32_t PlaceholderBindingCount = 94;
+inline constexpr PlaceholderBinding PlaceholderBindings[PlaceholderBindingCount] = {
+    {USER_GAMEPAD_INPUT_A_CLICK, 0, 0},
+    {USER_GAMEPAD_INPUT_B_CLICK, 0, 3},
+    {USER_GAMEPAD_INPUT_DPAD_DOWN_CLICK, 0, 6},
+    {USER_GAMEPAD_INPUT_DPAD_LEFT_CLICK, 0, 7},
+    {USER_GAMEPAD_INPUT_DPAD_RIGHT_CLICK, 0, 8},
+    {USER_GAMEPAD_INPUT_DPAD_UP_CLICK, 0, 9},
+    {USER_GAMEPAD_INPUT_MENU_CLICK, 0, 11},
+    {USER_GAMEPAD_INPUT_SHOULDER_LEFT_CLICK, 0, 14},
+    {USER_GAMEPAD_INPUT_SHOULDER_RIGHT_CLICK, 0, 15},
+    {USER_GAMEPAD_INPUT_THUMBSTICK_LEFT, 0, 27},
+    {USER_GAMEPAD_INPUT_THUMBSTICK_LEFT_CLICK, 0, 28},
+    {USER_GAMEPAD_INPUT_THUMBSTICK_LEFT_X, 0, 29},
+    {USER_GAMEPAD_INPUT_THUMBSTICK_LEFT_Y, 0, 30},
+    {USER_GAMEPAD_INPUT_THUMBSTICK_RIGHT, 0, 31},
+    {USER_GAMEPAD_INPUT_THUMBSTICK_RIGHT_CLICK, 0, 32},
+    {USER_GAMEPAD_INPUT_THUMBSTICK_RIGHT_X, 0, 33},
+    {USER_GAMEPAD_INPUT_THUMBSTICK_RIGHT_Y, 0, 34},
+    {USER_GAMEPAD_INPUT_TRIGGER_LEFT_VALUE, 0, 44},
+    {USER_GAMEPAD_INPUT_TRIGGER_RIGHT_VALUE, 0, 45},
+    {USER_GAMEPAD_INPUT_VIEW_CLICK, 0, 46},
+    {USER_GAMEPAD_INPUT_X_CLICK, 0, 49},
+    {USER_GAMEPAD_INPUT_Y_CLICK, 0, 51},
+    {USER_GAMEPAD_OUTPUT_HAPTIC_LEFT, 0, 54},
+    {USER_GAMEPAD_OUTPUT_HAPTIC_LEFT_TRIGGER, 0, 55},
+    {USER_GAMEPAD_OUTPUT_HAPTIC_RIGHT, 0, 56},
+    {USER_GAMEPAD_OUTPUT_HAPTIC_RIGHT_TRIGGER, 0, 57},
+    {USER_HAND_LEFT_INPUT_A_CLICK, 1, 0},
+    {USER_HAND_LEFT_INPUT_A_TOUCH, 1, 1},
+    {USER_HAND_LEFT_INPUT_AIM_POSE, 1, 2},
+    {USER_HAND_LEFT_INPUT_B_CLICK, 1, 3},
+    {USER_HAND_LEFT_INPUT_B_TOUCH, 1, 4},
+    {USER_HAND_LEFT_INPUT_BACK_CLICK, 1, 5},
+    {USER_HAND_LEFT_INPUT_GRIP_POSE, 1, 10},
+    {USER_HAND_LEFT_INPUT_MENU_CLICK, 1, 11},
+    {USER_HAND_LEFT_INPUT_SELECT_CLICK, 1, 13},
+    {USER_HAND_LEFT_INPUT_SQUEEZE_CLICK, 1, 16},
+    {USER_HAND_LEFT_INPUT_SQUEEZE_FORCE, 1, 17},
+    {USER_HAND_LEFT_INPUT_SQUEEZE_VALUE, 1, 18},
+    {USER_HAND_LEFT_INPUT_SYSTEM_CLICK, 1, 19},
+    {USER_HAND_LEFT_INPUT_SYSTEM_TOUCH, 1, 20},
+    {USER_HAND_LEFT_INPUT_THUMBREST_TOUCH, 1, 21},
+    {USER_HAND_LEFT_INPUT_THUMBSTICK, 1, 22},
+    {USER_HAND_LEFT_INPUT_THUMBSTICK_CLICK, 1, 23},
+    {USER_HAND_LEFT_INPUT_THUMBSTICK_TOUCH, 1, 24},
+    {USER_HAND_LEFT_INPUT_THUMBSTICK_X, 1, 25},
+    {USER_HAND_LEFT_INPUT_THUMBSTICK_Y, 1, 26},
+    {USER_HAND_LEFT_INPUT_TRACKPAD, 1, 35},
+    {USER_HAND_LEFT_INPUT_TRACKPAD_CLICK, 1, 36},
+    {USER_HAND_LEFT_INPUT_TRACKPAD_FORCE, 1, 37},
+    {USER_HAND_LEFT_INPUT_TRACKPAD_TOUCH, 1, 38},
+    {USER_HAND_LEFT_INPUT_TRACKPAD_X, 1, 39},
+    {USER_HAND_LEFT_INPUT_TRACKPAD_Y, 1, 40},
+    {USER_HAND_LEFT_INPUT_TRIGGER_CLICK, 1, 41},
+    {USER_HAND_LEFT_INPUT_TRIGGER_TOUCH, 1, 42},
+    {USER_HAND_LEFT_INPUT_TRIGGER_VALUE, 1, 43},
+    {USER_HAND_LEFT_INPUT_X_CLICK, 1, 49},
+    {USER_HAND_LEFT_INPUT_X_TOUCH, 1, 50},
+    {USER_HAND_LEFT_INPUT_Y_CLICK, 1, 51},
+    {USER_HAND_LEFT_INPUT_Y_TOUCH, 1, 52},
+    {USER_HAND_LEFT_OUTPUT_HAPTIC, 1, 53},
+    {USER_HAND_RIGHT_INPUT_A_CLICK, 2, 0},
+    {USER_HAND_RIGHT_INPUT_A_TOUCH, 2, 1},
+    {USER_HAND_RIGHT_INPUT_AIM_POSE, 2, 2},
+    {USER_HAND_RIGHT_INPUT_B_CLICK, 2, 3},
+    {USER_HAND_RIGHT_INPUT_B_TOUCH, 2, 4},
+    {USER_HAND_RIGHT_INPUT_BACK_CLICK, 2, 5},
+    {USER_HAND_RIGHT_INPUT_GRIP_POSE, 2, 10},
+    {USER_HAND_RIGHT_INPUT_MENU_CLICK, 2, 11},
+    {USER_HAND_RIGHT_INPUT_SELECT_CLICK, 2, 13},
+    {USER_HAND_RIGHT_INPUT_SQUEEZE_CLICK, 2, 16},
+    {USER_HAND_RIGHT_INPUT_SQUEEZE_FORCE, 2, 17},
+    {USER_HAND_RIGHT_INPUT_SQUEEZE_VALUE, 2, 18},
+    {USER_HAND_RIGHT_INPUT_SYSTEM_CLICK, 2, 19},
+    {USER_HAND_RIGHT_INPUT_SYSTEM_TOUCH, 2, 20},
+    {USER_HAND_RIGHT_INPUT_THUMBREST_TOUCH, 2, 21},
+    {USER_HAND_RIGHT_INPUT_THUMBSTICK, 2, 22},
+    {USER_HAND_RIGHT_INPUT_THUMBSTICK_CLICK, 2, 23},
+    {USER_HAND_RIGHT_INPUT_THUMBSTICK_TOUCH, 2, 24},
+    {USER_HAND_RIGHT_INPUT_THUMBSTICK_X, 2, 25},
+    {USER_HAND_RIGHT_INPUT_THUMBSTICK_Y, 2, 26},
+    {USER_HAND_RIGHT_INPUT_TRACKPAD, 2, 35},
+    {USER_HAND_RIGHT_INPUT_TRACKPAD_CLICK, 2, 36},
+    {USER_HAND_RIGHT_INPUT_TRACKPAD_FORCE, 2, 37},
+    {USER_HAND_RIGHT_INPUT_TRACKPAD_TOUCH, 2, 38},
+    {USER_HAND_RIGHT_INPUT_TRACKPAD_X, 2, 39},
+    {USER_HAND_RIGHT_INPUT_TRACKPAD_Y, 2, 40},
+    {USER_HAND_RIGHT_INPUT_TRIGGER_CLICK, 2, 41},
+    {USER_HAND_RIGHT_INPUT_TRIGGER_TOUCH, 2, 42},
+    {USER_HAND_RIGHT_INPUT_TRIGGER_VALUE, 2, 43},
+    {USER_HAND_RIGHT_OUTPUT_HAPTIC, 2, 53},
+    {USER_HEAD_INPUT_MUTE_MIC_CLICK, 3, 12},
+    {USER_HEAD_INPUT_SYSTEM_CLICK, 3, 19},
+    {USER_HEAD_INPUT_VOLUME_DOWN_CLICK, 3, 47},
+    {USER_HEAD_INPUT_VOLUME_UP_CLICK, 3, 48},
+};
+
+constexpr uint8_t PlaceholderNoIndex = 0xFF;
+
+// Where a well-known string falls in the tables above, if anywhere
+struct PlaceholderIndices
+{
+    uint8_t profile = PlaceholderNoIndex;       // if the string is an interaction profile
+    uint8_t topLevel = PlaceholderNoIndex;      // these two if it's a full binding
+    uint8_t component = PlaceholderNoIndex;
+};
+
+constexpr std::array<PlaceholderIndices, WellKnownStringCount> MakePlaceholderIndicesByString()
+{
+    std::array<PlaceholderIndices, WellKnownStringCount> indices {};
+    for(uint32_t i = 0; i < PlaceholderProfileCount; i++) {
+        indices[PlaceholderProfiles[i]].profile = (uint8_t)i;
+    }
+    for(const auto& binding: PlaceholderBindings) {
+        indices[binding.fullBindingString].topLevel = binding.topLevel;
+        indices[binding.fullBindingString].component = binding.component;
+    }
+    return indices;
+}
+
+inline constexpr std::array<PlaceholderIndices, WellKnownStringCount> PlaceholderIndicesByString = MakePlaceholderIndicesByString();
+
+// Cell and top-level path of the placeholder for a profile and full
+// binding; false if no placeholder has that binding
+constexpr bool FindPlaceholderCell(WellKnownStringIndex profileString, WellKnownStringIndex bindingString, uint32_t *profile, uint32_t *component, uint32_t *topLevel)
+{
+    if(((uint32_t)profileString >= WellKnownStringCount) || ((uint32_t)bindingString >= WellKnownStringCount)) {
+        return false;
+    }
+    const PlaceholderIndices& p = PlaceholderIndicesByString[profileString];
+    const PlaceholderIndices& b = PlaceholderIndicesByString[bindingString];
+    if((p.profile == PlaceholderNoIndex) || (b.component == PlaceholderNoIndex)) {
+        return false;
+    }
+    if((PlaceholderCells[p.profile][b.component].subactionMask & (1u << b.topLevel)) == 0) {
+        return false;
+    }
+    *profile = p.profile;
+    *component = b.component;
+    *topLevel = b.topLevel;
+    return true;
+}
+
+// WellKnownStringIndex of each of an instance's well-known XrPaths.  The
+// runtime picks the XrPath values, so this can't be a table indexed by
+// them; it is the paths sorted once at xrCreateInstance, next to their
+// indices, and a lookup is a binary search with no hashing or allocation.
+struct WellKnownStringsByPath
+{
+    std::vector<std::pair<XrPath, WellKnownStringIndex>> sorted;
+
+    // pathsByString is indexed by WellKnownStringIndex; XR_NULL_PATH maps to NULL_PATH
+    void Build(const std::vector<XrPath>& pathsByString)
+    {
+        sorted.clear();
+        sorted.reserve(pathsByString.size());
+        for(uint32_t i = 0; i < pathsByString.size(); i++) {
+            sorted.push_back({pathsByString[i], (WellKnownStringIndex)i});
+        }
+        std::sort(sorted.begin(), sorted.end());
+    }
+
+    // false if path wasn't made from a well-known string
+    bool Find(XrPath path, WellKnownStringIndex *index) const
+    {
+        auto it = std::lower_bound(sorted.begin(), sorted.end(), path,
+            [](const std::pair<XrPath, WellKnownStringIndex>& entry, XrPath p) { return entry.first < p; });
+        if((it == sorted.end()) || (it->first != path)) {
+            return false;
+        }
+        *index = it->second;
+        return true;
+    }
+
+    // For paths that must have been made from a well-known string; throws like std::map::at() otherwise
+    WellKnownStringIndex at(XrPath path) const
+    {
+        WellKnownStringIndex index;
+        if(!Find(path, &index)) {
+            throw std::out_of_range("XrPath is not a well-known string");
+        }
+        return index;
+    }
+};
+
+struct ActionGetInfo
+{
+    XrAction action;
+    XrActionType actionType;
+    XrPath subactionPath;
+};
+
+typedef std::vector<ActionGetInfo> ActionGetInfoList;
+
+struct OverlaysLayerXrActionSetHandleInfo;
+struct OverlaysLayerXrActionHandleInfo;
+
+// Everything xrSyncActions works out from one list of XrActiveActionSets,
+// compiled once and then replayed, since applications sync the same sets
+// every frame.  Plans belong to a session and refer to action state by
+// ActionStateStore slot.  The state arrays at the end are scratch space
+// reused by each sync with the plan, so a session's syncs hold its
+// GetSyncActionsLock().
+struct SyncActionsPlan
+{
+    std::vector<XrActiveActionSet> activeActionSets;    // as the application passed them
+    std::vector<std::shared_ptr<OverlaysLayerXrActionSetHandleInfo>> actionSetInfos;   // per activeActionSets, to notice a handle being reused
+    XrResult compileResult = XR_SUCCESS;                // returned from every sync with this plan if not XR_SUCCESS
+
+    std::vector<std::shared_ptr<OverlaysLayerXrActionHandleInfo>> actions;     // each action in the active sets once
+
+    // Main: one Get for each of these, in order, stored to the session's ActionStateStore slot
+    std::vector<XrActiveActionSet> downchainActiveActionSets;   // activeActionSets with runtime handles
+    ActionGetInfoList actionsToGet;
+    std::vector<uint32_t> getSlots;
+
+    // Overlay: placeholder actions Main gets for us
+    std::vector<WellKnownStringIndex> profileStrings;
+    std::vector<WellKnownStringIndex> fullBindingStrings;
+    std::vector<WellKnownStringIndex> topLevelStrings;
+
+    // Overlay: the states merged into each slot of one action type, in
+    // binding order.  Slots are sorted by how many states they merge, so
+    // round r merges the r'th state of the first few slots, all distinct.
+    struct MergeBatch
+    {
+        XrActionType actionType;
+        std::vector<uint32_t> slots;
+        std::vector<uint32_t> roundOffsets;     // into stateIndices, and one past the last round
+        std::vector<uint32_t> stateIndices;     // into states
+        ActionStateLaneArrays accumulated;      // per slots
+        ActionStateLaneArrays merging;          // per state in a round
+    };
+    std::vector<MergeBatch> mergeBatches;
+
+    // Slots whose changedSinceLastSync and lastChangeTime are updated
+    std::vector<uint32_t> updateSlots;
+
+    std::vector<ActionStateUnion> states;               // per actionsToGet or fullBindingStrings
+    std::vector<WellKnownStringIndex> currentInteractionProfileStrings;     // per topLevelStrings
+
+    // Overlay: Main only sends states changed since the one it tagged
+    // stateGeneration, which the previous sync with this plan patched into states
+    uint64_t stateGeneration = 0;
+    std::vector<uint32_t> changedIndices;
+    std::vector<ActionStateUnion> changedStates;
+
+    typedef std::shared_ptr<SyncActionsPlan> Ptr;
+};
+
+// Main side: the placeholder action states last sent to an Overlay for one
+// list of bindings, which the Overlay acknowledges by generation
+struct ActionStateBaseline
+{
+    uint64_t generation = 0;
+    uint32_t deltasSinceSnapshot = 0;
+    XrSession session = XR_NULL_HANDLE;
+    std::vector<WellKnownStringIndex> profileStrings;
+    std::vector<WellKnownStringIndex> bindingStrings;
+    std::vector<XrActionType> actionTypes;
+    std::vector<ActionStateUnion> states;
+};
+
+// Main side: one Overlay connection's ActionStateBaselines, by a hash of
+// the session and binding list.  Every so often all states are sent anyway.
+struct ActionStateBaselines
+{
+    static constexpr uint32_t snapshotInterval = 90;
+    static constexpr size_t maxBaselines = 32;
+
+    uint64_t nextGeneration = 1;    // 0 is never sent, so it acknowledges nothing
+    std::unordered_map<uint64_t, ActionStateBaseline> baselines;
+};
+
+uint64_t HashActiveActionSets(uint32_t count, const XrActiveActionSet* activeActionSets);
+
+// Placeholder action state Main fetched for Overlays, kept for the rest of
+// the frame so every Overlay syncing in that frame shares one downchain
+// xrSyncActions and one Get of each placeholder action
+struct PlaceholderStateCache
+{
+    std::mutex mutex;
+    uint64_t generation = 0;                // MainSessionContext::waitFrameCount + 1 when placeholders were last synced, 0 if outside a frame
+    XrResult syncResult = XR_SUCCESS;
+
+    static constexpr uint32_t NoPlaceholder = UINT32_MAX;   // index for a binding Main has no placeholder Action for
+
+    std::map<std::pair<XrAction, XrPath>, uint32_t> indices;
+    ActionGetInfoList gets;                 // per index
+    std::vector<uint64_t> fetchedGenerations;   // per index, generation in which states was Got
+    std::vector<ActionStateUnion> states;   // per index
+
+    uint32_t GetIndex(XrAction action, XrPath subactionPath, XrActionType actionType)
+    {
+        auto [it, inserted] = indices.insert({{action, subactionPath}, (uint32_t)gets.size()});
+        if(inserted) {
+            gets.push_back({action, actionType, subactionPath});
+            fetchedGenerations.push_back(0);
+            states.push_back({});
+        }
+        return it->second;
+    }
+};
+
 // Manually written functions -----------------------------------------------
 
 XrResult OverlaysLayerCreateSessionMainAsOverlay(ConnectionToOverlay::Ptr connection, XrFormFactor formFactor, const XrInstanceCreateInfo *instanceCreateInfo, const XrSessionCreateInfo *createInfo, const XrSessionCreateInfoOverlayEXTX *createInfoOverlay, XrSession *session);
@@ -955,6 +2519,16 @@ XrResult OverlaysLayerCreateSwapchainMainAsOverlay(ConnectionToOverlay::Ptr conn
 XrResult OverlaysLayerCreateSwapchainOverlay(XrInstance instance, XrSession session, const XrSwapchainCreateInfo* createInfo, XrSwapchain* swapchain);
 XrResult OverlaysLayerCreateSwapchain(XrSession session, const XrSwapchainCreateInfo* createInfo, XrSwapchain* swapchain);
 
+XrResult OverlaysLayerGetSwapchainSharedImagesMainAsOverlay(ConnectionToOverlay::Ptr connection, XrSwapchain swapchain, uint32_t imageCapacityInput, uint32_t* imageCountOutput, HANDLE* images, HANDLE* fences);
+XrResult FlushPendingSwapchainReleases(ConnectionToOverlay::Ptr connection, XrSwapchain onlySwapchain = XR_NULL_HANDLE, const std::set<XrSwapchain>* shownSwapchains = nullptr);
+XrResult ReleaseRuntimeSwapchainImages(const std::vector<MainAsOverlaySessionContext::PendingSwapchainRelease>& releases);
+void ReleaseSwapchainImagesAfterFlush();
+bool WaitForReleasesAfterFlush(ConnectionToOverlay::Ptr connection, XrSwapchain swapchain);
+bool LayerHasVisibleArea(const XrCompositionLayerBaseHeader* p);
+bool AddSwapchainsShownByLayer(const XrCompositionLayerBaseHeader* p, std::set<XrSwapchain>& swapchains);
+XrResult OverlaysLayerSetSwapchainSharedImagesMainAsOverlay(ConnectionToOverlay::Ptr connection, XrSwapchain swapchain, uint32_t imageCount, const HANDLE* images, const HANDLE* fences);
+XrResult OverlaysLayerDiscardSharedImagesMainAsOverlay(ConnectionToOverlay::Ptr connection, uint32_t imageCount, const HANDLE* images);
+
 XrResult OverlaysLayerDestroySessionMainAsOverlay(ConnectionToOverlay::Ptr connection, XrSession session);
 XrResult OverlaysLayerDestroySessionOverlay(XrInstance instance, XrSession session);
 
@@ -984,10 +2558,11 @@ XrResult OverlaysLayerAcquireSwapchainImageOverlay(XrInstance instance, XrSwapch
 XrResult OverlaysLayerWaitSwapchainImageMainAsOverlay(ConnectionToOverlay::Ptr connection, XrSwapchain swapchain, const XrSwapchainImageWaitInfo* waitInfo, HANDLE sourceImage);
 XrResult OverlaysLayerWaitSwapchainImageOverlay(XrInstance instance, XrSwapchain swapchain, const XrSwapchainImageWaitInfo* waitInfo);
 
-XrResult OverlaysLayerReleaseSwapchainImageMainAsOverlay(ConnectionToOverlay::Ptr connection, XrSwapchain swapchain, const XrSwapchainImageReleaseInfo* waitInfo, HANDLE sourceImage);
+XrResult OverlaysLayerReleaseSwapchainImageMainAsOverlay(ConnectionToOverlay::Ptr connection, XrSwapchain swapchain, const XrSwapchainImageReleaseInfo* waitInfo, HANDLE sourceImage, XrBool32 hasDamageRects, uint32_t damageRectCount, const XrRect2Di* damageRects);
 XrResult OverlaysLayerReleaseSwapchainImageOverlay(XrInstance instance, XrSwapchain swapchain, const XrSwapchainImageReleaseInfo* waitInfo);
 
 XrResult OverlaysLayerEndFrameMainAsOverlay(ConnectionToOverlay::Ptr connection, XrSession session, const XrFrameEndInfo* frameEndInfo);
+XrResult OverlaysLayerEndFrameUnchangedMainAsOverlay(ConnectionToOverlay::Ptr connection, XrSession session);
 XrResult OverlaysLayerEndFrame(XrSession session, const XrFrameEndInfo* frameEndInfo);
 
 XrResult OverlaysLayerEnumerateReferenceSpacesMainAsOverlay(ConnectionToOverlay::Ptr connection, XrSession session, uint32_t spaceCapacityInput, uint32_t* spaceCountOutput, XrReferenceSpaceType* spaces);
@@ -1001,6 +2576,8 @@ XrResult OverlaysLayerLocateViewsOverlay(XrInstance instance, XrSession session,
 
 XrResult OverlaysLayerLocateSpaceOverlay(XrInstance instance, XrSpace space, XrSpace baseSpace, XrTime time, XrSpaceLocation* location);
 XrResult OverlaysLayerLocateSpaceMainAsOverlay(ConnectionToOverlay::Ptr connection, XrSpace space, XrSpace baseSpace, XrTime time, XrSpaceLocation* location);
+XrResult OverlaysLayerLocateSpacesOverlay(XrInstance instance, XrTime time, uint32_t spaceCount, const XrSpace* spaces, const XrSpace* baseSpaces, XrSpaceLocation* locations, XrResult* results);
+XrResult OverlaysLayerLocateSpacesMainAsOverlay(ConnectionToOverlay::Ptr connection, XrTime time, uint32_t spaceCount, const XrSpace* spaces, const XrSpace* baseSpaces, XrSpaceLocation* locations, XrResult* results);
 
 XrResult OverlaysLayerDestroySpaceOverlay(XrInstance instance, XrSpace space);
 XrResult OverlaysLayerDestroySpaceMainAsOverlay(ConnectionToOverlay::Ptr connection, XrSpace space);
@@ -1011,7 +2588,7 @@ XrResult OverlaysLayerRequestExitSessionOverlay(XrInstance instance, XrSession s
 XrResult OverlaysLayerEndSessionMainAsOverlay(ConnectionToOverlay::Ptr connection, XrSession session);
 XrResult OverlaysLayerEndSessionOverlay(XrInstance instance, XrSession session);
 
-XrResult OverlaysLayerDestroySwapchainMainAsOverlay(ConnectionToOverlay::Ptr connection, XrSwapchain swapchain);
+XrResult OverlaysLayerDestroySwapchainMainAsOverlay(ConnectionToOverlay::Ptr connection, XrSwapchain swapchain, XrBool32* imagesPooled);
 XrResult OverlaysLayerDestroySwapchainOverlay(XrInstance instance, XrSwapchain swapchain);
 
 XrResult OverlaysLayerCreateActionSet(XrInstance instance, const XrActionSetCreateInfo* createInfo, XrActionSet* actionSet);
@@ -1033,7 +2610,8 @@ XrResult OverlaysLayerGetActionStatePose(XrSession session, const XrActionStateG
 XrResult OverlaysLayerSyncActionsAndGetStateMainAsOverlay(
     ConnectionToOverlay::Ptr connection, XrSession session,
     uint32_t countProfileAndBindings, const WellKnownStringIndex *profileStrings, const WellKnownStringIndex *bindingStrings,   /* input is profiles and bindings for which to Get */
-    ActionStateUnion *states,                                                                                                   /* output is result of Get */
+    uint64_t acknowledgedGeneration, uint64_t *stateGeneration,                                                                 /* input is generation Overlay has, output is generation sent */
+    uint32_t *changedCount, uint32_t *changedIndices, ActionStateUnion *changedStates,                                          /* output is results of Get which changed since acknowledgedGeneration */
     uint32_t countSubactionStrings, const WellKnownStringIndex *subactionStrings,                                               /* input is subactionPaths for which to get current interaction Profile */
     WellKnownStringIndex *interactionProfileStrings);                                                                           /* output is current interaction profiles */
 
@@ -1043,6 +2621,7 @@ XrResult OverlaysLayerLocateSpace(XrSpace space, XrSpace baseSpace, XrTime time,
 
 XrResult OverlaysLayerStopHapticFeedbackMainAsOverlay(ConnectionToOverlay::Ptr connection, XrSession session, uint32_t profileStringCount, const WellKnownStringIndex *profileStrings, const WellKnownStringIndex *bindingStrings);
 XrResult OverlaysLayerApplyHapticFeedbackMainAsOverlay(ConnectionToOverlay::Ptr connection, XrSession session, uint32_t profileStringCount, const WellKnownStringIndex *profileStrings, const WellKnownStringIndex *bindingStrings, const XrHapticBaseHeader* hapticFeedback);
+XrResult OverlaysLayerRequestPlaceholderActionsMainAsOverlay(ConnectionToOverlay::Ptr connection, XrSession session, uint32_t countProfileAndBindings, const WellKnownStringIndex *profileStrings, const WellKnownStringIndex *bindingStrings);
 XrResult OverlaysLayerApplyHapticFeedback(XrSession session, const XrHapticActionInfo* hapticActionInfo, const XrHapticBaseHeader* hapticFeedback);
 XrResult OverlaysLayerStopHapticFeedback(XrSession session, const XrHapticActionInfo* hapticActionInfo);
 
@@ -0,0 +1,181 @@
+// Copyright (c) 2021 LunarG, Inc.
+// Copyright (c) 2017-2021 PlutoVR Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Brad Grantham <brad@lunarg.com>
+#ifndef _POSE_EXTRAPOLATION_H_
+#define _POSE_EXTRAPOLATION_H_
+
+#include <openxr/openxr.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// One space's location and velocity relative to a baseSpace at one time
+struct SpacePoseSample
+{
+    XrResult result;
+    XrSpaceLocation location;   // next is always nullptr
+    XrSpaceVelocity velocity;   // next is always nullptr
+};
+
+// Whether a locate at time can be answered from samples located at
+// sampleTime: within window of it either way.  Otherwise the Overlay
+// locates its spaces through Main again.  A window of 0 is never near, so
+// OVERLAYS_API_LAYER_POSE_EXTRAPOLATION_MS=0 turns the cache off.
+inline bool PoseSampleTimeIsNear(XrTime sampleTime, XrTime time, XrDuration window)
+{
+    return (window > 0) && (std::abs(time - sampleTime) <= window);
+}
+
+// Move sample forward (or back) by dt assuming constant linear and angular
+// velocity.  Returns false if the sample doesn't have everything needed.
+// The location keeps the sample's flags, so a pose the runtime stopped
+// tracking isn't reported tracked because it was extrapolated.
+inline bool ExtrapolateSpacePoseSample(const SpacePoseSample& sample, XrDuration dt, XrSpaceLocation* location)
+{
+    const XrSpaceLocationFlags poseValid = XR_SPACE_LOCATION_POSITION_VALID_BIT | XR_SPACE_LOCATION_ORIENTATION_VALID_BIT;
+    const XrSpaceVelocityFlags velocityValid = XR_SPACE_VELOCITY_LINEAR_VALID_BIT | XR_SPACE_VELOCITY_ANGULAR_VALID_BIT;
+
+    if((sample.result != XR_SUCCESS) || ((sample.location.locationFlags & poseValid) != poseValid) || ((sample.velocity.velocityFlags & velocityValid) != velocityValid)) {
+        return false;
+    }
+
+    double seconds = dt / 1000000000.0;
+    const XrVector3f& v = sample.velocity.linearVelocity;
+    const XrVector3f& w = sample.velocity.angularVelocity;
+    XrPosef pose = sample.location.pose;
+
+    pose.position.x += (float)(v.x * seconds);
+    pose.position.y += (float)(v.y * seconds);
+    pose.position.z += (float)(v.z * seconds);
+
+    // angularVelocity is in baseSpace, so the rotation it makes over dt is applied on the left
+    double wLength = std::sqrt(w.x * w.x + w.y * w.y + w.z * w.z);
+    double angle = wLength * seconds;
+    if(std::abs(angle) > 1e-9) {
+        double s = std::sin(angle / 2) / wLength;
+        double dx = w.x * s, dy = w.y * s, dz = w.z * s, dw = std::cos(angle / 2);
+        const XrQuaternionf& q = sample.location.pose.orientation;
+        pose.orientation.x = (float)(dw * q.x + dx * q.w + dy * q.z - dz * q.y);
+        pose.orientation.y = (float)(dw * q.y - dx * q.z + dy * q.w + dz * q.x);
+        pose.orientation.z = (float)(dw * q.z + dx * q.y - dy * q.x + dz * q.w);
+        pose.orientation.w = (float)(dw * q.w - dx * q.x - dy * q.y - dz * q.z);
+    }
+
+    location->locationFlags = sample.location.locationFlags;
+    location->pose = pose;
+    return true;
+}
+
+// Overlay side: where a session's recently located spaces were relative to
+// one baseSpace at one time, located in one LocateSpaces RPC when the first
+// of them was located, so the rest of that frame's locates don't go to
+// Main.  Only spaces the Overlay located in its last recentFrames frames go
+// in the batch, so spaces it made but doesn't look at, and the syncs of
+// their action spaces with Main, aren't relocated every frame.  Locates at
+// nearby times are extrapolated from these samples.
+struct SpaceLocationCache
+{
+    static constexpr uint64_t recentFrames = 2;
+
+    std::mutex mutex;
+    XrSpace baseSpace = XR_NULL_HANDLE;
+    XrTime time = 0;
+    std::unordered_map<XrSpace, SpacePoseSample> samples;  // by local handle
+    uint64_t frame = 0;                                     // the Overlay's xrWaitFrames so far
+    std::unordered_map<XrSpace, uint64_t> lastLocatedFrames;    // by local handle
+
+    // The samples are void; which spaces were located lately still holds
+    void Clear()
+    {
+        baseSpace = XR_NULL_HANDLE;
+        time = 0;
+        samples.clear();
+    }
+
+    // space was destroyed
+    void Forget(XrSpace space)
+    {
+        samples.erase(space);
+        lastLocatedFrames.erase(space);
+    }
+
+    // Answer a locate of space relative to baseSpace_ at time_ from the
+    // samples.  When it isn't near them, or space isn't among them, first
+    // calls locate(spaces, time, located) to fill located with samples of
+    // spaces from Main, which returns false if that failed.  Returns false
+    // if the caller has to locate space itself.
+    // With a window of 0 nothing is batched or cached, and the caller
+    // always locates space itself.
+    template <class LocateFunc>
+    bool Locate(XrSpace space, XrSpace baseSpace_, XrTime time_, XrDuration window, LocateFunc locate, XrSpaceLocation* location, XrResult* result)
+    {
+        if(window <= 0) {
+            return false;
+        }
+        lastLocatedFrames[space] = frame;
+
+        if((baseSpace != baseSpace_) || !PoseSampleTimeIsNear(time, time_, window)) {
+            // First locate against this baseSpace near this time, so locate the other recent spaces along with it
+            Clear();
+            std::vector<XrSpace> spaces { space };
+            for(const auto& [other, lastFrame]: lastLocatedFrames) {
+                if((other != space) && (other != baseSpace_) && (frame - lastFrame < recentFrames)) {
+                    spaces.push_back(other);
+                }
+            }
+            std::vector<SpacePoseSample> located(spaces.size());
+            if(!locate(spaces, time_, located)) {
+                return false;
+            }
+            baseSpace = baseSpace_;
+            time = time_;
+            for(size_t i = 0; i < spaces.size(); i++) {
+                samples[spaces[i]] = located[i];
+            }
+
+        } else if(samples.count(space) == 0) {
+            // Not located lately when the batch was made, so join it at its time
+            std::vector<XrSpace> spaces { space };
+            std::vector<SpacePoseSample> located(1);
+            if(!locate(spaces, time, located)) {
+                return false;
+            }
+            samples[space] = located[0];
+        }
+
+        const SpacePoseSample& sample = samples.at(space);
+        XrDuration dt = time_ - time;
+        if(dt == 0) {
+            location->locationFlags = sample.location.locationFlags;
+            location->pose = sample.location.pose;
+            *result = sample.result;
+            return true;
+        }
+        if(ExtrapolateSpacePoseSample(sample, dt, location)) {
+            *result = XR_SUCCESS;
+            return true;
+        }
+        return false;
+    }
+};
+
+#endif /* _POSE_EXTRAPOLATION_H_ */
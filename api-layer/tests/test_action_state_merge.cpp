@@ -0,0 +1,231 @@
+// Copyright (c) 2021 LunarG, Inc.
+// Copyright (c) 2017-2021 PlutoVR Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Brad Grantham <brad@lunarg.com>
+
+// Merges random action states with every kernel this CPU runs and checks
+// each leaves exactly the bits the scalar merge does, for lane counts which
+// end partway through a vector and for floats which are NaN, signed zeros,
+// and ties.
+
+#include "action_state_merge.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <random>
+
+static int gFailures = 0;
+
+#define CHECK(expr) \
+    do { \
+        if(!(expr)) { \
+            fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #expr); \
+            gFailures++; \
+        } \
+    } while(0)
+
+static const struct
+{
+    ActionMergeKernel kernel;
+    const char *name;
+} Kernels[] = {
+    { ActionMergeKernel::SSE2, "SSE2" },
+    { ActionMergeKernel::AVX2, "AVX2" },
+    { ActionMergeKernel::NEON, "NEON" },
+};
+
+static const XrActionType ActionTypes[] = { XR_ACTION_TYPE_BOOLEAN_INPUT, XR_ACTION_TYPE_FLOAT_INPUT, XR_ACTION_TYPE_VECTOR2F_INPUT, XR_ACTION_TYPE_POSE_INPUT };
+
+// Mostly the values which compare specially, otherwise a few distinct
+// values so ties and equal lengths come up often
+static float RandomFloat(std::mt19937& random)
+{
+    static const float special[] = {
+        0.0f, -0.0f, 1.0f, -1.0f, 0.5f, -0.5f,
+        std::numeric_limits<float>::quiet_NaN(), -std::numeric_limits<float>::quiet_NaN(),
+        std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(),
+        std::numeric_limits<float>::denorm_min(), 3.0e38f,
+    };
+    uint32_t pick = random() % 16;
+    if(pick < sizeof(special) / sizeof(special[0])) {
+        return special[pick];
+    }
+    return std::uniform_real_distribution<float>(-1.0f, 1.0f)(random);
+}
+
+static void FillRandom(ActionStateLaneArrays& lanes, size_t count, std::mt19937& random)
+{
+    lanes.Resize(count);
+    for(size_t i = 0; i < count; i++) {
+        lanes.isActive[i] = (random() % 3 == 0) ? XR_FALSE : XR_TRUE;
+        lanes.changedSinceLastSync[i] = random() % 2;
+        lanes.lastChangeTimes[i] = ((XrTime)random() << 32) | random();
+        // XrBool32 values other than 0 and 1 are ORed as bits
+        lanes.booleanStates[i] = (random() % 4 == 0) ? (XrBool32)random() : (XrBool32)(random() % 2);
+        lanes.floatStates[i] = RandomFloat(random);
+        lanes.yStates[i] = RandomFloat(random);
+    }
+}
+
+// Bitwise, so signed zeros and NaN payloads count
+template <class T>
+static bool SameBits(const std::vector<T>& a, const std::vector<T>& b)
+{
+    return (a.size() == b.size()) && (memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0);
+}
+
+static bool SameLanes(const ActionStateLaneArrays& a, const ActionStateLaneArrays& b)
+{
+    return SameBits(a.isActive, b.isActive) &&
+        SameBits(a.changedSinceLastSync, b.changedSinceLastSync) &&
+        SameBits(a.lastChangeTimes, b.lastChangeTimes) &&
+        SameBits(a.booleanStates, b.booleanStates) &&
+        SameBits(a.floatStates, b.floatStates) &&
+        SameBits(a.yStates, b.yStates);
+}
+
+// Merge one round of states with kernel and with the scalar merge from the
+// same accumulated lanes, and compare.  Returns false on a mismatch.
+static bool MergeMatchesScalar(ActionMergeKernel kernel, XrActionType actionType, size_t count, std::mt19937& random)
+{
+    ActionStateLaneArrays accumulated, states;
+    FillRandom(accumulated, count, random);
+    FillRandom(states, count, random);
+    ActionStateLaneArrays expected = accumulated;
+
+    MergeActionStateLanesScalar(actionType, count, expected.Lanes(), states.Lanes());
+    MergeActionStateLanesWithKernel(kernel, actionType, count, accumulated.Lanes(), states.Lanes());
+
+    return SameLanes(accumulated, expected);
+}
+
+static void TestKernelsMatchScalar()
+{
+    std::mt19937 random(1234);
+    int kernelsRun = 0;
+
+    for(const auto& k: Kernels) {
+        if(!ActionMergeKernelAvailable(k.kernel)) {
+            printf("%s kernel not available, skipped\n", k.name);
+            continue;
+        }
+        kernelsRun++;
+
+        // Every tail length of a few vectors of up to 8 lanes, then a few long runs
+        for(XrActionType actionType: ActionTypes) {
+            int mismatches = 0;
+            for(size_t count = 0; count <= 40; count++) {
+                for(int trial = 0; trial < 20; trial++) {
+                    mismatches += MergeMatchesScalar(k.kernel, actionType, count, random) ? 0 : 1;
+                }
+            }
+            for(int trial = 0; trial < 20; trial++) {
+                mismatches += MergeMatchesScalar(k.kernel, actionType, 1000 + random() % 64, random) ? 0 : 1;
+            }
+            if(mismatches > 0) {
+                fprintf(stderr, "%s kernel differs from scalar for action type %d in %d merges\n", k.name, (int)actionType, mismatches);
+            }
+            CHECK(mismatches == 0);
+        }
+    }
+
+    // Every CPU this builds for has a vector kernel unless the scalar merge was asked for
+#if !defined(OVERLAYS_API_LAYER_SCALAR_ACTION_MERGE) && (defined(__SSE2__) || defined(_M_X64) || defined(__ARM_NEON) || defined(_M_ARM64))
+    CHECK(kernelsRun > 0);
+#endif
+}
+
+// The vector kernels only write whole vectors, so lanes past count are untouched
+static void TestTailIsLeftAlone()
+{
+    std::mt19937 random(5678);
+
+    for(const auto& k: Kernels) {
+        if(!ActionMergeKernelAvailable(k.kernel)) {
+            continue;
+        }
+        for(XrActionType actionType: ActionTypes) {
+            for(size_t count = 0; count < 20; count++) {
+                ActionStateLaneArrays accumulated, states;
+                FillRandom(accumulated, 24, random);
+                FillRandom(states, 24, random);
+                ActionStateLaneArrays before = accumulated;
+
+                MergeActionStateLanesWithKernel(k.kernel, actionType, count, accumulated.Lanes(), states.Lanes());
+
+                bool untouched = true;
+                for(size_t i = count; i < 24; i++) {
+                    untouched = untouched && (accumulated.isActive[i] == before.isActive[i]) &&
+                        (accumulated.lastChangeTimes[i] == before.lastChangeTimes[i]) &&
+                        (memcmp(&accumulated.floatStates[i], &before.floatStates[i], sizeof(float)) == 0) &&
+                        (memcmp(&accumulated.yStates[i], &before.yStates[i], sizeof(float)) == 0);
+                }
+                CHECK(untouched);
+            }
+        }
+    }
+}
+
+// A few lanes whose results are known, through whichever kernel is picked
+static void TestSpecialFloats()
+{
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    const float a[] = { 0.0f, -0.0f, nan, 1.0f, nan, 0.25f, -1.0f, 2.0f, -0.0f };
+    const float s[] = { -0.0f, 0.0f, 1.0f, nan, nan, 0.25f, -2.0f, 2.0f, -0.0f };
+    const size_t count = sizeof(a) / sizeof(a[0]);
+
+    ActionStateLaneArrays accumulated, states;
+    accumulated.Resize(count);
+    accumulated.Clear();
+    states.Resize(count);
+    states.Clear();
+    for(size_t i = 0; i < count; i++) {
+        accumulated.isActive[i] = XR_TRUE;
+        states.isActive[i] = XR_TRUE;
+        accumulated.floatStates[i] = a[i];
+        states.floatStates[i] = s[i];
+    }
+    MergeActionStateLanes(XR_ACTION_TYPE_FLOAT_INPUT, count, accumulated.Lanes(), states.Lanes());
+
+    // The accumulated value is kept unless the new one is larger
+    CHECK(!std::signbit(accumulated.floatStates[0]));
+    CHECK(std::signbit(accumulated.floatStates[1]));
+    CHECK(std::isnan(accumulated.floatStates[2]));
+    CHECK(accumulated.floatStates[3] == 1.0f);
+    CHECK(std::isnan(accumulated.floatStates[4]));
+    CHECK(accumulated.floatStates[5] == 0.25f);
+    CHECK(accumulated.floatStates[6] == -1.0f);
+    CHECK(accumulated.floatStates[7] == 2.0f);
+    CHECK(std::signbit(accumulated.floatStates[8]));
+}
+
+int main()
+{
+    TestKernelsMatchScalar();
+    TestTailIsLeftAlone();
+    TestSpecialFloats();
+
+    if(gFailures > 0) {
+        fprintf(stderr, "%d checks failed\n", gFailures);
+        return 1;
+    }
+    printf("all checks passed\n");
+    return 0;
+}
@@ -0,0 +1,314 @@
+// Copyright (c) 2021 LunarG, Inc.
+// Copyright (c) 2017-2021 PlutoVR Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Brad Grantham <brad@lunarg.com>
+
+// Shares images between two processes through the CPU graphics backend the
+// way the Overlay and Main sides of the layer do, and checks copies and
+// fences.
+
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif  // !NOMINMAX
+
+#include "graphics_backend.h"
+
+#include <cstdio>
+#include <cstring>
+
+#if !defined(_WIN32)
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+static int gFailures = 0;
+
+#define CHECK(expr) \
+    do { \
+        if(!(expr)) { \
+            fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #expr); \
+            gFailures++; \
+        } \
+    } while(0)
+
+static void PrintError(const char* xrfunc, const char* message)
+{
+    fprintf(stderr, "%s: %s\n", xrfunc ? xrfunc : "(no function)", message);
+}
+
+static const SharedImageDesc TestDesc = { 16, 8, 0, 2, 1, 1 };
+
+static uint32_t TexelPattern(uint32_t seed, uint32_t layer, uint32_t x, uint32_t y)
+{
+    return seed * 0x9E3779B1u ^ (layer << 24) ^ (y << 12) ^ x;
+}
+
+static void FillImage(GraphicsImage* image, uint32_t seed)
+{
+    uint32_t* texels = static_cast<uint32_t*>(GetCpuGraphicsImageMemory(image));
+    for(uint32_t layer = 0; layer < TestDesc.arraySize; layer++) {
+        for(uint32_t y = 0; y < TestDesc.height; y++) {
+            for(uint32_t x = 0; x < TestDesc.width; x++) {
+                texels[(layer * TestDesc.height + y) * TestDesc.width + x] = TexelPattern(seed, layer, x, y);
+            }
+        }
+    }
+}
+
+// Whether every texel is seed's pattern where inRect says so and untouched elsewhere
+template <class InRect>
+static bool ImageMatches(GraphicsImage* image, uint32_t seed, uint32_t untouchedSeed, InRect inRect)
+{
+    const uint32_t* texels = static_cast<const uint32_t*>(GetCpuGraphicsImageMemory(image));
+    for(uint32_t layer = 0; layer < TestDesc.arraySize; layer++) {
+        for(uint32_t y = 0; y < TestDesc.height; y++) {
+            for(uint32_t x = 0; x < TestDesc.width; x++) {
+                uint32_t expected = inRect(x, y) ? TexelPattern(seed, layer, x, y) : TexelPattern(untouchedSeed, layer, x, y);
+                if(texels[(layer * TestDesc.height + y) * TestDesc.width + x] != expected) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+static bool ImageIs(GraphicsImage* image, uint32_t seed)
+{
+    return ImageMatches(image, seed, seed, [](uint32_t, uint32_t) { return true; });
+}
+
+static void TestCopyImageRegions()
+{
+    auto backend = CreateCpuGraphicsBackend(PrintError);
+    auto src = backend->CreateLocalImage(TestDesc);
+    auto dst = backend->CreateLocalImage(TestDesc);
+    CHECK(src && dst);
+    if(!src || !dst) {
+        return;
+    }
+
+    FillImage(src.get(), 1);
+    FillImage(dst.get(), 2);
+
+    // One rect inside, one hanging off the top left, one entirely outside
+    XrRect2Di rects[3] = {
+        {{4, 2}, {3, 2}},
+        {{-2, -3}, {4, 5}},
+        {{20, 1}, {4, 4}},
+    };
+    CHECK(backend->CopyImageRegions(dst.get(), src.get(), rects, 3));
+    CHECK(ImageMatches(dst.get(), 1, 2, [](uint32_t x, uint32_t y) {
+        return ((x >= 4) && (x < 7) && (y >= 2) && (y < 4)) || ((x < 2) && (y < 2));
+    }));
+
+    CHECK(backend->CopyImage(dst.get(), src.get()));
+    CHECK(ImageIs(dst.get(), 1));
+}
+
+static void TestWaitImageTimesOut()
+{
+    int errors = 0;
+    auto backend = CreateCpuGraphicsBackend([&errors](const char*, const char*) { errors++; });
+    auto image = backend->CreateLocalImage(TestDesc);
+    CHECK(image);
+    if(!image) {
+        return;
+    }
+
+    CHECK(backend->SignalImage(image.get(), 3));
+    CHECK(backend->WaitImage(image.get(), 3, 0));
+    CHECK(errors == 0);
+    CHECK(!backend->WaitImage(image.get(), 4, 10));
+    CHECK(errors == 1);
+}
+
+#if defined(_WIN32)
+
+// Share with ourselves; the handles are duplicated into this process
+static void TestSharedImages()
+{
+    auto backend = CreateCpuGraphicsBackend(PrintError);
+    GraphicsPeer self { GetCurrentProcessId(), GetCurrentProcess() };
+
+    std::vector<GraphicsImage::Ptr> created;
+    std::vector<SharedImageHandle> handles;
+    CHECK(backend->CreateSharedImages(TestDesc, 2, self, created, handles));
+    if(created.size() != 2) {
+        return;
+    }
+
+    // A description that doesn't match the mapping is refused
+    HANDLE duplicate;
+    CHECK(DuplicateHandle(GetCurrentProcess(), handles[0].image, GetCurrentProcess(), &duplicate, 0, FALSE, DUPLICATE_SAME_ACCESS));
+    SharedImageDesc biggerDesc = TestDesc;
+    biggerDesc.height *= 2;
+    CHECK(!backend->OpenSharedImage(SharedImageHandle { duplicate, NULL }, biggerDesc, self));
+
+    auto opened = backend->OpenSharedImage(handles[1], TestDesc, self);
+    CHECK(opened);
+    if(!opened) {
+        return;
+    }
+    FillImage(created[1].get(), 5);
+    CHECK(backend->SignalImage(created[1].get(), 1));
+    CHECK(backend->WaitImage(opened.get(), 1, 1000));
+    CHECK(ImageIs(opened.get(), 5));
+}
+
+#else
+
+// Two processes that aren't each other's parent or child share images the
+// way the Overlay and Main do.  Yama's default ptrace_scope lets neither
+// take descriptors out of the other, so they go over a socket the creator
+// connects to by name, all of a swapchain's in one message.  A pipe from
+// creator to opener stands in for the RPC that carries the handle numbers.
+
+static const uint32_t SharedImageCount = 2;
+
+static int SharedImagesCreator(uint32_t channelId, int numbersPipe)
+{
+    int failures = 0;
+    auto backend = CreateCpuGraphicsBackend(PrintError);
+    GraphicsPeer opener { 0, ConnectForPeerHandles(channelId) };
+    if(opener.handleSocket < 0) {
+        return 1;
+    }
+
+    std::vector<GraphicsImage::Ptr> images;
+    std::vector<SharedImageHandle> handles;
+    if(!backend->CreateSharedImages(TestDesc, SharedImageCount, opener, images, handles)) {
+        return 1;
+    }
+    FillImage(images[0].get(), 3);
+    FillImage(images[1].get(), 4);
+    backend->SignalImage(images[0].get(), 1);
+    backend->Flush();
+
+    if(write(numbersPipe, handles.data(), sizeof(handles[0]) * handles.size()) != (ssize_t)(sizeof(handles[0]) * handles.size())) {
+        return 1;
+    }
+    close(numbersPipe);
+
+    if(!backend->WaitImage(images[0].get(), 2, 10000)) {
+        return 1;
+    }
+    failures += ImageIs(images[0].get(), 6) ? 0 : 1;
+    failures += ImageIs(images[1].get(), 4) ? 0 : 1;
+    close(opener.handleSocket);
+    return failures;
+}
+
+static int SharedImagesOpener(int listenSocket, int numbersPipe)
+{
+    int failures = 0;
+    auto backend = CreateCpuGraphicsBackend(PrintError);
+    GraphicsPeer creator { 0, AcceptPeerHandles(listenSocket, 10000) };
+    close(listenSocket);
+    if(creator.handleSocket < 0) {
+        return 1;
+    }
+
+    std::vector<SharedImageHandle> handles(SharedImageCount);
+    if(read(numbersPipe, handles.data(), sizeof(handles[0]) * handles.size()) != (ssize_t)(sizeof(handles[0]) * handles.size())) {
+        return 1;
+    }
+    close(numbersPipe);
+
+    // Numbers that don't match what was sent are refused
+    std::vector<SharedImageHandle> wrong = handles;
+    std::swap(wrong[0], wrong[1]);
+    std::vector<SharedImageHandle> received = handles;
+    if(!ReceivePeerHandles(creator, received, 10000)) {
+        return 1;
+    }
+    // Everything came in that one message
+    failures += !ReceivePeerHandles(creator, wrong, 10) ? 0 : 1;
+
+    // A description that doesn't match the memory is refused
+    SharedImageDesc biggerDesc = TestDesc;
+    biggerDesc.height *= 2;
+    failures += !CreateCpuGraphicsBackend([](const char*, const char*) {})->OpenSharedImage(SharedImageHandle { dup((int)received[1].image), -1 }, biggerDesc, creator) ? 0 : 1;
+
+    auto image = backend->OpenSharedImage(received[0], TestDesc, creator);
+    if(!image || !backend->WaitImage(image.get(), 1, 10000)) {
+        return failures + 1;
+    }
+    failures += ImageIs(image.get(), 3) ? 0 : 1;
+    FillImage(image.get(), 6);
+    backend->SignalImage(image.get(), 2);
+    backend->Flush();
+
+    close((int)received[1].image);
+    close(creator.handleSocket);
+    return failures;
+}
+
+template <class Body>
+static pid_t RunInChild(Body body)
+{
+    fflush(stderr);
+    pid_t child = fork();
+    if(child == 0) {
+        _exit(body());
+    }
+    return child;
+}
+
+static void TestSharedImages()
+{
+    // Bound before either child exists, so the creator can't connect too early
+    uint32_t channelId = (uint32_t)getpid();
+    int listenSocket = ListenForPeerHandles(channelId);
+    CHECK(listenSocket >= 0);
+    int numbersPipe[2];
+    CHECK(pipe(numbersPipe) == 0);
+    if(listenSocket < 0) {
+        return;
+    }
+
+    pid_t opener = RunInChild([&]() { close(numbersPipe[1]); return SharedImagesOpener(listenSocket, numbersPipe[0]); });
+    pid_t creator = RunInChild([&]() { close(numbersPipe[0]); close(listenSocket); return SharedImagesCreator(channelId, numbersPipe[1]); });
+    CHECK((opener > 0) && (creator > 0));
+    close(listenSocket);
+    close(numbersPipe[0]);
+    close(numbersPipe[1]);
+
+    for(pid_t child: { opener, creator }) {
+        if(child > 0) {
+            int status = 0;
+            CHECK(waitpid(child, &status, 0) == child);
+            CHECK(WIFEXITED(status) && (WEXITSTATUS(status) == 0));
+        }
+    }
+}
+
+#endif
+
+int main()
+{
+    TestCopyImageRegions();
+    TestWaitImageTimesOut();
+    TestSharedImages();
+
+    if(gFailures > 0) {
+        fprintf(stderr, "%d checks failed\n", gFailures);
+        return 1;
+    }
+    printf("all checks passed\n");
+    return 0;
+}
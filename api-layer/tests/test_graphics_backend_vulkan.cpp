@@ -0,0 +1,438 @@
+// Copyright (c) 2021 LunarG, Inc.
+// Copyright (c) 2017-2021 PlutoVR Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Brad Grantham <brad@lunarg.com>
+
+// Shares images between two Vulkan backends on one device the way the
+// Overlay and Main sides of the layer do, with the validation layer
+// enabled if it is installed: the "Overlay" clears its image and signals,
+// the "Main" backend waits, copies it into a local image, and the copy is
+// read back.  Also checks that signals are held until Flush.  Exits with
+// 77 (skipped) if no device has the extensions the backend needs.
+
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif  // !NOMINMAX
+
+#include "graphics_backend.h"
+
+#include <vulkan/vulkan.h>
+#include <openxr/openxr_platform.h>
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+static int gFailures = 0;
+
+#define CHECK(expr) \
+    do { \
+        if(!(expr)) { \
+            fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #expr); \
+            gFailures++; \
+        } \
+    } while(0)
+
+static void PrintError(const char* xrfunc, const char* message)
+{
+    fprintf(stderr, "%s: %s\n", xrfunc ? xrfunc : "(no function)", message);
+}
+
+static VKAPI_ATTR VkBool32 VKAPI_CALL CountValidationErrors(VkDebugUtilsMessageSeverityFlagBitsEXT severity, VkDebugUtilsMessageTypeFlagsEXT, const VkDebugUtilsMessengerCallbackDataEXT* data, void*)
+{
+    if(severity & VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT) {
+        fprintf(stderr, "validation: %s\n", data->pMessage);
+        gFailures++;
+    }
+    return VK_FALSE;
+}
+
+static const uint32_t Width = 16;
+static const uint32_t Height = 8;
+static const SharedImageDesc TestDesc = { Width, Height, VK_FORMAT_R8G8B8A8_UNORM, 1, 1, 1 };
+
+#if defined(_WIN32)
+static const char* ExternalExtensions[] = { "VK_KHR_external_memory_win32", "VK_KHR_external_semaphore_win32" };
+#else
+static const char* ExternalExtensions[] = { "VK_KHR_external_memory_fd", "VK_KHR_external_semaphore_fd" };
+#endif
+
+struct TestDevice
+{
+    VkInstance instance = VK_NULL_HANDLE;
+    VkDebugUtilsMessengerEXT messenger = VK_NULL_HANDLE;
+    VkPhysicalDevice physicalDevice = VK_NULL_HANDLE;
+    VkDevice device = VK_NULL_HANDLE;
+    uint32_t queueFamilyIndex = 0;
+    VkQueue queue = VK_NULL_HANDLE;
+    VkCommandPool commandPool = VK_NULL_HANDLE;
+
+    ~TestDevice()
+    {
+        if(commandPool != VK_NULL_HANDLE) {
+            vkDestroyCommandPool(device, commandPool, nullptr);
+        }
+        if(device != VK_NULL_HANDLE) {
+            vkDestroyDevice(device, nullptr);
+        }
+        if(messenger != VK_NULL_HANDLE) {
+            auto destroyMessenger = (PFN_vkDestroyDebugUtilsMessengerEXT)vkGetInstanceProcAddr(instance, "vkDestroyDebugUtilsMessengerEXT");
+            destroyMessenger(instance, messenger, nullptr);
+        }
+        if(instance != VK_NULL_HANDLE) {
+            vkDestroyInstance(instance, nullptr);
+        }
+    }
+};
+
+static bool HasLayer(const char* name)
+{
+    uint32_t count = 0;
+    vkEnumerateInstanceLayerProperties(&count, nullptr);
+    std::vector<VkLayerProperties> layers(count);
+    vkEnumerateInstanceLayerProperties(&count, layers.data());
+    for(const auto& layer: layers) {
+        if(strcmp(layer.layerName, name) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool HasDeviceExtensions(VkPhysicalDevice physicalDevice)
+{
+    uint32_t count = 0;
+    vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &count, nullptr);
+    std::vector<VkExtensionProperties> extensions(count);
+    vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &count, extensions.data());
+    for(const char* wanted: ExternalExtensions) {
+        bool found = false;
+        for(const auto& extension: extensions) {
+            found = found || (strcmp(extension.extensionName, wanted) == 0);
+        }
+        if(!found) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// A Vulkan 1.2 device with timeline semaphores and the external memory and
+// semaphore extensions, as an application using the layer must create
+static bool CreateTestDevice(TestDevice& test)
+{
+    bool validation = HasLayer("VK_LAYER_KHRONOS_validation");
+    const char* layerName = "VK_LAYER_KHRONOS_validation";
+    const char* debugUtils = VK_EXT_DEBUG_UTILS_EXTENSION_NAME;
+
+    VkApplicationInfo appInfo { VK_STRUCTURE_TYPE_APPLICATION_INFO };
+    appInfo.pApplicationName = "test_graphics_backend_vulkan";
+    appInfo.apiVersion = VK_API_VERSION_1_2;
+    VkInstanceCreateInfo instanceInfo { VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO };
+    instanceInfo.pApplicationInfo = &appInfo;
+    instanceInfo.enabledLayerCount = validation ? 1 : 0;
+    instanceInfo.ppEnabledLayerNames = &layerName;
+    instanceInfo.enabledExtensionCount = validation ? 1 : 0;
+    instanceInfo.ppEnabledExtensionNames = &debugUtils;
+    if(vkCreateInstance(&instanceInfo, nullptr, &test.instance) != VK_SUCCESS) {
+        return false;
+    }
+    if(validation) {
+        VkDebugUtilsMessengerCreateInfoEXT messengerInfo { VK_STRUCTURE_TYPE_DEBUG_UTILS_MESSENGER_CREATE_INFO_EXT };
+        messengerInfo.messageSeverity = VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT;
+        messengerInfo.messageType = VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT;
+        messengerInfo.pfnUserCallback = CountValidationErrors;
+        auto createMessenger = (PFN_vkCreateDebugUtilsMessengerEXT)vkGetInstanceProcAddr(test.instance, "vkCreateDebugUtilsMessengerEXT");
+        createMessenger(test.instance, &messengerInfo, nullptr, &test.messenger);
+    } else {
+        printf("VK_LAYER_KHRONOS_validation isn't installed; running without validation\n");
+    }
+
+    uint32_t count = 0;
+    vkEnumeratePhysicalDevices(test.instance, &count, nullptr);
+    std::vector<VkPhysicalDevice> physicalDevices(count);
+    vkEnumeratePhysicalDevices(test.instance, &count, physicalDevices.data());
+    for(auto physicalDevice: physicalDevices) {
+        VkPhysicalDeviceProperties properties;
+        vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+        VkPhysicalDeviceVulkan12Features features12 { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES };
+        VkPhysicalDeviceFeatures2 features { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2 };
+        features.pNext = &features12;
+        if(properties.apiVersion >= VK_API_VERSION_1_2) {
+            vkGetPhysicalDeviceFeatures2(physicalDevice, &features);
+        }
+        if(features12.timelineSemaphore && HasDeviceExtensions(physicalDevice)) {
+            test.physicalDevice = physicalDevice;
+            break;
+        }
+    }
+    if(test.physicalDevice == VK_NULL_HANDLE) {
+        return false;
+    }
+
+    vkGetPhysicalDeviceQueueFamilyProperties(test.physicalDevice, &count, nullptr);
+    std::vector<VkQueueFamilyProperties> families(count);
+    vkGetPhysicalDeviceQueueFamilyProperties(test.physicalDevice, &count, families.data());
+    test.queueFamilyIndex = count;
+    for(uint32_t i = 0; i < count; i++) {
+        if(families[i].queueFlags & VK_QUEUE_GRAPHICS_BIT) {
+            test.queueFamilyIndex = i;
+            break;
+        }
+    }
+    if(test.queueFamilyIndex == count) {
+        return false;
+    }
+
+    float priority = 1.0f;
+    VkDeviceQueueCreateInfo queueInfo { VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO };
+    queueInfo.queueFamilyIndex = test.queueFamilyIndex;
+    queueInfo.queueCount = 1;
+    queueInfo.pQueuePriorities = &priority;
+    VkPhysicalDeviceVulkan12Features features12 { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES };
+    features12.timelineSemaphore = VK_TRUE;
+    VkDeviceCreateInfo deviceInfo { VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO };
+    deviceInfo.pNext = &features12;
+    deviceInfo.queueCreateInfoCount = 1;
+    deviceInfo.pQueueCreateInfos = &queueInfo;
+    deviceInfo.enabledExtensionCount = sizeof(ExternalExtensions) / sizeof(ExternalExtensions[0]);
+    deviceInfo.ppEnabledExtensionNames = ExternalExtensions;
+    if(vkCreateDevice(test.physicalDevice, &deviceInfo, nullptr, &test.device) != VK_SUCCESS) {
+        return false;
+    }
+    vkGetDeviceQueue(test.device, test.queueFamilyIndex, 0, &test.queue);
+
+    VkCommandPoolCreateInfo poolInfo { VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO };
+    poolInfo.queueFamilyIndex = test.queueFamilyIndex;
+    return vkCreateCommandPool(test.device, &poolInfo, nullptr, &test.commandPool) == VK_SUCCESS;
+}
+
+// Record, submit and wait for commands on the application's queue, as the application would render
+template <class Record>
+static void RunCommands(TestDevice& test, Record record)
+{
+    VkCommandBufferAllocateInfo allocInfo { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
+    allocInfo.commandPool = test.commandPool;
+    allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    allocInfo.commandBufferCount = 1;
+    VkCommandBuffer commandBuffer;
+    vkAllocateCommandBuffers(test.device, &allocInfo, &commandBuffer);
+    VkCommandBufferBeginInfo beginInfo { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    vkBeginCommandBuffer(commandBuffer, &beginInfo);
+    record(commandBuffer);
+    vkEndCommandBuffer(commandBuffer);
+    VkSubmitInfo submitInfo { VK_STRUCTURE_TYPE_SUBMIT_INFO };
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &commandBuffer;
+    vkQueueSubmit(test.queue, 1, &submitInfo, VK_NULL_HANDLE);
+    vkQueueWaitIdle(test.queue);
+    vkFreeCommandBuffers(test.device, test.commandPool, 1, &commandBuffer);
+}
+
+static void Barrier(VkCommandBuffer commandBuffer, VkImage image, VkImageLayout oldLayout, VkImageLayout newLayout)
+{
+    VkImageMemoryBarrier barrier { VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER };
+    barrier.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+    barrier.oldLayout = oldLayout;
+    barrier.newLayout = newLayout;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = image;
+    barrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+}
+
+static VkImage GetImage(GraphicsBackend* backend, GraphicsImage* image)
+{
+    XrSwapchainImageVulkanKHR out { XR_TYPE_SWAPCHAIN_IMAGE_VULKAN_KHR };
+    backend->FillSwapchainImage(image, reinterpret_cast<XrSwapchainImageBaseHeader*>(&out));
+    return out.image;
+}
+
+// Clear image to one color, leaving it in COLOR_ATTACHMENT_OPTIMAL as the backend expects
+static void ClearImage(TestDevice& test, VkImage image, VkImageLayout layout, const float color[4])
+{
+    RunCommands(test, [&](VkCommandBuffer commandBuffer) {
+        Barrier(commandBuffer, image, layout, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+        VkClearColorValue clear;
+        memcpy(clear.float32, color, sizeof(clear.float32));
+        VkImageSubresourceRange range { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+        vkCmdClearColorImage(commandBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, &clear, 1, &range);
+        Barrier(commandBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+    });
+}
+
+// Texels of image, in COLOR_ATTACHMENT_OPTIMAL
+static std::vector<uint32_t> ReadImage(TestDevice& test, VkImage image)
+{
+    std::vector<uint32_t> texels(Width * Height, 0);
+
+    VkBufferCreateInfo bufferInfo { VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
+    bufferInfo.size = texels.size() * sizeof(uint32_t);
+    bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    VkBuffer buffer;
+    vkCreateBuffer(test.device, &bufferInfo, nullptr, &buffer);
+    VkMemoryRequirements requirements;
+    vkGetBufferMemoryRequirements(test.device, buffer, &requirements);
+    VkPhysicalDeviceMemoryProperties memoryProperties;
+    vkGetPhysicalDeviceMemoryProperties(test.physicalDevice, &memoryProperties);
+    VkMemoryAllocateInfo allocInfo { VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
+    allocInfo.allocationSize = requirements.size;
+    VkMemoryPropertyFlags wanted = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+    for(uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++) {
+        if((requirements.memoryTypeBits & (1u << i)) && ((memoryProperties.memoryTypes[i].propertyFlags & wanted) == wanted)) {
+            allocInfo.memoryTypeIndex = i;
+            break;
+        }
+    }
+    VkDeviceMemory memory;
+    vkAllocateMemory(test.device, &allocInfo, nullptr, &memory);
+    vkBindBufferMemory(test.device, buffer, memory, 0);
+
+    RunCommands(test, [&](VkCommandBuffer commandBuffer) {
+        Barrier(commandBuffer, image, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+        VkBufferImageCopy region {};
+        region.imageSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
+        region.imageExtent = { Width, Height, 1 };
+        vkCmdCopyImageToBuffer(commandBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, buffer, 1, &region);
+        Barrier(commandBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+    });
+
+    void* mapped;
+    vkMapMemory(test.device, memory, 0, bufferInfo.size, 0, &mapped);
+    memcpy(texels.data(), mapped, bufferInfo.size);
+    vkUnmapMemory(test.device, memory);
+    vkDestroyBuffer(test.device, buffer, nullptr);
+    vkFreeMemory(test.device, memory, nullptr);
+    return texels;
+}
+
+static bool AllTexelsAre(const std::vector<uint32_t>& texels, uint32_t value)
+{
+    for(uint32_t texel: texels) {
+        if(texel != value) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void TestSharedImages(TestDevice& test)
+{
+    XrGraphicsBindingVulkanKHR binding { XR_TYPE_GRAPHICS_BINDING_VULKAN_KHR };
+    binding.instance = test.instance;
+    binding.physicalDevice = test.physicalDevice;
+    binding.device = test.device;
+    binding.queueFamilyIndex = test.queueFamilyIndex;
+    binding.queueIndex = 0;
+
+    auto overlay = CreateVulkanGraphicsBackend(&binding, PrintError);
+    auto main = CreateVulkanGraphicsBackend(&binding, PrintError);
+    CHECK(overlay && main);
+    if(!overlay || !main) {
+        return;
+    }
+
+#if defined(_WIN32)
+    GraphicsPeer self { GetCurrentProcessId(), GetCurrentProcess() };
+    GraphicsPeer toMain = self;
+    GraphicsPeer toOverlay = self;
+#else
+    // Both ends of the descriptor socket are in this process
+    int sockets[2] = { -1, -1 };
+    CHECK(socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, sockets) == 0);
+    GraphicsPeer toMain { getpid(), sockets[0] };
+    GraphicsPeer toOverlay { getpid(), sockets[1] };
+#endif
+
+    std::vector<GraphicsImage::Ptr> created;
+    std::vector<SharedImageHandle> handles;
+    CHECK(overlay->CreateSharedImages(TestDesc, 2, toMain, created, handles));
+    CHECK((created.size() == 2) && (handles.size() == 2));
+    if(created.size() != 2) {
+        return;
+    }
+    // The layout transitions are held like everything else
+    overlay->Flush();
+
+    CHECK(ReceivePeerHandles(toOverlay, handles, 1000));
+#if !defined(_WIN32)
+    close((int)handles[0].image);
+    close((int)handles[0].fence);
+#endif
+    auto opened = main->OpenSharedImage(handles[1], TestDesc, toOverlay);
+    auto local = main->CreateLocalImage(TestDesc);
+    CHECK(opened && local);
+    if(!opened || !local) {
+        return;
+    }
+    float black[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    ClearImage(test, GetImage(main.get(), local.get()), VK_IMAGE_LAYOUT_UNDEFINED, black);
+
+    // The Overlay renders and releases; fence values follow the layer's, 1 for
+    // the Overlay's first release and 2 for Main having read it
+    float red[4] = { 1.0f, 0.0f, 0.0f, 1.0f };
+    ClearImage(test, GetImage(overlay.get(), created[1].get()), VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, red);
+    CHECK(overlay->SignalImage(created[1].get(), 1));
+
+    // Signals wait for Flush, which only runs inside the application's OpenXR calls
+    CHECK(!main->WaitImage(opened.get(), 1, 10));
+    overlay->Flush();
+    CHECK(main->WaitImage(opened.get(), 1, 1000));
+
+    // Main copies on its RPC thread, then submits in its xrEndFrame
+    CHECK(main->CopyImage(local.get(), opened.get()));
+    CHECK(main->SignalImage(opened.get(), 2));
+    CHECK(!main->FlushFromRPCThread());
+    CHECK(!overlay->WaitImage(created[1].get(), 2, 10));
+    main->Flush();
+    CHECK(overlay->WaitImage(created[1].get(), 2, 1000));
+    vkQueueWaitIdle(test.queue);
+
+    CHECK(AllTexelsAre(ReadImage(test, GetImage(main.get(), local.get())), 0xFF0000FFu));
+
+#if !defined(_WIN32)
+    close(sockets[0]);
+    close(sockets[1]);
+#endif
+}
+
+int main()
+{
+    TestDevice test;
+    if(!CreateTestDevice(test)) {
+        printf("no Vulkan 1.2 device with timeline semaphores and external memory and semaphores; skipping\n");
+        return 77;
+    }
+
+    TestSharedImages(test);
+    vkDeviceWaitIdle(test.device);
+
+    if(gFailures > 0) {
+        fprintf(stderr, "%d checks failed\n", gFailures);
+        return 1;
+    }
+    printf("all checks passed\n");
+    return 0;
+}
@@ -0,0 +1,153 @@
+// Copyright (c) 2021 LunarG, Inc.
+// Copyright (c) 2017-2021 PlutoVR Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Brad Grantham <brad@lunarg.com>
+
+// Runs an Overlay that submits a layer whenever it is told to render,
+// through stretches where the layer can and can't be seen, and checks
+// shouldRender settles instead of flipping every frame.
+
+#include "overlay_visibility.h"
+
+#include <cstdio>
+#include <vector>
+
+static int gFailures = 0;
+
+#define CHECK(expr) \
+    do { \
+        if(!(expr)) { \
+            fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #expr); \
+            gFailures++; \
+        } \
+    } while(0)
+
+// One frame of the Overlay and of Main: xrWaitFrame, then the Overlay
+// submits a layer if it rendered, then Main's xrEndFrame judges it
+static bool RunFrame(OverlayCullHysteresis& cull, bool layerVisible)
+{
+    bool shouldRender = cull.ShouldRender();
+    cull.UpdateFromLayers(shouldRender, layerVisible);
+    return shouldRender;
+}
+
+// shouldRender for each frame of a run where the layer's visibility follows layerVisible
+static std::vector<bool> Run(OverlayCullHysteresis& cull, const std::vector<bool>& layerVisible)
+{
+    std::vector<bool> rendered;
+    for(bool visible: layerVisible) {
+        rendered.push_back(RunFrame(cull, visible));
+    }
+    return rendered;
+}
+
+static uint32_t CountRendered(const std::vector<bool>& rendered, size_t first, size_t last)
+{
+    uint32_t count = 0;
+    for(size_t i = first; i < last; i++) {
+        count += rendered[i] ? 1 : 0;
+    }
+    return count;
+}
+
+static void TestVisibleAlwaysRenders()
+{
+    OverlayCullHysteresis cull;
+    auto rendered = Run(cull, std::vector<bool>(100, true));
+    CHECK(CountRendered(rendered, 0, rendered.size()) == 100);
+    CHECK(!cull.culled);
+}
+
+static void TestInvisibleSettles()
+{
+    OverlayCullHysteresis cull;
+    auto rendered = Run(cull, std::vector<bool>(300, false));
+
+    // Renders until culled, then only on probes
+    for(uint32_t i = 0; i < cull.framesToCull; i++) {
+        CHECK(rendered[i]);
+    }
+    CHECK(cull.culled);
+    uint32_t expectedProbes = uint32_t(300 - cull.framesToCull) / cull.framesBetweenProbes;
+    CHECK(CountRendered(rendered, cull.framesToCull, rendered.size()) == expectedProbes);
+
+    // Never rendering two frames in a row once culled, never going many frames without a probe
+    size_t lastRendered = cull.framesToCull - 1;
+    for(size_t i = cull.framesToCull; i < rendered.size(); i++) {
+        CHECK(!(rendered[i] && rendered[i - 1]));
+        if(rendered[i]) {
+            CHECK(i - lastRendered == cull.framesBetweenProbes);
+            lastRendered = i;
+        }
+    }
+}
+
+static void TestBriefInvisibilityIsNotCulled()
+{
+    OverlayCullHysteresis cull;
+    std::vector<bool> visibility;
+    for(int i = 0; i < 100; i++) {
+        // Invisible for one frame less than it takes to be culled, then visible once
+        visibility.push_back((i % cull.framesToCull) == cull.framesToCull - 1);
+    }
+    auto rendered = Run(cull, visibility);
+    CHECK(CountRendered(rendered, 0, rendered.size()) == rendered.size());
+    CHECK(!cull.culled);
+}
+
+static void TestProbeUncovers()
+{
+    OverlayCullHysteresis cull;
+    Run(cull, std::vector<bool>(cull.framesToCull, false));
+    CHECK(cull.culled);
+
+    // The layer comes back into view; found by the next probe, then rendered every frame
+    auto rendered = Run(cull, std::vector<bool>(cull.framesBetweenProbes + 10, true));
+    CHECK(CountRendered(rendered, 0, cull.framesBetweenProbes - 1) == 0);
+    CHECK(rendered[cull.framesBetweenProbes - 1]);
+    CHECK(CountRendered(rendered, cull.framesBetweenProbes - 1, rendered.size()) == 11);
+    CHECK(!cull.culled);
+}
+
+static void TestNothingSubmittedKeepsState()
+{
+    OverlayCullHysteresis cull;
+    cull.UpdateFromLayers(false, false);
+    CHECK(!cull.culled);
+    CHECK(cull.invisibleFrames == 0);
+
+    Run(cull, std::vector<bool>(cull.framesToCull, false));
+    CHECK(cull.culled);
+    cull.UpdateFromLayers(false, false);
+    CHECK(cull.culled);
+}
+
+int main()
+{
+    TestVisibleAlwaysRenders();
+    TestInvisibleSettles();
+    TestBriefInvisibilityIsNotCulled();
+    TestProbeUncovers();
+    TestNothingSubmittedKeepsState();
+
+    if(gFailures > 0) {
+        fprintf(stderr, "%d checks failed\n", gFailures);
+        return 1;
+    }
+    printf("all checks passed\n");
+    return 0;
+}
@@ -0,0 +1,406 @@
+// Copyright (c) 2021 LunarG, Inc.
+// Copyright (c) 2017-2021 PlutoVR Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Brad Grantham <brad@lunarg.com>
+
+// Replays a recorded controller motion through an Overlay's space location
+// cache, and checks extrapolated poses against the recorded ones, which
+// locates go back to Main, which spaces are batched, and what happens to
+// untracked and invalid poses.
+
+#include "pose_extrapolation.h"
+
+#include <cmath>
+#include <cstdio>
+
+static int gFailures = 0;
+
+#define CHECK(expr) \
+    do { \
+        if(!(expr)) { \
+            fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #expr); \
+            gFailures++; \
+        } \
+    } while(0)
+
+static const XrSpaceLocationFlags PoseValid = XR_SPACE_LOCATION_POSITION_VALID_BIT | XR_SPACE_LOCATION_ORIENTATION_VALID_BIT;
+static const XrSpaceLocationFlags PoseTracked = PoseValid | XR_SPACE_LOCATION_POSITION_TRACKED_BIT | XR_SPACE_LOCATION_ORIENTATION_TRACKED_BIT;
+static const XrSpaceLocationFlags PoseInvalid = 0;
+
+static const XrDuration FramePeriod = 11111111;    // 90Hz
+
+// A right controller swinging in front of the user, located once per
+// display frame with its velocities.  Tracking drops to valid but untracked
+// for two frames and the pose is lost for one.
+struct TraceFrame
+{
+    uint32_t frame;
+    XrSpaceLocationFlags locationFlags;
+    XrVector3f position;
+    XrQuaternionf orientation;
+    XrVector3f linearVelocity;
+    XrVector3f angularVelocity;
+};
+
+static const TraceFrame Trace[] = {
+    { 0, PoseTracked, {0.000000f, 1.100000f, -0.250000f}, {0.300000f, 0.100000f, -0.200000f, 0.927362f}, {0.785398f, 0.314159f, 0.000000f}, {0.000000f, 3.015929f, 2.261947f}},
+    { 1, PoseTracked, {0.008725f, 1.103488f, -0.250061f}, {0.295329f, 0.119276f, -0.193333f, 0.927996f}, {0.784920f, 0.313394f, -0.010964f}, {0.000000f, 3.011796f, 2.258847f}},
+    { 2, PoseTracked, {0.017439f, 1.106959f, -0.250244f}, {0.290542f, 0.138447f, -0.186599f, 0.928223f}, {0.783485f, 0.311102f, -0.021915f}, {0.000000f, 2.999407f, 2.249556f}},
+    { 3, PoseTracked, {0.026132f, 1.110396f, -0.250548f}, {0.285656f, 0.157453f, -0.179822f, 0.928048f}, {0.781096f, 0.307294f, -0.032839f}, {0.000000f, 2.978798f, 2.234098f}},
+    { 4, PoseTracked, {0.034793f, 1.113782f, -0.250973f}, {0.280688f, 0.176235f, -0.173024f, 0.927479f}, {0.777755f, 0.301989f, -0.043723f}, {0.000000f, 2.950024f, 2.212518f}},
+    { 5, PoseTracked, {0.043412f, 1.117101f, -0.251519f}, {0.275658f, 0.194735f, -0.166230f, 0.926530f}, {0.773466f, 0.295213f, -0.054553f}, {0.000000f, 2.913164f, 2.184873f}},
+    { 6, PoseValid, {0.051978f, 1.120337f, -0.252185f}, {0.270587f, 0.212899f, -0.159462f, 0.925218f}, {0.768235f, 0.286999f, -0.065317f}, {0.000000f, 2.868319f, 2.151239f}},
+    { 7, PoseValid, {0.060480f, 1.123474f, -0.252970f}, {0.265495f, 0.230672f, -0.152746f, 0.923565f}, {0.762068f, 0.277386f, -0.076002f}, {0.000000f, 2.815612f, 2.111709f}},
+    { 8, PoseTracked, {0.068909f, 1.126496f, -0.253874f}, {0.260403f, 0.248005f, -0.146106f, 0.921595f}, {0.754973f, 0.266422f, -0.086594f}, {0.000000f, 2.755188f, 2.066391f}},
+    { 9, PoseTracked, {0.077254f, 1.129389f, -0.254894f}, {0.255335f, 0.264849f, -0.139566f, 0.919337f}, {0.746958f, 0.254160f, -0.097081f}, {0.000000f, 2.687212f, 2.015409f}},
+    {10, PoseTracked, {0.085505f, 1.132139f, -0.256031f}, {0.250313f, 0.281158f, -0.133151f, 0.916823f}, {0.738033f, 0.240660f, -0.107449f}, {0.000000f, 2.611871f, 1.958903f}},
+    {11, PoseTracked, {0.093652f, 1.134733f, -0.257282f}, {0.245359f, 0.296890f, -0.126883f, 0.914087f}, {0.728208f, 0.225987f, -0.117686f}, {0.000000f, 2.529371f, 1.897028f}},
+    {12, PoseInvalid, {0.101684f, 1.137157f, -0.258645f}, {0.240496f, 0.312007f, -0.120787f, 0.911166f}, {0.717497f, 0.210214f, -0.127780f}, {0.000000f, 2.439938f, 1.829953f}},
+    {13, PoseTracked, {0.109593f, 1.139401f, -0.260121f}, {0.235748f, 0.326471f, -0.114884f, 0.908098f}, {0.705911f, 0.193416f, -0.137718f}, {0.000000f, 2.343817f, 1.757863f}},
+    {14, PoseTracked, {0.117368f, 1.141452f, -0.261705f}, {0.231135f, 0.340250f, -0.109197f, 0.904921f}, {0.693465f, 0.175676f, -0.147489f}, {0.000000f, 2.241272f, 1.680954f}},
+    {15, PoseTracked, {0.125000f, 1.143301f, -0.263397f}, {0.226681f, 0.353314f, -0.103745f, 0.901677f}, {0.680175f, 0.157080f, -0.157080f}, {0.000000f, 2.132584f, 1.599438f}},
+    {16, PoseTracked, {0.132480f, 1.144940f, -0.265195f}, {0.222405f, 0.365635f, -0.098550f, 0.898407f}, {0.666055f, 0.137718f, -0.166479f}, {0.000000f, 2.018050f, 1.513538f}},
+    {17, PoseTracked, {0.139798f, 1.146359f, -0.267096f}, {0.218329f, 0.377191f, -0.093630f, 0.895150f}, {0.651125f, 0.117686f, -0.175676f}, {0.000000f, 1.897986f, 1.423489f}},
+    {18, PoseTracked, {0.146946f, 1.147553f, -0.269098f}, {0.214471f, 0.387959f, -0.089002f, 0.891946f}, {0.635400f, 0.097081f, -0.184658f}, {0.000000f, 1.772719f, 1.329539f}},
+    {19, PoseTracked, {0.153915f, 1.148515f, -0.271199f}, {0.210850f, 0.397922f, -0.084683f, 0.888836f}, {0.618902f, 0.076002f, -0.193416f}, {0.000000f, 1.642593f, 1.231944f}},
+    {20, PoseTracked, {0.160697f, 1.149240f, -0.273396f}, {0.207484f, 0.407063f, -0.080689f, 0.885855f}, {0.601650f, 0.054553f, -0.201938f}, {0.000000f, 1.507964f, 1.130973f}},
+    {21, PoseTracked, {0.167283f, 1.149726f, -0.275686f}, {0.204388f, 0.415368f, -0.077032f, 0.883041f}, {0.583665f, 0.032839f, -0.210214f}, {0.000000f, 1.369203f, 1.026902f}},
+    {22, PoseTracked, {0.173665f, 1.149970f, -0.278066f}, {0.201578f, 0.422825f, -0.073726f, 0.880426f}, {0.564968f, 0.010964f, -0.218233f}, {0.000000f, 1.226689f, 0.920017f}},
+    {23, PoseTracked, {0.179835f, 1.149970f, -0.280534f}, {0.199065f, 0.429426f, -0.070783f, 0.878041f}, {0.545583f, -0.010964f, -0.225987f}, {0.000000f, 1.080812f, 0.810609f}},
+};
+
+static const uint32_t TraceFrameCount = sizeof(Trace) / sizeof(Trace[0]);
+
+static XrTime FrameTime(uint32_t frame)
+{
+    return 1000000000 + frame * FramePeriod;
+}
+
+static uint32_t TimeFrame(XrTime time)
+{
+    return (uint32_t)((time - FrameTime(0)) / FramePeriod);
+}
+
+static XrSpace TestSpace(uintptr_t id)
+{
+    return reinterpret_cast<XrSpace>(id);
+}
+
+// Value-initialized, so -Wextra has no fields to find missing
+static XrSpaceLocation EmptyLocation()
+{
+    XrSpaceLocation location {};
+    location.type = XR_TYPE_SPACE_LOCATION;
+    return location;
+}
+
+static SpacePoseSample TraceSample(uint32_t frame)
+{
+    const TraceFrame& f = Trace[frame];
+    SpacePoseSample sample {};
+    sample.result = XR_SUCCESS;
+    sample.location.type = XR_TYPE_SPACE_LOCATION;
+    sample.velocity.type = XR_TYPE_SPACE_VELOCITY;
+    sample.location.locationFlags = f.locationFlags;
+    if(f.locationFlags != PoseInvalid) {
+        sample.location.pose = { f.orientation, f.position };
+        sample.velocity.velocityFlags = XR_SPACE_VELOCITY_LINEAR_VALID_BIT | XR_SPACE_VELOCITY_ANGULAR_VALID_BIT;
+        sample.velocity.linearVelocity = f.linearVelocity;
+        sample.velocity.angularVelocity = f.angularVelocity;
+    }
+    return sample;
+}
+
+static double PositionError(const XrPosef& a, const XrPosef& b)
+{
+    double dx = a.position.x - b.position.x, dy = a.position.y - b.position.y, dz = a.position.z - b.position.z;
+    return std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+// Angle in radians of the rotation between a's and b's orientations
+static double OrientationError(const XrPosef& a, const XrPosef& b)
+{
+    const XrQuaternionf& p = a.orientation;
+    const XrQuaternionf& q = b.orientation;
+    double dot = std::abs(p.x * q.x + p.y * q.y + p.z * q.z + p.w * q.w);
+    double lengths = std::sqrt((p.x * p.x + p.y * p.y + p.z * p.z + p.w * p.w) * (q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w));
+    return 2 * std::acos(std::fmin(1.0, dot / lengths));
+}
+
+static void TestTimeWindow()
+{
+    const XrTime t = FrameTime(0);
+    const XrDuration window = 20000000;
+
+    CHECK(PoseSampleTimeIsNear(t, t, window));
+    CHECK(PoseSampleTimeIsNear(t, t + FramePeriod, window));
+    CHECK(PoseSampleTimeIsNear(t, t + window, window));
+    CHECK(PoseSampleTimeIsNear(t, t - window, window));
+    CHECK(!PoseSampleTimeIsNear(t, t + window + 1, window));
+    CHECK(!PoseSampleTimeIsNear(t, t - window - 1, window));
+    CHECK(!PoseSampleTimeIsNear(t, t + 2 * FramePeriod, window));
+
+    // A window of 0 turns the cache off, even for locates at the very time of the batch
+    CHECK(!PoseSampleTimeIsNear(t, t, 0));
+    CHECK(!PoseSampleTimeIsNear(t, t + 1, 0));
+
+    // An empty cache has time 0, which no frame time is near
+    CHECK(!PoseSampleTimeIsNear(0, t, window));
+}
+
+static void TestUnusableSamples()
+{
+    XrSpaceLocation location = EmptyLocation();
+    location.locationFlags = PoseTracked;
+
+    SpacePoseSample failed = TraceSample(0);
+    failed.result = XR_ERROR_SESSION_LOST;
+    CHECK(!ExtrapolateSpacePoseSample(failed, FramePeriod, &location));
+
+    CHECK(!ExtrapolateSpacePoseSample(TraceSample(12), FramePeriod, &location));
+
+    SpacePoseSample positionOnly = TraceSample(0);
+    positionOnly.location.locationFlags = XR_SPACE_LOCATION_POSITION_VALID_BIT | XR_SPACE_LOCATION_POSITION_TRACKED_BIT;
+    CHECK(!ExtrapolateSpacePoseSample(positionOnly, FramePeriod, &location));
+
+    SpacePoseSample noAngular = TraceSample(0);
+    noAngular.velocity.velocityFlags = XR_SPACE_VELOCITY_LINEAR_VALID_BIT;
+    CHECK(!ExtrapolateSpacePoseSample(noAngular, FramePeriod, &location));
+
+    // The caller's location is left alone
+    CHECK(location.locationFlags == PoseTracked);
+}
+
+static void TestExtrapolatesAlongTrace()
+{
+    for(uint32_t frame = 0; frame + 1 < TraceFrameCount; frame++) {
+        SpacePoseSample from = TraceSample(frame);
+        SpacePoseSample to = TraceSample(frame + 1);
+        if((from.location.locationFlags == PoseInvalid) || (to.location.locationFlags == PoseInvalid)) {
+            continue;
+        }
+
+        // Forward a frame, back a frame, and not at all
+        XrSpaceLocation forward = EmptyLocation();
+        XrSpaceLocation back = EmptyLocation();
+        XrSpaceLocation same = EmptyLocation();
+        CHECK(ExtrapolateSpacePoseSample(from, FramePeriod, &forward));
+        CHECK(ExtrapolateSpacePoseSample(to, -FramePeriod, &back));
+        CHECK(ExtrapolateSpacePoseSample(from, 0, &same));
+
+        CHECK(PositionError(forward.pose, to.location.pose) < 0.0005);
+        CHECK(OrientationError(forward.pose, to.location.pose) < 0.002);
+        CHECK(PositionError(back.pose, from.location.pose) < 0.0005);
+        CHECK(OrientationError(back.pose, from.location.pose) < 0.002);
+        CHECK(PositionError(same.pose, from.location.pose) == 0);
+        CHECK(OrientationError(same.pose, from.location.pose) < 1e-6);
+
+        // Better than holding the sample still
+        CHECK(PositionError(forward.pose, to.location.pose) < PositionError(from.location.pose, to.location.pose));
+        CHECK(OrientationError(forward.pose, to.location.pose) < OrientationError(from.location.pose, to.location.pose));
+
+        // Flags are the sample's; one that lost tracking isn't tracked by extrapolating it
+        CHECK(forward.locationFlags == from.location.locationFlags);
+    }
+}
+
+struct ReplayStats
+{
+    uint32_t batches = 0;           // LocateSpaces RPCs relocating the cache
+    uint32_t extrapolated = 0;
+    uint32_t fallbacks = 0;         // single LocateSpace RPCs for samples that can't be extrapolated
+    uint32_t untracked = 0;         // extrapolated from a sample that was valid but not tracked
+    double worstPositionError = 0;
+    double worstOrientationError = 0;
+};
+
+// Main answering LocateSpaces RPCs with the trace, for every space
+struct TraceMain
+{
+    uint32_t rpcs = 0;
+    uint32_t spacesLocated = 0;
+
+    bool operator()(const std::vector<XrSpace>& spaces, XrTime time, std::vector<SpacePoseSample>& located)
+    {
+        rpcs++;
+        spacesLocated += (uint32_t)spaces.size();
+        for(auto& sample: located) {
+            sample = TraceSample(TimeFrame(time));
+        }
+        return true;
+    }
+};
+
+// The Overlay locating the controller locatesPerFrame times a frame
+// through SpaceLocationCache the way OverlaysLayerLocateSpaceOverlay does
+static ReplayStats Replay(XrDuration window, uint32_t locatesPerFrame = 1)
+{
+    ReplayStats stats;
+    SpaceLocationCache cache;
+    TraceMain main;
+    const XrSpace controller = TestSpace(1);
+    const XrSpace stage = TestSpace(100);
+
+    for(uint32_t locate = 0; locate < TraceFrameCount * locatesPerFrame; locate++) {
+        uint32_t frame = locate / locatesPerFrame;
+        XrTime time = FrameTime(frame);
+        const TraceFrame& recorded = Trace[frame];
+        XrSpaceLocation location = EmptyLocation();
+        XrResult result = XR_ERROR_RUNTIME_FAILURE;
+
+        uint32_t rpcsBefore = main.rpcs;
+        bool answered = cache.Locate(controller, stage, time, window, [&](auto&&... args) { return main(args...); }, &location, &result);
+        stats.batches += main.rpcs - rpcsBefore;
+
+        if(!answered) {
+            stats.fallbacks++;
+            location.locationFlags = recorded.locationFlags;
+
+        } else if(cache.time != time) {
+            CHECK(result == XR_SUCCESS);
+            stats.extrapolated++;
+            CHECK(location.locationFlags == cache.samples.at(controller).location.locationFlags);
+            stats.untracked += (location.locationFlags == PoseValid) ? 1 : 0;
+            XrPosef recordedPose { recorded.orientation, recorded.position };
+            stats.worstPositionError = std::fmax(stats.worstPositionError, PositionError(location.pose, recordedPose));
+            stats.worstOrientationError = std::fmax(stats.worstOrientationError, OrientationError(location.pose, recordedPose));
+        }
+        if((locate + 1) % locatesPerFrame == 0) {
+            cache.frame++;
+        }
+    }
+    return stats;
+}
+
+static void TestReplayTrace()
+{
+    // No window: nothing is cached or batched, every locate goes to Main by itself
+    ReplayStats none = Replay(0);
+    CHECK(none.batches == 0);
+    CHECK(none.extrapolated == 0);
+    CHECK(none.fallbacks == TraceFrameCount);
+
+    // Not even a second locate at the same time is answered from the first
+    ReplayStats noneTwice = Replay(0, 2);
+    CHECK(noneTwice.batches == 0);
+    CHECK(noneTwice.extrapolated == 0);
+    CHECK(noneTwice.fallbacks == 2 * TraceFrameCount);
+
+    // The default window covers one frame: even frames are batched, odd
+    // frames extrapolated, except frame 13 whose batch lost the pose, and
+    // frame 7 stays untracked like its batch
+    ReplayStats oneFrame = Replay(20000000);
+    CHECK(oneFrame.batches == TraceFrameCount / 2);
+    CHECK(oneFrame.extrapolated == TraceFrameCount / 2 - 1);
+    CHECK(oneFrame.fallbacks == 1);
+    CHECK(oneFrame.untracked == 1);
+    CHECK(oneFrame.worstPositionError < 0.0005);
+    CHECK(oneFrame.worstOrientationError < 0.002);
+
+    // Two frames: a batch every third frame, frames 13 and 14 fall back, and
+    // frame 8 stays untracked with its batch although tracking came back
+    ReplayStats twoFrames = Replay(25000000);
+    CHECK(twoFrames.batches == TraceFrameCount / 3);
+    CHECK(twoFrames.extrapolated == TraceFrameCount - TraceFrameCount / 3 - 2);
+    CHECK(twoFrames.fallbacks == 2);
+    CHECK(twoFrames.untracked == 2);
+    CHECK(twoFrames.worstPositionError < 0.002);
+    CHECK(twoFrames.worstOrientationError < 0.006);
+}
+
+// An Overlay with ten spaces that looks at all of them once at startup,
+// then at its view and controllers every frame, and at one more for a
+// couple of frames midway.  Only what it located in its last two frames is
+// batched, and at most one RPC goes to Main in a frame once it's running.
+static void TestBatchesRecentSpaces()
+{
+    SpaceLocationCache cache;
+    TraceMain main;
+    const XrSpace stage = TestSpace(100);
+    const XrSpace view = TestSpace(1);
+    const XrSpace left = TestSpace(2);
+    const XrSpace right = TestSpace(3);
+    const uint32_t spaceCount = 10;
+    const XrDuration window = 20000000;
+
+    uint32_t fallbacks = 0;
+    for(uint32_t frame = 0; frame < TraceFrameCount; frame++) {
+        std::vector<XrSpace> spaces { view, right };
+        if(frame < 20) {
+            spaces.push_back(left);
+        }
+        if(frame == 0) {
+            for(uintptr_t id = 4; id <= spaceCount; id++) {
+                spaces.push_back(TestSpace(id));
+            }
+        }
+        if((frame == 10) || (frame == 11)) {
+            spaces.push_back(TestSpace(4));
+        }
+        if(frame == 20) {
+            cache.Forget(left);
+        }
+
+        uint32_t rpcsBefore = main.rpcs;
+        uint32_t spacesBefore = main.spacesLocated;
+        uint32_t fallbacksBefore = fallbacks;
+        for(XrSpace space: spaces) {
+            XrSpaceLocation location = EmptyLocation();
+            XrResult result;
+            fallbacks += cache.Locate(space, stage, FrameTime(frame), window, [&](auto&&... args) { return main(args...); }, &location, &result) ? 0 : 1;
+        }
+        uint32_t rpcs = main.rpcs - rpcsBefore;
+        uint32_t spacesLocated = main.spacesLocated - spacesBefore;
+
+        if(frame == 0) {
+            // The first locate's batch has only itself; every other space joins it on its own
+            CHECK((rpcs == spaceCount) && (spacesLocated == spaceCount));
+        } else if(frame % 2 == 1) {
+            // Extrapolated, except after the batch that lost the pose in frame 12
+            CHECK(rpcs == 0);
+            CHECK(fallbacks - fallbacksBefore == ((frame == 13) ? 3u : 0u));
+        } else if(frame == 10) {
+            // The view and controllers, then the one coming back joins
+            CHECK((rpcs == 2) && (spacesLocated == 4));
+        } else if(frame == 12) {
+            // It was located last frame, so it's batched
+            CHECK((rpcs == 1) && (spacesLocated == 4));
+        } else if(frame >= 20) {
+            // The left controller was destroyed
+            CHECK((rpcs == 1) && (spacesLocated == 2));
+        } else {
+            CHECK((rpcs == 1) && (spacesLocated == 3));
+        }
+        cache.frame++;
+    }
+}
+
+int main()
+{
+    TestTimeWindow();
+    TestUnusableSamples();
+    TestExtrapolatesAlongTrace();
+    TestReplayTrace();
+    TestBatchesRecentSpaces();
+
+    if(gFailures > 0) {
+        fprintf(stderr, "%d checks failed\n", gFailures);
+        return 1;
+    }
+    printf("all checks passed\n");
+    return 0;
+}
@@ -0,0 +1,58 @@
+// Copyright (c) 2021 LunarG, Inc.
+// Copyright (c) 2017-2021 PlutoVR Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Brad Grantham <brad@lunarg.com>
+#ifndef _XR_EXTX_OVERLAY_DAMAGE_H_
+#define _XR_EXTX_OVERLAY_DAMAGE_H_
+
+#include <openxr/openxr.h>
+
+// Revision 5 of XR_EXTX_overlay, implemented by this layer, adds damage
+// rectangles on xrReleaseSwapchainImage: chain this to
+// XrSwapchainImageReleaseInfo to say only rects changed since the image
+// was last released (a rectCount of 0 marks the image unchanged).  The
+// layer consumes the structure and never passes it to the runtime.  The
+// OpenXR headers only declare revision 4, so it is declared here until
+// they catch up.
+#if !defined(XR_EXTX_overlay_SPEC_VERSION) || (XR_EXTX_overlay_SPEC_VERSION < 5)
+
+#define XR_TYPE_SWAPCHAIN_IMAGE_RELEASE_DAMAGE_INFO_EXTX ((XrStructureType)1000033004)
+
+typedef struct XrSwapchainImageReleaseDamageInfoEXTX {
+    XrStructureType             type;
+    const void* XR_MAY_ALIAS    next;
+    uint32_t                    rectCount;
+    const XrRect2Di*            rects;
+} XrSwapchainImageReleaseDamageInfoEXTX;
+
+#endif
+
+// Also layer-defined: chain this to XrFrameEndInfo to say the layers and
+// blend mode are the same as in the previous xrEndFrame, so the layer
+// doesn't compare them.  Dropped before anything reaches the runtime.
+#if !defined(XR_TYPE_FRAME_END_INFO_UNCHANGED_EXTX)
+
+#define XR_TYPE_FRAME_END_INFO_UNCHANGED_EXTX ((XrStructureType)1000033005)
+
+typedef struct XrFrameEndInfoUnchangedEXTX {
+    XrStructureType             type;
+    const void* XR_MAY_ALIAS    next;
+} XrFrameEndInfoUnchangedEXTX;
+
+#endif
+
+#endif /* _XR_EXTX_OVERLAY_DAMAGE_H_ */